@@ -397,35 +397,44 @@ static void detect_zero_crossing(struct timecoder_channel *ch,
 }
 
 /*
- * Plot the given sample value in the x-y monitor
+ * Fade out the pixels already in the monitor
+ *
+ * Written without branches, so the compiler can vectorize the loop.
  */
 
-static inline void update_monitor(struct timecoder *tc, signed int x, signed int y)
+static void decay_monitor(struct timecoder *tc)
 {
-    int px, py, size, ref;
+    unsigned char *mon;
+    int p, n;
 
-    if (!tc->mon)
-        return;
+    mon = tc->mon;
+    n = SQ(tc->mon_size);
+    for (p = 0; p < n; p++)
+        mon[p] = (unsigned char)(mon[p] * 7 / 8);
+}
 
-    size = tc->mon_size;
-    ref = tc->ref_level;
+/*
+ * Plot the given sample value in the x-y monitor
+ *
+ * The scale is size / ref / 8, precomputed by the caller for the
+ * current reference level.
+ */
 
-    /* Decay the pixels already in the montior */
+static inline void update_monitor(struct timecoder *tc, signed int x, signed int y,
+                                  double scale)
+{
+    int px, py, size;
 
-    if (++tc->mon_counter % MONITOR_DECAY_EVERY == 0) {
-        int p;
+    size = tc->mon_size;
 
-        for (p = 0; p < SQ(size); p++) {
-            if (tc->mon[p])
-                tc->mon[p] = tc->mon[p] * 7 / 8;
-        }
-    }
+    /* Decay the pixels already in the montior */
 
-    assert(ref > 0);
+    if (++tc->mon_counter % MONITOR_DECAY_EVERY == 0)
+        decay_monitor(tc);
 
     /* ref_level is half the precision of signal level */
-    px = size / 2 + (long long)x * size / ref / 8;
-    py = size / 2 + (long long)y * size / ref / 8;
+    px = size / 2 + (int)(x * scale);
+    py = size / 2 + (int)(y * scale);
 
     if (px < 0 || px >= size || py < 0 || py >= size)
         return;
@@ -589,22 +598,43 @@ void timecoder_cycle_definition(struct timecoder *tc)
 
 void timecoder_submit(struct timecoder *tc, signed short *pcm, size_t npcm)
 {
-    while (npcm--) {
-	signed int left, right, primary, secondary;
+    int primary_offset, secondary_offset;
+    signed int scale_ref;
+    double scale;
 
-        left = pcm[0] << 16;
-        right = pcm[1] << 16;
+    /* The channel assignment is fixed for the whole block */
 
-        if (tc->def->flags & SWITCH_PRIMARY) {
-            primary = left;
-            secondary = right;
-        } else {
-            primary = right;
-            secondary = left;
-        }
+    if (tc->def->flags & SWITCH_PRIMARY) {
+        primary_offset = 0;
+        secondary_offset = 1;
+    } else {
+        primary_offset = 1;
+        secondary_offset = 0;
+    }
+
+    /* The monitor scale only changes with the reference level, which
+     * is updated once per wave cycle at most. Avoid two 64-bit
+     * divisions per sample. */
+
+    scale_ref = 0;
+    scale = 0.0;
+
+    while (npcm--) {
+	signed int primary, secondary;
+
+        primary = pcm[primary_offset] << 16;
+        secondary = pcm[secondary_offset] << 16;
 
 	process_sample(tc, primary, secondary);
-        update_monitor(tc, left, right);
+
+        if (tc->mon) {
+            assert(tc->ref_level > 0);
+            if (tc->ref_level != scale_ref) {
+                scale_ref = tc->ref_level;
+                scale = (double)tc->mon_size / scale_ref / 8;
+            }
+            update_monitor(tc, pcm[0] << 16, pcm[1] << 16, scale);
+        }
 
         pcm += TIMECODER_CHANNELS;
     }
@@ -0,0 +1,56 @@
+#include "broadcast/broadcastbitrateadapter.h"
+
+#include <algorithm>
+
+BroadcastBitrateAdapter::BroadcastBitrateAdapter(
+        const QList<int>& bitrates, int configuredBitrate)
+        : m_index(0),
+          m_drained(false) {
+    for (int bitrate : bitrates) {
+        if (bitrate <= configuredBitrate) {
+            m_bitrates.append(bitrate);
+        }
+    }
+    std::sort(m_bitrates.begin(), m_bitrates.end());
+    if (m_bitrates.isEmpty() || m_bitrates.last() != configuredBitrate) {
+        // Always allow the configured bitrate, even if it is not one
+        // of the regular steps.
+        m_bitrates.append(configuredBitrate);
+    }
+    m_index = static_cast<int>(m_bitrates.size()) - 1;
+}
+
+void BroadcastBitrateAdapter::reset(Clock::time_point now) {
+    m_index = static_cast<int>(m_bitrates.size()) - 1;
+    m_lastSwitch = now;
+    m_drained = false;
+}
+
+int BroadcastBitrateAdapter::update(
+        std::chrono::milliseconds backlog, Clock::time_point now) {
+    if (backlog >= kStepUpBacklog) {
+        m_drained = false;
+    } else if (!m_drained) {
+        m_drained = true;
+        m_drainedSince = now;
+    }
+
+    if (now - m_lastSwitch < kSwitchHoldTime) {
+        return bitrate();
+    }
+
+    if (backlog > kStepDownBacklog) {
+        if (m_index > 0) {
+            --m_index;
+            m_lastSwitch = now;
+        }
+    } else if (m_drained && now - m_drainedSince >= kStepUpHoldTime) {
+        if (m_index < m_bitrates.size() - 1) {
+            ++m_index;
+            m_lastSwitch = now;
+            // Require another hold period before the next step up
+            m_drainedSince = now;
+        }
+    }
+    return bitrate();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QList>
+#include <chrono>
+
+/// Decides which bitrate a broadcast connection should use, depending on
+/// how much encoded audio is waiting in its send queue.
+///
+/// When the backlog exceeds kStepDownBacklog the bitrate is lowered by one
+/// step. After the backlog has stayed below kStepUpBacklog for
+/// kStepUpHoldTime the bitrate is raised by one step again, up to the
+/// configured bitrate. After each switch the adapter waits for
+/// kSwitchHoldTime, to give the new bitrate a chance to take effect.
+class BroadcastBitrateAdapter {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr auto kStepDownBacklog = std::chrono::milliseconds(2000);
+    static constexpr auto kStepUpBacklog = std::chrono::milliseconds(250);
+    static constexpr auto kStepUpHoldTime = std::chrono::seconds(10);
+    static constexpr auto kSwitchHoldTime = std::chrono::seconds(5);
+
+    /// @param bitrates The supported bitrates in kbit/s, in any order
+    /// @param configuredBitrate The bitrate selected by the user, which
+    ///        is never exceeded
+    BroadcastBitrateAdapter(const QList<int>& bitrates, int configuredBitrate);
+
+    /// Returns to the configured bitrate.
+    void reset(Clock::time_point now);
+
+    /// Updates the adapter with the current send backlog and returns the
+    /// bitrate that should be used from now on.
+    int update(std::chrono::milliseconds backlog, Clock::time_point now);
+
+    int bitrate() const {
+        return m_bitrates.value(m_index);
+    }
+
+  private:
+    // ascending, capped at the configured bitrate
+    QList<int> m_bitrates;
+    int m_index;
+    Clock::time_point m_lastSwitch;
+    Clock::time_point m_drainedSince;
+    bool m_drained;
+};
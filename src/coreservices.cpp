@@ -50,6 +50,7 @@
 #include "sources/soundsourceproxy.h"
 #include "util/clipboard.h"
 #include "util/db/dbconnectionpooled.h"
+#include "util/fileblockcache.h"
 #include "util/font.h"
 #include "util/logger.h"
 #include "util/screensavermanager.h"
@@ -233,7 +234,8 @@ void CoreServices::initialize(QApplication* pApp) {
 
     ScopedTimer t(QStringLiteral("CoreServices::initialize"));
 
-    VERIFY_OR_DEBUG_ASSERT(SoundSourceProxy::registerProviders()) {
+    VERIFY_OR_DEBUG_ASSERT(SoundSourceProxy::registerProviders(
+            m_pSettingsManager->settings()->getSettingsPath())) {
         qCritical() << "Failed to register any SoundSource providers";
         return;
     }
@@ -253,6 +255,11 @@ void CoreServices::initialize(QApplication* pApp) {
 
     UserSettingsPointer pConfig = m_pSettingsManager->settings();
 
+    mixxx::FileBlockCache::instance()->setReadAheadBytes(
+            qint64{1024} *
+            pConfig->getValue(mixxx::library::prefs::kFileReadAheadKiBConfigKey,
+                    mixxx::library::prefs::kFileReadAheadKiBDefault));
+
     Sandbox::setPermissionsFilePath(QDir(pConfig->getSettingsPath()).filePath("sandbox.cfg"));
 
     QString resourcePath = pConfig->getResourcePath();
@@ -356,7 +363,8 @@ void CoreServices::initialize(QApplication* pApp) {
             &ScreensaverManager::slotCurrentPlayingDeckChanged);
 
     emit initializationProgressUpdate(50, tr("library"));
-    CoverArtCache::createInstance();
+    CoverArtCache::createInstance(
+            QDir(pConfig->getSettingsPath()).filePath(QStringLiteral("coverart")));
     Clipboard::createInstance();
 
     m_pTrackCollectionManager = std::make_shared<TrackCollectionManager>(
@@ -1,6 +1,8 @@
 #include "database/mixxxdb.h"
 
 #include <QDir>
+#include <QFileInfo>
+#include <QStorageInfo>
 
 #include "database/schemamanager.h"
 #include "moc_mixxxdb.cpp"
@@ -12,7 +14,7 @@
 const QString MixxxDb::kDefaultSchemaFile(":/schema.xml");
 
 //static
-const int MixxxDb::kRequiredSchemaVersion = 39;
+const int MixxxDb::kRequiredSchemaVersion = 41;
 
 namespace {
 
@@ -30,6 +32,40 @@ const QString kUserName = QStringLiteral("mixxx");
 
 const QString kPassword = QStringLiteral("mixxx");
 
+// SQLite tuning options. The defaults are suitable for libraries with
+// a few 100k tracks and can be overridden in mixxx.cfg if needed.
+//
+// Write-ahead logging and memory-mapped I/O are disabled by default.
+// Both rely on shared memory and file locking that network file systems
+// don't provide reliably, and an I/O error while accessing the mapped
+// database crashes Mixxx instead of failing the query.
+const QString kConfigGroup = QStringLiteral("[Library]");
+
+const ConfigKey kWriteAheadLogConfigKey =
+        ConfigKey{kConfigGroup, QStringLiteral("SqliteWriteAheadLog")};
+const ConfigKey kPageCacheSizeConfigKey =
+        ConfigKey{kConfigGroup, QStringLiteral("SqlitePageCacheSizeKiB")};
+const ConfigKey kMmapSizeConfigKey =
+        ConfigKey{kConfigGroup, QStringLiteral("SqliteMmapSizeMiB")};
+const ConfigKey kPreparedQueryCacheCapacityConfigKey =
+        ConfigKey{kConfigGroup, QStringLiteral("PreparedQueryCacheCapacity")};
+
+constexpr int kDefaultPageCacheSizeKiB = 16 * 1024;
+constexpr int kDefaultMmapSizeMiB = 0;
+constexpr int kDefaultPreparedQueryCacheCapacity = 32;
+
+bool isNetworkFileSystem(const QString& filePath) {
+    const QStorageInfo storageInfo(QFileInfo(filePath).absolutePath());
+    const QByteArray fileSystemType = storageInfo.fileSystemType().toLower();
+    return fileSystemType.startsWith("nfs") ||
+            fileSystemType == "cifs" ||
+            fileSystemType == "smbfs" ||
+            fileSystemType == "smb2" ||
+            fileSystemType.startsWith("fuse.sshfs") ||
+            fileSystemType == "afpfs" ||
+            fileSystemType == "webdav";
+}
+
 // The connection parameters for the main Mixxx DB
 mixxx::DbConnection::Params dbConnectionParams(
         const UserSettingsPointer& pConfig,
@@ -58,6 +94,24 @@ mixxx::DbConnection::Params dbConnectionParams(
     }
     params.userName = kUserName;
     params.password = kPassword;
+    // The shared cache of in-memory databases doesn't support WAL
+    params.writeAheadLog = !inMemoryConnection &&
+            pConfig->getValue(kWriteAheadLogConfigKey, false);
+    if (params.writeAheadLog && isNetworkFileSystem(absFilePath)) {
+        kLogger.warning()
+                << "Not using write-ahead logging for the database"
+                << absFilePath
+                << "on a network file system";
+        params.writeAheadLog = false;
+    }
+    params.pageCacheSizeKiB = pConfig->getValue(
+            kPageCacheSizeConfigKey, kDefaultPageCacheSizeKiB);
+    params.mmapSizeBytes = static_cast<qint64>(pConfig->getValue(
+                                   kMmapSizeConfigKey, kDefaultMmapSizeMiB)) *
+            1024 * 1024;
+    params.preparedQueryCacheCapacity = pConfig->getValue(
+            kPreparedQueryCacheCapacityConfigKey,
+            kDefaultPreparedQueryCacheCapacity);
     return params;
 }
 
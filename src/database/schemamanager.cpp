@@ -214,6 +214,12 @@ SchemaManager::Result SchemaManager::upgradeToSchemaVersion(
 
         QString description = eDescription.text();
         QString sql = eSql.text();
+        // Optional migrations depend on features of SQLite that might not
+        // be available, e.g. the FTS5 extension. If they fail the changes
+        // are reverted and the schema version is upgraded nevertheless.
+        // Code that depends on an optional migration needs to check at
+        // runtime if the migration has actually been applied.
+        const bool optional = revision.attribute("optional") == QStringLiteral("true");
 
         kLogger.info()
                 << "Upgrading database schema to version"
@@ -228,6 +234,15 @@ SchemaManager::Result SchemaManager::upgradeToSchemaVersion(
 
         QStringListIterator it(sqlStatements);
 
+        if (optional) {
+            FwdSqlQuery query(m_settingsDao.database(),
+                    QStringLiteral("SAVEPOINT optional_migration"));
+            if (!query.isPrepared() || !query.execPrepared()) {
+                transaction.rollback();
+                return Result::UpgradeFailed;
+            }
+        }
+
         bool result = true;
         while (result && it.hasNext()) {
             QString statement = it.next().trimmed();
@@ -255,6 +270,20 @@ SchemaManager::Result SchemaManager::upgradeToSchemaVersion(
             }
         }
 
+        if (optional) {
+            if (!result) {
+                kLogger.warning()
+                        << "Skipping optional database schema migration"
+                        << "to version" << nextVersion;
+                FwdSqlQuery query(m_settingsDao.database(),
+                        QStringLiteral("ROLLBACK TO optional_migration"));
+                result = query.isPrepared() && query.execPrepared();
+            }
+            FwdSqlQuery query(m_settingsDao.database(),
+                    QStringLiteral("RELEASE optional_migration"));
+            result = result && query.isPrepared() && query.execPrepared();
+        }
+
         if (result) {
             if (nextVersion > currentVersion) {
                 currentVersion = nextVersion;
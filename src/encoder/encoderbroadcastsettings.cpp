@@ -5,8 +5,9 @@
 #define DEFAULT_BITRATE 128
 
 EncoderBroadcastSettings::EncoderBroadcastSettings(
-        BroadcastProfilePtr profile)
-        : m_pProfile(profile) {
+        BroadcastProfilePtr profile, int bitrate)
+        : m_pProfile(profile),
+          m_bitrate(bitrate) {
     m_qualList.append(32);
     m_qualList.append(48);
     m_qualList.append(64);
@@ -26,7 +27,7 @@ QList<int> EncoderBroadcastSettings::getQualityValues() const {
 }
 
 int EncoderBroadcastSettings::getQuality() const {
-    int bitrate = m_pProfile->getBitrate();
+    int bitrate = m_bitrate > 0 ? m_bitrate : m_pProfile->getBitrate();
     if (m_qualList.contains(bitrate)) {
         return bitrate;
     }
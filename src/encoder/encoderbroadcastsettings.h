@@ -6,7 +6,8 @@
 /// Storage of broadcast settings for the encoders.
 class EncoderBroadcastSettings : public EncoderSettings {
   public:
-    explicit EncoderBroadcastSettings(BroadcastProfilePtr profile);
+    /// @param bitrate Overrides the bitrate of the profile if > 0
+    explicit EncoderBroadcastSettings(BroadcastProfilePtr profile, int bitrate = 0);
     ~EncoderBroadcastSettings() override = default;
 
     // Returns the list of quality values that it supports, to assign them to the slider
@@ -20,4 +21,5 @@ class EncoderBroadcastSettings : public EncoderSettings {
   private:
     QList<int> m_qualList;
     BroadcastProfilePtr m_pProfile;
+    int m_bitrate;
 };
@@ -0,0 +1,374 @@
+#include "encoder/encodershared.h"
+
+#include <QHash>
+#include <QMutex>
+#include <utility>
+#include <vector>
+
+#include "audio/types.h"
+#include "encoder/encodercallback.h"
+#include "recording/defs_recording.h"
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("EncoderShared");
+
+// Same limit as the libshout queue of a single connection:
+// 10 s mp3 @ 192 kbit/s
+constexpr int kMaxPendingBytes = 491520;
+
+// A client that has not received any encoded data while passing this
+// many seconds of its own audio takes over feeding the shared encoder,
+// because the connection that fed it so far has stalled.
+constexpr double kMaxStallSeconds = 1.0;
+
+QString streamKey(const EncoderSettings& settings, mixxx::audio::SampleRate sampleRate) {
+    QString key = QStringLiteral("%1|%2|%3|%4")
+                          .arg(settings.getFormat(),
+                                  QString::number(settings.getQuality()),
+                                  QString::number(static_cast<int>(
+                                          settings.getChannelMode())),
+                                  QString::number(sampleRate.value()));
+    const auto optionGroups = settings.getOptionGroups();
+    for (const auto& group : optionGroups) {
+        key += QChar('|') + group.groupCode + QChar('=') +
+                QString::number(settings.getSelectedOption(group.groupCode));
+    }
+    return key;
+}
+
+/// A copy of the values of settings that are passed to
+/// EncoderShared::setEncoderSettings(), because the shared
+/// encoder may outlive them.
+class EncoderSettingsSnapshot final : public EncoderSettings {
+  public:
+    explicit EncoderSettingsSnapshot(const EncoderSettings& settings)
+            : m_format(settings.getFormat()),
+              m_qualityValues(settings.getQualityValues()),
+              m_quality(settings.getQuality()),
+              m_qualityIndex(settings.getQualityIndex()),
+              m_compressionValues(settings.getCompressionValues()),
+              m_compression(settings.getCompression()),
+              m_optionGroups(settings.getOptionGroups()),
+              m_channelMode(settings.getChannelMode()) {
+        for (const auto& group : std::as_const(m_optionGroups)) {
+            m_selectedOptions.insert(group.groupCode,
+                    settings.getSelectedOption(group.groupCode));
+        }
+    }
+
+    QList<int> getQualityValues() const override {
+        return m_qualityValues;
+    }
+    int getQuality() const override {
+        return m_quality;
+    }
+    int getQualityIndex() const override {
+        return m_qualityIndex;
+    }
+    QList<int> getCompressionValues() const override {
+        return m_compressionValues;
+    }
+    int getCompression() const override {
+        return m_compression;
+    }
+    QList<OptionsGroup> getOptionGroups() const override {
+        return m_optionGroups;
+    }
+    int getSelectedOption(const QString& groupCode) const override {
+        return m_selectedOptions.value(groupCode);
+    }
+    ChannelMode getChannelMode() const override {
+        return m_channelMode;
+    }
+    QString getFormat() const override {
+        return m_format;
+    }
+
+  private:
+    const QString m_format;
+    const QList<int> m_qualityValues;
+    const int m_quality;
+    const int m_qualityIndex;
+    const QList<int> m_compressionValues;
+    const int m_compression;
+    const QList<OptionsGroup> m_optionGroups;
+    QHash<QString, int> m_selectedOptions;
+    const ChannelMode m_channelMode;
+};
+
+} // anonymous namespace
+
+/// The encoder that is shared by all EncoderShared handles with the same
+/// settings. It receives the encoded data from the wrapped encoder and
+/// distributes it to the pending buffers of all subscribed handles.
+class EncoderShared::Stream : public EncoderCallback {
+  public:
+    static std::shared_ptr<Stream> getOrCreate(
+            EncoderSettingsPointer pSettings,
+            mixxx::audio::SampleRate sampleRate,
+            QString* pUserErrorMessage) {
+        const QString key = streamKey(*pSettings, sampleRate);
+        const auto locker = lockMutex(&s_registryMutex);
+        std::shared_ptr<Stream> pStream = s_registry.value(key).lock();
+        if (pStream) {
+            kLogger.debug() << "Sharing encoder" << key;
+            return pStream;
+        }
+        pStream = std::make_shared<Stream>();
+        pStream->m_maxStallSamples = static_cast<quint64>(kMaxStallSeconds *
+                sampleRate.value() * mixxx::audio::ChannelCount::stereo());
+        pStream->m_pEncoder = EncoderFactory::getFactory().createEncoder(
+                pSettings, pStream.get());
+        if (!pStream->m_pEncoder ||
+                pStream->m_pEncoder->initEncoder(sampleRate, pUserErrorMessage) < 0) {
+            return nullptr;
+        }
+        kLogger.debug() << "Created encoder" << key;
+        // Drop expired entries while we are here
+        for (auto it = s_registry.begin(); it != s_registry.end();) {
+            if (it.value().expired()) {
+                it = s_registry.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        s_registry.insert(key, pStream);
+        return pStream;
+    }
+
+    ~Stream() override {
+        // Deleting the encoder flushes it, which calls write()
+        m_pEncoder.reset();
+    }
+
+    void unsubscribe(const EncoderShared* pClient) {
+        const auto locker = lockMutex(&m_mutex);
+        for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+            if (it->pHandle == pClient) {
+                m_clients.erase(it);
+                break;
+            }
+        }
+        if (m_pFeedingClient == pClient) {
+            // The next client that passes audio takes over
+            m_pFeedingClient = nullptr;
+        }
+    }
+
+    /// Encodes the buffer if the client is the one that feeds the shared
+    /// encoder and moves all encoded data pending for the client into
+    /// pPending.
+    ///
+    /// The output FIFOs of the connections are filled independently, i.e.
+    /// they are flushed on connect, overflow and are drift corrected on
+    /// their own. Their audio can't be combined into a single stream, so
+    /// the encoder is only fed by one connection at a time and the audio
+    /// of all other clients is ignored.
+    ///
+    /// Clients are subscribed with their first buffer, i.e. when the
+    /// connection starts streaming and not already while it is still
+    /// connecting.
+    void encodeBuffer(const EncoderShared* pClient,
+            const CSAMPLE* samples,
+            std::size_t bufferSize,
+            QByteArray* pPending) {
+        const auto locker = lockMutex(&m_mutex);
+        Client* pThisClient = findClient(pClient);
+        if (!pThisClient) {
+            // Start with the next encoded data, joining in the middle
+            // of the stream
+            m_clients.push_back(Client{pClient, 0, QByteArray()});
+            pThisClient = &m_clients.back();
+        }
+        if (!m_pFeedingClient) {
+            m_pFeedingClient = pClient;
+        } else if (m_pFeedingClient != pClient) {
+            pThisClient->stalledSamples += bufferSize;
+            if (pThisClient->stalledSamples > m_maxStallSamples) {
+                kLogger.debug() << "Taking over the shared encoder after"
+                                << pThisClient->stalledSamples
+                                << "samples without encoded data";
+                m_pFeedingClient = pClient;
+            }
+        }
+        if (m_pFeedingClient == pClient) {
+            // The wrapped encoder calls write() synchronously, while we
+            // still hold the lock.
+            m_pEncoder->encodeBuffer(samples, bufferSize);
+            for (auto& client : m_clients) {
+                client.stalledSamples = 0;
+            }
+        }
+        pPending->append(pThisClient->pending);
+        pThisClient->pending.clear();
+    }
+
+    void updateMetaData(const QString& artist, const QString& title, const QString& album) {
+        const auto locker = lockMutex(&m_mutex);
+        m_pEncoder->updateMetaData(artist, title, album);
+    }
+
+    // EncoderCallback, called from within the wrapped encoder while
+    // m_mutex is locked or from the destructor
+    void write(const unsigned char* header,
+            const unsigned char* body,
+            int headerLen,
+            int bodyLen) override {
+        for (auto& client : m_clients) {
+            if (client.pending.size() + headerLen + bodyLen > kMaxPendingBytes) {
+                // The connection is not draining its data, it would only
+                // receive outdated audio
+                kLogger.warning() << "Pending data overflow, dropping"
+                                  << client.pending.size() << "bytes";
+                client.pending.clear();
+            }
+            if (headerLen > 0) {
+                client.pending.append(reinterpret_cast<const char*>(header), headerLen);
+            }
+            if (bodyLen > 0) {
+                client.pending.append(reinterpret_cast<const char*>(body), bodyLen);
+            }
+        }
+    }
+    // These are not used for streaming, but the interface requires them
+    int tell() override {
+        return -1;
+    }
+    void seek(int pos) override {
+        Q_UNUSED(pos);
+    }
+    int filelen() override {
+        return 0;
+    }
+
+  private:
+    struct Client {
+        const EncoderShared* pHandle;
+        // Number of samples this client has passed to encodeBuffer()
+        // since the shared encoder has been fed
+        quint64 stalledSamples;
+        QByteArray pending;
+    };
+
+    Client* findClient(const EncoderShared* pClient) {
+        for (auto& client : m_clients) {
+            if (client.pHandle == pClient) {
+                return &client;
+            }
+        }
+        return nullptr;
+    }
+
+    static QMutex s_registryMutex;
+    static QHash<QString, std::weak_ptr<Stream>> s_registry;
+
+    QMutex m_mutex;
+    EncoderPointer m_pEncoder;
+    quint64 m_maxStallSamples = 0;
+    std::vector<Client> m_clients;
+    const EncoderShared* m_pFeedingClient = nullptr;
+};
+
+QMutex EncoderShared::Stream::s_registryMutex;
+QHash<QString, std::weak_ptr<EncoderShared::Stream>> EncoderShared::Stream::s_registry;
+
+// static
+bool EncoderShared::isShareable(const EncoderSettings& settings) {
+    // MP3 and ADTS framed AAC streams can be decoded starting at
+    // any frame. Ogg streams start with header pages and carry the
+    // metadata in-stream, so each connection needs its own encoder.
+    const QString format = settings.getFormat();
+    return format == ENCODING_MP3 ||
+            format == ENCODING_AAC ||
+            format == ENCODING_HEAAC ||
+            format == ENCODING_HEAACV2;
+}
+
+EncoderShared::EncoderShared(EncoderSettingsPointer pSettings, EncoderCallback* pCallback)
+        : m_pSettings(pSettings),
+          m_pCallback(pCallback) {
+    DEBUG_ASSERT(m_pSettings);
+    DEBUG_ASSERT(m_pCallback);
+}
+
+EncoderShared::~EncoderShared() {
+    if (m_pStream) {
+        m_pStream->unsubscribe(this);
+    }
+}
+
+int EncoderShared::initEncoder(mixxx::audio::SampleRate sampleRate,
+        QString* pUserErrorMessage) {
+    if (m_pStream) {
+        m_pStream->unsubscribe(this);
+    }
+    m_sampleRate = sampleRate;
+    m_pStream = Stream::getOrCreate(m_pSettings, sampleRate, pUserErrorMessage);
+    if (!m_pStream) {
+        return -1;
+    }
+    return 0;
+}
+
+void EncoderShared::encodeBuffer(const CSAMPLE* samples, const std::size_t bufferSize) {
+    VERIFY_OR_DEBUG_ASSERT(m_pStream) {
+        return;
+    }
+    m_pStream->encodeBuffer(this, samples, bufferSize, &m_pending);
+    writePending();
+}
+
+void EncoderShared::updateMetaData(const QString& artist,
+        const QString& title,
+        const QString& album) {
+    // Applies to all connections that share the encoder, just like the
+    // metadata of the playing track that is sent to the servers.
+    VERIFY_OR_DEBUG_ASSERT(m_pStream) {
+        return;
+    }
+    m_pStream->updateMetaData(artist, title, album);
+}
+
+void EncoderShared::flush() {
+    // The shared encoder is flushed when the last handle is gone.
+    // Only pass on what is already pending for this handle.
+    writePending();
+}
+
+void EncoderShared::setEncoderSettings(const EncoderSettings& settings) {
+    m_pSettings = std::make_shared<EncoderSettingsSnapshot>(settings);
+    if (!m_pStream) {
+        // Applied by initEncoder()
+        return;
+    }
+    // Switch to the encoder that is shared by all handles with
+    // the new settings
+    QString userErrorMessage;
+    auto pStream = Stream::getOrCreate(m_pSettings, m_sampleRate, &userErrorMessage);
+    if (!pStream) {
+        kLogger.warning()
+                << "Failed to apply the encoder settings:"
+                << userErrorMessage;
+        return;
+    }
+    if (pStream == m_pStream) {
+        return;
+    }
+    m_pStream->unsubscribe(this);
+    m_pStream = std::move(pStream);
+}
+
+void EncoderShared::writePending() {
+    if (m_pending.isEmpty()) {
+        return;
+    }
+    m_pCallback->write(nullptr,
+            reinterpret_cast<const unsigned char*>(m_pending.constData()),
+            0,
+            static_cast<int>(m_pending.size()));
+    m_pending.clear();
+}
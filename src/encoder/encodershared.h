@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QByteArray>
+#include <memory>
+
+#include "encoder/encoder.h"
+#include "encoder/encodersettings.h"
+
+class EncoderCallback;
+
+/// Encoder handle that shares a single encoder instance between all
+/// broadcast connections with identical encoder settings, so streaming
+/// the same mix to several mounts encodes it only once.
+///
+/// The shared encoder is fed with the audio of a single handle at a time,
+/// because the connections receive the engine output through independent
+/// FIFOs that are not in sync. The audio of the other handles is not
+/// encoded. The encoded data is buffered per handle and passed to the
+/// handle's own callback from within encodeBuffer(), i.e. on the thread of
+/// the connection that owns the handle.
+class EncoderShared : public Encoder {
+  public:
+    /// Only formats without a stream header can be shared, because
+    /// a connection that joins later has to be able to start at any frame.
+    static bool isShareable(const EncoderSettings& settings);
+
+    EncoderShared(EncoderSettingsPointer pSettings, EncoderCallback* pCallback);
+    ~EncoderShared() override;
+
+    int initEncoder(mixxx::audio::SampleRate sampleRate, QString* pUserErrorMessage) override;
+    void encodeBuffer(const CSAMPLE* samples, const std::size_t bufferSize) override;
+    // Forwarded to the shared encoder
+    void updateMetaData(const QString& artist, const QString& title, const QString& album) override;
+    void flush() override;
+    // The settings identify the shared encoder. Changing them after
+    // initEncoder() switches to the encoder that is shared by all handles
+    // with the new settings.
+    void setEncoderSettings(const EncoderSettings& settings) override;
+
+    class Stream;
+
+  private:
+    void writePending();
+
+    EncoderSettingsPointer m_pSettings;
+    EncoderCallback* const m_pCallback;
+    mixxx::audio::SampleRate m_sampleRate;
+    std::shared_ptr<Stream> m_pStream;
+    QByteArray m_pending;
+};
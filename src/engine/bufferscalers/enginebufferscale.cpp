@@ -12,6 +12,7 @@ EngineBufferScale::EngineBufferScale()
           m_dBaseRate(1.0),
           m_bSpeedAffectsPitch(false),
           m_dTempoRatio(1.0),
+          m_dOldTempoRatio(1.0),
           m_dPitchRatio(1.0),
           m_effectiveRate(1.0) {
     DEBUG_ASSERT(!m_signal.isValid());
@@ -36,3 +37,14 @@ void EngineBufferScale::setSignal(
     }
     DEBUG_ASSERT(m_signal.isValid());
 }
+
+double EngineBufferScale::rampedTempoRatio(
+        SINT processedFrames, SINT totalFrames) const {
+    if (m_dOldTempoRatio <= 0.0 || m_dTempoRatio <= 0.0 || totalFrames <= 0) {
+        return m_dTempoRatio;
+    }
+    DEBUG_ASSERT(processedFrames >= 0);
+    DEBUG_ASSERT(processedFrames <= totalFrames);
+    return m_dOldTempoRatio +
+            (m_dTempoRatio - m_dOldTempoRatio) * processedFrames / totalFrames;
+}
@@ -70,9 +70,20 @@ class EngineBufferScale : public QObject {
     virtual void onSignalChanged() = 0;
 
   protected:
+    // Returns the tempo ratio for the block of input frames that is processed
+    // after processedFrames of the totalFrames in the output buffer have been
+    // produced. Scalers that process the output buffer in blocks use this to
+    // ramp linearly from the tempo ratio of the previous buffer to the new one,
+    // so that the sync phase correction is not applied in steps at large buffer
+    // sizes. No ramp is applied when starting from or stopping at a tempo of 0.
+    double rampedTempoRatio(SINT processedFrames, SINT totalFrames) const;
+
     double m_dBaseRate;
     bool m_bSpeedAffectsPitch;
     double m_dTempoRatio;
+    // The tempo ratio at the end of the previous buffer, i.e. the start of
+    // the tempo ramp.
+    double m_dOldTempoRatio;
     double m_dPitchRatio;
     // Due to the scaler latency, tempo and pitch changes are not immediately effective.
     double m_effectiveRate;
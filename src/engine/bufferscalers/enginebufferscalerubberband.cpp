@@ -87,6 +87,7 @@ void EngineBufferScaleRubberBand::setScaleParameters(double base_rate,
             *pTempoRatio = m_bBackwards ? -speed_abs : speed_abs;
         }
     }
+    m_appliedTimeRatioInverse = timeRatioInverse;
     // Used by other methods so we need to keep them up to date.
     m_dBaseRate = base_rate;
     m_dTempoRatio = speed_abs;
@@ -141,6 +142,7 @@ void EngineBufferScaleRubberBand::onSignalChanged() {
     // avoid memory reallocations during playback.
     m_rubberBand.setTimeRatio(2.0);
     m_rubberBand.setTimeRatio(1.0);
+    m_appliedTimeRatioInverse = 1.0;
 }
 
 void EngineBufferScaleRubberBand::clear() {
@@ -148,6 +150,8 @@ void EngineBufferScaleRubberBand::clear() {
         return;
     }
     reset();
+    // Don't ramp the tempo after seeking
+    m_dOldTempoRatio = m_dTempoRatio;
 }
 
 SINT EngineBufferScaleRubberBand::retrieveAndDeinterleave(
@@ -290,6 +294,7 @@ double EngineBufferScaleRubberBand::scaleBuffer(
     }
     ScopedTimer t(QStringLiteral("EngineBufferScaleRubberBand::scaleBuffer"));
     if (m_dBaseRate == 0.0 || m_dTempoRatio == 0.0) {
+        m_dOldTempoRatio = m_dTempoRatio;
         SampleUtil::clear(pOutputBuffer, iOutputBufferSize);
         // No actual samples/frames have been read from the
         // unscaled input buffer!
@@ -297,7 +302,8 @@ double EngineBufferScaleRubberBand::scaleBuffer(
     }
 
     double readFramesProcessed = 0;
-    SINT remaining_frames = getOutputSignal().samples2frames(iOutputBufferSize);
+    const SINT total_frames = getOutputSignal().samples2frames(iOutputBufferSize);
+    SINT remaining_frames = total_frames;
     CSAMPLE* read = pOutputBuffer;
     bool last_read_failed = false;
     while (remaining_frames > 0) {
@@ -317,12 +323,18 @@ double EngineBufferScaleRubberBand::scaleBuffer(
         const SINT next_block_frames_required =
                 static_cast<SINT>(m_rubberBand.getSamplesRequired());
         if (remaining_frames > 0 && next_block_frames_required > 0) {
+            const double timeRatioInverse = m_dBaseRate *
+                    rampedTempoRatio(total_frames - remaining_frames, total_frames);
+            if (timeRatioInverse != m_appliedTimeRatioInverse) {
+                m_rubberBand.setTimeRatio(1.0 / timeRatioInverse);
+                m_appliedTimeRatioInverse = timeRatioInverse;
+            }
             // The requested setting becomes effective after all previous frames have been processed
-            m_effectiveRate = m_dBaseRate * m_dTempoRatio;
+            m_effectiveRate = timeRatioInverse;
             const SINT available_samples = m_pReadAheadManager->getNextSamples(
                     // The value doesn't matter here. All that matters is we
                     // are going forward or backward.
-                    (m_bBackwards ? -1.0 : 1.0) * m_dBaseRate * m_dTempoRatio,
+                    (m_bBackwards ? -1.0 : 1.0) * timeRatioInverse,
                     m_interleavedReadBuffer.data(),
                     getOutputSignal().frames2samples(next_block_frames_required),
                     getOutputSignal().getChannelCount());
@@ -358,6 +370,8 @@ double EngineBufferScaleRubberBand::scaleBuffer(
         counter.increment();
     }
 
+    m_dOldTempoRatio = m_dTempoRatio;
+
     // readFramesProcessed is interpreted as the total number of frames
     // consumed to produce the scaled buffer. Due to this, we do not take into
     // account directionality or starting point.
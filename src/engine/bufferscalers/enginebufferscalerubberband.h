@@ -77,6 +77,11 @@ class EngineBufferScaleRubberBand final : public EngineBufferScale {
     /// to be deinterleaved before they can be passed to Rubber Band.
     mixxx::SampleBuffer m_interleavedReadBuffer;
 
+    /// The inverse of the time ratio that has been passed to Rubber Band most
+    /// recently. It differs from `m_dBaseRate * m_dTempoRatio` while ramping
+    /// the tempo.
+    double m_appliedTimeRatioInverse = 1.0;
+
     // Holds the playback direction
     bool m_bBackwards;
     /// The amount of silence padding that still needs to be dropped from the
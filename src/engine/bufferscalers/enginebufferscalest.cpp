@@ -31,6 +31,7 @@ constexpr SINT kBackBufferFrameSize = 512;
 EngineBufferScaleST::EngineBufferScaleST(ReadAheadManager* pReadAheadManager)
         : m_pReadAheadManager(pReadAheadManager),
           m_pSoundTouch(std::make_unique<soundtouch::SoundTouch>()),
+          m_appliedTempoRatio(1.0),
           m_bBackwards(false) {
     m_pSoundTouch->setRate(m_dBaseRate);
     m_pSoundTouch->setPitch(1.0);
@@ -65,12 +66,10 @@ void EngineBufferScaleST::setScaleParameters(double base_rate,
 
     // Include baserate in rate_abs so that we do samplerate conversion as part
     // of rate adjustment.
-    if (speed_abs != m_dTempoRatio) {
-        // Note: A rate of zero would make Soundtouch crash,
-        // this is caught in scaleBuffer()
-        m_pSoundTouch->setTempo(speed_abs);
-        m_dTempoRatio = speed_abs;
-    }
+    // The tempo is passed to SoundTouch block by block in scaleBuffer().
+    // Note: A rate of zero would make Soundtouch crash,
+    // this is caught in scaleBuffer()
+    m_dTempoRatio = speed_abs;
     if (base_rate != m_dBaseRate) {
         m_pSoundTouch->setRate(base_rate);
         m_dBaseRate = base_rate;
@@ -107,11 +106,14 @@ void EngineBufferScaleST::onSignalChanged() {
     // avoid memory reallocations during playback.
     m_pSoundTouch->setTempo(0.1);
     m_pSoundTouch->setTempo(m_dTempoRatio);
+    m_appliedTempoRatio = m_dTempoRatio;
     clear();
 }
 
 void EngineBufferScaleST::clear() {
     m_pSoundTouch->clear();
+    // Don't ramp the tempo after seeking
+    m_dOldTempoRatio = m_dTempoRatio;
 
     // compensate seek offset for a rate of 1.0
     if (SoundTouch::getVersionId() < 20302) {
@@ -127,6 +129,7 @@ double EngineBufferScaleST::scaleBuffer(
         CSAMPLE* pOutputBuffer,
         SINT iOutputBufferSize) {
     if (m_dBaseRate == 0.0 || m_dTempoRatio == 0.0 || m_dPitchRatio == 0.0) {
+        m_dOldTempoRatio = m_dTempoRatio;
         SampleUtil::clear(pOutputBuffer, iOutputBufferSize);
         // No actual samples/frames have been read from the
         // unscaled input buffer!
@@ -134,7 +137,8 @@ double EngineBufferScaleST::scaleBuffer(
     }
 
     double readFramesProcessed = 0;
-    SINT remaining_frames = getOutputSignal().samples2frames(iOutputBufferSize);
+    const SINT total_frames = getOutputSignal().samples2frames(iOutputBufferSize);
+    SINT remaining_frames = total_frames;
     CSAMPLE* read = pOutputBuffer;
     bool last_read_failed = false;
     while (remaining_frames > 0) {
@@ -146,8 +150,14 @@ double EngineBufferScaleST::scaleBuffer(
         read += getOutputSignal().frames2samples(received_frames);
 
         if (remaining_frames > 0) {
+            const double tempoRatio = rampedTempoRatio(
+                    total_frames - remaining_frames, total_frames);
+            if (tempoRatio != m_appliedTempoRatio) {
+                m_pSoundTouch->setTempo(tempoRatio);
+                m_appliedTempoRatio = tempoRatio;
+            }
             // The requested setting becomes effective after all previous frames have been processed
-            m_effectiveRate = m_dBaseRate * m_dTempoRatio;
+            m_effectiveRate = m_dBaseRate * tempoRatio;
             SINT iAvailSamples = m_pReadAheadManager->getNextSamples(
                     // The value doesn't matter here. All that matters is we
                     // are going forward or backward.
@@ -179,6 +189,8 @@ double EngineBufferScaleST::scaleBuffer(
         }
     }
 
+    m_dOldTempoRatio = m_dTempoRatio;
+
     // readFramesProcessed is interpreted as the total number of frames
     // consumed to produce the scaled buffer. Due to this, we do not take into
     // account directionality or starting point.
@@ -43,6 +43,10 @@ class EngineBufferScaleST : public EngineBufferScale {
     // Temporary buffer for reading from the RAMAN.
     mixxx::SampleBuffer m_bufferBack;
 
+    // The tempo that has been passed to SoundTouch most recently. It
+    // differs from m_dTempoRatio while ramping the tempo.
+    double m_appliedTempoRatio;
+
     // Holds the playback direction.
     bool m_bBackwards;
 };
@@ -244,9 +244,12 @@ void CachingReader::process() {
                     update.status == CHUNK_READ_EOF ||
                     update.status == CHUNK_READ_INVALID ||
                     update.status == CHUNK_READ_DISCARDED);
-            if (m_state.loadAcquire() == STATE_TRACK_LOADING) {
+            const auto state = m_state.loadAcquire();
+            if (state == STATE_TRACK_LOADING || state == STATE_TRACK_UNLOADING) {
                 // Discard all results from pending read requests for the
-                // previous track before the next track has been loaded.
+                // previous track before the next track has been loaded,
+                // or for a preloaded track that failed to open and is
+                // being unloaded.
                 freeChunk(pChunk);
                 continue;
             }
@@ -77,6 +77,26 @@ mixxx::IndexRange CachingReaderChunk::bufferSampleFrames(
     return m_bufferedSampleFrames.frameIndexRange();
 }
 
+mixxx::IndexRange CachingReaderChunk::bufferSampleFrames(
+        const mixxx::ReadableSampleFrames& sampleFrames) {
+    DEBUG_ASSERT(m_index != kInvalidChunkIndex);
+    const SINT sampleCount = sampleFrames.readableLength();
+    VERIFY_OR_DEBUG_ASSERT(sampleCount <= m_sampleBuffer.length()) {
+        m_bufferedSampleFrames = mixxx::ReadableSampleFrames();
+        return m_bufferedSampleFrames.frameIndexRange();
+    }
+    SampleUtil::copy(
+            m_sampleBuffer.data(),
+            sampleFrames.readableData(),
+            sampleCount);
+    m_bufferedSampleFrames = mixxx::ReadableSampleFrames(
+            sampleFrames.frameIndexRange(),
+            mixxx::SampleBuffer::ReadableSlice(
+                    m_sampleBuffer.data(),
+                    sampleCount));
+    return m_bufferedSampleFrames.frameIndexRange();
+}
+
 mixxx::IndexRange CachingReaderChunk::readBufferedSampleFrames(
         CSAMPLE* sampleBuffer,
         mixxx::audio::ChannelCount channelCount,
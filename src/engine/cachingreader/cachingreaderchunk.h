@@ -63,6 +63,16 @@ public:
             const mixxx::AudioSourcePointer& pAudioSource,
             mixxx::SampleBuffer::WritableSlice tempOutputBuffer);
 
+    // Copy sample frames that have been read before, e.g. from a
+    // preloaded track, and return the range of frames that have
+    // been copied.
+    mixxx::IndexRange bufferSampleFrames(
+            const mixxx::ReadableSampleFrames& sampleFrames);
+
+    const mixxx::ReadableSampleFrames& bufferedSampleFrames() const {
+        return m_bufferedSampleFrames;
+    }
+
     mixxx::IndexRange readBufferedSampleFrames(CSAMPLE* sampleBuffer,
             mixxx::audio::ChannelCount channelCount,
             const mixxx::IndexRange& frameIndexRange) const;
@@ -11,6 +11,7 @@
 #include "util/event.h"
 #include "util/fifo.h"
 #include "util/logger.h"
+#include "util/sample.h"
 #include "util/span.h"
 
 namespace {
@@ -31,6 +32,7 @@ CachingReaderWorker::CachingReaderWorker(
           m_tag(QString("CachingReaderWorker %1").arg(m_group)),
           m_pChunkReadRequestFIFO(pChunkReadRequestFIFO),
           m_pReaderStatusFIFO(pReaderStatusFIFO),
+          m_preloadedChunksServed(false),
           m_maxSupportedChannel(maxSupportedChannel) {
 }
 
@@ -39,6 +41,30 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
     CachingReaderChunk* pChunk = request.chunk;
     DEBUG_ASSERT(pChunk);
 
+    if (m_pPreloadedTrack) {
+        // Copying the preloaded chunks is faster than decoding them again
+        const auto preloadedChunk =
+                m_pPreloadedTrack->chunks.constFind(pChunk->getIndex());
+        if (preloadedChunk != m_pPreloadedTrack->chunks.constEnd()) {
+            pChunk->bufferSampleFrames(mixxx::ReadableSampleFrames(
+                    preloadedChunk->frameIndexRange,
+                    mixxx::SampleBuffer::ReadableSlice(
+                            preloadedChunk->samples.constData(),
+                            preloadedChunk->samples.size())));
+            m_preloadedChunksServed = true;
+            ReaderStatusUpdate result;
+            result.init(CHUNK_READ_SUCCESS, pChunk, m_pPreloadedTrack->frameIndexRange);
+            return result;
+        }
+    }
+    if (m_pTrackToOpen) {
+        DEBUG_ASSERT(!m_pAudioSource);
+        // The chunk is not preloaded and must be read from the audio source
+        if (!openPendingAudioSource()) {
+            return ReaderStatusUpdate::readDiscarded(pChunk);
+        }
+    }
+
     // Before trying to read any data we need to check if the audio source
     // is available and if any audio data that is needed by the chunk is
     // actually available.
@@ -86,6 +112,10 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
     // Failures of the sanity check only result in an entry into the log at the moment.
     verifyFirstSound(pChunk, m_pAudioSource->getSignalInfo().getChannelCount());
 
+    if (status == CHUNK_READ_SUCCESS && bufferedFrameIndexRange == chunkFrameIndexRange) {
+        storePreloadedChunk(pChunk);
+    }
+
     ReaderStatusUpdate result;
     result.init(status, pChunk, m_pAudioSource ? m_pAudioSource->frameIndexRange() : mixxx::IndexRange());
     return result;
@@ -150,6 +180,10 @@ void CachingReaderWorker::run() {
             // Read the requested chunk and send the result
             const ReaderStatusUpdate update = processReadRequest(request);
             m_pReaderStatusFIFO->writeBlocking(&update, 1);
+        } else if (m_pTrackToOpen && m_preloadedChunksServed) {
+            // Open the audio source in the background while the engine
+            // is playing the preloaded chunks
+            openPendingAudioSource();
         } else {
             Event::end(m_tag);
             m_semaRun.acquire();
@@ -169,6 +203,11 @@ void CachingReaderWorker::discardAllPendingRequests() {
 void CachingReaderWorker::closeAudioSource() {
     discardAllPendingRequests();
 
+    publishPreloadedTrack();
+    m_pTrackToOpen.reset();
+    m_pPreloadedTrack.reset();
+    m_preloadedChunksServed = false;
+
     if (m_pAudioSource) {
         // Closes open file handles of the old track.
         m_pAudioSource->close();
@@ -216,68 +255,122 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
     config.setChannelCount(m_maxSupportedChannel);
 #ifdef __STEM__
     config.setStemMask(stemMask);
+    m_preloadedTrackKey = PreloadedTrackPool::key(
+            pTrack->getFileInfo(),
+            m_maxSupportedChannel,
+            static_cast<int>(stemMask));
+#else
+    m_preloadedTrackKey = PreloadedTrackPool::key(
+            pTrack->getFileInfo(),
+            m_maxSupportedChannel);
 #endif
-    m_pAudioSource = SoundSourceProxy(pTrack).openAudioSource(config);
-    if (!m_pAudioSource) {
-        kLogger.warning()
+    m_mainCuePosition = pTrack->getMainCuePosition();
+
+    mixxx::audio::SignalInfo signalInfo;
+    mixxx::IndexRange frameIndexRange;
+    m_pPreloadedTrack = PreloadedTrackPool::instance()->find(m_preloadedTrackKey);
+    // An audio source that has been opened in advance is taken over
+    // without any file I/O
+    m_pAudioSource = PreloadedTrackPool::instance()->takeAudioSource(m_preloadedTrackKey);
+    if (m_pPreloadedTrack && !m_pAudioSource) {
+        // Start playing the preloaded chunks immediately and defer
+        // opening the audio source
+        m_pTrackToOpen = pTrack;
+        m_openParams = config;
+        signalInfo = m_pPreloadedTrack->signalInfo;
+        frameIndexRange = m_pPreloadedTrack->frameIndexRange;
+        // Implicitly shared, i.e. the chunks are not copied
+        m_pPreloadedTrackToPublish =
+                std::make_shared<PreloadedTrack>(*m_pPreloadedTrack);
+        kLogger.debug()
                 << m_group
-                << "Failed to open file"
+                << "Loading preloaded track"
                 << pTrack->getFileInfo();
-        const auto update = ReaderStatusUpdate::trackUnloaded();
-        m_pReaderStatusFIFO->writeBlocking(&update, 1);
-        emit trackLoadFailed(pTrack,
-                tr("The file '%1' could not be loaded.")
-                        .arg(QDir::toNativeSeparators(pTrack->getLocation())));
-        return;
-    }
+    } else {
+        if (m_pAudioSource) {
+            kLogger.debug()
+                    << m_group
+                    << "Loading track with preloaded audio source"
+                    << pTrack->getFileInfo();
+        } else {
+            m_pAudioSource = SoundSourceProxy(pTrack).openAudioSource(config);
+        }
+        if (!m_pAudioSource) {
+            kLogger.warning()
+                    << m_group
+                    << "Failed to open file"
+                    << pTrack->getFileInfo();
+            const auto update = ReaderStatusUpdate::trackUnloaded();
+            m_pReaderStatusFIFO->writeBlocking(&update, 1);
+            emit trackLoadFailed(pTrack,
+                    tr("The file '%1' could not be loaded.")
+                            .arg(QDir::toNativeSeparators(pTrack->getLocation())));
+            return;
+        }
 
-    // It is critical that the audio source doesn't contain more channels than
-    // requested as this could lead to overflow when reading chunks
-    VERIFY_OR_DEBUG_ASSERT(m_pAudioSource->getSignalInfo().getChannelCount() >=
-                    mixxx::audio::ChannelCount::mono() &&
-            m_pAudioSource->getSignalInfo().getChannelCount() <=
-                    m_maxSupportedChannel) {
-        m_pAudioSource.reset(); // Close open file handles
-        const auto update = ReaderStatusUpdate::trackUnloaded();
-        m_pReaderStatusFIFO->writeBlocking(&update, 1);
-        emit trackLoadFailed(pTrack,
-                tr("The file '%1' could not be loaded because it contains %2 "
-                   "channels, and only 1 to %3 are supported.")
-                        .arg(QDir::toNativeSeparators(pTrack->getLocation()),
-                                QString::number(m_pAudioSource->getSignalInfo()
-                                                        .getChannelCount()),
-                                QString::number(m_maxSupportedChannel)));
-        return;
-    }
+        // It is critical that the audio source doesn't contain more channels than
+        // requested as this could lead to overflow when reading chunks
+        VERIFY_OR_DEBUG_ASSERT(m_pAudioSource->getSignalInfo().getChannelCount() >=
+                        mixxx::audio::ChannelCount::mono() &&
+                m_pAudioSource->getSignalInfo().getChannelCount() <=
+                        m_maxSupportedChannel) {
+            const auto channelCount = m_pAudioSource->getSignalInfo().getChannelCount();
+            m_pAudioSource.reset(); // Close open file handles
+            const auto update = ReaderStatusUpdate::trackUnloaded();
+            m_pReaderStatusFIFO->writeBlocking(&update, 1);
+            emit trackLoadFailed(pTrack,
+                    tr("The file '%1' could not be loaded because it contains %2 "
+                       "channels, and only 1 to %3 are supported.")
+                            .arg(QDir::toNativeSeparators(pTrack->getLocation()),
+                                    QString::number(channelCount),
+                                    QString::number(m_maxSupportedChannel)));
+            return;
+        }
 
-    // Initially assume that the complete content offered by audio source
-    // is available for reading. Later if read errors occur this value will
-    // be decreased to avoid repeated reading of corrupt audio data.
-    if (m_pAudioSource->frameIndexRange().empty()) {
-        m_pAudioSource.reset(); // Close open file handles
-        kLogger.warning()
-                << m_group
-                << "Failed to open empty file"
-                << pTrack->getFileInfo();
-        const auto update = ReaderStatusUpdate::trackUnloaded();
-        m_pReaderStatusFIFO->writeBlocking(&update, 1);
-        emit trackLoadFailed(pTrack,
-                tr("The file '%1' is empty and could not be loaded.")
-                        .arg(QDir::toNativeSeparators(pTrack->getLocation())));
-        return;
+        // Initially assume that the complete content offered by audio source
+        // is available for reading. Later if read errors occur this value will
+        // be decreased to avoid repeated reading of corrupt audio data.
+        if (m_pAudioSource->frameIndexRange().empty()) {
+            m_pAudioSource.reset(); // Close open file handles
+            kLogger.warning()
+                    << m_group
+                    << "Failed to open empty file"
+                    << pTrack->getFileInfo();
+            const auto update = ReaderStatusUpdate::trackUnloaded();
+            m_pReaderStatusFIFO->writeBlocking(&update, 1);
+            emit trackLoadFailed(pTrack,
+                    tr("The file '%1' is empty and could not be loaded.")
+                            .arg(QDir::toNativeSeparators(pTrack->getLocation())));
+            return;
+        }
+
+        signalInfo = m_pAudioSource->getSignalInfo();
+        frameIndexRange = m_pAudioSource->frameIndexRange();
+        if (m_pPreloadedTrack &&
+                (m_pPreloadedTrack->signalInfo != signalInfo ||
+                        m_pPreloadedTrack->frameIndexRange != frameIndexRange)) {
+            // Outdated
+            m_pPreloadedTrack.reset();
+        }
+        if (m_pPreloadedTrack) {
+            m_pPreloadedTrackToPublish =
+                    std::make_shared<PreloadedTrack>(*m_pPreloadedTrack);
+        } else {
+            m_pPreloadedTrackToPublish = std::make_shared<PreloadedTrack>();
+            m_pPreloadedTrackToPublish->signalInfo = signalInfo;
+            m_pPreloadedTrackToPublish->frameIndexRange = frameIndexRange;
+        }
     }
 
     // Adjust the internal buffer
     const SINT tempReadBufferSize =
-            m_pAudioSource->getSignalInfo().frames2samples(
-                    CachingReaderChunk::kFrames);
+            signalInfo.frames2samples(CachingReaderChunk::kFrames);
     if (m_tempReadBuffer.size() != tempReadBufferSize) {
         mixxx::SampleBuffer(tempReadBufferSize).swap(m_tempReadBuffer);
     }
 
     const auto update =
-            ReaderStatusUpdate::trackLoaded(
-                    m_pAudioSource->frameIndexRange());
+            ReaderStatusUpdate::trackLoaded(frameIndexRange);
     m_pReaderStatusFIFO->writeBlocking(&update, 1);
 
     // Emit that the track is loaded.
@@ -296,9 +389,75 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
 
     emit trackLoaded(
             pTrack,
-            m_pAudioSource->getSignalInfo().getSampleRate(),
-            m_pAudioSource->getSignalInfo().getChannelCount(),
-            mixxx::audio::FramePos(m_pAudioSource->frameLength()));
+            signalInfo.getSampleRate(),
+            signalInfo.getChannelCount(),
+            mixxx::audio::FramePos(frameIndexRange.length()));
+}
+
+bool CachingReaderWorker::openPendingAudioSource() {
+    DEBUG_ASSERT(m_pTrackToOpen);
+    DEBUG_ASSERT(m_pPreloadedTrack);
+    DEBUG_ASSERT(!m_pAudioSource);
+    const TrackPointer pTrack = std::move(m_pTrackToOpen);
+    m_pTrackToOpen.reset();
+    m_preloadedChunksServed = false;
+
+    auto pAudioSource = SoundSourceProxy(pTrack).openAudioSource(m_openParams);
+    // The engine continues playing the preloaded chunks seamlessly
+    // only if the audio source still provides the same signal
+    if (pAudioSource &&
+            pAudioSource->getSignalInfo() == m_pPreloadedTrack->signalInfo &&
+            pAudioSource->frameIndexRange() == m_pPreloadedTrack->frameIndexRange) {
+        m_pAudioSource = std::move(pAudioSource);
+        return true;
+    }
+
+    kLogger.warning()
+            << m_group
+            << "Failed to open preloaded file"
+            << pTrack->getFileInfo();
+    PreloadedTrackPool::instance()->remove(m_preloadedTrackKey);
+    m_pPreloadedTrack.reset();
+    m_pPreloadedTrackToPublish.reset();
+    // Unlike a failure while loading the track has already been reported
+    // as loaded to the engine, which then unloads it again
+    emit trackLoadFailed(pTrack,
+            tr("The file '%1' could not be loaded.")
+                    .arg(QDir::toNativeSeparators(pTrack->getLocation())));
+    return false;
+}
+
+void CachingReaderWorker::storePreloadedChunk(const CachingReaderChunk* pChunk) {
+    if (!m_pPreloadedTrackToPublish ||
+            m_pPreloadedTrackToPublish->chunks.contains(pChunk->getIndex()) ||
+            !PreloadedTrackPool::isChunkToPreload(pChunk->getIndex(),
+                    m_pPreloadedTrackToPublish->frameIndexRange,
+                    m_pPreloadedTrackToPublish->signalInfo.getSampleRate(),
+                    m_mainCuePosition)) {
+        return;
+    }
+    const mixxx::ReadableSampleFrames& sampleFrames = pChunk->bufferedSampleFrames();
+    if (!sampleFrames.readableData()) {
+        return;
+    }
+    PreloadedTrack::Chunk chunk;
+    chunk.frameIndexRange = sampleFrames.frameIndexRange();
+    chunk.samples.resize(sampleFrames.readableLength());
+    SampleUtil::copy(
+            chunk.samples.data(),
+            sampleFrames.readableData(),
+            sampleFrames.readableLength());
+    m_pPreloadedTrackToPublish->chunks.insert(pChunk->getIndex(), chunk);
+}
+
+void CachingReaderWorker::publishPreloadedTrack() {
+    if (m_pPreloadedTrackToPublish &&
+            !m_pPreloadedTrackToPublish->chunks.isEmpty()) {
+        PreloadedTrackPool::instance()->insert(
+                m_preloadedTrackKey,
+                std::move(m_pPreloadedTrackToPublish));
+    }
+    m_pPreloadedTrackToPublish.reset();
 }
 
 void CachingReaderWorker::quitWait() {
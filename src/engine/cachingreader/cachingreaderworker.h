@@ -6,6 +6,7 @@
 #include "audio/frame.h"
 #include "audio/types.h"
 #include "engine/cachingreader/cachingreaderchunk.h"
+#include "engine/cachingreader/preloadedtrackpool.h"
 #include "engine/engineworker.h"
 #include "sources/audiosource.h"
 #include "track/track_decl.h"
@@ -167,6 +168,15 @@ class CachingReaderWorker : public EngineWorker {
     void loadTrack(const TrackPointer& pTrack);
 #endif
 
+    /// Opens the audio source of a track that has been loaded from
+    /// the pool of preloaded tracks. Emits trackLoadFailed on failure.
+    bool openPendingAudioSource();
+
+    /// Keeps the chunks of the current track that have been read
+    /// into the pool of preloaded tracks for loading it again.
+    void storePreloadedChunk(const CachingReaderChunk* pChunk);
+    void publishPreloadedTrack();
+
     ReaderStatusUpdate processReadRequest(
             const CachingReaderChunkReadRequest& request);
 
@@ -178,6 +188,21 @@ class CachingReaderWorker : public EngineWorker {
 
     mixxx::audio::FramePos m_firstSoundFrameToVerify;
 
+    // A track that has been loaded from the pool of preloaded tracks is
+    // played from the preloaded chunks until its audio source has been
+    // opened. The audio source is opened once the initial requests have
+    // been served, or when a chunk is requested that is not preloaded.
+    TrackPointer m_pTrackToOpen;
+    mixxx::AudioSource::OpenParams m_openParams;
+    PreloadedTrackPointer m_pPreloadedTrack;
+    bool m_preloadedChunksServed;
+
+    // The chunks of the current track that are added to the pool of
+    // preloaded tracks when the track is unloaded
+    PreloadedTrackPool::Key m_preloadedTrackKey;
+    std::shared_ptr<PreloadedTrack> m_pPreloadedTrackToPublish;
+    mixxx::audio::FramePos m_mainCuePosition;
+
     // Temporary buffer for reading samples from all channels
     // before conversion to a stereo signal.
     mixxx::SampleBuffer m_tempReadBuffer;
@@ -0,0 +1,191 @@
+#include "engine/cachingreader/preloadedtrackpool.h"
+
+#include <utility>
+
+#include "engine/cachingreader/cachingreaderchunk.h"
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+
+namespace {
+
+// About 2.3 MB per stereo track at 44.1 kHz, i.e. ~25 tracks. Stem
+// tracks need four times as much.
+constexpr qint64 kDefaultCapacityBytes = 64 * 1024 * 1024;
+
+// The next tracks in the Auto DJ queue and the selected track
+constexpr int kDefaultMaxAudioSourceCount = 4;
+
+void closeAll(const QList<mixxx::AudioSourcePointer>& audioSources) {
+    for (const auto& pAudioSource : audioSources) {
+        pAudioSource->close();
+    }
+}
+
+} // anonymous namespace
+
+qint64 PreloadedTrack::sizeInBytes() const {
+    qint64 size = 0;
+    for (const auto& chunk : chunks) {
+        size += chunk.samples.size() * sizeof(CSAMPLE);
+    }
+    return size;
+}
+
+// static
+PreloadedTrackPool::Key PreloadedTrackPool::key(
+        const mixxx::FileInfo& fileInfo,
+        mixxx::audio::ChannelCount channelCount,
+        int stemMask) {
+    Key key;
+    key.location = fileInfo.location();
+    key.fileSize = fileInfo.sizeInBytes();
+    key.fileLastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    key.channelCount = channelCount;
+    key.stemMask = stemMask;
+    return key;
+}
+
+// static
+bool PreloadedTrackPool::isChunkToPreload(
+        SINT chunkIndex,
+        const mixxx::IndexRange& frameIndexRange,
+        mixxx::audio::SampleRate sampleRate,
+        mixxx::audio::FramePos mainCuePosition) {
+    if (frameIndexRange.empty() || !sampleRate.isValid()) {
+        return false;
+    }
+    const SINT chunkCount = 1 +
+            static_cast<SINT>(kPreloadSeconds * sampleRate) /
+                    CachingReaderChunk::kFrames;
+    const SINT firstChunkIndex =
+            CachingReaderChunk::indexForFrame(frameIndexRange.start());
+    if (chunkIndex >= firstChunkIndex &&
+            chunkIndex < firstChunkIndex + chunkCount) {
+        return true;
+    }
+    if (!mainCuePosition.isValid()) {
+        return false;
+    }
+    const SINT mainCueFrame = static_cast<SINT>(
+            mainCuePosition.toLowerFrameBoundary().value());
+    if (!frameIndexRange.containsIndex(mainCueFrame)) {
+        return false;
+    }
+    // Including the chunk before the main cue for the preroll
+    const SINT mainCueChunkIndex =
+            CachingReaderChunk::indexForFrame(mainCueFrame);
+    return chunkIndex >= mainCueChunkIndex - 1 &&
+            chunkIndex < mainCueChunkIndex + chunkCount;
+}
+
+PreloadedTrackPool::PreloadedTrackPool(
+        qint64 capacityBytes,
+        int maxAudioSourceCount)
+        : m_maxAudioSourceCount(maxAudioSourceCount),
+          m_tracks(static_cast<int>(capacityBytes)) {
+}
+
+// static
+PreloadedTrackPool* PreloadedTrackPool::instance() {
+    static PreloadedTrackPool s_instance(
+            kDefaultCapacityBytes,
+            kDefaultMaxAudioSourceCount);
+    return &s_instance;
+}
+
+PreloadedTrackPointer PreloadedTrackPool::find(const Key& key) const {
+    const auto locker = lockMutex(&m_mutex);
+    const PreloadedTrackPointer* ppTrack = m_tracks.object(key);
+    if (!ppTrack) {
+        return nullptr;
+    }
+    return *ppTrack;
+}
+
+void PreloadedTrackPool::insert(const Key& key, PreloadedTrackPointer pTrack) {
+    VERIFY_OR_DEBUG_ASSERT(key.isValid() && pTrack) {
+        return;
+    }
+    const qint64 sizeInBytes = pTrack->sizeInBytes();
+    const auto locker = lockMutex(&m_mutex);
+    // Tracks that exceed the capacity are discarded
+    m_tracks.insert(key,
+            new PreloadedTrackPointer(std::move(pTrack)),
+            static_cast<int>(sizeInBytes));
+}
+
+void PreloadedTrackPool::remove(const Key& key) {
+    const auto locker = lockMutex(&m_mutex);
+    m_tracks.remove(key);
+}
+
+int PreloadedTrackPool::count() const {
+    const auto locker = lockMutex(&m_mutex);
+    return m_tracks.count();
+}
+
+qint64 PreloadedTrackPool::sizeInBytes() const {
+    const auto locker = lockMutex(&m_mutex);
+    return m_tracks.totalCost();
+}
+
+void PreloadedTrackPool::insertAudioSource(
+        const Key& key,
+        mixxx::AudioSourcePointer pAudioSource) {
+    VERIFY_OR_DEBUG_ASSERT(key.isValid() && pAudioSource) {
+        return;
+    }
+    // Closing is done without holding the lock
+    QList<mixxx::AudioSourcePointer> closedAudioSources;
+    {
+        const auto locker = lockMutex(&m_mutex);
+        for (int i = 0; i < m_audioSources.size(); ++i) {
+            if (m_audioSources.at(i).key == key) {
+                closedAudioSources.append(m_audioSources.takeAt(i).pAudioSource);
+                break;
+            }
+        }
+        m_audioSources.append(OpenedAudioSource{key, std::move(pAudioSource)});
+        while (m_audioSources.size() > m_maxAudioSourceCount) {
+            closedAudioSources.append(m_audioSources.takeFirst().pAudioSource);
+        }
+    }
+    closeAll(closedAudioSources);
+}
+
+mixxx::AudioSourcePointer PreloadedTrackPool::takeAudioSource(const Key& key) {
+    const auto locker = lockMutex(&m_mutex);
+    for (int i = 0; i < m_audioSources.size(); ++i) {
+        if (m_audioSources.at(i).key == key) {
+            return m_audioSources.takeAt(i).pAudioSource;
+        }
+    }
+    return nullptr;
+}
+
+bool PreloadedTrackPool::containsAudioSource(const Key& key) const {
+    const auto locker = lockMutex(&m_mutex);
+    for (const auto& audioSource : m_audioSources) {
+        if (audioSource.key == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int PreloadedTrackPool::audioSourceCount() const {
+    const auto locker = lockMutex(&m_mutex);
+    return m_audioSources.size();
+}
+
+void PreloadedTrackPool::closeAudioSources() {
+    QList<mixxx::AudioSourcePointer> closedAudioSources;
+    {
+        const auto locker = lockMutex(&m_mutex);
+        for (const auto& audioSource : std::as_const(m_audioSources)) {
+            closedAudioSources.append(audioSource.pAudioSource);
+        }
+        m_audioSources.clear();
+    }
+    closeAll(closedAudioSources);
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <QCache>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <memory>
+
+#include "audio/frame.h"
+#include "audio/signalinfo.h"
+#include "sources/audiosource.h"
+#include "util/compatibility/qhash.h"
+#include "util/fileinfo.h"
+#include "util/indexrange.h"
+#include "util/types.h"
+
+// The decoded chunks at the start and after the main cue of a track that
+// are kept in memory for starting playback before the audio source of the
+// track has been opened. Immutable after it has been added to the pool.
+struct PreloadedTrack {
+    // The sample frames of a single chunk, stored with the same
+    // layout as in CachingReaderChunk.
+    struct Chunk {
+        mixxx::IndexRange frameIndexRange;
+        QVector<CSAMPLE> samples;
+    };
+
+    // The properties of the audio source from which the chunks
+    // have been read
+    mixxx::audio::SignalInfo signalInfo;
+    mixxx::IndexRange frameIndexRange;
+
+    QHash<SINT, Chunk> chunks;
+
+    qint64 sizeInBytes() const;
+};
+
+typedef std::shared_ptr<const PreloadedTrack> PreloadedTrackPointer;
+
+// A shared pool of preloaded tracks with a least-recently-used (LRU)
+// eviction policy that is used by the CachingReaderWorker of all decks
+// and samplers. Loading a track that is found in the pool completes
+// immediately while the audio source is opened in the background.
+// Tracks that are likely to be loaded next are preloaded together with
+// their opened audio source, which is then handed over when loading.
+//
+// Tracks are identified by the location, the size and the last
+// modification time of their file, i.e. a track that has been modified
+// in the meantime is never found. The chunks also depend on how the
+// audio source has been opened for the deck.
+//
+// All functions are thread-safe.
+class PreloadedTrackPool final {
+  public:
+    struct Key {
+        QString location;
+        qint64 fileSize = 0;
+        qint64 fileLastModified = 0;
+        int channelCount = 0;
+        int stemMask = 0;
+
+        bool isValid() const {
+            return !location.isEmpty();
+        }
+
+        friend bool operator==(const Key& lhs, const Key& rhs) {
+            return lhs.fileSize == rhs.fileSize &&
+                    lhs.fileLastModified == rhs.fileLastModified &&
+                    lhs.channelCount == rhs.channelCount &&
+                    lhs.stemMask == rhs.stemMask &&
+                    lhs.location == rhs.location;
+        }
+        friend qhash_seed_t qHash(
+                const Key& key,
+                qhash_seed_t seed = 0) {
+            return qHash(key.location, seed) ^
+                    qHash(key.fileLastModified, seed) ^
+                    qHash(key.stemMask, seed);
+        }
+    };
+
+    static Key key(
+            const mixxx::FileInfo& fileInfo,
+            mixxx::audio::ChannelCount channelCount,
+            int stemMask = 0);
+
+    // The duration of the regions at the start and after the main cue
+    // of a track that are preloaded.
+    static constexpr double kPreloadSeconds = 3.0;
+
+    // Checks if a chunk belongs to one of the preloaded regions.
+    static bool isChunkToPreload(
+            SINT chunkIndex,
+            const mixxx::IndexRange& frameIndexRange,
+            mixxx::audio::SampleRate sampleRate,
+            mixxx::audio::FramePos mainCuePosition);
+
+    PreloadedTrackPool(
+            qint64 capacityBytes,
+            int maxAudioSourceCount);
+
+    // The shared instance that is used by all decks and samplers.
+    static PreloadedTrackPool* instance();
+
+    // Returns nullptr if the track is not available. Otherwise the
+    // track becomes the most recently used one.
+    PreloadedTrackPointer find(const Key& key) const;
+
+    // Adds or replaces a track and evicts the least recently used
+    // tracks that exceed the capacity.
+    void insert(const Key& key, PreloadedTrackPointer pTrack);
+
+    void remove(const Key& key);
+
+    int count() const;
+    qint64 sizeInBytes() const;
+
+    // Each audio source that has been opened in advance is handed over
+    // to a single deck. The audio sources that have been added first
+    // are closed when the maximum number of audio sources is exceeded.
+    void insertAudioSource(
+            const Key& key,
+            mixxx::AudioSourcePointer pAudioSource);
+    mixxx::AudioSourcePointer takeAudioSource(const Key& key);
+    bool containsAudioSource(const Key& key) const;
+    int audioSourceCount() const;
+    void closeAudioSources();
+
+  private:
+    struct OpenedAudioSource {
+        Key key;
+        mixxx::AudioSourcePointer pAudioSource;
+    };
+
+    const int m_maxAudioSourceCount;
+
+    mutable QMutex m_mutex;
+    // QCache::object() updates the LRU order
+    mutable QCache<Key, PreloadedTrackPointer> m_tracks;
+    // Ordered by insertion
+    QList<OpenedAudioSource> m_audioSources;
+};
@@ -0,0 +1,200 @@
+#include "engine/cachingreader/trackpreloader.h"
+
+#include <QtConcurrentRun>
+
+#include "engine/cachingreader/cachingreaderchunk.h"
+#include "sources/soundsourceproxy.h"
+#include "track/track.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/sample.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+const mixxx::Logger kLogger("TrackPreloader");
+
+// Tracks are preloaded one after another in the order of
+// their priority while the decks are playing
+constexpr int kThreadCount = 1;
+
+} // anonymous namespace
+
+TrackPreloader::TrackPreloader(PreloadedTrackPool* pPool)
+        : m_pPool(pPool) {
+    DEBUG_ASSERT(m_pPool);
+    m_threadPool.setObjectName(QStringLiteral("TrackPreloader"));
+    m_threadPool.setMaxThreadCount(kThreadCount);
+}
+
+TrackPreloader::~TrackPreloader() {
+    m_stop = 1;
+    m_threadPool.waitForDone();
+    m_pPool->closeAudioSources();
+}
+
+void TrackPreloader::preloadTrack(
+        const TrackPointer& pTrack,
+        mixxx::audio::ChannelCount channelCount) {
+    enqueueTrack(pTrack, channelCount, false);
+}
+
+void TrackPreloader::preloadSelectedTrack(
+        const TrackPointer& pTrack,
+        mixxx::audio::ChannelCount channelCount) {
+    enqueueTrack(pTrack, channelCount, true);
+}
+
+void TrackPreloader::enqueueTrack(
+        const TrackPointer& pTrack,
+        mixxx::audio::ChannelCount channelCount,
+        bool selected) {
+    if (!pTrack) {
+        return;
+    }
+    const auto key = PreloadedTrackPool::key(
+            pTrack->getFileInfo(),
+            channelCount);
+    if (!key.isValid()) {
+        return;
+    }
+    {
+        const auto locker = lockMutex(&m_pendingMutex);
+        if (selected) {
+            // Outdates all pending tracks that have been selected before
+            m_selectedKey = key;
+        }
+        const auto iPending = m_pendingKeys.find(key);
+        if (iPending != m_pendingKeys.end()) {
+            iPending.value() = iPending.value() && selected;
+            return;
+        }
+        if (m_pPool->containsAudioSource(key)) {
+            return;
+        }
+        m_pendingKeys.insert(key, selected);
+    }
+    QtConcurrent::run(&m_threadPool, [this, pTrack, key] {
+        bool outdated;
+        {
+            const auto locker = lockMutex(&m_pendingMutex);
+            outdated = m_pendingKeys.value(key) && !(key == m_selectedKey);
+        }
+        if (!outdated && !m_stop.loadAcquire()) {
+            preloadTrackNow(pTrack, key);
+        }
+        const auto locker = lockMutex(&m_pendingMutex);
+        m_pendingKeys.remove(key);
+    });
+}
+
+void TrackPreloader::waitForDone() {
+    m_threadPool.waitForDone();
+}
+
+void TrackPreloader::preloadTrackNow(
+        const TrackPointer& pTrack,
+        const PreloadedTrackPool::Key& key) {
+    if (!pTrack->getFileInfo().checkFileExists()) {
+        return;
+    }
+    const auto channelCount = mixxx::audio::ChannelCount::fromInt(key.channelCount);
+    mixxx::AudioSource::OpenParams config;
+    config.setChannelCount(channelCount);
+    auto pAudioSource = SoundSourceProxy(pTrack).openAudioSource(config);
+    if (!pAudioSource) {
+        kLogger.warning()
+                << "Failed to open file"
+                << pTrack->getFileInfo();
+        return;
+    }
+    // The same checks as when loading the track into a deck
+    if (pAudioSource->getSignalInfo().getChannelCount() <
+                    mixxx::audio::ChannelCount::mono() ||
+            pAudioSource->getSignalInfo().getChannelCount() > channelCount ||
+            pAudioSource->frameIndexRange().empty()) {
+        pAudioSource->close();
+        return;
+    }
+
+    PreloadedTrackPointer pPreloadedTrack = m_pPool->find(key);
+    if (!pPreloadedTrack ||
+            pPreloadedTrack->signalInfo != pAudioSource->getSignalInfo() ||
+            pPreloadedTrack->frameIndexRange != pAudioSource->frameIndexRange()) {
+        pPreloadedTrack = readPreloadedTrack(
+                pAudioSource,
+                channelCount,
+                pTrack->getMainCuePosition());
+        if (!pPreloadedTrack) {
+            pAudioSource->close();
+            return;
+        }
+        m_pPool->insert(key, pPreloadedTrack);
+    }
+    kLogger.debug()
+            << "Preloaded"
+            << pPreloadedTrack->chunks.size()
+            << "chunks of"
+            << pTrack->getFileInfo();
+    m_pPool->insertAudioSource(key, std::move(pAudioSource));
+}
+
+// static
+PreloadedTrackPointer TrackPreloader::readPreloadedTrack(
+        const mixxx::AudioSourcePointer& pAudioSource,
+        mixxx::audio::ChannelCount channelCount,
+        mixxx::audio::FramePos mainCuePosition) {
+    DEBUG_ASSERT(pAudioSource);
+    auto pPreloadedTrack = std::make_shared<PreloadedTrack>();
+    pPreloadedTrack->signalInfo = pAudioSource->getSignalInfo();
+    pPreloadedTrack->frameIndexRange = pAudioSource->frameIndexRange();
+
+    // Same buffer sizes as used by CachingReader and CachingReaderWorker
+    mixxx::SampleBuffer sampleBuffer(
+            CachingReaderChunk::frames2samples(
+                    CachingReaderChunk::kFrames, channelCount));
+    mixxx::SampleBuffer tempReadBuffer(
+            pPreloadedTrack->signalInfo.frames2samples(
+                    CachingReaderChunk::kFrames));
+    CachingReaderChunkForOwner chunk(
+            mixxx::SampleBuffer::WritableSlice(sampleBuffer));
+
+    const SINT firstChunkIndex = CachingReaderChunk::indexForFrame(
+            pPreloadedTrack->frameIndexRange.start());
+    const SINT lastChunkIndex = CachingReaderChunk::indexForFrame(
+            pPreloadedTrack->frameIndexRange.end() - 1);
+    for (SINT chunkIndex = firstChunkIndex; chunkIndex <= lastChunkIndex; ++chunkIndex) {
+        if (!PreloadedTrackPool::isChunkToPreload(chunkIndex,
+                    pPreloadedTrack->frameIndexRange,
+                    pPreloadedTrack->signalInfo.getSampleRate(),
+                    mainCuePosition)) {
+            continue;
+        }
+        chunk.init(chunkIndex);
+        const auto chunkFrameIndexRange = chunk.frameIndexRange(pAudioSource);
+        const auto bufferedFrameIndexRange = chunk.bufferSampleFrames(
+                pAudioSource,
+                mixxx::SampleBuffer::WritableSlice(tempReadBuffer));
+        const mixxx::ReadableSampleFrames& sampleFrames = chunk.bufferedSampleFrames();
+        if (bufferedFrameIndexRange.empty() ||
+                bufferedFrameIndexRange != chunkFrameIndexRange ||
+                !sampleFrames.readableData()) {
+            kLogger.warning()
+                    << "Failed to read chunk"
+                    << chunkIndex
+                    << "of"
+                    << pAudioSource->getUrlString();
+            return nullptr;
+        }
+        PreloadedTrack::Chunk preloadedChunk;
+        preloadedChunk.frameIndexRange = sampleFrames.frameIndexRange();
+        preloadedChunk.samples.resize(sampleFrames.readableLength());
+        SampleUtil::copy(
+                preloadedChunk.samples.data(),
+                sampleFrames.readableData(),
+                sampleFrames.readableLength());
+        pPreloadedTrack->chunks.insert(chunkIndex, preloadedChunk);
+        chunk.free();
+    }
+    return pPreloadedTrack;
+}
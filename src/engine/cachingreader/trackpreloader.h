@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QMutex>
+#include <QThreadPool>
+
+#include "engine/cachingreader/preloadedtrackpool.h"
+#include "track/track_decl.h"
+
+// Preloads tracks that are likely to be loaded next, e.g. the next tracks
+// in the Auto DJ queue or the track that is selected in the library.
+//
+// The audio source of each track is opened and the preloaded chunks are
+// read on a background thread. Both are added to the PreloadedTrackPool
+// and a deck that loads the track takes over the opened audio source
+// without any file I/O.
+class TrackPreloader final {
+  public:
+    explicit TrackPreloader(
+            PreloadedTrackPool* pPool = PreloadedTrackPool::instance());
+    // Skips all pending tracks and closes the audio sources that
+    // have not been taken over yet.
+    ~TrackPreloader();
+
+    // The channel count must match the maximum number of channels
+    // that are supported by the deck that will load the track.
+    void preloadTrack(
+            const TrackPointer& pTrack,
+            mixxx::audio::ChannelCount channelCount);
+
+    // Like preloadTrack(), but only for the most recently selected
+    // track. Pending tracks that have been selected before are skipped.
+    void preloadSelectedTrack(
+            const TrackPointer& pTrack,
+            mixxx::audio::ChannelCount channelCount);
+
+    // Blocks until all pending tracks have been preloaded.
+    void waitForDone();
+
+    // Reads all chunks of an audio source that need to be preloaded.
+    static PreloadedTrackPointer readPreloadedTrack(
+            const mixxx::AudioSourcePointer& pAudioSource,
+            mixxx::audio::ChannelCount channelCount,
+            mixxx::audio::FramePos mainCuePosition);
+
+  private:
+    void enqueueTrack(
+            const TrackPointer& pTrack,
+            mixxx::audio::ChannelCount channelCount,
+            bool selected);
+
+    void preloadTrackNow(
+            const TrackPointer& pTrack,
+            const PreloadedTrackPool::Key& key);
+
+    PreloadedTrackPool* const m_pPool;
+
+    QMutex m_pendingMutex;
+    // Pending tracks that are only preloaded while they are selected
+    // are mapped to true
+    QHash<PreloadedTrackPool::Key, bool> m_pendingKeys;
+    PreloadedTrackPool::Key m_selectedKey;
+
+    QAtomicInt m_stop;
+
+    QThreadPool m_threadPool;
+};
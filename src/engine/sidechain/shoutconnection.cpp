@@ -3,6 +3,8 @@
 #include <QRegularExpression>
 #include <QTextCodec>
 #include <QUrl>
+#include <algorithm>
+#include <chrono>
 
 // These includes are only required by ignoreSigpipe, which is unix-only
 #ifndef __WINDOWS__
@@ -15,6 +17,7 @@
 #include "broadcast/defs_broadcast.h"
 #include "encoder/encoder.h"
 #include "encoder/encoderbroadcastsettings.h"
+#include "encoder/encodershared.h"
 #ifdef __OPUS__
 #include "encoder/encoderopus.h"
 #endif
@@ -26,11 +29,14 @@
 #include "track/track.h"
 #include "util/compatibility/qatomic.h"
 #include "util/logger.h"
+#include "util/stat.h"
+#include "util/timer.h"
 
 namespace {
 
 constexpr int kConnectRetries = 30;
-constexpr int kMaxNetworkCache = 491520; // 10 s mp3 @ 192 kbit/s
+// Reconnect if more encoded audio than this is waiting to be sent
+constexpr auto kMaxNetworkBacklog = std::chrono::seconds(10);
 // Shoutcast default receive buffer 1048576 and autodumpsourcetime 30 s
 // http://wiki.shoutcast.com/wiki/SHOUTcast_DNAS_Server_2
 constexpr int kMaxShoutFailures = 3;
@@ -54,6 +60,8 @@ ShoutConnection::ShoutConnection(BroadcastProfilePtr profile,
           m_pConfig(pConfig),
           m_pProfile(profile),
           m_encoder(nullptr),
+          m_bitrate(0),
+          m_requestedBitrate(0),
           m_mainSamplerate(QStringLiteral("[App]"), QStringLiteral("samplerate")),
           m_broadcastEnabled(BROADCAST_PREF_KEY, "enabled"),
           m_custom_metadata(false),
@@ -72,7 +80,9 @@ ShoutConnection::ShoutConnection(BroadcastProfilePtr profile,
           m_reconnectPeriod(5.0),
           m_noDelayFirstReconnect(true),
           m_limitReconnects(true),
-          m_maximumRetries(10) {
+          m_maximumRetries(10),
+          m_backlogStatTag(QStringLiteral("ShoutConnection %1 send backlog")
+                                   .arg(profile->getProfileName())) {
     setStatus(BroadcastProfile::STATUS_UNCONNECTED);
     setState(NETWORKSTREAMWORKER_STATE_INIT);
 
@@ -453,8 +463,15 @@ void ShoutConnection::updateFromPreferences() {
     // Initialize m_encoder
     EncoderSettingsPointer pBroadcastSettings =
             std::make_shared<EncoderBroadcastSettings>(m_pProfile);
-    m_encoder = EncoderFactory::getFactory().createEncoder(
-                    pBroadcastSettings, this);
+    m_encoder = createEncoder(pBroadcastSettings);
+    m_bitrate = pBroadcastSettings->getQuality();
+    m_requestedBitrate = m_bitrate;
+    if (m_pProfile->getAdaptiveBitrate() && (m_format_is_mp3 || m_format_is_aac)) {
+        m_pBitrateAdapter = std::make_unique<BroadcastBitrateAdapter>(
+                pBroadcastSettings->getQualityValues(), m_bitrate);
+    } else {
+        m_pBitrateAdapter.reset();
+    }
 
     QString userErrorMsg;
     int ret = -1;
@@ -483,6 +500,37 @@ void ShoutConnection::updateFromPreferences() {
     setState(NETWORKSTREAMWORKER_STATE_READY);
 }
 
+EncoderPointer ShoutConnection::createEncoder(EncoderSettingsPointer pSettings) {
+    if (EncoderShared::isShareable(*pSettings)) {
+        // Connections with identical settings share a single encoder
+        return std::make_shared<EncoderShared>(pSettings, this);
+    }
+    return EncoderFactory::getFactory().createEncoder(pSettings, this);
+}
+
+void ShoutConnection::switchBitrate(int bitrate) {
+    const auto mainSamplerate = mixxx::audio::SampleRate::fromDouble(m_mainSamplerate.get());
+    EncoderPointer pEncoder = createEncoder(
+            std::make_shared<EncoderBroadcastSettings>(m_pProfile, bitrate));
+    QString userErrorMsg;
+    if (!pEncoder || pEncoder->initEncoder(mainSamplerate, &userErrorMsg) < 0) {
+        kLogger.warning()
+                << m_pProfile->getProfileName()
+                << "switching to" << bitrate << "kbit/s failed:" << userErrorMsg
+                << "Disabling adaptive bitrate";
+        m_pBitrateAdapter.reset();
+        m_requestedBitrate = m_bitrate;
+        return;
+    }
+    kLogger.info()
+            << m_pProfile->getProfileName()
+            << "switching from" << m_bitrate << "to" << bitrate << "kbit/s";
+    // The previous encoder is flushed into write() when it is released,
+    // before the new one produces any data
+    m_encoder = std::move(pEncoder);
+    m_bitrate = bitrate;
+}
+
 bool ShoutConnection::serverConnect() {
     if (!m_pProfile->getEnabled()) {
         return false;
@@ -591,6 +639,10 @@ bool ShoutConnection::processConnect() {
             kLogger.debug() << "***********Connected to streaming server...";
 
             m_retryCount = 0;
+            m_queuedBytes.clear();
+            if (m_pBitrateAdapter) {
+                m_pBitrateAdapter->reset(BroadcastBitrateAdapter::Clock::now());
+            }
 
             if(m_pOutputFifo->readAvailable()) {
             	m_pOutputFifo->flushReadData(m_pOutputFifo->readAvailable());
@@ -674,14 +726,81 @@ void ShoutConnection::write(const unsigned char* header, const unsigned char* bo
         return;
     }
 
-    ssize_t queuelen = shout_queuelen(m_pShout);
-    if (queuelen > 0) {
+    // libshout is in non-blocking mode and queues everything that could
+    // not be sent yet. Convert the queue length into the duration of the
+    // queued audio.
+    const ssize_t queuelen = shout_queuelen(m_pShout);
+    const auto backlog = updateQueuedBytes(
+            headerLen + bodyLen, std::max<ssize_t>(queuelen, 0));
+    Stat::track(m_backlogStatTag,
+            Stat::DURATION_MSEC,
+            Stat::experimentFlags(Stat::COUNT | Stat::AVERAGE | Stat::MAX),
+            static_cast<double>(backlog.count()));
+    if (backlog > kMaxNetworkBacklog) {
         kLogger.debug() << "shout_queuelen" << queuelen;
-        if (queuelen > kMaxNetworkCache) {
-            m_lastErrorStr = tr("Network cache overflow");
-            tryReconnect();
+        m_lastErrorStr = tr("Network cache overflow");
+        tryReconnect();
+        return;
+    }
+    // Don't switch again before the queued audio of the previous bitrate
+    // has been sent, the backlog doesn't reflect the current bitrate yet
+    if (m_pBitrateAdapter && !isSendingPreviousBitrate()) {
+        m_requestedBitrate = m_pBitrateAdapter->update(
+                backlog, BroadcastBitrateAdapter::Clock::now());
+    }
+}
+
+std::chrono::milliseconds ShoutConnection::updateQueuedBytes(
+        qint64 writtenBytes, qint64 queuedBytes) {
+    if (writtenBytes > 0) {
+        if (!m_queuedBytes.empty() && m_queuedBytes.back().bitrate == m_bitrate) {
+            m_queuedBytes.back().bytes += writtenBytes;
+        } else {
+            m_queuedBytes.push_back(QueuedBytes{m_bitrate, writtenBytes});
+        }
+    }
+
+    qint64 totalBytes = 0;
+    for (const auto& queued : m_queuedBytes) {
+        totalBytes += queued.bytes;
+    }
+    if (totalBytes < queuedBytes) {
+        // Should not happen, unless a write failed partially
+        if (m_queuedBytes.empty() || m_queuedBytes.back().bitrate != m_bitrate) {
+            m_queuedBytes.push_back(QueuedBytes{m_bitrate, 0});
+        }
+        m_queuedBytes.back().bytes += queuedBytes - totalBytes;
+        totalBytes = queuedBytes;
+    }
+    // The queue is sent in order, so the oldest bytes have been sent
+    qint64 sentBytes = totalBytes - queuedBytes;
+    while (sentBytes > 0) {
+        DEBUG_ASSERT(!m_queuedBytes.empty());
+        QueuedBytes& oldest = m_queuedBytes.front();
+        if (oldest.bytes > sentBytes) {
+            oldest.bytes -= sentBytes;
+            break;
+        }
+        sentBytes -= oldest.bytes;
+        m_queuedBytes.pop_front();
+    }
+
+    // kbit/s equals bit/ms
+    qint64 backlogMillis = 0;
+    for (const auto& queued : m_queuedBytes) {
+        if (queued.bitrate > 0) {
+            backlogMillis += queued.bytes * 8 / queued.bitrate;
         }
     }
+    return std::chrono::milliseconds(backlogMillis);
+}
+
+bool ShoutConnection::isSendingPreviousBitrate() const {
+    return std::any_of(m_queuedBytes.begin(),
+            m_queuedBytes.end(),
+            [this](const QueuedBytes& queued) {
+                return queued.bitrate != m_bitrate;
+            });
 }
 // These are not used for streaming, but the interface requires them
 int ShoutConnection::tell() {
@@ -702,14 +821,15 @@ int ShoutConnection::filelen() {
 
 bool ShoutConnection::writeSingle(const unsigned char* data, std::size_t len) {
     setFunctionCode(8);
+    ScopedTimer t(QStringLiteral("ShoutConnection::writeSingle %1"),
+            m_pProfile->getProfileName());
     int ret = shout_send_raw(m_pShout, data, len);
     if (ret == SHOUTERR_BUSY) {
-        // in case of busy, frames are queued
-        // try to flush queue after a short sleep
-        kLogger.warning() << "writeSingle() SHOUTERR_BUSY, trying again";
-        usleep(10000); // wait 10 ms until "busy" is over. TODO() tweak for an optimum.
-        // if this fails, the queue is transmitted after the next regular shout_send_raw()
-        (void)shout_send_raw(m_pShout, nullptr, 0);
+        // In case of busy, the frames are queued by libshout and sent
+        // with the next regular shout_send_raw(). Don't wait here, this
+        // would only fill the sidechain FIFO. The queue length is checked
+        // in write().
+        kLogger.debug() << "writeSingle() SHOUTERR_BUSY, data queued";
     } else if (ret < SHOUTERR_SUCCESS) {
         m_lastErrorStr = shout_get_error(m_pShout);
         kLogger.warning()
@@ -750,6 +870,11 @@ void ShoutConnection::process(const CSAMPLE* pBuffer, const std::size_t bufferSi
         // the encoded frames are received by the write() callback.
     }
 
+    // The encoder can't be replaced from within the write() callback
+    if (m_requestedBitrate != m_bitrate) {
+        switchBitrate(m_requestedBitrate);
+    }
+
     // Check if track metadata has changed and if so, update.
     if (metaDataHasChanged()) {
         updateMetaData();
@@ -8,7 +8,11 @@
 #include <QThread>
 #include <QVector>
 #include <QWaitCondition>
+#include <chrono>
+#include <deque>
+#include <memory>
 
+#include "broadcast/broadcastbitrateadapter.h"
 #include "control/pollingcontrolproxy.h"
 #include "encoder/encoder.h"
 #include "encoder/encodercallback.h"
@@ -108,6 +112,14 @@ class ShoutConnection
     bool waitForRetry();
 
     void tryReconnect();
+
+    EncoderPointer createEncoder(EncoderSettingsPointer pSettings);
+    // Replaces the encoder with one for the given bitrate while connected
+    void switchBitrate(int bitrate);
+    // Accounts the written bytes and the queue length of libshout and
+    // returns the duration of the queued audio
+    std::chrono::milliseconds updateQueuedBytes(qint64 writtenBytes, qint64 queuedBytes);
+    bool isSendingPreviousBitrate() const;
     void insertMetaData(const char *name, const char *value);
 
     QTextCodec* m_pTextCodec;
@@ -120,6 +132,21 @@ class ShoutConnection
     UserSettingsPointer m_pConfig;
     BroadcastProfilePtr m_pProfile;
     EncoderPointer m_encoder;
+    // The bitrate of m_encoder in kbit/s
+    int m_bitrate;
+    // Set by write(), applied by process() outside the encoder callback
+    int m_requestedBitrate;
+    // Only set if the profile has adaptive bitrate enabled
+    std::unique_ptr<BroadcastBitrateAdapter> m_pBitrateAdapter;
+    struct QueuedBytes {
+        // in kbit/s
+        int bitrate;
+        qint64 bytes;
+    };
+    // The send queue of libshout by the bitrate of the encoded bytes,
+    // oldest first. After switching the bitrate the queue still contains
+    // bytes of the previous bitrate.
+    std::deque<QueuedBytes> m_queuedBytes;
     PollingControlProxy m_mainSamplerate;
     PollingControlProxy m_broadcastEnabled;
     // static metadata according to prefereneces
@@ -153,6 +180,8 @@ class ShoutConnection
     bool m_limitReconnects;
     int m_maximumRetries;
 
+    const QString m_backlogStatTag;
+
     QMutex m_enabledMutex;
     QWaitCondition m_waitEnabled;
 };
@@ -640,7 +640,7 @@ void EngineSync::updateLeaderBpm(Syncable* pSource, mixxx::Bpm bpm) {
     if (pSource != m_pInternalClock) {
         m_pInternalClock->updateLeaderBpm(bpm);
     }
-    foreach (Syncable* pSyncable, m_syncables) {
+    for (Syncable* pSyncable : std::as_const(m_syncables)) {
         if (pSyncable == pSource ||
                 !pSyncable->isSynchronized()) {
             continue;
@@ -653,7 +653,7 @@ void EngineSync::updateLeaderInstantaneousBpm(Syncable* pSource, mixxx::Bpm bpm)
     if (pSource != m_pInternalClock) {
         m_pInternalClock->updateInstantaneousBpm(bpm);
     }
-    foreach (Syncable* pSyncable, m_syncables) {
+    for (Syncable* pSyncable : std::as_const(m_syncables)) {
         if (pSyncable == pSource ||
                 !pSyncable->isSynchronized()) {
             continue;
@@ -669,9 +669,13 @@ void EngineSync::updateLeaderBeatDistance(Syncable* pSource, double beatDistance
                         << beatDistance;
     }
     if (pSource != m_pInternalClock) {
+        // The internal clock notifies us about its new beat distance, which
+        // updates all synced syncables. Updating them here again would only
+        // repeat the same work once more per audio callback.
         m_pInternalClock->updateLeaderBeatDistance(beatDistance);
+        return;
     }
-    foreach (Syncable* pSyncable, m_syncables) {
+    for (Syncable* pSyncable : std::as_const(m_syncables)) {
         if (pSyncable == pSource ||
                 !pSyncable->isSynchronized()) {
             continue;
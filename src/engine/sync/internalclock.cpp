@@ -22,7 +22,8 @@ InternalClock::InternalClock(const QString& group, SyncableListener* pEngineSync
           m_oldBpm(kDefaultBpm),
           m_baseBpm(kDefaultBpm),
           m_dBeatLength(m_oldSampleRate * 60.0 / m_oldBpm.value()),
-          m_dClockPosition(0) {
+          m_dClockPosition(0),
+          m_bInCallback(false) {
     // Pick a wide range (1 to 200) and allow out of bounds sets. This lets you
     // map a soft-takeover MIDI knob to the leader BPM. This also creates bpm_up
     // and bpm_down controls.
@@ -108,7 +109,10 @@ void InternalClock::updateLeaderBeatDistance(double beatDistance) {
         kLogger.trace() << "InternalClock::updateLeaderBeatDistance" << beatDistance;
     }
     m_dClockPosition = beatDistance * m_dBeatLength;
-    m_pClockBeatDistance->set(beatDistance);
+    if (!m_bInCallback) {
+        // Otherwise published once in onCallbackEnd()
+        m_pClockBeatDistance->set(beatDistance);
+    }
     // Make sure followers have an up-to-date beat distance.
     m_pEngineSync->notifyBeatDistanceChanged(this, beatDistance);
 }
@@ -213,6 +217,7 @@ void InternalClock::updateBeatLength(mixxx::audio::SampleRate sampleRate, mixxx:
 void InternalClock::onCallbackStart(mixxx::audio::SampleRate sampleRate, std::size_t bufferSize) {
     Q_UNUSED(sampleRate)
     Q_UNUSED(bufferSize)
+    m_bInCallback = true;
     m_pEngineSync->notifyInstantaneousBpmChanged(this, getBpm());
 }
 
@@ -231,6 +236,7 @@ void InternalClock::onCallbackEnd(mixxx::audio::SampleRate sampleRate, std::size
 
     m_dClockPosition = fmod(m_dClockPosition, m_dBeatLength);
     double beatDistance = getBeatDistance();
-    m_pClockBeatDistance->set(beatDistance);
     m_pEngineSync->notifyBeatDistanceChanged(this, beatDistance);
+    m_bInCallback = false;
+    m_pClockBeatDistance->set(beatDistance);
 }
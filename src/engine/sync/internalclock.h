@@ -94,4 +94,8 @@ class InternalClock : public QObject, public Clock, public Syncable {
     // The current number of frames accumulated since the last beat (e.g. beat
     // distance is m_dClockPosition / m_dBeatLength).
     double m_dClockPosition;
+
+    // Set between onCallbackStart() and onCallbackEnd(). The beat distance
+    // control is only updated once at the end of each audio callback.
+    bool m_bInCallback;
 };
@@ -21,6 +21,9 @@ constexpr double kKeepPosition = -1.0;
 constexpr double kMinimumTrackDurationSec = 0.2;
 
 constexpr bool sDebug = false;
+
+// The tracks that will be loaded after the next fades
+constexpr int kPreloadTrackCount = 2;
 } // anonymous namespace
 
 DeckAttributes::DeckAttributes(int index,
@@ -116,6 +119,7 @@ AutoDJProcessor::AutoDJProcessor(
         int iAutoDJPlaylistId)
         : QObject(pParent),
           m_pConfig(pConfig),
+          m_pPlayerManager(pPlayerManager),
           m_pAutoDJTableModel(nullptr),
           m_eState(ADJ_DISABLED),
           m_transitionProgress(0.0),
@@ -1623,6 +1627,12 @@ void AutoDJProcessor::playerTrackLoaded(DeckAttributes* pDeck, TrackPointer pTra
             pDeck->play();
         }
     }
+
+    if (m_eState != ADJ_DISABLED) {
+        // Loading the next tracks after the following fades
+        // will not require any file I/O
+        preloadNextTracksFromQueue();
+    }
 }
 
 void AutoDJProcessor::playerLoadingTrack(DeckAttributes* pDeck,
@@ -1702,6 +1712,32 @@ void AutoDJProcessor::playlistFirstTrackChanged() {
         } else if (!pRightDeck->isPlaying()) {
             loadNextTrackFromQueue(*pRightDeck);
         }
+        preloadNextTracksFromQueue();
+    }
+}
+
+void AutoDJProcessor::preloadNextTracksFromQueue() {
+    int preloadedTrackCount = 0;
+    for (int row = 0; row < m_pAutoDJTableModel->rowCount() &&
+            preloadedTrackCount < kPreloadTrackCount;
+            ++row) {
+        TrackPointer pTrack = m_pAutoDJTableModel->getTrack(
+                m_pAutoDJTableModel->index(row, 0));
+        if (!pTrack) {
+            continue;
+        }
+        bool loaded = false;
+        for (const auto* pDeck : std::as_const(m_decks)) {
+            if (pDeck->getLoadedTrack() == pTrack) {
+                loaded = true;
+                break;
+            }
+        }
+        if (loaded) {
+            continue;
+        }
+        m_pPlayerManager->preloadTrack(pTrack);
+        ++preloadedTrackCount;
     }
 }
 
@@ -291,7 +291,10 @@ class AutoDJProcessor : public QObject {
     // present.
     bool removeTrackFromTopOfQueue(TrackPointer pTrack);
     void maybeFillRandomTracks();
+    // Preloads the next tracks in the queue that are not loaded yet.
+    void preloadNextTracksFromQueue();
     UserSettingsPointer m_pConfig;
+    PlayerManagerInterface* m_pPlayerManager;
     PlaylistTableModel* m_pAutoDJTableModel;
 
     AutoDJState m_eState;
@@ -6,6 +6,7 @@
 
 #include "library/dao/trackschema.h"
 #include "library/queryutil.h"
+#include "library/searchquery.h"
 #include "library/starrating.h"
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
@@ -17,6 +18,8 @@
 #include "util/assert.h"
 #include "util/datetime.h"
 #include "util/db/dbconnection.h"
+#include "util/db/dbqueryexecutor.h"
+#include "util/db/sqltransaction.h"
 #include "util/duration.h"
 #include "util/performancetimer.h"
 #include "util/platform.h"
@@ -31,6 +34,11 @@ const bool sDebug = false;
 constexpr int kIdColumn = 0;
 constexpr int kMaxSortColumns = 3;
 
+// The values of the table columns are fetched in pages of consecutive
+// rows. Only the most recently accessed pages are kept in memory.
+constexpr int kTableRowPageSize = 256;
+constexpr int kTableRowPageCacheCapacity = 64;
+
 // Constant for getModelSetting(name)
 const QString COLUMNS_SORTING = QStringLiteral("ColumnsSorting");
 
@@ -45,10 +53,30 @@ BaseSqlTableModel::BaseSqlTableModel(
         : BaseTrackTableModel(parent, pTrackCollectionManager, settingsNamespace),
           m_pTrackCollectionManager(pTrackCollectionManager),
           m_database(pTrackCollectionManager->internalCollection()->database()),
+          m_fetchTableRowsInBackground(false),
+          m_tableRowPages(kTableRowPageCacheCapacity),
+          m_pSelectWatcher(nullptr),
           m_bInitialized(false) {
 }
 
 BaseSqlTableModel::~BaseSqlTableModel() {
+    // Pending queries would create the view again
+    cancelPendingSelect();
+    clearTableRowPages();
+    dropTemporaryViewOfExecutor();
+}
+
+void BaseSqlTableModel::dropTemporaryViewOfExecutor() {
+    // The views are only needed while the model shows them. Otherwise
+    // they accumulate on the connection of the executor with every
+    // playlist and crate that has been shown.
+    if (m_tableViewSql.isEmpty()) {
+        return;
+    }
+    mixxx::DbQueryExecutor* pQueryExecutor = m_pTrackCollectionManager->queryExecutor();
+    if (pQueryExecutor) {
+        pQueryExecutor->dropTemporaryView(m_tableName);
+    }
 }
 
 void BaseSqlTableModel::initHeaderProperties() {
@@ -160,6 +188,7 @@ void BaseSqlTableModel::initSortColumnMapping() {
 void BaseSqlTableModel::clearRows() {
     DEBUG_ASSERT(m_rowInfo.empty() == m_trackIdToRows.empty());
     DEBUG_ASSERT(m_rowInfo.size() >= m_trackIdToRows.size());
+    clearTableRowPages();
     if (!m_rowInfo.isEmpty()) {
         beginRemoveRows(QModelIndex(), 0, m_rowInfo.size() - 1);
         m_rowInfo.clear();
@@ -191,6 +220,7 @@ void BaseSqlTableModel::replaceRows(
     if (rows.isEmpty()) {
         clearRows();
     } else {
+        clearTableRowPages();
         beginInsertRows(QModelIndex(), 0, rows.size() - 1);
         m_rowInfo = rows;
         m_trackIdToRows = trackIdToRows;
@@ -218,91 +248,255 @@ void BaseSqlTableModel::select() {
         qDebug() << this << "select()";
     }
 
+    // The result of a pending select would be outdated
+    cancelPendingSelect();
+
     PerformanceTimer time;
     time.start();
 
-    // Prepare query for id and all columns not in m_trackSource
-    QString queryString = QString("SELECT %1 FROM %2 %3")
-                                  .arg(m_tableColumns.join(","), m_tableName, m_tableOrderBy);
+    QVector<RowInfo> rowInfos;
+    if (!selectRowKeys(m_database,
+                selectRowKeysQuery(),
+                positionColumn() >= 0,
+                &rowInfos)) {
+        return;
+    }
+
+    // Remove all the rows from the table after(!) the query has been
+    // executed successfully. See issue #6782.
+    // TODO(rryan) we could edit the table in place instead of clearing it?
+    clearRows();
+
+    if (m_trackSource) {
+        QSet<TrackId> trackIds;
+        for (const auto& rowInfo : std::as_const(rowInfos)) {
+            trackIds.insert(rowInfo.trackId);
+        }
+        m_trackSource->filterAndSort(trackIds,
+                m_currentSearch,
+                m_currentSearchFilter,
+                m_trackSourceOrderBy,
+                m_sortColumns,
+                m_tableColumns.size() - 1, // exclude the 1st column with the id
+                &m_trackSortOrder);
+    }
+
+    replaceSelectedRows(std::move(rowInfos));
+
+    qDebug() << this << "select() returned" << m_rowInfo.size()
+             << "results in" << time.elapsed().debugMillisWithUnit();
+    emit selectFinished();
+}
+
+void BaseSqlTableModel::selectInBackground() {
+    if (!m_bInitialized) {
+        return;
+    }
+    // Both the table and the track source must be visible from the
+    // connection of the query executor. Without write-ahead logging the
+    // read transaction would block writers on our connection.
+    if (!m_fetchTableRowsInBackground ||
+            m_pTrackCollectionManager->queryExecutor()->readsBlockWriters() ||
+            (m_trackSource && !m_trackSource->canQueryInBackground())) {
+        select();
+        return;
+    }
 
+    if (sDebug) {
+        qDebug() << this << "selectInBackground()";
+    }
+
+    cancelPendingSelect();
+
+    PerformanceTimer time;
+    time.start();
+
+    // The search query is parsed here, because it is needed again for
+    // matching the dirty tracks when the result has arrived.
+    std::shared_ptr<QueryNode> pQueryNode;
+    QString trackSourceQuery;
+    if (m_trackSource) {
+        std::unique_ptr<QueryNode> pParsedQueryNode;
+        trackSourceQuery = m_trackSource->filterQuery(
+                QStringLiteral("SELECT %1 FROM %2").arg(m_idColumn, m_tableName),
+                m_currentSearch,
+                m_currentSearchFilter,
+                m_trackSourceOrderBy,
+                &pParsedQueryNode);
+        pQueryNode = std::move(pParsedQueryNode);
+    }
+
+    m_pSelectWatcher = new QFutureWatcher<SelectResult>(this);
+    connect(m_pSelectWatcher,
+            &QFutureWatcher<SelectResult>::finished,
+            this,
+            [this,
+                    pWatcher = m_pSelectWatcher,
+                    pQueryNode,
+                    searchQuery = m_currentSearch,
+                    sortColumns = m_sortColumns,
+                    time]() {
+                onSelectFinished(pWatcher, pQueryNode, searchQuery, sortColumns, time);
+            });
+    m_pSelectWatcher->setFuture(
+            m_pTrackCollectionManager->queryExecutor()->execute<SelectResult>(
+                    [tableName = m_tableName,
+                            tableViewSql = m_tableViewSql,
+                            rowKeysQuery = selectRowKeysQuery(),
+                            hasPositionColumn = positionColumn() >= 0,
+                            trackSourceTableName = m_trackSource
+                                    ? m_trackSource->tableName()
+                                    : QString(),
+                            trackSourceViewSql = m_trackSource
+                                    ? m_trackSource->tableViewSql()
+                                    : QString(),
+                            trackSourceQuery](const QSqlDatabase& database) {
+                        SelectResult result;
+                        if (!tableViewSql.isEmpty() &&
+                                !mixxx::DbQueryExecutor::createTemporaryView(
+                                        database, tableName, tableViewSql)) {
+                            return result;
+                        }
+                        if (!trackSourceViewSql.isEmpty() &&
+                                !mixxx::DbQueryExecutor::createTemporaryView(
+                                        database,
+                                        trackSourceTableName,
+                                        trackSourceViewSql)) {
+                            return result;
+                        }
+                        // Both queries need to see the same tracks
+                        SqlTransaction transaction(database);
+                        if (!selectRowKeys(database,
+                                    rowKeysQuery,
+                                    hasPositionColumn,
+                                    &result.rows)) {
+                            return result;
+                        }
+                        if (!trackSourceQuery.isEmpty()) {
+                            result.trackOrder = BaseTrackCache::selectTrackIds(
+                                    database, trackSourceQuery);
+                        }
+                        transaction.commit();
+                        result.ok = true;
+                        return result;
+                    }));
+}
+
+void BaseSqlTableModel::onSelectFinished(
+        QFutureWatcher<SelectResult>* pWatcher,
+        const std::shared_ptr<QueryNode>& pQueryNode,
+        const QString& searchQuery,
+        const QList<SortColumn>& sortColumns,
+        PerformanceTimer time) {
+    DEBUG_ASSERT(m_pSelectWatcher == pWatcher);
+    m_pSelectWatcher = nullptr;
+    pWatcher->deleteLater();
+    if (pWatcher->isCanceled()) {
+        return;
+    }
+    SelectResult result = pWatcher->result();
+    if (!result.ok) {
+        // Try again on our own connection
+        select();
+        return;
+    }
+
+    // The search query has been parsed for the track source
+    VERIFY_OR_DEBUG_ASSERT(!m_trackSource || pQueryNode) {
+        return;
+    }
+
+    clearRows();
+
+    if (m_trackSource && !result.rows.isEmpty()) {
+        QSet<TrackId> trackIds;
+        for (const auto& rowInfo : std::as_const(result.rows)) {
+            trackIds.insert(rowInfo.trackId);
+        }
+        m_trackSource->mergeFilteredTracks(std::move(result.trackOrder),
+                trackIds,
+                searchQuery,
+                *pQueryNode,
+                sortColumns,
+                m_tableColumns.size() - 1, // exclude the 1st column with the id
+                &m_trackSortOrder);
+    }
+
+    replaceSelectedRows(std::move(result.rows));
+
+    qDebug() << this << "select() returned" << m_rowInfo.size()
+             << "results in the background in" << time.elapsed().debugMillisWithUnit();
+    emit selectFinished();
+}
+
+void BaseSqlTableModel::cancelPendingSelect() {
+    if (!m_pSelectWatcher) {
+        return;
+    }
+    m_pSelectWatcher->disconnect(this);
+    m_pSelectWatcher->cancel();
+    m_pSelectWatcher->deleteLater();
+    m_pSelectWatcher = nullptr;
+}
+
+QString BaseSqlTableModel::selectRowKeysQuery() const {
+    // Only the keys of the rows are selected here. The values of the
+    // remaining table columns are fetched page by page when accessed.
+    QStringList keyColumns{m_idColumn};
+    const int posColumn = positionColumn();
+    if (posColumn >= 0) {
+        keyColumns << m_tableColumns[posColumn];
+    }
+    QString queryString = QString("SELECT %1 FROM %2 %3")
+                                  .arg(keyColumns.join(","), m_tableName, m_tableOrderBy);
     if (sDebug) {
         qDebug() << this << "select() executing:" << queryString;
     }
+    return queryString;
+}
 
-    QSqlQuery query(m_database);
+// static
+bool BaseSqlTableModel::selectRowKeys(
+        const QSqlDatabase& database,
+        const QString& queryString,
+        bool hasPositionColumn,
+        QVector<RowInfo>* pRowInfos) {
+    QSqlQuery query(database);
     // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
     // won't allocate a giant in-memory table that we won't use at all.
     query.setForwardOnly(true);
     if (!query.prepare(queryString)) {
         LOG_FAILED_QUERY(query);
-        return;
+        return false;
     }
     if (!query.exec()) {
         LOG_FAILED_QUERY(query);
-        return;
+        return false;
     }
 
-    // Remove all the rows from the table after(!) the query has been
-    // executed successfully. See issue #6782.
-    // TODO(rryan) we could edit the table in place instead of clearing it?
-    clearRows();
-
     // The size of the result set is not known in advance for a
     // forward-only query, so we cannot reserve memory for rows
     // in advance.
-    QVector<RowInfo> rowInfos;
-    QSet<TrackId> trackIds;
-    int idColumn = -1;
-    int posColumn = -1;
     while (query.next()) {
-        QSqlRecord sqlRecord = query.record();
-
-        if (idColumn < 0) {
-            idColumn = sqlRecord.indexOf(m_idColumn);
-        }
-
-        if (posColumn == -1 && hasPositionColumn()) {
-            posColumn = sqlRecord.indexOf(PLAYLISTTABLE_POSITION);
-        }
-
-        // TODO(XXX): Can we get rid of the hard-coded assumption that
-        // the the first column always contains the id?
-        DEBUG_ASSERT(idColumn == kIdColumn);
-
-        VERIFY_OR_DEBUG_ASSERT(idColumn != -1) {
-            qCritical()
-                    << "ID column not available in database query results:"
-                    << m_idColumn;
-            return;
-        }
-
-        TrackId trackId(sqlRecord.value(idColumn));
-        trackIds.insert(trackId);
-
         RowInfo rowInfo;
-        rowInfo.trackId = trackId;
-        rowInfo.row = rowInfos.size();
-
-        rowInfo.columnValues.reserve(sqlRecord.count());
-        for (int i = 0; i < m_tableColumns.size(); ++i) {
-            rowInfo.columnValues.push_back(sqlRecord.value(i));
+        rowInfo.trackId = TrackId(query.value(kIdColumn));
+        rowInfo.row = pRowInfos->size();
+        if (hasPositionColumn) {
+            bool ok = false;
+            const int position = query.value(1).toInt(&ok);
+            rowInfo.position = ok ? position : -1;
         }
-        rowInfos.push_back(rowInfo);
+        pRowInfos->push_back(rowInfo);
     }
 
     if (sDebug) {
-        qDebug() << "Rows actually received:" << rowInfos.size();
+        qDebug() << "Rows actually received:" << pRowInfos->size();
     }
+    return true;
+}
 
+void BaseSqlTableModel::replaceSelectedRows(QVector<RowInfo>&& rowInfos) {
     if (m_trackSource) {
-        m_trackSource->filterAndSort(trackIds,
-                m_currentSearch,
-                m_currentSearchFilter,
-                m_trackSourceOrderBy,
-                m_sortColumns,
-                m_tableColumns.size() - 1, // exclude the 1st column with the id
-                &m_trackSortOrder);
-
         // Re-sort the track IDs since filterAndSort can change their order or mark
         // them for removal (by setting their row to -1).
         for (auto& rowInfo : rowInfos) {
@@ -346,8 +540,7 @@ void BaseSqlTableModel::select() {
         // We expect as many positions as we have rows
         trackPosToRows.reserve(rowInfos.size());
         for (int i = 0; i < rowInfos.size(); ++i) {
-            const RowInfo& rowInfo = rowInfos[i];
-            trackPosToRows.insert(rowInfo.getPosition(posColumn), i);
+            trackPosToRows.insert(rowInfos[i].position, i);
         }
         DEBUG_ASSERT(trackPosToRows.size() == rowInfos.size());
     }
@@ -359,9 +552,6 @@ void BaseSqlTableModel::select() {
             std::move(trackPosToRows));
     // Both rowInfo and trackIdToRows (might) have been moved and
     // must not be used afterwards!
-
-    qDebug() << this << "select() returned" << m_rowInfo.size()
-             << "results in" << time.elapsed().debugMillisWithUnit();
 }
 
 void BaseSqlTableModel::setTable(QString tableName,
@@ -371,15 +561,34 @@ void BaseSqlTableModel::setTable(QString tableName,
     if (sDebug) {
         qDebug() << this << "setTable" << tableName << tableColumns << idColumn;
     }
+    // Skip all pending queries of the previous table
+    cancelPendingSelect();
+    clearTableRowPages();
+    if (tableName != m_tableName) {
+        dropTemporaryViewOfExecutor();
+    }
+
     m_tableName = std::move(tableName);
     m_idColumn = std::move(idColumn);
     m_tableColumns = std::move(tableColumns);
 
+    // The table rows can only be fetched on the connection of the query
+    // executor if the table is visible there. Temporary views are created
+    // again on that connection, temporary tables are not accessible.
+    m_tableViewSql.clear();
+    m_fetchTableRowsInBackground = m_pTrackCollectionManager->queryExecutor() &&
+            mixxx::DbQueryExecutor::isVisibleFromExecutor(
+                    m_database, m_tableName, &m_tableViewSql);
+
     if (m_trackSource) {
         disconnect(m_trackSource.data(),
                 &BaseTrackCache::tracksChanged,
                 this,
                 &BaseSqlTableModel::tracksChanged);
+        disconnect(m_trackSource.data(),
+                &BaseTrackCache::indexBuilt,
+                this,
+                &BaseSqlTableModel::trackSourceIndexBuilt);
     }
     m_trackSource = trackSource;
     if (m_trackSource) {
@@ -395,6 +604,11 @@ void BaseSqlTableModel::setTable(QString tableName,
                 this,
                 &BaseSqlTableModel::tracksChanged,
                 Qt::QueuedConnection);
+        connect(m_trackSource.data(),
+                &BaseTrackCache::indexBuilt,
+                this,
+                &BaseSqlTableModel::trackSourceIndexBuilt,
+                Qt::QueuedConnection);
     }
 
     initTableColumnsAndHeaderProperties(m_tableColumns);
@@ -442,7 +656,7 @@ void BaseSqlTableModel::search(const QString& searchText, const QString& extraFi
         qDebug() << this << "search" << searchText;
     }
     setSearch(searchText, extraFilter);
-    select();
+    selectInBackground();
 }
 
 void BaseSqlTableModel::setSort(int column, Qt::SortOrder order) {
@@ -587,7 +801,7 @@ void BaseSqlTableModel::sort(int column, Qt::SortOrder order) {
         qDebug() << this << "sort()" << column << order;
     }
     setSort(column, order);
-    select();
+    selectInBackground();
 }
 
 int BaseSqlTableModel::rowCount(const QModelIndex& parent) const {
@@ -674,13 +888,25 @@ QVariant BaseSqlTableModel::rawValue(
             return previewDeckTrackId() == trackId;
         }
 
-        const QVector<QVariant>& columnValues = rowInfo.columnValues;
+        // The keys of all rows are available
+        if (column == kIdColumn) {
+            return trackId.isValid() ? trackId.toVariant() : QVariant();
+        }
+        if (column == positionColumn()) {
+            return rowInfo.position;
+        }
+
+        // The values of other columns might still be pending
+        const TableRowValues* pValues = tableRowValues(row);
+        if (!pValues || column >= pValues->size()) {
+            return QVariant();
+        }
         if (sDebug) {
             qDebug() << "Returning table-column value"
-                     << columnValues.at(column)
+                     << pValues->at(column)
                      << "for column" << column;
         }
-        return columnValues[column];
+        return pValues->at(column);
     }
 
     // Otherwise, return the information from the track record cache for the
@@ -704,6 +930,166 @@ QVariant BaseSqlTableModel::rawValue(
     return m_trackSource->data(trackId, trackSourceColumn);
 }
 
+int BaseSqlTableModel::positionColumn() const {
+    const int column = fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION);
+    return column < m_tableColumns.size() ? column : -1;
+}
+
+void BaseSqlTableModel::clearTableRowPages() {
+    m_tableRowPages.clear();
+    for (auto* pWatcher : std::as_const(m_pendingTableRowPages)) {
+        pWatcher->disconnect(this);
+        pWatcher->cancel();
+        pWatcher->deleteLater();
+    }
+    m_pendingTableRowPages.clear();
+}
+
+const BaseSqlTableModel::TableRowValues* BaseSqlTableModel::tableRowValues(
+        int row) const {
+    const int page = row / kTableRowPageSize;
+    if (m_fetchTableRowsInBackground) {
+        // Prefetch the pages around the visible rows while scrolling
+        requestTableRowPage(page - 1);
+        requestTableRowPage(page + 1);
+    }
+    requestTableRowPage(page);
+    const TableRowPage* pPage = m_tableRowPages.object(page);
+    if (!pPage) {
+        return nullptr;
+    }
+    return &pPage->at(row - page * kTableRowPageSize);
+}
+
+void BaseSqlTableModel::requestTableRowPage(int page) const {
+    const int firstRow = page * kTableRowPageSize;
+    if (firstRow < 0 || firstRow >= m_rowInfo.size()) {
+        return;
+    }
+    if (m_tableRowPages.contains(page) || m_pendingTableRowPages.contains(page)) {
+        return;
+    }
+    const int endRow = std::min(firstRow + kTableRowPageSize, m_rowInfo.size());
+    QStringList idStrings;
+    idStrings.reserve(endRow - firstRow);
+    for (int row = firstRow; row < endRow; ++row) {
+        idStrings << m_rowInfo[row].trackId.toString();
+    }
+    const QString queryString =
+            QStringLiteral("SELECT %1 FROM %2 WHERE %3 IN (%4)")
+                    .arg(m_tableColumns.join(","),
+                            m_tableName,
+                            m_idColumn,
+                            idStrings.join(","));
+
+    // data() is const, but the rows are updated asynchronously
+    auto* pThis = const_cast<BaseSqlTableModel*>(this);
+    if (!m_fetchTableRowsInBackground) {
+        pThis->insertTableRowPage(page,
+                selectTableRows(m_database, QString(), QString(), queryString));
+        return;
+    }
+
+    auto* pWatcher = new QFutureWatcher<QVector<TableRowValues>>(pThis);
+    connect(pWatcher,
+            &QFutureWatcher<QVector<TableRowValues>>::finished,
+            pThis,
+            [pThis, pWatcher, page]() {
+                pThis->onTableRowPageFetched(page, pWatcher);
+            });
+    m_pendingTableRowPages.insert(page, pWatcher);
+    pWatcher->setFuture(
+            m_pTrackCollectionManager->queryExecutor()->execute<QVector<TableRowValues>>(
+                    [tableName = m_tableName,
+                            tableViewSql = m_tableViewSql,
+                            queryString](const QSqlDatabase& database) {
+                        return selectTableRows(
+                                database, tableName, tableViewSql, queryString);
+                    }));
+}
+
+void BaseSqlTableModel::onTableRowPageFetched(
+        int page,
+        QFutureWatcher<QVector<TableRowValues>>* pWatcher) {
+    DEBUG_ASSERT(m_pendingTableRowPages.value(page) == pWatcher);
+    m_pendingTableRowPages.remove(page);
+    pWatcher->deleteLater();
+    if (pWatcher->isCanceled()) {
+        return;
+    }
+    insertTableRowPage(page, pWatcher->result());
+
+    const int firstRow = page * kTableRowPageSize;
+    const int lastRow = std::min(firstRow + kTableRowPageSize, m_rowInfo.size()) - 1;
+    if (lastRow >= firstRow) {
+        emit dataChanged(
+                index(firstRow, 0),
+                index(lastRow, m_tableColumns.size() - 1));
+    }
+}
+
+void BaseSqlTableModel::insertTableRowPage(
+        int page,
+        const QVector<TableRowValues>& rows) {
+    const int firstRow = page * kTableRowPageSize;
+    const int endRow = std::min(firstRow + kTableRowPageSize, m_rowInfo.size());
+    if (endRow <= firstRow) {
+        return;
+    }
+    // Rows that are not contained in the result, e.g. if the track has
+    // been removed in the meantime, don't have any values.
+    auto pPage = std::make_unique<TableRowPage>(endRow - firstRow);
+    const int posColumn = positionColumn();
+    for (const auto& values : rows) {
+        const TrackId trackId(values.value(kIdColumn));
+        if (posColumn >= 0) {
+            // Tracks might appear multiple times in playlists
+            const int row = m_trackPosToRow.value(values.value(posColumn).toInt(), -1);
+            if (row >= firstRow && row < endRow && m_rowInfo[row].trackId == trackId) {
+                (*pPage)[row - firstRow] = values;
+            }
+        } else {
+            const auto trackRows = m_trackIdToRows.value(trackId);
+            for (int row : trackRows) {
+                if (row >= firstRow && row < endRow) {
+                    (*pPage)[row - firstRow] = values;
+                }
+            }
+        }
+    }
+    m_tableRowPages.insert(page, pPage.release());
+}
+
+// static
+QVector<BaseSqlTableModel::TableRowValues> BaseSqlTableModel::selectTableRows(
+        const QSqlDatabase& database,
+        const QString& tableName,
+        const QString& tableViewSql,
+        const QString& queryString) {
+    if (!tableViewSql.isEmpty() &&
+            !mixxx::DbQueryExecutor::createTemporaryView(
+                    database, tableName, tableViewSql)) {
+        return {};
+    }
+    QSqlQuery query(database);
+    query.setForwardOnly(true);
+    if (!query.prepare(queryString) || !query.exec()) {
+        LOG_FAILED_QUERY(query);
+        return {};
+    }
+    const int columnCount = query.record().count();
+    QVector<TableRowValues> rows;
+    while (query.next()) {
+        TableRowValues values;
+        values.reserve(columnCount);
+        for (int i = 0; i < columnCount; ++i) {
+            values.push_back(query.value(i));
+        }
+        rows.push_back(std::move(values));
+    }
+    return rows;
+}
+
 bool BaseSqlTableModel::setTrackValueForColumn(
         const TrackPointer& pTrack,
         int column,
@@ -868,6 +1254,16 @@ void BaseSqlTableModel::tracksChanged(const QSet<TrackId>& trackIds) {
     }
 }
 
+void BaseSqlTableModel::trackSourceIndexBuilt() {
+    if (m_rowInfo.isEmpty() || columnCount() <= m_tableColumns.size()) {
+        return;
+    }
+    // All track columns of all rows might have been changed
+    emit dataChanged(
+            index(0, m_tableColumns.size()),
+            index(m_rowInfo.size() - 1, columnCount() - 1));
+}
+
 void BaseSqlTableModel::hideTracks(const QModelIndexList& indices) {
     QList<TrackId> trackIds;
     foreach (QModelIndex index, indices) {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QCache>
+#include <QFutureWatcher>
 #include <QHash>
 
 #include "library/basetrackcache.h"
@@ -7,11 +9,21 @@
 #include "library/basetracktablemodel.h"
 #include "library/columncache.h"
 #include "util/class.h"
+#include "util/performancetimer.h"
 
+class QueryNode;
 class TrackCollectionManager;
 
 // BaseSqlTableModel is a custom-written SQL-backed table which aggressively
 // caches the contents of the table and supports lightweight updates.
+//
+// Only the ids (and positions) of all rows are loaded by select(). The
+// values of the remaining table columns are fetched in pages on demand,
+// in the background if possible. Track columns are provided by the
+// BaseTrackCache.
+//
+// Searching and sorting select the rows in the background if possible.
+// The rows are replaced when the result arrives, see selectFinished().
 class BaseSqlTableModel : public BaseTrackTableModel {
     Q_OBJECT
   public:
@@ -69,6 +81,11 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     void select() override;
 
+    /// A select() in the background has not finished yet
+    bool isSelectPending() const {
+        return m_pSelectWatcher != nullptr;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Inherited from BaseTrackTableModel
     ///////////////////////////////////////////////////////////////////////////
@@ -77,6 +94,10 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     QString modelKey(bool noSearch) const override;
 
+  signals:
+    /// The rows have been replaced by select()
+    void selectFinished();
+
   protected:
     ///////////////////////////////////////////////////////////////////////////
     // Inherited from BaseTrackTableModel
@@ -114,6 +135,7 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
   private slots:
     void tracksChanged(const QSet<TrackId>& trackIds);
+    void trackSourceIndexBuilt();
 
   private:
     void setTrackValueForColumn(
@@ -126,20 +148,9 @@ class BaseSqlTableModel : public BaseTrackTableModel {
 
     struct RowInfo {
         TrackId trackId;
-        int row;
-        QVector<QVariant> columnValues;
-
-        int getPosition(int posCol) const {
-            if (posCol < 0) {
-                return -1;
-            }
-            bool ok = false;
-            int pos = columnValues.at(posCol).toInt(&ok);
-            if (ok) {
-                return pos;
-            }
-            return -1;
-        }
+        int row = -1;
+        // -1 if the table has no position column
+        int position = -1;
 
         bool operator<(const RowInfo& other) const {
             // -1 is greater than anything
@@ -156,6 +167,56 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     typedef QHash<int, int> TrackPos2Row;
 
     void clearRows();
+
+    // The result of selecting the rows in the background
+    struct SelectResult {
+        bool ok = false;
+        QVector<RowInfo> rows;
+        // The filtered and sorted ids of the track source
+        QVector<TrackId> trackOrder;
+    };
+
+    // Searching and sorting in the background if possible
+    void selectInBackground();
+    void onSelectFinished(
+            QFutureWatcher<SelectResult>* pWatcher,
+            const std::shared_ptr<QueryNode>& pQueryNode,
+            const QString& searchQuery,
+            const QList<SortColumn>& sortColumns,
+            PerformanceTimer timer);
+    void cancelPendingSelect();
+    QString selectRowKeysQuery() const;
+    static bool selectRowKeys(
+            const QSqlDatabase& database,
+            const QString& queryString,
+            bool hasPositionColumn,
+            QVector<RowInfo>* pRowInfos);
+    void replaceSelectedRows(QVector<RowInfo>&& rowInfos);
+
+    // The position column is a table column, if any
+    int positionColumn() const;
+
+    // The values of all table columns of a row
+    typedef QVector<QVariant> TableRowValues;
+    typedef QVector<TableRowValues> TableRowPage;
+
+    // Returns nullptr while the page of the row is being fetched
+    const TableRowValues* tableRowValues(int row) const;
+    void requestTableRowPage(int page) const;
+    void onTableRowPageFetched(
+            int page,
+            QFutureWatcher<QVector<TableRowValues>>* pWatcher);
+    void insertTableRowPage(
+            int page,
+            const QVector<TableRowValues>& rows);
+    void clearTableRowPages();
+
+    static QVector<TableRowValues> selectTableRows(
+            const QSqlDatabase& database,
+            const QString& tableName,
+            const QString& tableViewSql,
+            const QString& queryString);
+    void dropTemporaryViewOfExecutor();
     void replaceRows(
             QVector<RowInfo>&& rows,
             TrackId2Rows&& trackIdToRows,
@@ -164,6 +225,13 @@ class BaseSqlTableModel : public BaseTrackTableModel {
     QVector<RowInfo> m_rowInfo;
 
     QString m_idColumn;
+    // The definition of the table if it is a temporary view, see
+    // DbQueryExecutor::createTemporaryView()
+    QString m_tableViewSql;
+    bool m_fetchTableRowsInBackground;
+    mutable QCache<int, TableRowPage> m_tableRowPages;
+    mutable QHash<int, QFutureWatcher<QVector<TableRowValues>>*> m_pendingTableRowPages;
+    QFutureWatcher<SelectResult>* m_pSelectWatcher;
     QSharedPointer<BaseTrackCache> m_trackSource;
     QStringList m_tableColumns;
     QList<SortColumn> m_sortColumns;
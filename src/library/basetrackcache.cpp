@@ -1,5 +1,8 @@
 #include "library/basetrackcache.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "library/queryutil.h"
 #include "library/searchquery.h"
 #include "library/searchqueryparser.h"
@@ -8,6 +11,7 @@
 #include "track/globaltrackcache.h"
 #include "track/keyutils.h"
 #include "track/track.h"
+#include "util/db/dbqueryexecutor.h"
 #include "util/performancetimer.h"
 
 namespace {
@@ -31,7 +35,10 @@ BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
                   pTrackCollection, std::move(searchColumns))),
           m_bIndexBuilt(false),
           m_bIsCaching(isCaching),
-          m_database(pTrackCollection->database()) {
+          m_trackInfo(m_columnCount),
+          m_database(pTrackCollection->database()),
+          m_pQueryExecutor(nullptr),
+          m_pIndexWatcher(nullptr) {
 }
 
 BaseTrackCache::~BaseTrackCache() {
@@ -78,9 +85,12 @@ void BaseTrackCache::slotTracksRemoved(const QSet<TrackId>& trackIds) {
         qDebug() << this << "slotTracksRemoved" << trackIds.size();
     }
     for (const auto& trackId : std::as_const(trackIds)) {
-        m_trackInfo.remove(trackId);
+        m_trackInfo.removeRow(trackId);
         m_dirtyTracks.remove(trackId);
     }
+    if (m_pIndexWatcher) {
+        m_tracksRemovedWhileBuildingIndex += trackIds;
+    }
 }
 
 void BaseTrackCache::slotTrackDirty(TrackId trackId) {
@@ -104,11 +114,22 @@ bool BaseTrackCache::isCached(TrackId trackId) const {
 }
 
 void BaseTrackCache::ensureCached(TrackId trackId) {
-    updateTrackInIndex(trackId);
+    ensureCached(QSet<TrackId>{trackId});
 }
 
 void BaseTrackCache::ensureCached(const QSet<TrackId>& trackIds) {
-    updateTracksInIndex(trackIds);
+    if (!m_pQueryExecutor) {
+        updateTracksInIndex(trackIds);
+        return;
+    }
+    // The pending index will contain the tracks. Otherwise don't request
+    // the same tracks again and again while they are fetched.
+    if (m_pIndexWatcher) {
+        return;
+    }
+    const QSet<TrackId> uncachedTrackIds = trackIds - m_tracksBeingCached;
+    m_tracksBeingCached += uncachedTrackIds;
+    updateTracksInIndex(uncachedTrackIds);
 }
 
 const TrackPointer& BaseTrackCache::getRecentTrack(TrackId trackId) const {
@@ -120,7 +141,7 @@ const TrackPointer& BaseTrackCache::getRecentTrack(TrackId trackId) const {
     if (m_recentTrackId != trackId) {
         if (trackId.isValid()) {
             TrackPointer trackPtr =
-                    GlobalTrackCacheLocker().lookupTrackById(trackId);
+                    GlobalTrackCacheReader::lookupTrackById(trackId);
             replaceRecentTrack(
                     std::move(trackId),
                     std::move(trackPtr));
@@ -201,13 +222,11 @@ bool BaseTrackCache::updateTrackInIndex(
 
     TrackId trackId = pTrack->getId();
     if (trackId.isValid()) {
-        // m_trackInfo[id] will insert a QVector<QVariant> into the
-        // m_trackInfo HashTable with the key "id"
-        QVector<QVariant>& record = m_trackInfo[trackId];
-        // preallocate memory for all columns at once
-        record.resize(numColumns);
+        const int row = m_trackInfo.insertRow(trackId);
         for (int i = 0; i < numColumns; ++i) {
-            getTrackValueForColumn(pTrack, i, record[i]);
+            QVariant value;
+            getTrackValueForColumn(pTrack, i, value);
+            m_trackInfo.setValue(row, i, value);
         }
         if (m_bIsCaching) {
             replaceRecentTrack(std::move(trackId), pTrack);
@@ -232,7 +251,25 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
         resetRecentTrack();
     }
 
-    QSqlQuery query(m_database);
+    if (!selectIndexRows(m_database,
+                queryString,
+                m_idColumn,
+                fieldIndex(ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION),
+                &m_trackInfo)) {
+        return false;
+    }
+
+    qDebug() << this << "updateIndexWithQuery took" << timer.elapsed().debugMillisWithUnit();
+    return true;
+}
+
+// static
+bool BaseTrackCache::selectIndexRows(const QSqlDatabase& database,
+        const QString& queryString,
+        const QString& idColumn,
+        int locationColumn,
+        ColumnarTrackStore* pTrackInfo) {
+    QSqlQuery query(database);
     // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
     // won't allocate a giant in-memory table that we won't use at all.
     query.setForwardOnly(true); // performance improvement?
@@ -243,33 +280,133 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
         return false;
     }
 
-    int numColumns = columnCount();
-    int idColumn = query.record().indexOf(m_idColumn);
+    int numColumns = pTrackInfo->columnCount();
+    int idColumnIndex = query.record().indexOf(idColumn);
 
     while (query.next()) {
-        TrackId trackId(query.value(idColumn));
-
-        //m_trackInfo[id] will insert a QVector<QVariant> into the
-        //m_trackInfo HashTable with the key "id"
-        QVector<QVariant>& record = m_trackInfo[trackId];
-        record.resize(numColumns);
+        TrackId trackId(query.value(idColumnIndex));
 
+        const int row = pTrackInfo->insertRow(trackId);
         for (int i = 0; i < numColumns; ++i) {
-            if (fieldIndex(ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION) == i) {
+            if (locationColumn == i) {
                 // Database stores all locations with Qt separators: "/"
                 // Here we want to cache the display string with native separators.
                 QString location = query.value(i).toString();
-                record[i] = QDir::toNativeSeparators(location);
+                pTrackInfo->setValue(row, i, QDir::toNativeSeparators(location));
             } else {
-                record[i] = query.value(i);
+                pTrackInfo->setValue(row, i, query.value(i));
             }
         }
     }
-
-    qDebug() << this << "updateIndexWithQuery took" << timer.elapsed().debugMillisWithUnit();
     return true;
 }
 
+BaseTrackCache::IndexRowsWatcher* BaseTrackCache::updateIndexInBackground(
+        const QString& queryString,
+        const QSet<TrackId>& trackIds) {
+    DEBUG_ASSERT(m_pQueryExecutor);
+    auto* pWatcher = new IndexRowsWatcher(this);
+    connect(pWatcher,
+            &IndexRowsWatcher::finished,
+            this,
+            [this, pWatcher, trackIds]() {
+                onIndexRowsSelected(pWatcher, trackIds);
+            });
+    pWatcher->setFuture(
+            m_pQueryExecutor->execute<std::shared_ptr<ColumnarTrackStore>>(
+                    [tableName = m_tableName,
+                            tableViewSql = m_tableViewSql,
+                            idColumn = m_idColumn,
+                            columnCount = m_columnCount,
+                            locationColumn = fieldIndex(
+                                    ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION),
+                            queryString](const QSqlDatabase& database) {
+                        if (!tableViewSql.isEmpty() &&
+                                !mixxx::DbQueryExecutor::createTemporaryView(
+                                        database, tableName, tableViewSql)) {
+                            return std::shared_ptr<ColumnarTrackStore>();
+                        }
+                        auto pTrackInfo = std::make_shared<ColumnarTrackStore>(columnCount);
+                        if (!selectIndexRows(database,
+                                    queryString,
+                                    idColumn,
+                                    locationColumn,
+                                    pTrackInfo.get())) {
+                            return std::shared_ptr<ColumnarTrackStore>();
+                        }
+                        return pTrackInfo;
+                    }));
+    return pWatcher;
+}
+
+void BaseTrackCache::onIndexRowsSelected(
+        IndexRowsWatcher* pWatcher,
+        const QSet<TrackId>& trackIds) {
+    pWatcher->deleteLater();
+    const bool isIndex = pWatcher == m_pIndexWatcher;
+    if (isIndex) {
+        m_pIndexWatcher = nullptr;
+    }
+    m_tracksBeingCached -= trackIds;
+
+    std::shared_ptr<ColumnarTrackStore> pTrackInfo;
+    if (!pWatcher->isCanceled()) {
+        pTrackInfo = pWatcher->result();
+    }
+    if (!pTrackInfo) {
+        if (isIndex) {
+            qDebug() << "buildIndex failed!";
+            m_tracksRemovedWhileBuildingIndex.clear();
+            m_bIndexBuilt = true;
+        } else {
+            qDebug() << "updateTracksInIndex failed!";
+        }
+        return;
+    }
+
+    // The queries are executed and their results are delivered in the
+    // order they have been submitted, so updates of single tracks
+    // requested after the index always overwrite the index rows.
+    if (m_bIsCaching) {
+        resetRecentTrack();
+    }
+    if (isIndex) {
+        m_trackInfo = std::move(*pTrackInfo);
+        for (const auto& trackId : std::as_const(m_tracksRemovedWhileBuildingIndex)) {
+            m_trackInfo.removeRow(trackId);
+        }
+        m_tracksRemovedWhileBuildingIndex.clear();
+        m_bIndexBuilt = true;
+        emit indexBuilt();
+        return;
+    }
+    const int numColumns = columnCount();
+    for (int i = 0; i < pTrackInfo->rowCount(); ++i) {
+        const int row = m_trackInfo.insertRow(pTrackInfo->trackIdAt(i));
+        for (int column = 0; column < numColumns; ++column) {
+            m_trackInfo.setValue(row, column, pTrackInfo->value(i, column));
+        }
+    }
+    emit tracksChanged(trackIds);
+}
+
+void BaseTrackCache::setUseFullTextIndex(bool useFullTextIndex) {
+    m_pQueryParser->setUseFullTextIndex(useFullTextIndex);
+}
+
+void BaseTrackCache::setQueryExecutor(mixxx::DbQueryExecutor* pQueryExecutor) {
+    m_pQueryExecutor = nullptr;
+    m_tableViewSql.clear();
+    // Reading the whole table in the background would block the writers
+    // on the caller's connection, e.g. when saving track metadata.
+    if (pQueryExecutor &&
+            !pQueryExecutor->readsBlockWriters() &&
+            mixxx::DbQueryExecutor::isVisibleFromExecutor(
+                    m_database, m_tableName, &m_tableViewSql)) {
+        m_pQueryExecutor = pQueryExecutor;
+    }
+}
+
 void BaseTrackCache::buildIndex() {
     if (sDebug) {
         qDebug() << this << "buildIndex()";
@@ -282,6 +419,18 @@ void BaseTrackCache::buildIndex() {
         qDebug() << this << "buildIndex query:" << queryString;
     }
 
+    if (m_pQueryExecutor) {
+        // The current index remains accessible until it is replaced
+        if (m_pIndexWatcher) {
+            m_pIndexWatcher->disconnect(this);
+            m_pIndexWatcher->cancel();
+            m_pIndexWatcher->deleteLater();
+        }
+        m_tracksRemovedWhileBuildingIndex.clear();
+        m_pIndexWatcher = updateIndexInBackground(queryString, QSet<TrackId>());
+        return;
+    }
+
     // TODO(rryan) for very large tables, it probably makes more sense to NOT
     // clear the table, and keep track of what IDs we see, then delete the ones
     // we don't see.
@@ -318,6 +467,11 @@ void BaseTrackCache::updateTracksInIndex(const QSet<TrackId>& trackIds) {
         qDebug() << this << "updateTracksInIndex update query:" << queryString;
     }
 
+    if (m_pQueryExecutor) {
+        updateIndexInBackground(queryString, trackIds);
+        return;
+    }
+
     if (!updateIndexWithQuery(queryString)) {
         qDebug() << "updateTracksInIndex failed!";
         return;
@@ -410,7 +564,9 @@ QVariant BaseTrackCache::data(TrackId trackId, int column) const {
     QVariant result;
 
     if (!m_bIndexBuilt) {
-        qDebug() << this << "ERROR index is not built for" << m_tableName;
+        if (!m_pIndexWatcher) {
+            qDebug() << this << "ERROR index is not built for" << m_tableName;
+        }
         return result;
     }
 
@@ -428,11 +584,10 @@ QVariant BaseTrackCache::data(TrackId trackId, int column) const {
     // TODO(rryan) this code is flawed for columns that contains row-specific
     // metadata. Currently the upper-levels will not delegate row-specific
     // columns to this method, but there should still be a check here I think.
-    if (!result.isValid()) {
-        auto it = m_trackInfo.constFind(trackId);
-        if (it != m_trackInfo.constEnd()) {
-            const QVector<QVariant>& fields = it.value();
-            result = fields.value(column, result);
+    if (!result.isValid() && column >= 0 && column < m_trackInfo.columnCount()) {
+        const int row = m_trackInfo.row(trackId);
+        if (row >= 0) {
+            result = m_trackInfo.value(row, column);
         }
     }
     return result;
@@ -450,36 +605,51 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         return;
     }
 
-    if (!m_bIndexBuilt) {
-        buildIndex();
-    }
-
     QStringList idStrings;
-    // TODO(rryan) consider making this the data passed in and a separate
-    // QVector for output
-    QSet<TrackId> dirtyTracks;
+    idStrings.reserve(trackIds.size());
     for (const auto& trackId: trackIds) {
         idStrings << trackId.toString();
-        if (m_dirtyTracks.contains(trackId)) {
-            dirtyTracks.insert(trackId);
-        }
+    }
+
+    std::unique_ptr<QueryNode> pQuery;
+    const QString queryString = filterQuery(
+            idStrings.join(","),
+            searchQuery,
+            extraFilter,
+            orderByClause,
+            &pQuery);
+
+    mergeFilteredTracks(selectTrackIds(m_database, queryString),
+            trackIds,
+            searchQuery,
+            *pQuery,
+            sortColumns,
+            columnOffset,
+            trackToIndex);
+}
+
+QString BaseTrackCache::filterQuery(const QString& trackIdsSql,
+        const QString& searchQuery,
+        const QString& extraFilter,
+        const QString& orderByClause,
+        std::unique_ptr<QueryNode>* pQueryNode) {
+    if (!m_bIndexBuilt && !m_pIndexWatcher) {
+        buildIndex();
     }
 
     QStringList queryFragments;
     if (!extraFilter.isNull() && extraFilter != "") {
         queryFragments << QString("(%1)").arg(extraFilter);
     }
-    if (idStrings.size() > 0) {
-        queryFragments << QString("%1 in (%2)")
-                .arg(m_idColumn, idStrings.join(","));
+    if (!trackIdsSql.isEmpty()) {
+        queryFragments << QString("%1 in (%2)").arg(m_idColumn, trackIdsSql);
     }
 
-    const std::unique_ptr<QueryNode> pQuery =
-            m_pQueryParser->parseQuery(
-                    searchQuery,
-                    queryFragments.join(" AND "));
+    *pQueryNode = m_pQueryParser->parseQuery(
+            searchQuery,
+            queryFragments.join(" AND "));
 
-    QString filter = pQuery->toSql();
+    QString filter = (*pQueryNode)->toSql();
     if (!filter.isEmpty()) {
         filter.prepend("WHERE ");
     }
@@ -490,35 +660,46 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
     if (sDebug) {
         qDebug() << this << "select() executing:" << queryString;
     }
+    return queryString;
+}
 
-    QSqlQuery query(m_database);
+// static
+QVector<TrackId> BaseTrackCache::selectTrackIds(
+        const QSqlDatabase& database,
+        const QString& queryString) {
+    QSqlQuery query(database);
     // This causes a memory savings since QSqlCachedResult (what QtSQLite uses)
     // won't allocate a giant in-memory table that we won't use at all.
     query.setForwardOnly(true);
     query.prepare(queryString);
 
+    QVector<TrackId> trackOrder;
     if (!query.exec()) {
         LOG_FAILED_QUERY(query);
+        return trackOrder;
     }
+    while (query.next()) {
+        trackOrder.append(TrackId(query.value(0)));
+    }
+    return trackOrder;
+}
 
-    int idColumn = query.record().indexOf(m_idColumn);
-    int rows = query.size();
-
+void BaseTrackCache::mergeFilteredTracks(QVector<TrackId> trackOrder,
+        const QSet<TrackId>& trackIds,
+        const QString& searchQuery,
+        const QueryNode& queryNode,
+        const QList<SortColumn>& sortColumns,
+        const int columnOffset,
+        QHash<TrackId, int>* trackToIndex) {
     if (sDebug) {
-        qDebug() << "Rows returned:" << rows;
+        qDebug() << "Rows returned:" << trackOrder.size();
     }
 
-    m_trackOrder.resize(0); // keeps allocated memory
+    m_trackOrder = std::move(trackOrder);
     trackToIndex->clear();
-    if (rows > 0) {
-        trackToIndex->reserve(rows);
-        m_trackOrder.reserve(rows);
-    }
-
-    while (query.next()) {
-        TrackId trackId(query.value(idColumn));
-        (*trackToIndex)[trackId] = m_trackOrder.size();
-        m_trackOrder.append(trackId);
+    trackToIndex->reserve(m_trackOrder.size());
+    for (int i = 0; i < m_trackOrder.size(); ++i) {
+        trackToIndex->insert(m_trackOrder[i], i);
     }
 
     // At this point, the original set of tracks have been divided into two
@@ -527,14 +708,48 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
     // either category that are there incorrectly. We must look at all the dirty
     // tracks (within the original set, if specified) and evaluate whether they
     // would match or not match the given filter criteria. Once we correct the
-    // membership of tracks in either set, we must then insertion-sort the
-    // missing tracks into the resulting index list.
+    // membership of tracks in either set, we must then merge the missing
+    // tracks into the resulting index list.
 
-    if (!m_bIsCaching || dirtyTracks.isEmpty()) {
+    if (!m_bIsCaching) {
         return;
     }
 
-    for (TrackId trackId : std::as_const(dirtyTracks)) {
+    QSet<TrackId> dirtyTracks;
+    for (const auto& trackId : trackIds) {
+        if (m_dirtyTracks.contains(trackId)) {
+            dirtyTracks.insert(trackId);
+        }
+    }
+    if (dirtyTracks.isEmpty()) {
+        return;
+    }
+
+    insertDirtyTracks(dirtyTracks,
+            searchQuery,
+            queryNode,
+            sortColumns,
+            columnOffset,
+            trackToIndex);
+}
+
+void BaseTrackCache::insertDirtyTracks(const QSet<TrackId>& dirtyTracks,
+        const QString& searchQuery,
+        const QueryNode& query,
+        const QList<SortColumn>& sortColumns,
+        const int columnOffset,
+        QHash<TrackId, int>* trackToIndex) {
+    struct DirtyTrack {
+        TrackId trackId;
+        SortKey sortKey;
+    };
+    std::vector<DirtyTrack> insertTracks;
+    QSet<TrackId> removeTracks;
+
+    // The matching needs to be done on this thread, because some query nodes
+    // lazily query the database, and the database connection must not be used
+    // from other threads.
+    for (TrackId trackId : dirtyTracks) {
         // Only get the track if it is in the cache. Tracks that
         // are not cached in memory cannot be dirty.
         TrackPointer pTrack = getRecentTrack(trackId);
@@ -543,174 +758,184 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
             continue;
         }
 
+        // Remove the track from the results first, if it should be in the
+        // result set it is inserted again at its proper position below.
+        if (trackToIndex->contains(trackId)) {
+            removeTracks.insert(trackId);
+        }
+
         // The track should be in the result set if the search is empty or the
         // track matches the search.
-        bool shouldBeInResultSet = searchQuery.isEmpty() ||
-                pQuery->match(pTrack);
-
-        // If the track is in this result set.
-        bool isInResultSet = trackToIndex->contains(trackId);
+        if (searchQuery.isEmpty() || query.match(pTrack)) {
+            insertTracks.push_back(DirtyTrack{
+                    trackId, trackSortKey(pTrack, sortColumns, columnOffset)});
+        }
+    }
 
-        if (shouldBeInResultSet) {
-            // Track should be in result set...
+    if (removeTracks.isEmpty() && insertTracks.empty()) {
+        return;
+    }
 
-            // Remove the track from the results first (we have to do this or it
-            // will sort wrong).
-            if (isInResultSet) {
-                int index = (*trackToIndex)[trackId];
-                m_trackOrder.remove(index);
-                // Don't update trackToIndex, since we do it below.
+    if (!removeTracks.isEmpty()) {
+        m_trackOrder.erase(std::remove_if(m_trackOrder.begin(),
+                                   m_trackOrder.end(),
+                                   [&removeTracks](TrackId trackId) {
+                                       return removeTracks.contains(trackId);
+                                   }),
+                m_trackOrder.end());
+    }
+
+    // Sort the dirty tracks by their precomputed keys. Then each one can be
+    // placed with a binary search that starts where the previous one was
+    // inserted, and all of them are merged into the result in a single pass.
+    // Dirty tracks with equal keys are ordered by their id, otherwise their
+    // order would depend on the iteration order of the set.
+    std::sort(insertTracks.begin(),
+            insertTracks.end(),
+            [this, &sortColumns](const DirtyTrack& track1, const DirtyTrack& track2) {
+                const int result = compareSortKeys(
+                        sortColumns, track1.sortKey, track2.sortKey);
+                if (result != 0) {
+                    return result < 0;
+                }
+                return track1.trackId < track2.trackId;
+            });
+
+    // The binary searches of consecutive tracks visit the same rows over
+    // and over, so the sort keys of the rows are cached.
+    QHash<int, SortKey> rowSortKeys;
+    const auto rowSortKey = [&](int row) -> const SortKey& {
+        auto it = rowSortKeys.find(row);
+        if (it == rowSortKeys.end()) {
+            it = rowSortKeys.insert(row,
+                    cachedSortKey(m_trackOrder[row], sortColumns, columnOffset));
+        }
+        return it.value();
+    };
+
+    QVector<TrackId> mergedOrder;
+    mergedOrder.reserve(m_trackOrder.size() + static_cast<int>(insertTracks.size()));
+    int nextRow = 0;
+    for (const auto& dirtyTrack : insertTracks) {
+        int min = nextRow;
+        int max = m_trackOrder.size();
+        while (min < max) {
+            const int mid = min + (max - min) / 2;
+            if (compareSortKeys(sortColumns, dirtyTrack.sortKey, rowSortKey(mid)) > 0) {
+                min = mid + 1;
+            } else {
+                max = mid;
             }
+        }
+        if (sDebug) {
+            qDebug() << this << "Merge sort says" << dirtyTrack.trackId
+                     << "should be inserted at:" << min;
+        }
+        for (; nextRow < min; ++nextRow) {
+            mergedOrder.append(m_trackOrder[nextRow]);
+        }
+        mergedOrder.append(dirtyTrack.trackId);
+    }
+    for (; nextRow < m_trackOrder.size(); ++nextRow) {
+        mergedOrder.append(m_trackOrder[nextRow]);
+    }
+    m_trackOrder.swap(mergedOrder);
 
-            // Figure out where it is supposed to sort. The table is sorted by
-            // the sort column, so we can binary search.
-            int insertRow = findSortInsertionPoint(
-                    pTrack, sortColumns, columnOffset, m_trackOrder);
-
-            if (sDebug) {
-                qDebug() << this
-                         << "Insertion sort says it should be inserted at:"
-                         << insertRow;
-            }
+    trackToIndex->clear();
+    trackToIndex->reserve(m_trackOrder.size());
+    for (int i = 0; i < m_trackOrder.size(); ++i) {
+        trackToIndex->insert(m_trackOrder[i], i);
+    }
+}
 
-            // The track should sort at insertRow
-            m_trackOrder.insert(insertRow, trackId);
+bool BaseTrackCache::isNumericSortColumn(int column) const {
+    return column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_YEAR) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TRACKNUMBER) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_DURATION) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BITRATE) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BPM) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_REPLAYGAIN) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_SAMPLERATE) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_CHANNELS) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TIMESPLAYED) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_RATING) ||
+            column == fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION);
+}
 
-            trackToIndex->clear();
-            // Fix the index. TODO(rryan) find a non-stupid way to do this.
-            for (int i = 0; i < m_trackOrder.size(); ++i) {
-                (*trackToIndex)[m_trackOrder[i]] = i;
-            }
-        } else if (isInResultSet) {
-            // Track should not be in this result set, but it is. We need to
-            // remove it.
-            int index = (*trackToIndex)[trackId];
-            m_trackOrder.remove(index);
-
-            trackToIndex->clear();
-            // Fix the index. TODO(rryan) find a non-stupid way to do this.
-            for (int i = 0; i < m_trackOrder.size(); ++i) {
-                (*trackToIndex)[m_trackOrder[i]] = i;
-            }
-        }
+BaseTrackCache::ColumnSortKey BaseTrackCache::columnSortKey(
+        int column, const QVariant& value) const {
+    ColumnSortKey key;
+    if (isNumericSortColumn(column)) {
+        // Sort as floats.
+        key.number = value.toDouble();
+    } else if (column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY)) {
+        key.number = KeyUtils::keyToCircleOfFifthsOrder(
+                KeyUtils::guessKeyFromText(value.toString()),
+                m_columnCache.keyNotation());
+    } else {
+        key.text = value.toString();
     }
+    return key;
 }
 
-int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
+BaseTrackCache::SortKey BaseTrackCache::trackSortKey(const TrackPointer& pTrack,
         const QList<SortColumn>& sortColumns,
-        const int columnOffset,
-        const QVector<TrackId>& trackIds) const {
-    QList<QVariant> trackValues;
-    if (sortColumns.isEmpty()) {
-        return 0;
-    }
-    for (const auto& sc: sortColumns) {
+        const int columnOffset) const {
+    SortKey sortKey;
+    sortKey.reserve(sortColumns.size());
+    for (const auto& sc : sortColumns) {
+        const int column = sc.m_column - columnOffset;
         QVariant trackValue;
-        getTrackValueForColumn(pTrack, sc.m_column - columnOffset, trackValue);
-        trackValues.append(trackValue);
-    }
-
-    int min = 0;
-    int max = trackIds.size() - 1;
-
-    if (sDebug) {
-        qDebug() << this << "Trying to insertion sort:"
-                 << trackValues.at(0) << "min" << min << "max" << max;
+        getTrackValueForColumn(pTrack, column, trackValue);
+        sortKey.append(columnSortKey(column, trackValue));
     }
+    return sortKey;
+}
 
-    // If trackIds is empty, min is 0 and max is -1 so findSortInsertionPoint
-    // returns 0.
-    while (min <= max) {
-        int mid = min + (max - min) / 2;
-        TrackId otherTrackId(trackIds[mid]);
-
-        // This should not happen, but it's a recoverable error so we should
-        // only log it.
-        if (!m_trackInfo.contains(otherTrackId)) {
-            qDebug() << "WARNING: track" << otherTrackId << "was not in index";
-            //updateTrackInIndex(otherTrackId);
-        }
-
-        int compare = 0;
-        for (int i = 0; i < sortColumns.count(); i++) {
-            QVariant tableValue =
-                    data(otherTrackId, sortColumns[i].m_column - columnOffset);
-
-            compare = compareColumnValues(
-                    sortColumns[i].m_column - columnOffset,
-                    sortColumns[i].m_order,
-                    trackValues[i],
-                    tableValue);
+BaseTrackCache::SortKey BaseTrackCache::cachedSortKey(TrackId trackId,
+        const QList<SortColumn>& sortColumns,
+        const int columnOffset) const {
+    // This should not happen, but it's a recoverable error so we should
+    // only log it.
+    if (!m_trackInfo.contains(trackId)) {
+        qDebug() << "WARNING: track" << trackId << "was not in index";
+    }
+    SortKey sortKey;
+    sortKey.reserve(sortColumns.size());
+    for (const auto& sc : sortColumns) {
+        const int column = sc.m_column - columnOffset;
+        sortKey.append(columnSortKey(column, data(trackId, column)));
+    }
+    return sortKey;
+}
 
-            if (compare != 0) {
-                break;
+int BaseTrackCache::compareSortKeys(const QList<SortColumn>& sortColumns,
+        const SortKey& key1,
+        const SortKey& key2) const {
+    for (int i = 0; i < sortColumns.size(); ++i) {
+        const ColumnSortKey& value1 = key1[i];
+        const ColumnSortKey& value2 = key2[i];
+        int result = 0;
+        if (value1.text && value2.text) {
+            result = m_collator.compare(*value1.text, *value2.text);
+        } else {
+            const double delta = value1.number - value2.number;
+            if (fabs(delta) < .00001) {
+                result = 0;
+            } else if (delta > 0.0) {
+                result = 1;
+            } else {
+                result = -1;
             }
         }
 
-        if (compare == 0) {
-            // Alright, if we're here then we can insert it here and be
-            // "correct"
-            min = mid;
-            break;
-        } else if (compare > 0) {
-            min = mid + 1;
-        } else {
-            max = mid - 1;
+        // If we're in descending order, flip the comparison.
+        if (sortColumns[i].m_order == Qt::DescendingOrder) {
+            result = -result;
         }
-    }
-    return min;
-}
-
-int BaseTrackCache::compareColumnValues(int sortColumn,
-        Qt::SortOrder sortOrder,
-        const QVariant& val1,
-        const QVariant& val2) const {
-    int result = 0;
-
-    if (sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_YEAR) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TRACKNUMBER) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_DURATION) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BITRATE) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BPM) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_REPLAYGAIN) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_SAMPLERATE) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_CHANNELS) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TIMESPLAYED) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_RATING) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION)
-    ) {
-        // Sort as floats.
-        double delta = val1.toDouble() - val2.toDouble();
-
-        if (fabs(delta) < .00001) {
-            result = 0;
-        } else if (delta > 0.0) {
-            result = 1;
-        } else {
-            result = -1;
+        if (result != 0) {
+            return result;
         }
-    } else if (sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY)) {
-        KeyUtils::KeyNotation keyNotation = m_columnCache.keyNotation();
-
-        int key1 = KeyUtils::keyToCircleOfFifthsOrder(
-            KeyUtils::guessKeyFromText(val1.toString()), keyNotation);
-        int key2 = KeyUtils::keyToCircleOfFifthsOrder(
-            KeyUtils::guessKeyFromText(val2.toString()), keyNotation);
-        if (key1 > key2) {
-            result = 1;
-        } else if (key1 < key2) {
-            result = -1;
-        } else if (key1 == key2) {
-            result = 0;
-        }
-    } else {
-        result = m_collator.compare(val1.toString(), val2.toString());
     }
-
-    // If we're in descending order, flip the comparison.
-    if (sortOrder == Qt::DescendingOrder) {
-        result = -result;
-    }
-
-    return result;
+    return 0;
 }
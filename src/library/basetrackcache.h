@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QFutureWatcher>
 #include <QHash>
 #include <QList>
 #include <QObject>
@@ -9,16 +10,25 @@
 #include <QStringList>
 #include <QVector>
 #include <memory>
+#include <optional>
 
 #include "library/columncache.h"
+#include "library/columnartrackstore.h"
 #include "track/track_decl.h"
 #include "track/trackid.h"
 #include "util/class.h"
 #include "util/string.h"
 
+class QueryNode;
 class SearchQueryParser;
 class TrackCollection;
 
+namespace mixxx {
+
+class DbQueryExecutor;
+
+} // namespace mixxx
+
 class SortColumn {
   public:
     SortColumn(int column, Qt::SortOrder order)
@@ -54,6 +64,27 @@ class BaseTrackCache : public QObject {
     // expensive on large tables.
     virtual void buildIndex();
 
+    /// Use the full-text index of the library for text searches. Only
+    /// applicable if the table is a view of the library table.
+    void setUseFullTextIndex(bool useFullTextIndex);
+
+    /// Build and update the index on the connection of the query executor
+    /// instead of blocking the caller. Only applicable if the table is
+    /// visible from that connection, i.e. not a temporary table, and if
+    /// reading doesn't block writers, i.e. with write-ahead logging.
+    void setQueryExecutor(mixxx::DbQueryExecutor* pQueryExecutor);
+    bool canQueryInBackground() const {
+        return m_pQueryExecutor != nullptr;
+    }
+    const QString& tableName() const {
+        return m_tableName;
+    }
+    /// The definition of the table if it is a temporary view that needs
+    /// to be created on the connection of the query executor.
+    const QString& tableViewSql() const {
+        return m_tableViewSql;
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     // Data access methods
     ////////////////////////////////////////////////////////////////////////////
@@ -71,12 +102,37 @@ class BaseTrackCache : public QObject {
                                const QList<SortColumn>& sortColumns,
                                const int columnOffset,
                                QHash<TrackId, int>* trackToIndex);
+
+    /// The query of filterAndSort() that selects the ids of all tracks
+    /// matching the filter in order. Only tracks with an id in trackIdsSql,
+    /// either a list of ids or a subquery, are considered. The query can be
+    /// executed on another connection with selectTrackIds() and the result
+    /// is then passed on to mergeFilteredTracks() together with the parsed
+    /// search query.
+    QString filterQuery(const QString& trackIdsSql,
+            const QString& searchQuery,
+            const QString& extraFilter,
+            const QString& orderByClause,
+            std::unique_ptr<QueryNode>* pQueryNode);
+    static QVector<TrackId> selectTrackIds(
+            const QSqlDatabase& database,
+            const QString& queryString);
+    void mergeFilteredTracks(QVector<TrackId> trackOrder,
+            const QSet<TrackId>& trackIds,
+            const QString& searchQuery,
+            const QueryNode& queryNode,
+            const QList<SortColumn>& sortColumns,
+            const int columnOffset,
+            QHash<TrackId, int>* trackToIndex);
+
     virtual bool isCached(TrackId trackId) const;
     virtual void ensureCached(TrackId trackId);
     virtual void ensureCached(const QSet<TrackId>& trackIds);
 
   signals:
     void tracksChanged(const QSet<TrackId>& trackIds);
+    /// The index has been built in the background
+    void indexBuilt();
 
   public slots:
     void slotScanTrackAdded(TrackPointer pTrack);
@@ -93,20 +149,48 @@ class BaseTrackCache : public QObject {
     void resetRecentTrack() const;
 
     bool updateIndexWithQuery(const QString& query);
+    static bool selectIndexRows(const QSqlDatabase& database,
+            const QString& queryString,
+            const QString& idColumn,
+            int locationColumn,
+            ColumnarTrackStore* pTrackInfo);
+    typedef QFutureWatcher<std::shared_ptr<ColumnarTrackStore>> IndexRowsWatcher;
+    IndexRowsWatcher* updateIndexInBackground(const QString& queryString,
+            const QSet<TrackId>& trackIds);
+    void onIndexRowsSelected(IndexRowsWatcher* pWatcher,
+            const QSet<TrackId>& trackIds);
     void updateTrackInIndex(TrackId trackId);
     bool updateTrackInIndex(const TrackPointer& pTrack);
     void updateTracksInIndex(const QSet<TrackId>& trackIds);
     void getTrackValueForColumn(TrackPointer pTrack, int column,
                                 QVariant& trackValue) const;
 
-    int findSortInsertionPoint(TrackPointer pTrack,
-                               const QList<SortColumn>& sortColumns,
-                               const int columnOffset,
-                               const QVector<TrackId>& trackIds) const;
-    int compareColumnValues(int sortColumn,
-            Qt::SortOrder sortOrder,
-            const QVariant& val1,
-            const QVariant& val2) const;
+    // The value of a single sort column, converted once instead of for
+    // every comparison. Strings are compared with m_collator, because
+    // QCollatorSortKey ignores its case insensitivity on some platforms.
+    struct ColumnSortKey {
+        double number = 0.0;
+        std::optional<QString> text;
+    };
+    using SortKey = QVector<ColumnSortKey>;
+
+    void insertDirtyTracks(const QSet<TrackId>& dirtyTracks,
+            const QString& searchQuery,
+            const QueryNode& query,
+            const QList<SortColumn>& sortColumns,
+            const int columnOffset,
+            QHash<TrackId, int>* trackToIndex);
+    bool isNumericSortColumn(int column) const;
+    ColumnSortKey columnSortKey(int column, const QVariant& value) const;
+    SortKey trackSortKey(const TrackPointer& pTrack,
+            const QList<SortColumn>& sortColumns,
+            const int columnOffset) const;
+    SortKey cachedSortKey(TrackId trackId,
+            const QList<SortColumn>& sortColumns,
+            const int columnOffset) const;
+    int compareSortKeys(const QList<SortColumn>& sortColumns,
+            const SortKey& key1,
+            const SortKey& key2) const;
     bool trackMatches(const TrackPointer& pTrack,
             const QRegularExpression& matcher) const;
     bool trackMatchesNumeric(const TrackPointer& pTrack,
@@ -144,8 +228,17 @@ class BaseTrackCache : public QObject {
 
     bool m_bIndexBuilt;
     bool m_bIsCaching;
-    QHash<TrackId, QVector<QVariant>> m_trackInfo;
+    ColumnarTrackStore m_trackInfo;
     QSqlDatabase m_database;
 
+    mixxx::DbQueryExecutor* m_pQueryExecutor;
+    QString m_tableViewSql;
+    // The pending query that builds the index in the background
+    IndexRowsWatcher* m_pIndexWatcher;
+    // Removals that the pending index might not reflect yet
+    QSet<TrackId> m_tracksRemovedWhileBuildingIndex;
+    // Tracks that are requested by ensureCached() in the background
+    QSet<TrackId> m_tracksBeingCached;
+
     DISALLOW_COPY_AND_ASSIGN(BaseTrackCache);
 };
@@ -0,0 +1,312 @@
+#include "library/columnartrackstore.h"
+
+#include "util/assert.h"
+
+void ColumnarTrackStore::Column::appendRow() {
+    m_states.push_back(State::Invalid);
+    switch (m_storage) {
+    case Storage::Empty:
+        break;
+    case Storage::Integer:
+        m_integers.push_back(0);
+        break;
+    case Storage::Double:
+        m_doubles.push_back(0.0);
+        break;
+    case Storage::String:
+        m_stringIndices.push_back(0);
+        break;
+    case Storage::Variant:
+        m_variants.emplace_back();
+        break;
+    }
+}
+
+void ColumnarTrackStore::Column::moveRow(int from, int to) {
+    m_states[to] = m_states[from];
+    switch (m_storage) {
+    case Storage::Empty:
+        break;
+    case Storage::Integer:
+        m_integers[to] = m_integers[from];
+        break;
+    case Storage::Double:
+        m_doubles[to] = m_doubles[from];
+        break;
+    case Storage::String:
+        m_stringIndices[to] = m_stringIndices[from];
+        break;
+    case Storage::Variant:
+        m_variants[to] = std::move(m_variants[from]);
+        break;
+    }
+}
+
+void ColumnarTrackStore::Column::removeLastRow() {
+    m_states.pop_back();
+    switch (m_storage) {
+    case Storage::Empty:
+        break;
+    case Storage::Integer:
+        m_integers.pop_back();
+        break;
+    case Storage::Double:
+        m_doubles.pop_back();
+        break;
+    case Storage::String:
+        m_stringIndices.pop_back();
+        break;
+    case Storage::Variant:
+        m_variants.pop_back();
+        break;
+    }
+}
+
+void ColumnarTrackStore::Column::clear() {
+    // Release the memory, the number of rows is usually very different
+    // after the index has been rebuilt.
+    *this = Column();
+}
+
+ColumnarTrackStore::ColumnarTrackStore(int columnCount)
+        : m_columns(columnCount) {
+}
+
+void ColumnarTrackStore::clear() {
+    for (auto& column : m_columns) {
+        column.clear();
+    }
+    m_trackIds = std::vector<TrackId>();
+    m_rows.clear();
+    m_strings = std::vector<InternedString>();
+    m_freeStringIndices = std::vector<quint32>();
+    m_stringIndices.clear();
+}
+
+int ColumnarTrackStore::insertRow(TrackId trackId) {
+    DEBUG_ASSERT(trackId.isValid());
+    const auto it = m_rows.constFind(trackId);
+    if (it != m_rows.constEnd()) {
+        return it.value();
+    }
+    const int row = rowCount();
+    m_trackIds.push_back(trackId);
+    m_rows.insert(trackId, row);
+    for (auto& column : m_columns) {
+        column.appendRow();
+    }
+    return row;
+}
+
+void ColumnarTrackStore::removeRow(TrackId trackId) {
+    const auto it = m_rows.find(trackId);
+    if (it == m_rows.end()) {
+        return;
+    }
+    const int row = it.value();
+    m_rows.erase(it);
+    for (const auto& column : m_columns) {
+        releaseValue(column, row);
+    }
+    const int lastRow = rowCount() - 1;
+    if (row != lastRow) {
+        for (auto& column : m_columns) {
+            column.moveRow(lastRow, row);
+        }
+        m_trackIds[row] = m_trackIds[lastRow];
+        m_rows[m_trackIds[row]] = row;
+    }
+    for (auto& column : m_columns) {
+        column.removeLastRow();
+    }
+    m_trackIds.pop_back();
+}
+
+// static
+ColumnarTrackStore::Storage ColumnarTrackStore::storageForType(int typeId) {
+    switch (typeId) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+        return Storage::Integer;
+    case QMetaType::Double:
+        return Storage::Double;
+    case QMetaType::QString:
+        return Storage::String;
+    default:
+        return Storage::Variant;
+    }
+}
+
+// static
+ColumnarTrackStore::Column::State ColumnarTrackStore::stateForType(int typeId) {
+    switch (typeId) {
+    case QMetaType::Bool:
+        return Column::State::Bool;
+    case QMetaType::Int:
+        return Column::State::Int;
+    case QMetaType::UInt:
+        return Column::State::UInt;
+    case QMetaType::LongLong:
+        return Column::State::LongLong;
+    default:
+        return Column::State::Value;
+    }
+}
+
+QVariant ColumnarTrackStore::value(int row, int column) const {
+    const Column& col = m_columns[column];
+    switch (col.m_states[row]) {
+    case Column::State::Invalid:
+        return QVariant();
+    case Column::State::NullString:
+        // This is how the SQLite driver returns NULL values
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        return QVariant(QMetaType::fromType<QString>());
+#else
+        return QVariant(QVariant::String);
+#endif
+    default:
+        return typedValue(col, row);
+    }
+}
+
+QVariant ColumnarTrackStore::typedValue(const Column& column, int row) const {
+    switch (column.m_storage) {
+    case Storage::Empty:
+        break;
+    case Storage::Integer:
+        switch (column.m_states[row]) {
+        case Column::State::Bool:
+            return QVariant(column.m_integers[row] != 0);
+        case Column::State::Int:
+            return QVariant(static_cast<int>(column.m_integers[row]));
+        case Column::State::UInt:
+            return QVariant(static_cast<uint>(column.m_integers[row]));
+        default:
+            DEBUG_ASSERT(column.m_states[row] == Column::State::LongLong);
+            return QVariant(static_cast<qlonglong>(column.m_integers[row]));
+        }
+    case Storage::Double:
+        return QVariant(column.m_doubles[row]);
+    case Storage::String:
+        return QVariant(m_strings[column.m_stringIndices[row]].string);
+    case Storage::Variant:
+        return column.m_variants[row];
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return QVariant();
+}
+
+void ColumnarTrackStore::setValue(int row, int column, const QVariant& value) {
+    Column& col = m_columns[column];
+    releaseValue(col, row);
+    col.m_states[row] = Column::State::Invalid;
+    if (!value.isValid()) {
+        col.m_states[row] = Column::State::Invalid;
+        return;
+    }
+    const int typeId = value.userType();
+    if (typeId == QMetaType::QString && value.isNull()) {
+        col.m_states[row] = Column::State::NullString;
+        return;
+    }
+
+    const Storage storage = storageForType(typeId);
+    if (col.m_storage == Storage::Empty) {
+        // The first value determines the storage of the column
+        col.m_storage = storage;
+        const std::size_t rows = col.m_states.size();
+        switch (col.m_storage) {
+        case Storage::Empty:
+            break;
+        case Storage::Integer:
+            col.m_integers.resize(rows);
+            break;
+        case Storage::Double:
+            col.m_doubles.resize(rows);
+            break;
+        case Storage::String:
+            col.m_stringIndices.resize(rows);
+            break;
+        case Storage::Variant:
+            col.m_variants.resize(rows);
+            break;
+        }
+    } else if (col.m_storage != storage) {
+        convertToVariants(&col);
+    }
+
+    switch (col.m_storage) {
+    case Storage::Empty:
+        DEBUG_ASSERT(!"unreachable");
+        return;
+    case Storage::Integer:
+        col.m_integers[row] = value.toLongLong();
+        break;
+    case Storage::Double:
+        col.m_doubles[row] = value.toDouble();
+        break;
+    case Storage::String:
+        col.m_stringIndices[row] = intern(value.toString());
+        break;
+    case Storage::Variant:
+        col.m_variants[row] = value;
+        col.m_states[row] = Column::State::Value;
+        return;
+    }
+    col.m_states[row] = stateForType(typeId);
+}
+
+void ColumnarTrackStore::convertToVariants(Column* pColumn) {
+    std::vector<QVariant> variants(pColumn->m_states.size());
+    for (std::size_t row = 0; row < variants.size(); ++row) {
+        if (pColumn->hasValue(static_cast<int>(row))) {
+            variants[row] = typedValue(*pColumn, static_cast<int>(row));
+            releaseValue(*pColumn, static_cast<int>(row));
+            pColumn->m_states[row] = Column::State::Value;
+        }
+    }
+    pColumn->m_integers = std::vector<qint64>();
+    pColumn->m_doubles = std::vector<double>();
+    pColumn->m_stringIndices = std::vector<quint32>();
+    pColumn->m_variants = std::move(variants);
+    pColumn->m_storage = Storage::Variant;
+}
+
+void ColumnarTrackStore::releaseValue(const Column& column, int row) {
+    if (column.m_storage == Storage::String && column.hasValue(row)) {
+        release(column.m_stringIndices[row]);
+    }
+}
+
+quint32 ColumnarTrackStore::intern(const QString& string) {
+    const auto it = m_stringIndices.constFind(string);
+    if (it != m_stringIndices.constEnd()) {
+        ++m_strings[it.value()].refCount;
+        return it.value();
+    }
+    quint32 index;
+    if (m_freeStringIndices.empty()) {
+        index = static_cast<quint32>(m_strings.size());
+        m_strings.push_back(InternedString{string, 1});
+    } else {
+        index = m_freeStringIndices.back();
+        m_freeStringIndices.pop_back();
+        m_strings[index] = InternedString{string, 1};
+    }
+    m_stringIndices.insert(string, index);
+    return index;
+}
+
+void ColumnarTrackStore::release(quint32 index) {
+    InternedString& interned = m_strings[index];
+    DEBUG_ASSERT(interned.refCount > 0);
+    if (--interned.refCount > 0) {
+        return;
+    }
+    m_stringIndices.remove(interned.string);
+    interned.string = QString();
+    m_freeStringIndices.push_back(index);
+}
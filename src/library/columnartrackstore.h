@@ -0,0 +1,132 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <vector>
+
+#include "track/trackid.h"
+
+/// Column-oriented storage of the track fields cached by BaseTrackCache.
+///
+/// Storing a QVector<QVariant> per track needs one heap allocation per
+/// track plus one QVariant and usually one string per field. Here each
+/// column keeps its values in a contiguous array of the column's type
+/// instead. Integer and floating point values are stored unboxed, strings
+/// are interned in a reference counted pool that is shared by all columns.
+/// Rows are dense: removing a track moves the last row into the freed slot.
+///
+/// A column adopts the storage for the type of the first value that is
+/// stored in it. If a value that doesn't fit is stored later, the column
+/// falls back to storing QVariants. Values are returned with the same type
+/// they were stored with.
+class ColumnarTrackStore {
+  public:
+    enum class Storage {
+        Empty,
+        Integer,
+        Double,
+        String,
+        Variant,
+    };
+
+    explicit ColumnarTrackStore(int columnCount = 0);
+
+    int columnCount() const {
+        return static_cast<int>(m_columns.size());
+    }
+    int rowCount() const {
+        return static_cast<int>(m_trackIds.size());
+    }
+
+    /// Removes all rows and all interned strings.
+    void clear();
+
+    bool contains(TrackId trackId) const {
+        return m_rows.contains(trackId);
+    }
+    /// Returns -1 if the track is not stored.
+    int row(TrackId trackId) const {
+        return m_rows.value(trackId, -1);
+    }
+    TrackId trackIdAt(int row) const {
+        return m_trackIds[row];
+    }
+
+    /// Returns the row of the track, appending a new row with invalid
+    /// values if it is not stored yet.
+    int insertRow(TrackId trackId);
+    void removeRow(TrackId trackId);
+
+    QVariant value(int row, int column) const;
+    void setValue(int row, int column, const QVariant& value);
+
+    /// The storage the column has adopted, for diagnostics.
+    Storage columnStorage(int column) const {
+        return m_columns[column].m_storage;
+    }
+    /// The number of distinct strings that are currently stored,
+    /// for diagnostics.
+    int internedStringCount() const {
+        return m_stringIndices.size();
+    }
+
+  private:
+    class Column {
+      public:
+        // The integer states remember the type of integer values, so
+        // they can be returned with the type they were stored with.
+        enum class State : quint8 {
+            Invalid,
+            NullString,
+            Value,
+            Bool,
+            Int,
+            UInt,
+            LongLong,
+        };
+
+        /// False if the value is invalid or a null SQL value.
+        bool hasValue(int row) const {
+            return m_states[row] >= State::Value;
+        }
+
+        void appendRow();
+        void moveRow(int from, int to);
+        void removeLastRow();
+        void clear();
+
+        Storage m_storage = Storage::Empty;
+        std::vector<State> m_states;
+        // Only one of these is used, depending on m_storage
+        std::vector<qint64> m_integers;
+        std::vector<double> m_doubles;
+        std::vector<quint32> m_stringIndices;
+        std::vector<QVariant> m_variants;
+    };
+
+    struct InternedString {
+        QString string;
+        // The number of values that refer to the string
+        int refCount;
+    };
+
+    static Storage storageForType(int typeId);
+    static Column::State stateForType(int typeId);
+    QVariant typedValue(const Column& column, int row) const;
+    void convertToVariants(Column* pColumn);
+    /// Releases the interned string of the value, if any.
+    void releaseValue(const Column& column, int row);
+    quint32 intern(const QString& string);
+    void release(quint32 index);
+
+    std::vector<Column> m_columns;
+    std::vector<TrackId> m_trackIds;
+    QHash<TrackId, int> m_rows;
+
+    // Slots of released strings are reused by the next interned string
+    std::vector<InternedString> m_strings;
+    std::vector<quint32> m_freeStringIndices;
+    QHash<QString, quint32> m_stringIndices;
+};
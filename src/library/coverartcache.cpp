@@ -2,9 +2,12 @@
 
 #include <QFutureWatcher>
 #include <QPixmapCache>
+#include <QThread>
 #include <QtConcurrentRun>
 #include <QtDebug>
+#include <algorithm>
 
+#include "library/coverartdiskcache.h"
 #include "moc_coverartcache.cpp"
 #include "track/track.h"
 #include "util/logger.h"
@@ -27,9 +30,42 @@ inline QImage resizeImageWidth(const QImage& image, int width) {
     return image.scaledToWidth(width, kTransformationMode);
 }
 
+// Least recently used thumbnails are deleted at startup when exceeded
+constexpr qint64 kMaxDiskCacheSizeBytes = 256 * 1024 * 1024;
+
+enum LoadStateValue {
+    kLoadPending = 0,
+    kLoadStarted = 1,
+    kLoadCanceled = 2,
+};
+
+int loaderThreadCount() {
+    return std::clamp(QThread::idealThreadCount() / 2, 1, 4);
+}
+
 } // anonymous namespace
 
-CoverArtCache::CoverArtCache() {
+CoverArtCache::CoverArtCache(
+        const QString& diskCacheDirectoryPath) {
+    m_loaderThreadPool.setObjectName(QStringLiteral("CoverArtCache"));
+    m_loaderThreadPool.setMaxThreadCount(loaderThreadCount());
+    if (!diskCacheDirectoryPath.isEmpty()) {
+        auto pDiskCache = std::make_shared<const CoverArtDiskCache>(
+                diskCacheDirectoryPath, kMaxDiskCacheSizeBytes);
+        QtConcurrent::run(&m_loaderThreadPool, [pDiskCache] {
+            pDiskCache->prune();
+        });
+        m_pDiskCache = std::move(pDiskCache);
+    }
+}
+
+CoverArtCache::~CoverArtCache() {
+    // Skip all loads that have not been started yet before waiting
+    // for the remaining ones
+    for (const auto& pLoadState : std::as_const(m_runningLoads)) {
+        pLoadState->testAndSetOrdered(kLoadPending, kLoadCanceled);
+    }
+    m_loaderThreadPool.waitForDone();
 }
 
 //static
@@ -131,6 +167,43 @@ void CoverArtCache::requestUncachedCover(
             desiredWidth);
 }
 
+// static
+void CoverArtCache::cancelUncachedCover(
+        const QObject* pRequester,
+        mixxx::cache_key_t requestedCacheKey) {
+    CoverArtCache* pCache = CoverArtCache::instance();
+    VERIFY_OR_DEBUG_ASSERT(pCache) {
+        return;
+    }
+    pCache->cancelRequest(
+            pRequester,
+            requestedCacheKey);
+}
+
+void CoverArtCache::cancelRequest(
+        const QObject* pRequester,
+        mixxx::cache_key_t requestedCacheKey) {
+    auto i = m_runningRequests.find(requestedCacheKey);
+    while (i != m_runningRequests.end() && i.key() == requestedCacheKey) {
+        if (i.value().pRequester == pRequester) {
+            i = m_runningRequests.erase(i);
+        } else {
+            ++i;
+        }
+    }
+    if (m_runningRequests.contains(requestedCacheKey)) {
+        return;
+    }
+    const LoadState pLoadState = m_runningLoads.value(requestedCacheKey);
+    if (pLoadState && pLoadState->testAndSetOrdered(kLoadPending, kLoadCanceled)) {
+        if (kLogger.traceEnabled()) {
+            kLogger.trace()
+                    << "cancelRequest skipping load of"
+                    << requestedCacheKey;
+        }
+    }
+}
+
 void CoverArtCache::tryLoadCover(
         const QObject* pRequester,
         const TrackPointer& pTrack,
@@ -156,11 +229,15 @@ void CoverArtCache::tryLoadCover(
     // to avoid loading the same picture again while we are loading it.
     // This fixes also https://github.com/mixxxdj/mixxx/issues/11131 on
     // Windows where simultaneous open the same file from two threads fails.
-    bool requestPending = m_runningRequests.contains(requestedCacheKey);
     m_runningRequests.insert(requestedCacheKey, {pRequester, desiredWidth});
-    if (requestPending) {
+    const auto runningLoad = m_runningLoads.constFind(requestedCacheKey);
+    if (runningLoad != m_runningLoads.constEnd()) {
+        // Resume the load if it has been canceled before being started
+        runningLoad.value()->testAndSetOrdered(kLoadCanceled, kLoadPending);
         return;
     }
+    const auto pLoadState = std::make_shared<QAtomicInt>(kLoadPending);
+    m_runningLoads.insert(requestedCacheKey, pLoadState);
 
     if (kLogger.traceEnabled()) {
         kLogger.trace()
@@ -171,7 +248,10 @@ void CoverArtCache::tryLoadCover(
     // The watcher will be deleted in coverLoaded()
     QFutureWatcher<FutureResult>* watcher = new QFutureWatcher<FutureResult>(this);
     QFuture<FutureResult> future = QtConcurrent::run(
-            &CoverArtCache::loadCover,
+            &m_loaderThreadPool,
+            &CoverArtCache::loadCoverCached,
+            m_pDiskCache,
+            pLoadState,
             pTrack,
             coverInfo,
             desiredWidth);
@@ -231,6 +311,65 @@ CoverArtCache::FutureResult CoverArtCache::loadCover(
     return res;
 }
 
+//static
+CoverArtCache::FutureResult CoverArtCache::loadCoverCached(
+        std::shared_ptr<const CoverArtDiskCache> pDiskCache,
+        LoadState pLoadState,
+        TrackPointer pTrack,
+        CoverInfo coverInfo,
+        int desiredWidth) {
+    if (!pLoadState->testAndSetOrdered(kLoadPending, kLoadStarted)) {
+        auto res = FutureResult(coverInfo.cacheKey());
+        res.coverArt = CoverArt(
+                std::move(coverInfo),
+                CoverInfo::LoadedImage(CoverInfo::LoadedImage::Result::NoImage),
+                desiredWidth);
+        res.canceled = true;
+        return res;
+    }
+
+    // Covers with a legacy hash are loaded from their source for
+    // updating the digest. Full size covers are not cached at all.
+    const bool diskCacheable = pDiskCache &&
+            desiredWidth > 0 &&
+            !coverInfo.imageDigest().isEmpty();
+    if (diskCacheable) {
+        QImage image = pDiskCache->readImage(coverInfo.cacheKey(), desiredWidth);
+        if (!image.isNull()) {
+            if (kLogger.traceEnabled()) {
+                kLogger.trace()
+                        << "loadCover disk cache hit"
+                        << coverInfo
+                        << desiredWidth;
+            }
+            CoverInfo::LoadedImage loadedImage(CoverInfo::LoadedImage::Result::Ok);
+            loadedImage.image = std::move(image);
+            loadedImage.location = coverInfo.type == CoverInfo::METADATA
+                    ? coverInfo.trackLocation
+                    : coverInfo.coverLocation;
+            auto res = FutureResult(coverInfo.cacheKey());
+            res.coverArt = CoverArt(
+                    std::move(coverInfo),
+                    std::move(loadedImage),
+                    desiredWidth);
+            return res;
+        }
+    }
+
+    auto res = loadCover(
+            std::move(pTrack),
+            std::move(coverInfo),
+            desiredWidth);
+    if (diskCacheable &&
+            res.coverArt.loadedImage.result == CoverInfo::LoadedImage::Result::Ok) {
+        pDiskCache->writeImage(
+                res.requestedCacheKey,
+                desiredWidth,
+                res.coverArt.loadedImage.image);
+    }
+    return res;
+}
+
 // watcher
 void CoverArtCache::coverLoaded() {
     FutureResult res;
@@ -248,6 +387,22 @@ void CoverArtCache::coverLoaded() {
         kLogger.trace() << "coverLoaded" << res.coverArt;
     }
 
+    m_runningLoads.remove(res.requestedCacheKey);
+    if (res.canceled) {
+        // Requests that arrived while the load was skipped need to
+        // start a new load
+        const auto requests = m_runningRequests.values(res.requestedCacheKey);
+        m_runningRequests.remove(res.requestedCacheKey);
+        for (const auto& request : requests) {
+            tryLoadCover(
+                    request.pRequester,
+                    nullptr,
+                    res.coverArt,
+                    request.desiredWidth);
+        }
+        return;
+    }
+
     QString cacheKey = pixmapCacheKey(
             res.coverArt.cacheKey(), res.coverArt.resizedToWidth);
     QPixmap pixmap;
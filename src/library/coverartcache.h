@@ -1,15 +1,21 @@
 #pragma once
 
+#include <QAtomicInt>
+#include <QHash>
 #include <QObject>
 #include <QPair>
 #include <QPixmap>
 #include <QSet>
+#include <QThreadPool>
 #include <QtDebug>
+#include <memory>
 
 #include "library/coverart.h"
 #include "track/track_decl.h"
 #include "util/singleton.h"
 
+class CoverArtDiskCache;
+
 class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
     Q_OBJECT
   public:
@@ -37,6 +43,14 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             const TrackPointer& pTrack,
             int desiredWidth);
 
+    /// Withdraws a request for a cover that is no longer needed, e.g.
+    /// because the row that requested it has been scrolled out of view.
+    /// Loading the cover is skipped if it has not been started yet and
+    /// if no other requests for the same cover are pending.
+    static void cancelUncachedCover(
+            const QObject* pRequester,
+            mixxx::cache_key_t requestedCacheKey);
+
     // Only public for testing
     struct FutureResult {
         FutureResult()
@@ -48,6 +62,8 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
         }
         mixxx::cache_key_t requestedCacheKey;
         CoverArt coverArt;
+        // All requests have been canceled before loading the cover
+        bool canceled = false;
     };
     // Load cover from path indicated in coverInfo. WARNING: This is run in a
     // worker thread.
@@ -67,8 +83,10 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             const QPixmap& pixmap);
 
   protected:
-    CoverArtCache();
-    ~CoverArtCache() override = default;
+    // Scaled covers are only cached in memory if no directory is given
+    explicit CoverArtCache(
+            const QString& diskCacheDirectoryPath = QString());
+    ~CoverArtCache() override;
     friend class Singleton<CoverArtCache>;
 
   private:
@@ -84,9 +102,34 @@ class CoverArtCache : public QObject, public Singleton<CoverArtCache> {
             const CoverInfo& info,
             int desiredWidth);
 
+    void cancelRequest(
+            const QObject* pRequester,
+            mixxx::cache_key_t requestedCacheKey);
+
+    // Pending -> Started or Pending <-> Canceled
+    typedef std::shared_ptr<QAtomicInt> LoadState;
+
+    // Looks up scaled covers in the disk cache before loading them
+    // and stores them afterwards. WARNING: This is run in a worker
+    // thread.
+    static FutureResult loadCoverCached(
+            std::shared_ptr<const CoverArtDiskCache> pDiskCache,
+            LoadState pLoadState,
+            TrackPointer pTrack,
+            CoverInfo coverInfo,
+            int desiredWidth);
+
     struct RequestData {
         const QObject* pRequester;
         int desiredWidth;
     };
     QMultiHash<mixxx::cache_key_t, RequestData> m_runningRequests;
+    QHash<mixxx::cache_key_t, LoadState> m_runningLoads;
+
+    std::shared_ptr<const CoverArtDiskCache> m_pDiskCache;
+
+    // Decoding and scaling images is expensive. A bounded number
+    // of threads prevents that loading covers while scrolling through
+    // the library occupies all threads of the global pool.
+    QThreadPool m_loaderThreadPool;
 };
@@ -0,0 +1,180 @@
+#include "library/coverartdiskcache.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <cstring>
+
+#include "util/assert.h"
+#include "util/cachedirectory.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("CoverArtDiskCache");
+
+const QString kFileSuffix = QStringLiteral(".thumb");
+
+constexpr quint32 kFileMagic = 0x4d584354; // "MXCT"
+
+// Increment when changing the file layout to invalidate all existing files
+constexpr quint32 kFileVersion = 1;
+
+// Refreshing the modification time of a file when reading it would
+// require an additional write operation for every single cache hit
+constexpr qint64 kTouchIntervalSecs = 24 * 60 * 60;
+
+struct FileHeader {
+    quint32 magic;
+    quint32 version;
+    qint32 format;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+};
+
+// Opaque covers are stored with 3 instead of 4 bytes per pixel
+inline QImage::Format storageFormat(const QImage& image) {
+    return image.hasAlphaChannel()
+            ? QImage::Format_ARGB32_Premultiplied
+            : QImage::Format_RGB888;
+}
+
+inline bool isStorageFormat(qint32 format) {
+    return format == QImage::Format_ARGB32_Premultiplied ||
+            format == QImage::Format_RGB888;
+}
+
+} // anonymous namespace
+
+CoverArtDiskCache::CoverArtDiskCache(
+        const QString& directoryPath,
+        qint64 maxTotalSizeBytes)
+        : m_directoryPath(directoryPath),
+          m_maxTotalSizeBytes(maxTotalSizeBytes) {
+    if (!QDir().mkpath(m_directoryPath)) {
+        kLogger.warning()
+                << "Failed to create directory"
+                << m_directoryPath;
+    }
+}
+
+QString CoverArtDiskCache::imageFilePath(
+        mixxx::cache_key_t cacheKey,
+        int width) const {
+    return m_directoryPath +
+            QStringLiteral("/%1_%2").arg(cacheKey, 16, 16, QChar('0')).arg(width) +
+            kFileSuffix;
+}
+
+QImage CoverArtDiskCache::readImage(
+        mixxx::cache_key_t cacheKey,
+        int width) const {
+    QFile file(imageFilePath(cacheKey, width));
+    if (!file.open(QIODevice::ReadOnly)) {
+        // Not cached yet
+        return QImage();
+    }
+    const qint64 fileSize = file.size();
+    if (fileSize < static_cast<qint64>(sizeof(FileHeader))) {
+        kLogger.warning()
+                << "Corrupt file"
+                << file.fileName();
+        return QImage();
+    }
+    const uchar* pFileData = file.map(0, fileSize);
+    if (!pFileData) {
+        kLogger.warning()
+                << "Failed to map file"
+                << file.fileName()
+                << file.errorString();
+        return QImage();
+    }
+    FileHeader header;
+    std::memcpy(&header, pFileData, sizeof(header));
+    QImage image;
+    if (header.magic == kFileMagic &&
+            header.version == kFileVersion &&
+            isStorageFormat(header.format) &&
+            header.width == width &&
+            header.height > 0 &&
+            header.bytesPerLine > 0 &&
+            fileSize == static_cast<qint64>(sizeof(header)) +
+                            static_cast<qint64>(header.bytesPerLine) * header.height) {
+        // The image only references the mapped data that becomes
+        // invalid when unmapping the file and needs to be copied
+        image = QImage(pFileData + sizeof(header),
+                header.width,
+                header.height,
+                header.bytesPerLine,
+                static_cast<QImage::Format>(header.format))
+                        .copy();
+    } else {
+        kLogger.warning()
+                << "Discarding outdated or corrupt file"
+                << file.fileName();
+    }
+    file.unmap(const_cast<uchar*>(pFileData));
+    if (image.isNull()) {
+        file.close();
+        file.remove();
+        return QImage();
+    }
+    // The modification time is used for pruning the least recently
+    // used files
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    if (file.fileTime(QFileDevice::FileModificationTime).secsTo(now) > kTouchIntervalSecs) {
+        file.setFileTime(now, QFileDevice::FileModificationTime);
+    }
+    return image;
+}
+
+bool CoverArtDiskCache::writeImage(
+        mixxx::cache_key_t cacheKey,
+        int width,
+        const QImage& image) const {
+    VERIFY_OR_DEBUG_ASSERT(!image.isNull() && image.width() == width) {
+        return false;
+    }
+    const QImage storedImage = image.convertToFormat(storageFormat(image));
+    FileHeader header;
+    header.magic = kFileMagic;
+    header.version = kFileVersion;
+    header.format = storedImage.format();
+    header.width = storedImage.width();
+    header.height = storedImage.height();
+    header.bytesPerLine = static_cast<qint32>(storedImage.bytesPerLine());
+
+    // Concurrent readers either find the previous file or the complete
+    // new file, but never a partially written file
+    QSaveFile file(imageFilePath(cacheKey, width));
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning()
+                << "Failed to create file"
+                << file.fileName()
+                << file.errorString();
+        return false;
+    }
+    const qint64 imageSize =
+            static_cast<qint64>(header.bytesPerLine) * header.height;
+    if (file.write(reinterpret_cast<const char*>(&header), sizeof(header)) !=
+                    static_cast<qint64>(sizeof(header)) ||
+            file.write(reinterpret_cast<const char*>(storedImage.constBits()),
+                    imageSize) != imageSize) {
+        kLogger.warning()
+                << "Failed to write file"
+                << file.fileName()
+                << file.errorString();
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+void CoverArtDiskCache::prune() const {
+    mixxx::pruneCacheDirectory(
+            m_directoryPath,
+            QStringLiteral("*") + kFileSuffix,
+            m_maxTotalSizeBytes);
+}
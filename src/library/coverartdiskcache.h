@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QImage>
+#include <QString>
+
+#include "util/cache.h"
+
+/// Persistent cache for scaled cover art thumbnails.
+///
+/// Each thumbnail is stored in a separate file that is named after
+/// the cache key of the cover image and the width of the thumbnail.
+/// The file contains a small header followed by the raw pixel data,
+/// which is mapped into memory when reading it. This is considerably
+/// faster than decoding and scaling the original image again.
+///
+/// The files are only valid on the host where they have been written,
+/// i.e. they are stored in native byte order.
+///
+/// All functions are thread-safe and supposed to be called from
+/// worker threads.
+class CoverArtDiskCache final {
+  public:
+    CoverArtDiskCache(
+            const QString& directoryPath,
+            qint64 maxTotalSizeBytes);
+
+    const QString& directoryPath() const {
+        return m_directoryPath;
+    }
+
+    /// Returns a null image if the thumbnail is not cached.
+    QImage readImage(
+            mixxx::cache_key_t cacheKey,
+            int width) const;
+
+    bool writeImage(
+            mixxx::cache_key_t cacheKey,
+            int width,
+            const QImage& image) const;
+
+    /// Deletes the least recently used thumbnails until the total
+    /// size of all files is below the limit.
+    void prune() const;
+
+  private:
+    QString imageFilePath(
+            mixxx::cache_key_t cacheKey,
+            int width) const;
+
+    const QString m_directoryPath;
+    const qint64 m_maxTotalSizeBytes;
+};
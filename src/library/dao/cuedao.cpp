@@ -9,6 +9,7 @@
 #include "util/assert.h"
 #include "util/color/rgbcolor.h"
 #include "util/db/fwdsqlquery.h"
+#include "util/db/sqlquerycache.h"
 #include "util/logger.h"
 
 namespace {
@@ -78,14 +79,14 @@ QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
     //qDebug() << "CueDAO::getCuesForTrack" << QThread::currentThread() << m_database.connectionName();
     QList<CuePointer> cues;
 
-    FwdSqlQuery query(
+    mixxx::CachedSqlQuery query(
             m_database,
             QStringLiteral("SELECT * FROM " CUE_TABLE " WHERE track_id=:id"));
     DEBUG_ASSERT(
-            query.isPrepared() &&
-            !query.hasError());
-    query.bindValue(":id", trackId);
-    if (!query.execPrepared()) {
+            query->isPrepared() &&
+            !query->hasError());
+    query->bindValue(":id", trackId);
+    if (!query->execPrepared()) {
         kLogger.warning()
                 << "Failed to load cues of track"
                 << trackId;
@@ -93,8 +94,8 @@ QList<CuePointer> CueDAO::getCuesForTrack(TrackId trackId) const {
         return cues;
     }
     QMap<int, CuePointer> hotCuesByNumber;
-    while (query.next()) {
-        CuePointer pCue = cueFromRow(query.record());
+    while (query->next()) {
+        CuePointer pCue = cueFromRow(query->record());
         if (!pCue) {
             continue;
         }
@@ -1,5 +1,6 @@
 #include "libraryhashdao.h"
 
+#include <QDateTime>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QSqlRecord>
@@ -185,3 +186,76 @@ QStringList LibraryHashDAO::getDeletedDirectories() {
     }
     return result;
 }
+
+QHash<QString, QDateTime> LibraryHashDAO::getDirectoryModifiedTimes() {
+    QHash<QString, QDateTime> result;
+    QSqlQuery query(m_database);
+    query.prepare("SELECT directory_path, modified_at FROM LibraryHashes "
+                  "WHERE directory_deleted=0");
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+    const int directoryPathColumn = query.record().indexOf("directory_path");
+    const int modifiedAtColumn = query.record().indexOf("modified_at");
+    while (query.next()) {
+        const QVariant modifiedAt = query.value(modifiedAtColumn);
+        result.insert(query.value(directoryPathColumn).toString(),
+                modifiedAt.isNull()
+                        ? QDateTime()
+                        : QDateTime::fromMSecsSinceEpoch(
+                                  modifiedAt.toLongLong(), Qt::UTC));
+    }
+    return result;
+}
+
+void LibraryHashDAO::updateDirectoryModifiedTimes(
+        const QHash<QString, QDateTime>& modifiedTimes) {
+    QSqlQuery query(m_database);
+    query.prepare("UPDATE LibraryHashes SET modified_at=:modified_at "
+                  "WHERE directory_path=:directory_path");
+    for (auto it = modifiedTimes.constBegin(); it != modifiedTimes.constEnd(); ++it) {
+        query.bindValue(":modified_at",
+                it.value().isValid()
+                        ? QVariant(it.value().toMSecsSinceEpoch())
+                        : QVariant());
+        query.bindValue(":directory_path", it.key());
+        if (!query.exec()) {
+            LOG_FAILED_QUERY(query);
+        }
+    }
+}
+
+void LibraryHashDAO::recordChangedDirectory(const QString& dirPath) {
+    QSqlQuery query(m_database);
+    query.prepare("INSERT OR REPLACE INTO LibraryChangeJournal "
+                  "(directory_path, changed_at) "
+                  "VALUES (:directory_path, :changed_at)");
+    query.bindValue(":directory_path", dirPath);
+    query.bindValue(":changed_at", QDateTime::currentMSecsSinceEpoch());
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+}
+
+QStringList LibraryHashDAO::getChangedDirectories() {
+    QStringList result;
+    QSqlQuery query(m_database);
+    query.prepare("SELECT directory_path FROM LibraryChangeJournal "
+                  "ORDER BY directory_path");
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+    const int directoryPathColumn = query.record().indexOf("directory_path");
+    while (query.next()) {
+        result << query.value(directoryPathColumn).toString();
+    }
+    return result;
+}
+
+void LibraryHashDAO::clearChangedDirectories() {
+    QSqlQuery query(m_database);
+    query.prepare("DELETE FROM LibraryChangeJournal");
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+}
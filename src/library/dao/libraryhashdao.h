@@ -1,7 +1,8 @@
 #pragma once
 
-#include <QObject>
+#include <QDateTime>
 #include <QHash>
+#include <QObject>
 #include <QString>
 
 #include "library/dao/dao.h"
@@ -23,4 +24,15 @@ class LibraryHashDAO : public DAO {
     void updateDirectoryStatuses(const QStringList& dirPaths,
                                  const bool deleted, const bool verified);
     QStringList getDeletedDirectories();
+
+    // The modification times of the existing directories when they have
+    // been listed during the last scan. The time is invalid if unknown.
+    QHash<QString, QDateTime> getDirectoryModifiedTimes();
+    void updateDirectoryModifiedTimes(const QHash<QString, QDateTime>& modifiedTimes);
+
+    // The change journal records the directories that have been modified
+    // since the last scan.
+    void recordChangedDirectory(const QString& dirPath);
+    QStringList getChangedDirectories();
+    void clearChangedDirectories();
 };
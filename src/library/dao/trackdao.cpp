@@ -16,6 +16,7 @@
 #include "library/dao/cuedao.h"
 #include "library/dao/libraryhashdao.h"
 #include "library/dao/playlistdao.h"
+#include "library/dao/trackschema.h"
 #include "library/library_prefs.h"
 #include "library/queryutil.h"
 #include "moc_trackdao.cpp"
@@ -27,8 +28,10 @@
 #include "track/track.h"
 #include "util/assert.h"
 #include "util/datetime.h"
+#include "util/db/dbconnection.h"
 #include "util/db/fwdsqlquery.h"
 #include "util/db/sqlite.h"
+#include "util/db/sqlquerycache.h"
 #include "util/db/sqlstringformatter.h"
 #include "util/db/sqltransaction.h"
 #include "util/fileinfo.h"
@@ -88,7 +91,8 @@ TrackDAO::TrackDAO(CueDAO& cueDao,
           m_pConfig(pConfig),
           m_trackLocationIdColumn(UndefinedRecordIndex),
           m_queryLibraryIdColumn(UndefinedRecordIndex),
-          m_queryLibraryMixxxDeletedColumn(UndefinedRecordIndex) {
+          m_queryLibraryMixxxDeletedColumn(UndefinedRecordIndex),
+          m_hasFullTextIndex(false) {
     connect(&m_playlistDao,
             &PlaylistDAO::tracksRemovedFromPlayedHistory,
             this,
@@ -109,6 +113,66 @@ TrackDAO::~TrackDAO() {
     addTracksFinish(true);
 }
 
+void TrackDAO::initialize(const QSqlDatabase& database) {
+    DAO::initialize(database);
+    FwdSqlQuery query(m_database,
+            QStringLiteral(
+                    "SELECT name FROM sqlite_master "
+                    "WHERE type='table' AND name='" LIBRARYFTS_TABLE "'"));
+    m_hasFullTextIndex = query.execPrepared() && query.next();
+    if (!m_hasFullTextIndex) {
+        kLogger.info()
+                << "Full-text index is not available, searching the library"
+                << "requires a full table scan";
+    }
+}
+
+bool TrackDAO::updateFullTextIndex(
+        TrackId trackId,
+        const mixxx::TrackRecord& trackRecord) const {
+    if (!m_hasFullTextIndex) {
+        return true;
+    }
+    const mixxx::TrackMetadata& trackMetadata = trackRecord.getMetadata();
+    const mixxx::TrackInfo& trackInfo = trackMetadata.getTrackInfo();
+    const mixxx::AlbumInfo& albumInfo = trackMetadata.getAlbumInfo();
+    // The same order as LIBRARYFTS_COLUMNS
+    QString values[] = {
+            trackInfo.getArtist(),
+            trackInfo.getTitle(),
+            albumInfo.getTitle(),
+            albumInfo.getArtist(),
+            trackInfo.getGenre(),
+            trackInfo.getComposer(),
+            trackInfo.getGrouping(),
+            trackInfo.getComment(),
+    };
+    DEBUG_ASSERT(std::size(values) == static_cast<std::size_t>(LIBRARYFTS_COLUMNS.size()));
+
+    mixxx::CachedSqlQuery query(m_database,
+            QStringLiteral(
+                    "INSERT OR REPLACE INTO " LIBRARYFTS_TABLE " "
+                    "(rowid,artist,title,album,album_artist,genre,composer,grouping,comment) "
+                    "VALUES (:id,:artist,:title,:album,:album_artist,:genre,:composer,:grouping,:comment)"));
+    query->bindValue(QStringLiteral(":id"), trackId);
+    for (int i = 0; i < LIBRARYFTS_COLUMNS.size(); ++i) {
+        mixxx::DbConnection::makeStringLatinLow(&values[i]);
+        query->bindValue(QChar(':') + LIBRARYFTS_COLUMNS[i], values[i]);
+    }
+    return query->execPrepared();
+}
+
+bool TrackDAO::removeFromFullTextIndex(
+        const QString& trackIdListJoined) const {
+    if (!m_hasFullTextIndex) {
+        return true;
+    }
+    FwdSqlQuery query(m_database,
+            QStringLiteral("DELETE FROM " LIBRARYFTS_TABLE " WHERE rowid IN (%1)")
+                    .arg(trackIdListJoined));
+    return !query.hasError() && query.execPrepared();
+}
+
 void TrackDAO::finish() {
     qDebug() << "TrackDAO::finish()";
 
@@ -144,22 +208,21 @@ TrackId TrackDAO::getTrackIdByLocation(const QString& location) const {
         return {};
     }
 
-    QSqlQuery query(m_database);
-    query.prepare(
-            "SELECT library.id FROM library "
-            "INNER JOIN track_locations ON library.location = track_locations.id "
-            "WHERE track_locations.location=:location");
-    query.bindValue(":location", location);
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
+    mixxx::CachedSqlQuery query(m_database,
+            QStringLiteral(
+                    "SELECT library.id FROM library "
+                    "INNER JOIN track_locations ON library.location = track_locations.id "
+                    "WHERE track_locations.location=:location"));
+    query->bindValue(QStringLiteral(":location"), location);
+    if (!query->execPrepared()) {
         DEBUG_ASSERT(!"Failed query");
         return {};
     }
-    if (!query.next()) {
+    if (!query->next()) {
         qDebug() << "TrackDAO::getTrackId(): Track location not found in library:" << location;
         return {};
     }
-    const auto trackId = TrackId(query.value(query.record().indexOf("id")));
+    const auto trackId = TrackId(query->fieldValue(query->fieldIndex(QStringLiteral("id"))));
     DEBUG_ASSERT(trackId.isValid());
     return trackId;
 }
@@ -283,20 +346,20 @@ QSet<QString> TrackDAO::getAllTrackLocations() const {
 QString TrackDAO::getTrackLocation(TrackId trackId) const {
     qDebug() << "TrackDAO::getTrackLocation"
              << QThread::currentThread() << m_database.connectionName();
-    QSqlQuery query(m_database);
+    mixxx::CachedSqlQuery query(m_database,
+            QStringLiteral(
+                    "SELECT track_locations.location FROM track_locations "
+                    "INNER JOIN library ON library.location = track_locations.id "
+                    "WHERE library.id=:id"));
     QString trackLocation = "";
-    query.prepare("SELECT track_locations.location FROM track_locations "
-                  "INNER JOIN library ON library.location = track_locations.id "
-                  "WHERE library.id=:id");
-    query.bindValue(":id", trackId.toVariant());
-    if (!query.exec()) {
-        LOG_FAILED_QUERY(query);
+    query->bindValue(QStringLiteral(":id"), trackId);
+    if (!query->execPrepared()) {
         DEBUG_ASSERT(!"Failed query");
         return "";
     }
-    const int locationColumn = query.record().indexOf("location");
-    while (query.next()) {
-        trackLocation = query.value(locationColumn).toString();
+    const DbFieldIndex locationColumn = query->fieldIndex(QStringLiteral("location"));
+    while (query->next()) {
+        trackLocation = query->fieldValue(locationColumn).toString();
     }
 
     return trackLocation;
@@ -797,6 +860,12 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
         }
         pTrack->initId(trackId);
         pTrack->setDateAdded(trackDateAdded);
+        if (!updateFullTextIndex(trackId, trackRecord)) {
+            kLogger.warning()
+                    << "Failed to add track"
+                    << trackId
+                    << "to the full-text index";
+        }
 
         m_analysisDao.saveTrackAnalyses(
                 trackId,
@@ -815,7 +884,8 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
 
 TrackPointer TrackDAO::addTracksAddFile(
         const mixxx::FileAccess& fileAccess,
-        bool unremove) {
+        bool unremove,
+        const SoundSourceProxy::PrefetchedMetadata* pPrefetchedMetadata) {
     // Check that track is a supported extension.
     // TODO(uklotzde): The following check can be skipped if
     // the track is already in the library. A refactoring is
@@ -865,7 +935,8 @@ TrackPointer TrackDAO::addTracksAddFile(
     // from the file.
     SoundSourceProxy(pTrack).updateTrackFromSource(
             SoundSourceProxy::UpdateTrackFromSourceMode::Once,
-            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig));
+            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig),
+            pPrefetchedMetadata);
     if (!pTrack->checkSourceSynchronized()) {
         qWarning() << "TrackDAO::addTracksAddFile:"
                 << "Failed to parse track metadata from file"
@@ -1041,6 +1112,9 @@ bool TrackDAO::onPurgingTracks(
             return false;
         }
     }
+    if (!removeFromFullTextIndex(idListJoined)) {
+        return false;
+    }
     {
         // invalidate the hash in LibraryHash,
         // in case the file was not deleted to detect it on a rescan
@@ -1304,8 +1378,8 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         return nullptr;
     }
 
-    // The GlobalTrackCache is only locked while executing the following line.
-    TrackPointer pTrack = GlobalTrackCacheLocker().lookupTrackById(trackId);
+    // Concurrent lookups are not blocked while the GlobalTrackCache is locked.
+    TrackPointer pTrack = GlobalTrackCacheReader::lookupTrackById(trackId);
     if (pTrack) {
         return pTrack;
     }
@@ -1379,39 +1453,45 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
 
     QSqlRecord queryRecord;
     {
-        QString columnsStr;
-        int columnsSize = 0;
-        for (int i = 0; i < columnsCount; ++i) {
-            columnsSize += static_cast<int>(qstrlen(columns[i].name)) + 1;
-        }
-        columnsStr.reserve(columnsSize);
-        for (int i = 0; i < columnsCount; ++i) {
-            if (i > 0) {
-                columnsStr.append(QChar(','));
+        // The statement is constant and bound to the track id, so it
+        // only needs to be built and prepared once per connection.
+        static const QString kStatement = [&columns] {
+            QString columnsStr;
+            int columnsSize = 0;
+            for (int i = 0; i < columnsCount; ++i) {
+                columnsSize += static_cast<int>(qstrlen(columns[i].name)) + 1;
             }
-            columnsStr.append(columns[i].name);
-        }
-
-        QSqlQuery query(m_database);
-        query.prepare(QString(
-                "SELECT %1 FROM Library "
-                "INNER JOIN track_locations ON library.location = track_locations.id "
-                "WHERE library.id = %2")
-                              .arg(columnsStr, trackId.toString()));
-        if (!query.exec()) {
-            LOG_FAILED_QUERY(query)
-                    << QString("getTrack(%1)").arg(trackId.toString());
+            columnsStr.reserve(columnsSize);
+            for (int i = 0; i < columnsCount; ++i) {
+                if (i > 0) {
+                    columnsStr.append(QChar(','));
+                }
+                columnsStr.append(columns[i].name);
+            }
+            return QString(
+                    "SELECT %1 FROM Library "
+                    "INNER JOIN track_locations ON library.location = track_locations.id "
+                    "WHERE library.id=:id")
+                    .arg(columnsStr);
+        }();
+
+        mixxx::CachedSqlQuery query(m_database, kStatement);
+        query->bindValue(QStringLiteral(":id"), trackId);
+        if (!query->execPrepared()) {
+            kLogger.warning()
+                    << "Failed to load track with id"
+                    << trackId;
             DEBUG_ASSERT(!"Failed query");
             return nullptr;
         }
 
-        if (!query.next()) {
+        if (!query->next()) {
             qDebug() << "Track with id =" << trackId << "not found";
             return nullptr;
         }
-        queryRecord = query.record();
+        queryRecord = query->record();
         // Only a single record is expected
-        DEBUG_ASSERT(!query.next());
+        DEBUG_ASSERT(!query->next());
     }
 
     {
@@ -1574,7 +1654,7 @@ TrackId TrackDAO::getTrackIdByRef(
     if (trackRef.getId().isValid()) {
         return trackRef.getId();
     }
-    const auto pTrack = GlobalTrackCacheLocker().lookupTrackByRef(trackRef);
+    const auto pTrack = GlobalTrackCacheReader::lookupTrackByRef(trackRef);
     if (pTrack) {
         const auto trackId = pTrack->getId();
         DEBUG_ASSERT(trackId.isValid());
@@ -1588,7 +1668,7 @@ TrackPointer TrackDAO::getTrackByRef(
     if (!trackRef.isValid()) {
         return nullptr;
     }
-    const auto pTrack = GlobalTrackCacheLocker().lookupTrackByRef(trackRef);
+    const auto pTrack = GlobalTrackCacheReader::lookupTrackByRef(trackRef);
     if (pTrack) {
         return pTrack;
     }
@@ -1687,6 +1767,10 @@ bool TrackDAO::updateTrack(const Track& track) const {
         return false;
     }
 
+    if (!updateFullTextIndex(trackId, trackRecord)) {
+        return false;
+    }
+
     //qDebug() << "Update track took : " << time.elapsed().formatMillisWithUnit() << "Now updating cues";
     //time.start();
     m_analysisDao.saveTrackAnalyses(
@@ -1943,6 +2027,7 @@ bool TrackDAO::detectMovedTracks(
                 continue;
             }
         }
+        removeFromFullTextIndex(relocatedTrack.deletedTrackId().toString());
 
         // Update the location foreign key for the existing row in the
         // library table to point to the correct row in the track_locations
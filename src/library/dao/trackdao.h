@@ -9,6 +9,7 @@
 #include "library/dao/dao.h"
 #include "library/relocatedtrack.h"
 #include "preferences/usersettings.h"
+#include "sources/soundsourceproxy.h"
 #include "track/globaltrackcache.h"
 #include "util/class.h"
 
@@ -45,8 +46,16 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
             UserSettingsPointer pConfig);
     ~TrackDAO() override;
 
+    void initialize(const QSqlDatabase& database) override;
+
     void finish();
 
+    /// The optional full-text index of the library is only available
+    /// if SQLite supports it, see LIBRARYFTS_TABLE.
+    bool hasFullTextIndex() const {
+        return m_hasFullTextIndex;
+    }
+
     QList<TrackId> resolveTrackIds(
             const QList<mixxx::FileInfo>& fileInfos,
             ResolveTrackIdFlags flags = ResolveTrackIdFlag::ResolveOnly);
@@ -147,9 +156,12 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     TrackId addTracksAddTrack(
             const TrackPointer& pTrack,
             bool unremove);
+    /// Metadata of the file that has been prefetched by the caller is
+    /// used for initializing a new track instead of reading the file.
     TrackPointer addTracksAddFile(
             const mixxx::FileAccess& fileAccess,
-            bool unremove);
+            bool unremove,
+            const SoundSourceProxy::PrefetchedMetadata* pPrefetchedMetadata = nullptr);
     TrackPointer addTracksAddFile(
             const QString& filePath,
             bool unremove) {
@@ -194,6 +206,12 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     // Callback for GlobalTrackCache
     mixxx::FileAccess relocateCachedTrack(TrackId trackId) override;
 
+    bool updateFullTextIndex(
+            TrackId trackId,
+            const mixxx::TrackRecord& trackRecord) const;
+    bool removeFromFullTextIndex(
+            const QString& trackIdListJoined) const;
+
     CueDAO& m_cueDao;
     PlaylistDAO& m_playlistDao;
     AnalysisDao& m_analysisDao;
@@ -211,6 +229,8 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     int m_queryLibraryIdColumn;
     int m_queryLibraryMixxxDeletedColumn;
 
+    bool m_hasFullTextIndex;
+
     QSet<TrackId> m_tracksAddedSet;
 
     DISALLOW_COPY_AND_ASSIGN(TrackDAO);
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <QString>
+#include <QStringList>
 
 #define LIBRARY_TABLE "library"
 #define TRACKLOCATIONS_TABLE "track_locations"
+// Optional, see schema version 41
+#define LIBRARYFTS_TABLE "library_fts"
 
 #define PLAYLIST_TABLE "Playlists"
 #define PLAYLIST_TRACKS_TABLE "PlaylistTracks"
@@ -61,6 +64,20 @@ const QString TRACKLOCATIONSTABLE_FILESIZE = QStringLiteral("filesize");
 const QString TRACKLOCATIONSTABLE_FSDELETED = QStringLiteral("fs_deleted");
 const QString TRACKLOCATIONSTABLE_NEEDSVERIFICATION = QStringLiteral("needs_verification");
 
+// The text columns of the library table that are contained in the
+// full-text index with the same names. The indexed text is folded with
+// DbConnection::makeStringLatinLow().
+const QStringList LIBRARYFTS_COLUMNS = {
+        LIBRARYTABLE_ARTIST,
+        LIBRARYTABLE_TITLE,
+        LIBRARYTABLE_ALBUM,
+        LIBRARYTABLE_ALBUMARTIST,
+        LIBRARYTABLE_GENRE,
+        LIBRARYTABLE_COMPOSER,
+        LIBRARYTABLE_GROUPING,
+        LIBRARYTABLE_COMMENT,
+};
+
 const QString PLAYLISTTABLE_ID = QStringLiteral("id");
 const QString PLAYLISTTABLE_NAME = QStringLiteral("name");
 const QString PLAYLISTTABLE_POSITION = QStringLiteral("position");
@@ -14,6 +14,8 @@ extern const QString kConfigGroup;
 
 extern const ConfigKey kRescanOnStartupConfigKey;
 
+extern const ConfigKey kWatchDirectoriesConfigKey;
+
 extern const ConfigKey kKeyNotationConfigKey;
 
 extern const ConfigKey kTrackDoubleClickActionConfigKey;
@@ -56,6 +58,12 @@ extern const ConfigKey kTagFetcherApplyTagsConfigKey;
 
 extern const ConfigKey kTagFetcherApplyCoverConfigKey;
 
+/// Number of KiB that are read ahead asynchronously when decoding
+/// audio files, e.g. from network storage. Disabled if 0.
+extern const ConfigKey kFileReadAheadKiBConfigKey;
+
+const int kFileReadAheadKiBDefault = 512;
+
 } // namespace prefs
 
 } // namespace library
@@ -106,6 +106,10 @@ MixxxLibraryFeature::MixxxLibraryFeature(Library* pLibrary,
             std::move(columns),
             std::move(searchColumns),
             true);
+    pBaseTrackCache->setUseFullTextIndex(
+            m_pTrackCollection->getTrackDAO().hasFullTextIndex());
+    pBaseTrackCache->setQueryExecutor(
+            pLibrary->trackCollectionManager()->queryExecutor());
     m_pBaseTrackCache = QSharedPointer<BaseTrackCache>(pBaseTrackCache);
     m_pTrackCollection->connectTrackSource(m_pBaseTrackCache);
 
@@ -49,7 +49,12 @@ void ImportFilesTask::run() {
             }
             qDebug() << "Importing track" << trackLocation;
 
-            emit addNewTrack(trackLocation);
+            // Read the file tags here on the worker thread. Only the
+            // database is updated on the scanner thread.
+            emit addNewTrack(trackLocation,
+                    SoundSourceProxy::prefetchMetadataOfNewFile(
+                            mixxx::FileAccess(mixxx::FileInfo(fileInfo), m_pToken),
+                            m_scannerGlobal->resetMissingTagMetadataOnImport()));
         }
     }
     // Insert or update the hash in the database.
@@ -1,6 +1,10 @@
 #include "library/scanner/libraryscanner.h"
 
+#include <QFileSystemWatcher>
+#include <algorithm>
+
 #include "library/coverartutils.h"
+#include "library/library_prefs.h"
 #include "library/queryutil.h"
 #include "library/scanner/libraryscannerdlg.h"
 #include "library/scanner/recursivescandirectorytask.h"
@@ -13,14 +17,23 @@
 #include "util/db/dbconnectionpooler.h"
 #include "util/db/fwdsqlquery.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/performancetimer.h"
 #include "util/timer.h"
 #include "util/trace.h"
 
 namespace {
 
-// TODO(rryan) make configurable
-constexpr int kScannerThreadPoolSize = 1;
+// Directories are hashed and file tags are read by the worker threads,
+// while all database updates are done in a single transaction on the
+// scanner thread. Reading tags is often bound by I/O latency rather than
+// CPU, e.g. for libraries on network shares, so use at least a few threads
+// even on machines with only one or two cores.
+constexpr int kMinScannerThreadPoolSize = 4;
+
+int scannerThreadPoolSize() {
+    return math_max(kMinScannerThreadPoolSize, QThread::idealThreadCount());
+}
 
 mixxx::Logger kLogger("LibraryScanner");
 
@@ -98,12 +111,14 @@ LibraryScanner::LibraryScanner(
         mixxx::DbConnectionPoolPtr pDbConnectionPool,
         const UserSettingsPointer& pConfig)
         : m_pDbConnectionPool(std::move(pDbConnectionPool)),
+          m_pConfig(pConfig),
           m_analysisDao(pConfig),
           m_trackDao(m_cueDao, m_playlistDao,
                   m_analysisDao, m_libraryHashDao,
                   pConfig),
           m_stateSema(1), // only one transaction is possible at a time
-          m_state(IDLE) {
+          m_state(IDLE),
+          m_changeJournalComplete(false) {
     // Move LibraryScanner to its own thread so that our signals/slots will
     // queue to our event loop.
     moveToThread(this);
@@ -112,7 +127,10 @@ LibraryScanner::LibraryScanner(
     const int instanceId = s_instanceCounter.fetchAndAddAcquire(1) + 1;
     setObjectName(QString("LibraryScanner %1").arg(instanceId));
 
-    m_pool.setMaxThreadCount(kScannerThreadPoolSize);
+    m_pool.setMaxThreadCount(scannerThreadPoolSize());
+
+    qRegisterMetaType<SoundSourceProxy::PrefetchedMetadata>(
+            "SoundSourceProxy::PrefetchedMetadata");
 
     // Listen to signals from our public methods (invoked by other threads) and
     // connect them to our slots to run the command on the scanner thread.
@@ -174,10 +192,21 @@ void LibraryScanner::run() {
         m_analysisDao.initialize(dbConnection);
         m_directoryDao.initialize(dbConnection);
 
+        if (m_pConfig->getValue(mixxx::library::prefs::kWatchDirectoriesConfigKey, false)) {
+            m_pDirectoryWatcher = std::make_unique<QFileSystemWatcher>();
+            connect(m_pDirectoryWatcher.get(),
+                    &QFileSystemWatcher::directoryChanged,
+                    this,
+                    &LibraryScanner::slotWatchedDirectoryChanged);
+            recordChangesSinceLastScan();
+        }
+
         // Start the event loop.
         kLogger.debug() << "Event loop starting";
         exec();
         kLogger.debug() << "Event loop stopped";
+
+        m_pDirectoryWatcher.reset();
     }
     kLogger.debug() << "Exiting thread";
 }
@@ -186,7 +215,17 @@ void LibraryScanner::slotStartScan() {
     kLogger.debug() << "slotStartScan()";
     DEBUG_ASSERT(m_state == STARTING);
 
-    cleanUpDatabase(m_libraryHashDao.database());
+    // Only visit the directories in the change journal if it is complete.
+    // The journal must not be trusted again until this scan has finished.
+    const bool incremental = m_pDirectoryWatcher && m_changeJournalComplete;
+    m_changeJournalComplete = false;
+
+    if (!incremental) {
+        // The deleted hashes are re-created while visiting all directories.
+        // An incremental scan needs them to verify and watch the directories
+        // that it doesn't visit.
+        cleanUpDatabase(m_libraryHashDao.database());
+    }
 
     // Recursively scan each directory in the directories table.
     m_libraryRootDirs = m_directoryDao.loadAllDirectories();
@@ -206,9 +245,16 @@ void LibraryScanner::slotStartScan() {
                     QRegularExpression::CaseInsensitiveOption);
     QStringList directoryBlacklist = ScannerUtil::getDirectoryBlacklist();
 
-    m_scannerGlobal = ScannerGlobalPointer(
-            new ScannerGlobal(trackLocations, directoryHashes, extensionFilter,
-                              coverExtensionFilter, directoryBlacklist));
+    m_scannerGlobal = ScannerGlobalPointer(new ScannerGlobal(trackLocations,
+            directoryHashes,
+            extensionFilter,
+            coverExtensionFilter,
+            directoryBlacklist,
+            SyncTrackMetadataParams::readFromUserSettings(*m_pConfig)
+                    .resetMissingTagMetadataOnImport));
+    if (incremental) {
+        m_scannerGlobal->setIncremental();
+    }
 
     m_scannerGlobal->startTimer();
 
@@ -245,22 +291,196 @@ void LibraryScanner::slotStartScan() {
             this,
             &LibraryScanner::slotFinishHashedScan);
 
+    if (m_scannerGlobal->isIncremental()) {
+        queueChangedDirectories(directoryHashes);
+    } else {
+        // All changes are detected by visiting all directories
+        m_libraryHashDao.clearChangedDirectories();
+        for (const mixxx::FileInfo& rootDir : std::as_const(m_libraryRootDirs)) {
+            // Acquire a security bookmark for this directory if we are in a
+            // sandbox. For speed we avoid opening security bookmarks when recursive
+            // scanning so that relies on having an open bookmark for the containing
+            // directory.
+            if (!rootDir.exists() || !rootDir.isDir()) {
+                qWarning() << "Skipping to scan" << rootDir;
+                continue;
+            }
+            auto dirAccess = mixxx::FileAccess(rootDir);
+            if (!m_scannerGlobal->testAndMarkDirectoryScanned(rootDir.toQDir())) {
+                queueTask(new RecursiveScanDirectoryTask(
+                        this, m_scannerGlobal, std::move(dirAccess), false));
+            }
+        }
+    }
+    pWatcher->taskDone();
+}
+
+bool LibraryScanner::isInLibraryRootDir(const QString& directoryPath) const {
+    for (const mixxx::FileInfo& rootDir : m_libraryRootDirs) {
+        if (mixxx::FileInfo::isRootSubCanonicalLocation(
+                    rootDir.location(), directoryPath)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LibraryScanner::queueChangedDirectories(
+        const QHash<QString, mixxx::cache_key_t>& directoryHashes) {
+    const QStringList changedDirectories = m_libraryHashDao.getChangedDirectories();
+    m_libraryHashDao.clearChangedDirectories();
+    kLogger.info()
+            << "Scanning"
+            << changedDirectories.size()
+            << "changed directories";
+    const QSet<QString> changedDirectorySet(
+            changedDirectories.begin(), changedDirectories.end());
+
+    // A directory that has been moved or deleted is only reported as a change
+    // of its parent directory. Neither it nor its sub-directories must be
+    // verified without visiting them.
+    QStringList vanishedDirectories;
+    for (auto it = directoryHashes.constBegin(); it != directoryHashes.constEnd(); ++it) {
+        const QString& directoryPath = it.key();
+        if (changedDirectorySet.contains(QFileInfo(directoryPath).path()) &&
+                !QFileInfo::exists(directoryPath)) {
+            vanishedDirectories.append(directoryPath);
+        }
+    }
+    for (auto it = directoryHashes.constBegin(); it != directoryHashes.constEnd(); ++it) {
+        const QString& directoryPath = it.key();
+        if (changedDirectorySet.contains(directoryPath) ||
+                !isInLibraryRootDir(directoryPath)) {
+            continue;
+        }
+        const bool vanished = std::any_of(vanishedDirectories.cbegin(),
+                vanishedDirectories.cend(),
+                [&directoryPath](const QString& vanishedDirectory) {
+                    return mixxx::FileInfo::isRootSubCanonicalLocation(
+                            vanishedDirectory, directoryPath);
+                });
+        if (!vanished) {
+            m_scannerGlobal->addVerifiedDirectory(directoryPath);
+        }
+    }
+
+    for (const QString& directoryPath : changedDirectories) {
+        const mixxx::FileInfo dirInfo(directoryPath);
+        if (!dirInfo.isDir() || !isInLibraryRootDir(directoryPath)) {
+            // Deleted directories are detected while cleaning up
+            continue;
+        }
+        if (!m_scannerGlobal->testAndMarkDirectoryScanned(dirInfo.toQDir())) {
+            queueTask(new RecursiveScanDirectoryTask(
+                    this, m_scannerGlobal, mixxx::FileAccess(dirInfo), true));
+        }
+    }
+
+    // Library directories that have been added since the last scan
     for (const mixxx::FileInfo& rootDir : std::as_const(m_libraryRootDirs)) {
-        // Acquire a security bookmark for this directory if we are in a
-        // sandbox. For speed we avoid opening security bookmarks when recursive
-        // scanning so that relies on having an open bookmark for the containing
-        // directory.
-        if (!rootDir.exists() || !rootDir.isDir()) {
-            qWarning() << "Skipping to scan" << rootDir;
+        if (directoryHashes.contains(rootDir.location()) ||
+                !rootDir.exists() || !rootDir.isDir()) {
             continue;
         }
         auto dirAccess = mixxx::FileAccess(rootDir);
         if (!m_scannerGlobal->testAndMarkDirectoryScanned(rootDir.toQDir())) {
             queueTask(new RecursiveScanDirectoryTask(
-                    this, m_scannerGlobal, std::move(dirAccess), false));
+                    this, m_scannerGlobal, std::move(dirAccess), true));
         }
     }
-    pWatcher->taskDone();
+}
+
+void LibraryScanner::recordChangesSinceLastScan() {
+    const QHash<QString, QDateTime> modifiedTimes =
+            m_libraryHashDao.getDirectoryModifiedTimes();
+    QSet<QString> existingDirectories;
+    existingDirectories.reserve(modifiedTimes.size());
+    for (auto it = modifiedTimes.constBegin(); it != modifiedTimes.constEnd(); ++it) {
+        if (QFileInfo(it.key()).isDir()) {
+            existingDirectories.insert(it.key());
+        }
+    }
+    // Start watching before comparing the modification times, all
+    // later changes are reported by the watcher.
+    if (!watchDirectories(existingDirectories)) {
+        return;
+    }
+
+    // Changes while Mixxx was not running are detected by comparing the
+    // modification times of the directories with the times when they have
+    // been listed. Adding, removing or renaming a file or sub-directory
+    // modifies the directory, which is all the directory hash depends on.
+    int changedDirectoryCount = 0;
+    ScopedTransaction transaction(m_libraryHashDao.database());
+    for (auto it = modifiedTimes.constBegin(); it != modifiedTimes.constEnd(); ++it) {
+        const QFileInfo dirInfo(it.key());
+        if (!it.value().isValid() ||
+                !dirInfo.isDir() ||
+                dirInfo.lastModified().toMSecsSinceEpoch() !=
+                        it.value().toMSecsSinceEpoch()) {
+            m_libraryHashDao.recordChangedDirectory(it.key());
+            ++changedDirectoryCount;
+        }
+    }
+    transaction.commit();
+    kLogger.info()
+            << changedDirectoryCount
+            << "library directories have changed since the last scan";
+    m_changeJournalComplete = true;
+}
+
+void LibraryScanner::updateWatchedDirectories() {
+    if (!m_pDirectoryWatcher) {
+        return;
+    }
+    // After cleaning up LibraryHashes contains exactly the existing
+    // library directories.
+    const QHash<QString, mixxx::cache_key_t> directoryHashes =
+            m_libraryHashDao.getDirectoryHashes();
+    QSet<QString> directories;
+    directories.reserve(directoryHashes.size());
+    for (auto it = directoryHashes.constBegin(); it != directoryHashes.constEnd(); ++it) {
+        directories.insert(it.key());
+    }
+    if (watchDirectories(directories)) {
+        m_changeJournalComplete = true;
+    }
+}
+
+bool LibraryScanner::watchDirectories(QSet<QString> unwatchedDirectories) {
+    DEBUG_ASSERT(m_pDirectoryWatcher);
+    const int directoryCount = unwatchedDirectories.size();
+    QStringList staleDirectories;
+    const QStringList watchedDirectories = m_pDirectoryWatcher->directories();
+    for (const QString& directoryPath : watchedDirectories) {
+        if (!unwatchedDirectories.remove(directoryPath)) {
+            staleDirectories.append(directoryPath);
+        }
+    }
+    // Remove stale paths first, a moved directory might still be
+    // watched by its old path.
+    if (!staleDirectories.isEmpty()) {
+        m_pDirectoryWatcher->removePaths(staleDirectories);
+    }
+    if (!unwatchedDirectories.isEmpty()) {
+        const QStringList failedDirectories =
+                m_pDirectoryWatcher->addPaths(unwatchedDirectories.values());
+        if (!failedDirectories.isEmpty()) {
+            // Usually the system limit for watches has been exceeded
+            kLogger.warning()
+                    << "Failed to watch"
+                    << failedDirectories.size()
+                    << "library directories, all directories will be"
+                    << "visited during the next scan";
+            m_pDirectoryWatcher->removePaths(m_pDirectoryWatcher->directories());
+            return false;
+        }
+    }
+    kLogger.debug()
+            << "Watching"
+            << directoryCount
+            << "library directories for changes";
+    return true;
 }
 
 // is called when all tasks of the first stage are done (threads are finished)
@@ -322,6 +542,8 @@ void LibraryScanner::cleanUpScan() {
             m_scannerGlobal->verifiedDirectories(),
             false,
             true);
+    m_libraryHashDao.updateDirectoryModifiedTimes(
+            m_scannerGlobal->directoryModifiedTimes());
     m_trackDao.markTracksInDirectoriesAsVerified(
             m_scannerGlobal->verifiedDirectories());
 
@@ -411,6 +633,10 @@ void LibraryScanner::slotFinishUnhashedScan() {
         cleanUpScan();
     }
 
+    if (!m_scannerGlobal->shouldCancel() && bScanFinishedCleanly) {
+        updateWatchedDirectories();
+    }
+
     if (!m_scannerGlobal->shouldCancel() && bScanFinishedCleanly) {
         const auto dbConnection = mixxx::DbConnectionPooled(m_pDbConnectionPool);
         updateQueryPlannerStatisticsForDatabase(dbConnection);
@@ -558,6 +784,10 @@ void LibraryScanner::slotDirectoryUnchanged(const QString& directoryPath) {
     emit progressHashing(directoryPath);
 }
 
+void LibraryScanner::slotWatchedDirectoryChanged(const QString& directoryPath) {
+    m_libraryHashDao.recordChangedDirectory(directoryPath);
+}
+
 void LibraryScanner::slotTrackExists(const QString& trackPath) {
     //kLogger.debug() << "slotTrackExists" << trackPath;
     ScopedTimer timer(QStringLiteral("LibraryScanner::slotTrackExists"));
@@ -566,13 +796,15 @@ void LibraryScanner::slotTrackExists(const QString& trackPath) {
     }
 }
 
-void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
+void LibraryScanner::slotAddNewTrack(const QString& trackPath,
+        const SoundSourceProxy::PrefetchedMetadata& prefetchedMetadata) {
     //kLogger.debug() << "slotAddNewTrack" << trackPath;
     ScopedTimer timer(QStringLiteral("LibraryScanner::addNewTrack"));
     // For statistics tracking and to detect moved tracks
     TrackPointer pTrack = m_trackDao.addTracksAddFile(
-            trackPath,
-            false);
+            mixxx::FileAccess(mixxx::FileInfo(trackPath)),
+            false,
+            &prefetchedMetadata);
     if (pTrack) {
         DEBUG_ASSERT(!pTrack->isDirty());
         // The track's actual location might differ from the
@@ -7,6 +7,7 @@
 #include <QSemaphore>
 #include <QThread>
 #include <QThreadPool>
+#include <memory>
 
 #include "library/dao/analysisdao.h"
 #include "library/dao/cuedao.h"
@@ -15,11 +16,13 @@
 #include "library/dao/playlistdao.h"
 #include "library/dao/trackdao.h"
 #include "library/scanner/scannerglobal.h"
+#include "sources/soundsourceproxy.h"
 #include "track/track_decl.h"
 #include "util/db/dbconnectionpool.h"
 
 class ScannerTask;
 class LibraryScannerDlg;
+class QFileSystemWatcher;
 class QString;
 
 class LibraryScanner : public QThread {
@@ -69,7 +72,11 @@ class LibraryScanner : public QThread {
                                    bool newDirectory, mixxx::cache_key_t hash);
     void slotDirectoryUnchanged(const QString& directoryPath);
     void slotTrackExists(const QString& trackPath);
-    void slotAddNewTrack(const QString& trackPath);
+
+    // QFileSystemWatcher signal handler
+    void slotWatchedDirectoryChanged(const QString& directoryPath);
+    void slotAddNewTrack(const QString& trackPath,
+            const SoundSourceProxy::PrefetchedMetadata& prefetchedMetadata);
 
   private:
     enum ScannerState {
@@ -95,7 +102,18 @@ class LibraryScanner : public QThread {
 
     void cleanUpScan();
 
+    bool isInLibraryRootDir(const QString& directoryPath) const;
+    void queueChangedDirectories(
+            const QHash<QString, mixxx::cache_key_t>& directoryHashes);
+    void updateWatchedDirectories();
+    // Returns false if not all directories could be watched
+    bool watchDirectories(QSet<QString> unwatchedDirectories);
+    // Starts watching the library directories and records the directories
+    // that have been modified since they have been scanned.
+    void recordChangesSinceLastScan();
+
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+    const UserSettingsPointer m_pConfig;
 
     // The pool of threads used for worker tasks.
     QThreadPool m_pool;
@@ -119,5 +137,15 @@ class LibraryScanner : public QThread {
     volatile ScannerState m_state;
 
     QList<mixxx::FileInfo> m_libraryRootDirs;
+
+    // Watches all library directories for changes and records them in the
+    // change journal, if enabled. Only created and used in the scanner
+    // thread.
+    std::unique_ptr<QFileSystemWatcher> m_pDirectoryWatcher;
+    // The change journal is complete if all library directories have been
+    // watched since the last scan or since their modification times have
+    // been compared on startup. Otherwise the next scan needs to visit all
+    // directories.
+    bool m_changeJournalComplete;
     QScopedPointer<LibraryScannerDlg> m_pProgressDlg;
 };
@@ -1,6 +1,7 @@
 #include "library/scanner/recursivescandirectorytask.h"
 
 #include <QCryptographicHash>
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
 
@@ -9,6 +10,13 @@
 #include "moc_recursivescandirectorytask.cpp"
 #include "util/timer.h"
 
+namespace {
+
+// FAT file systems store modification times with a resolution of 2 s
+constexpr qint64 kModifiedTimeResolutionSecs = 2;
+
+} // anonymous namespace
+
 RecursiveScanDirectoryTask::RecursiveScanDirectoryTask(
         LibraryScanner* pScanner,
         const ScannerGlobalPointer& scannerGlobal,
@@ -30,6 +38,19 @@ void RecursiveScanDirectoryTask::run() {
     //qDebug() << "Burn CPU";
     //for (int i = 0;i < 1000000000; i++) asm("nop");
 
+    // The modification time is taken before listing the directory, so any
+    // change while listing it results in a different time. Times that are
+    // too recent to distinguish a later change within the resolution of the
+    // file system are not stored.
+    {
+        const QDateTime listedAt = QDateTime::currentDateTimeUtc();
+        QDateTime modified = QFileInfo(m_dirAccess.info().location()).lastModified();
+        if (modified.secsTo(listedAt) < kModifiedTimeResolutionSecs) {
+            modified = QDateTime();
+        }
+        m_scannerGlobal->setDirectoryModifiedTime(m_dirAccess.info().location(), modified);
+    }
+
     // Note, we save on filesystem operations (and random work) by initializing
     // a QDirIterator with a QDir instead of a QString -- but it inherits its
     // Filter from the QDir so we have to set it first. If the QDir has not done
@@ -117,6 +138,13 @@ void RecursiveScanDirectoryTask::run() {
 
     // Process all of the sub-directories.
     for (const mixxx::FileInfo& dirInfo : dirsToScan) {
+        if (m_scannerGlobal->isIncremental() &&
+                mixxx::isValidCacheKey(m_scannerGlobal->directoryHashInDatabase(
+                        dirInfo.location()))) {
+            // Known directories are only scanned if they are listed in
+            // the change journal.
+            continue;
+        }
         // Atomically test and mark the directory as scanned to avoid
         // that the same directory is scanned multiple times by different
         // tasks.
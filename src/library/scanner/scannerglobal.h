@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QDateTime>
 #include <QDir>
 #include <QHash>
 #include <QMutex>
@@ -20,15 +21,18 @@ class ScannerGlobal {
             const QHash<QString, mixxx::cache_key_t>& directoryHashes,
             const QRegularExpression& supportedExtensionsMatcher,
             const QRegularExpression& supportedCoverExtensionsMatcher,
-            const QStringList& directoriesBlacklist)
+            const QStringList& directoriesBlacklist,
+            bool resetMissingTagMetadataOnImport)
             : m_trackLocations(trackLocations),
               m_directoryHashes(directoryHashes),
               m_supportedExtensionsMatcher(supportedExtensionsMatcher),
               m_supportedCoverExtensionsMatcher(supportedCoverExtensionsMatcher),
               m_directoriesBlacklist(directoriesBlacklist),
+              m_resetMissingTagMetadataOnImport(resetMissingTagMetadataOnImport),
               // Unless marked un-clean, we assume it will finish cleanly.
               m_scanFinishedCleanly(true),
               m_shouldCancel(false),
+              m_incremental(false),
               m_numScannedDirectories(0) {
     }
 
@@ -54,6 +58,23 @@ class ScannerGlobal {
         return m_supportedExtensionsMatcher;
     }
 
+    // Whether tags that are missing in a file reset the imported metadata,
+    // as configured when the scan was started.
+    bool resetMissingTagMetadataOnImport() const {
+        return m_resetMissingTagMetadataOnImport;
+    }
+
+    // An incremental scan only visits the directories that have changed
+    // according to the change journal. Known sub-directories are not
+    // visited recursively, only new ones. Must be set before any tasks are
+    // started.
+    bool isIncremental() const {
+        return m_incremental;
+    }
+    void setIncremental() {
+        m_incremental = true;
+    }
+
     bool testAndMarkDirectoryScanned(const QDir& dir) {
         const QString canonicalPath(dir.canonicalPath());
         const auto locker = lockMutex(&m_directoriesScannedMutex);
@@ -114,6 +135,19 @@ class ScannerGlobal {
         m_scanFinishedCleanly = false;
     }
 
+    // The modification time of a directory before it has been listed.
+    // Stored when the scan has finished cleanly, to detect changes
+    // while Mixxx is not running.
+    void setDirectoryModifiedTime(const QString& directoryPath, const QDateTime& modified) {
+        const auto locker = lockMutex(&m_directoryModifiedTimesMutex);
+        m_directoryModifiedTimes.insert(directoryPath, modified);
+    }
+
+    QHash<QString, QDateTime> directoryModifiedTimes() const {
+        const auto locker = lockMutex(&m_directoryModifiedTimesMutex);
+        return m_directoryModifiedTimes;
+    }
+
     void addVerifiedDirectory(const QString& directory) {
         m_verifiedDirectories << directory;
     }
@@ -171,6 +205,9 @@ class ScannerGlobal {
     mutable QMutex m_directoriesScannedMutex;
     QSet<QString> m_directoriesScanned;
 
+    mutable QMutex m_directoryModifiedTimesMutex;
+    QHash<QString, QDateTime> m_directoryModifiedTimes;
+
     // This set will collect all locations of new
     // discovered directories, they are scanned in a
     // second run to avoid swapping between duplicated tracks
@@ -182,6 +219,8 @@ class ScannerGlobal {
     // this has never been investigated.
     QStringList m_directoriesBlacklist;
 
+    const bool m_resetMissingTagMetadataOnImport;
+
     // The list of directories verified by the scan.
     QStringList m_verifiedDirectories;
 
@@ -193,6 +232,7 @@ class ScannerGlobal {
 
     volatile bool m_scanFinishedCleanly;
     volatile bool m_shouldCancel;
+    bool m_incremental;
 
     // Stats tracking.
     PerformanceTimer m_timer;
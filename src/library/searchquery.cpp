@@ -170,14 +170,32 @@ QString NotNode::toSql() const {
 TextFilterNode::TextFilterNode(const QSqlDatabase& database,
         const QStringList& sqlColumns,
         const QString& argument,
-        const StringMatch matchMode)
+        const StringMatch matchMode,
+        bool useFullTextIndex)
         : m_database(database),
           m_sqlColumns(sqlColumns),
           m_argument(argument),
-          m_matchMode(matchMode) {
+          m_matchMode(matchMode),
+          m_useFullTextIndex(useFullTextIndex) {
     mixxx::DbConnection::makeStringLatinLow(&m_argument);
 }
 
+bool TextFilterNode::canUseFullTextIndex() const {
+    if (!m_useFullTextIndex || m_matchMode != StringMatch::Contains) {
+        return false;
+    }
+    // The trigram tokenizer can only find substrings with 3 or more
+    // characters
+    if (m_argument.toUcs4().size() < 3) {
+        return false;
+    }
+    // Wildcards in the argument are not escaped for LIKE and the
+    // handling of a trailing space differs
+    return !m_argument.contains(kSqlLikeMatchAll) &&
+            !m_argument.contains(kSqlLikeMatchOne) &&
+            !m_argument.back().isSpace();
+}
+
 bool TextFilterNode::match(const TrackPointer& pTrack) const {
     for (const auto& sqlColumn : m_sqlColumns) {
         QVariant value = getTrackValueForColumn(pTrack, sqlColumn);
@@ -222,8 +240,26 @@ QString TextFilterNode::toSql() const {
         break;
     }
     QStringList searchClauses;
+    QStringList indexedColumns;
+    const bool useFullTextIndex = canUseFullTextIndex();
     for (const auto& sqlColumn : m_sqlColumns) {
-        searchClauses << QString("%1 LIKE %2").arg(sqlColumn, escapedArgument);
+        if (useFullTextIndex && LIBRARYFTS_COLUMNS.contains(sqlColumn)) {
+            indexedColumns << sqlColumn;
+        } else {
+            searchClauses << QString("%1 LIKE %2").arg(sqlColumn, escapedArgument);
+        }
+    }
+    if (!indexedColumns.isEmpty()) {
+        // The argument is searched as a single phrase, i.e. a substring,
+        // in all indexed columns at once
+        QString phrase = m_argument;
+        phrase.replace(QChar('"'), QStringLiteral("\"\""));
+        const QString matchExpression = QStringLiteral("{%1} : \"%2\"")
+                                                .arg(indexedColumns.join(' '), phrase);
+        searchClauses.prepend(
+                QStringLiteral("id IN (SELECT rowid FROM " LIBRARYFTS_TABLE
+                               " WHERE " LIBRARYFTS_TABLE " MATCH %1)")
+                        .arg(escaper.escapeString(matchExpression)));
     }
     return concatSqlClauses(searchClauses, "OR");
 }
@@ -77,19 +77,26 @@ class NotNode : public QueryNode {
 
 class TextFilterNode : public QueryNode {
   public:
+    /// If useFullTextIndex is set the columns that are contained in the
+    /// full-text index of the library are searched with MATCH instead of
+    /// LIKE where both produce the same results.
     TextFilterNode(const QSqlDatabase& database,
             const QStringList& sqlColumns,
             const QString& argument,
-            const StringMatch matchMode = StringMatch::Contains);
+            const StringMatch matchMode = StringMatch::Contains,
+            bool useFullTextIndex = false);
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
 
   private:
+    bool canUseFullTextIndex() const;
+
     QSqlDatabase m_database;
     QStringList m_sqlColumns;
     QString m_argument;
     StringMatch m_matchMode;
+    bool m_useFullTextIndex;
 };
 
 class NullOrEmptyTextFilterNode : public QueryNode {
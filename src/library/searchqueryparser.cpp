@@ -69,7 +69,8 @@ const QRegularExpression kSplitOnOrOperatorRegexp = QRegularExpression(
 
 SearchQueryParser::SearchQueryParser(TrackCollection* pTrackCollection, QStringList searchColumns)
         : m_pTrackCollection(pTrackCollection),
-          m_searchCrates(false) {
+          m_searchCrates(false),
+          m_useFullTextIndex(false) {
     setSearchColumns(std::move(searchColumns));
 
     m_textFilters << "artist"
@@ -206,7 +207,8 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                             m_pTrackCollection->database(),
                             m_fieldToSqlColumns[field],
                             argument,
-                            matchMode);
+                            matchMode,
+                            m_useFullTextIndex);
                 }
             }
         } else if (numericFilterMatch.hasMatch()) {
@@ -281,11 +283,19 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                     gNode->addNode(std::make_unique<CrateFilterNode>(
                                     &m_pTrackCollection->crates(), argument));
                     gNode->addNode(std::make_unique<TextFilterNode>(
-                            m_pTrackCollection->database(), m_queryColumns, argument));
+                            m_pTrackCollection->database(),
+                            m_queryColumns,
+                            argument,
+                            StringMatch::Contains,
+                            m_useFullTextIndex));
                     pNode = std::move(gNode);
                 } else {
                     pNode = std::make_unique<TextFilterNode>(
-                            m_pTrackCollection->database(), m_queryColumns, argument);
+                            m_pTrackCollection->database(),
+                            m_queryColumns,
+                            argument,
+                            StringMatch::Contains,
+                            m_useFullTextIndex);
                 }
             }
         }
@@ -17,6 +17,12 @@ class SearchQueryParser {
 
     void setSearchColumns(QStringList searchColumns);
 
+    /// Search the text columns of the internal library with the
+    /// full-text index, see TrackDAO::hasFullTextIndex().
+    void setUseFullTextIndex(bool useFullTextIndex) {
+        m_useFullTextIndex = useFullTextIndex;
+    }
+
     std::unique_ptr<QueryNode> parseQuery(
             const QString& query,
             const QString& extraFilter) const;
@@ -45,6 +51,7 @@ class SearchQueryParser {
     TrackCollection* m_pTrackCollection;
     QStringList m_queryColumns;
     bool m_searchCrates;
+    bool m_useFullTextIndex;
     QStringList m_textFilters;
     QStringList m_numericFilters;
     QStringList m_specialFilters;
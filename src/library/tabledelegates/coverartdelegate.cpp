@@ -81,7 +81,13 @@ void CoverArtDelegate::requestUncachedCover(
 void CoverArtDelegate::slotInhibitLazyLoading(
         bool inhibitLazyLoading) {
     m_inhibitLazyLoading = inhibitLazyLoading;
-    if (m_inhibitLazyLoading || m_cacheMissRows.isEmpty()) {
+    if (m_inhibitLazyLoading) {
+        // Covers of rows that have been scrolled out of view
+        // do not need to be loaded anymore
+        cancelInvisibleCoverRequests();
+        return;
+    }
+    if (m_cacheMissRows.isEmpty()) {
         return;
     }
     VERIFY_OR_DEBUG_ASSERT(m_pTrackModel) {
@@ -191,3 +197,33 @@ void CoverArtDelegate::cleanCacheMissRows() const {
         }
     }
 }
+
+void CoverArtDelegate::cancelInvisibleCoverRequests() {
+    if (m_pendingCacheRows.isEmpty()) {
+        return;
+    }
+    QSet<mixxx::cache_key_t> visibleCacheKeys;
+    QSet<mixxx::cache_key_t> invisibleCacheKeys;
+    auto it = m_pendingCacheRows.begin();
+    while (it != m_pendingCacheRows.end()) {
+        const QModelIndex index = m_pTableView->model()->index(it.value(), m_column);
+        const QRect rect = m_pTableView->visualRect(index);
+        if (rect.intersects(m_pTableView->rect())) {
+            visibleCacheKeys.insert(it.key());
+            ++it;
+        } else {
+            invisibleCacheKeys.insert(it.key());
+            it = m_pendingCacheRows.erase(it);
+        }
+    }
+    // Multiple rows might share the same cover
+    invisibleCacheKeys.subtract(visibleCacheKeys);
+    for (const auto cacheKey : std::as_const(invisibleCacheKeys)) {
+        if (kLogger.traceEnabled()) {
+            kLogger.trace()
+                    << "Canceling request for invisible cover"
+                    << cacheKey;
+        }
+        CoverArtCache::cancelUncachedCover(this, cacheKey);
+    }
+}
@@ -11,6 +11,7 @@
 #include "track/track.h"
 #include "util/assert.h"
 #include "util/db/dbconnectionpooled.h"
+#include "util/db/dbqueryexecutor.h"
 #include "util/logger.h"
 
 namespace {
@@ -41,7 +42,8 @@ TrackCollectionManager::TrackCollectionManager(
         deleteTrackFn_t /*only-needed-for-testing*/ deleteTrackForTestingFn)
     : QObject(parent),
       m_pConfig(pConfig),
-      m_pInternalCollection(createInternalTrackCollection(this, pConfig, deleteTrackForTestingFn)) {
+      m_pInternalCollection(createInternalTrackCollection(this, pConfig, deleteTrackForTestingFn)),
+      m_pQueryExecutor(std::make_unique<mixxx::DbQueryExecutor>(pDbConnectionPool)) {
     const QSqlDatabase dbConnection = mixxx::DbConnectionPooled(pDbConnectionPool);
 
     // TODO(XXX): Add a checkbox in the library preferences for checking
@@ -17,6 +17,10 @@ class TrackCollection;
 class ExternalTrackCollection;
 class RelocatedTrack;
 
+namespace mixxx {
+class DbQueryExecutor;
+} // namespace mixxx
+
 // Manages Mixxx's internal database of tracks as well as external track collections.
 //
 // All modifying operations that might affect external collections
@@ -47,6 +51,12 @@ class TrackCollectionManager: public QObject,
         return m_externalCollections;
     }
 
+    /// Executes queries on a separate connection to the internal
+    /// collection without blocking the calling thread.
+    mixxx::DbQueryExecutor* queryExecutor() const {
+        return m_pQueryExecutor.get();
+    }
+
     TrackPointer getTrackById(
             TrackId trackId) const;
     TrackPointer getTrackByRef(
@@ -126,6 +136,8 @@ class TrackCollectionManager: public QObject,
 
     QList<ExternalTrackCollection*> m_externalCollections;
 
+    const std::unique_ptr<mixxx::DbQueryExecutor> m_pQueryExecutor;
+
     // TODO: Extract and decouple LibraryScanner from TrackCollectionManager
     std::unique_ptr<LibraryScanner> m_pScanner;
 };
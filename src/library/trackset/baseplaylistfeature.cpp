@@ -3,8 +3,9 @@
 #include <QAction>
 #include <QFileInfo>
 #include <QInputDialog>
+#include <QFutureWatcher>
 #include <QList>
-#include <QSqlTableModel>
+#include <QSqlQuery>
 #include <QStandardPaths>
 
 #include "library/export/trackexportwizard.h"
@@ -13,6 +14,7 @@
 #include "library/parser.h"
 #include "library/parsercsv.h"
 #include "library/playlisttablemodel.h"
+#include "library/queryutil.h"
 #include "library/trackcollection.h"
 #include "library/trackcollectionmanager.h"
 #include "library/treeitem.h"
@@ -21,6 +23,7 @@
 #include "track/track.h"
 #include "track/trackid.h"
 #include "util/assert.h"
+#include "util/db/dbqueryexecutor.h"
 #include "util/defs.h"
 #include "util/file.h"
 #include "widget/wlibrary.h"
@@ -721,46 +724,6 @@ void BasePlaylistFeature::htmlLinkClicked(const QUrl& link) {
     }
 }
 
-QString BasePlaylistFeature::fetchPlaylistLabel(int playlistId) {
-    // This queries the temporary id/count/duration table that was has been created
-    // by the features' createPlaylistLabels() (updated each time playlists are added/removed)
-    QSqlDatabase database =
-            m_pLibrary->trackCollectionManager()->internalCollection()->database();
-    VERIFY_OR_DEBUG_ASSERT(database.tables(QSql::Views).contains(m_countsDurationTableName)) {
-        qWarning() << "BasePlaylistFeature: view" << m_countsDurationTableName
-                   << "does not exist! Can't fetch label for playlist" << playlistId;
-        return QString();
-    }
-    QSqlTableModel playlistTableModel(this, database);
-    playlistTableModel.setTable(m_countsDurationTableName);
-    const QString filter = "id=" + QString::number(playlistId);
-    playlistTableModel.setFilter(filter);
-    playlistTableModel.select();
-    while (playlistTableModel.canFetchMore()) {
-        playlistTableModel.fetchMore();
-    }
-    QSqlRecord record = playlistTableModel.record();
-    int nameColumn = record.indexOf("name");
-    int countColumn = record.indexOf("count");
-    int durationColumn = record.indexOf("durationSeconds");
-
-    DEBUG_ASSERT(playlistTableModel.rowCount() <= 1);
-    if (playlistTableModel.rowCount() > 0) {
-        QString name =
-                playlistTableModel.data(playlistTableModel.index(0, nameColumn))
-                        .toString();
-        int count = playlistTableModel
-                            .data(playlistTableModel.index(0, countColumn))
-                            .toInt();
-        int duration =
-                playlistTableModel
-                        .data(playlistTableModel.index(0, durationColumn))
-                        .toInt();
-        return createPlaylistLabel(name, count, duration);
-    }
-    return QString();
-}
-
 void BasePlaylistFeature::updateChildModel(const QSet<int>& playlistIds) {
     // qDebug() << "BasePlaylistFeature::updateChildModel() for"
     //          << playlistIds.count() << "playlist(s)";
@@ -768,8 +731,55 @@ void BasePlaylistFeature::updateChildModel(const QSet<int>& playlistIds) {
         return;
     }
 
+    // This queries the temporary id/count/duration view that has been created
+    // by the features' createPlaylistLabels() (updated each time playlists are
+    // added/removed). The view is created again on the connection of the query
+    // executor if needed.
+    QSqlDatabase database =
+            m_pLibrary->trackCollectionManager()->internalCollection()->database();
+    mixxx::DbQueryExecutor* pQueryExecutor =
+            m_pLibrary->trackCollectionManager()->queryExecutor();
+    QString viewSql;
+    if (!pQueryExecutor ||
+            !mixxx::DbQueryExecutor::isVisibleFromExecutor(
+                    database, m_countsDurationTableName, &viewSql) ||
+            viewSql.isEmpty()) {
+        updateChildModelLabels(playlistIds,
+                selectPlaylistSummaries(
+                        database, m_countsDurationTableName, QString(), playlistIds));
+        return;
+    }
+
+    auto* pWatcher = new QFutureWatcher<QList<PlaylistSummary>>(this);
+    connect(pWatcher,
+            &QFutureWatcher<QList<PlaylistSummary>>::finished,
+            this,
+            [this, pWatcher, playlistIds]() {
+                pWatcher->deleteLater();
+                if (!pWatcher->isCanceled()) {
+                    updateChildModelLabels(playlistIds, pWatcher->result());
+                }
+            });
+    pWatcher->setFuture(pQueryExecutor->execute<QList<PlaylistSummary>>(
+            [viewName = m_countsDurationTableName, viewSql, playlistIds](
+                    const QSqlDatabase& database) {
+                return selectPlaylistSummaries(
+                        database, viewName, viewSql, playlistIds);
+            }));
+}
+
+void BasePlaylistFeature::updateChildModelLabels(
+        const QSet<int>& playlistIds,
+        const QList<PlaylistSummary>& playlistSummaries) {
+    QHash<int, QString> labels;
+    for (const auto& playlistSummary : playlistSummaries) {
+        labels.insert(playlistSummary.id,
+                createPlaylistLabel(playlistSummary.name,
+                        playlistSummary.count,
+                        playlistSummary.duration));
+    }
+
     int id = kInvalidPlaylistId;
-    QString label;
     bool ok = false;
 
     for (int row = 0; row < m_pSidebarModel->rowCount(); ++row) {
@@ -780,8 +790,7 @@ void BasePlaylistFeature::updateChildModel(const QSet<int>& playlistIds) {
             for (TreeItem* pChild : pTreeItem->children()) {
                 id = pChild->getData().toInt(&ok);
                 if (ok && id != kInvalidPlaylistId && playlistIds.contains(id)) {
-                    label = fetchPlaylistLabel(id);
-                    pChild->setLabel(label);
+                    pChild->setLabel(labels.value(id));
                     decorateChild(pChild, id);
                     markTreeItem(pChild);
                 }
@@ -789,8 +798,7 @@ void BasePlaylistFeature::updateChildModel(const QSet<int>& playlistIds) {
         } else {
             id = pTreeItem->getData().toInt(&ok);
             if (ok && id != kInvalidPlaylistId && playlistIds.contains(id)) {
-                label = fetchPlaylistLabel(id);
-                pTreeItem->setLabel(label);
+                pTreeItem->setLabel(labels.value(id));
                 decorateChild(pTreeItem, id);
                 markTreeItem(pTreeItem);
             }
@@ -799,6 +807,42 @@ void BasePlaylistFeature::updateChildModel(const QSet<int>& playlistIds) {
     m_pSidebarModel->triggerRepaint();
 }
 
+// static
+QList<BasePlaylistFeature::PlaylistSummary> BasePlaylistFeature::selectPlaylistSummaries(
+        const QSqlDatabase& database,
+        const QString& viewName,
+        const QString& viewSql,
+        const QSet<int>& playlistIds) {
+    QList<PlaylistSummary> playlistSummaries;
+    if (!viewSql.isEmpty() &&
+            !mixxx::DbQueryExecutor::createTemporaryView(
+                    database, viewName, viewSql)) {
+        return playlistSummaries;
+    }
+    QStringList idStrings;
+    idStrings.reserve(playlistIds.size());
+    for (int playlistId : playlistIds) {
+        idStrings << QString::number(playlistId);
+    }
+    QSqlQuery query(database);
+    query.setForwardOnly(true);
+    if (!query.exec(QStringLiteral(
+                "SELECT id,name,count,durationSeconds FROM %1 WHERE id IN (%2)")
+                        .arg(viewName, idStrings.join(",")))) {
+        LOG_FAILED_QUERY(query);
+        return playlistSummaries;
+    }
+    while (query.next()) {
+        PlaylistSummary playlistSummary;
+        playlistSummary.id = query.value(0).toInt();
+        playlistSummary.name = query.value(1).toString();
+        playlistSummary.count = query.value(2).toInt();
+        playlistSummary.duration = query.value(3).toInt();
+        playlistSummaries.append(playlistSummary);
+    }
+    return playlistSummaries;
+}
+
 /// Clears the child model dynamically, but the invisible root item remains
 void BasePlaylistFeature::clearChildModel() {
     m_lastClickedIndex = QModelIndex();
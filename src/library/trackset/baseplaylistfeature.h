@@ -1,8 +1,10 @@
 #pragma once
 
+#include <QList>
 #include <QModelIndex>
 #include <QPointer>
 #include <QSet>
+#include <QSqlDatabase>
 #include <QString>
 
 #include "library/dao/playlistdao.h"
@@ -129,7 +131,22 @@ class BasePlaylistFeature : public BaseTrackSetFeature {
     void connectPlaylistDAO();
     virtual QString getRootViewHtml() const = 0;
     void markTreeItem(TreeItem* pTreeItem);
-    QString fetchPlaylistLabel(int playlistId);
+
+    // The columns of the id/count/duration view of a playlist
+    struct PlaylistSummary {
+        int id = kInvalidPlaylistId;
+        QString name;
+        int count = 0;
+        int duration = 0;
+    };
+    static QList<PlaylistSummary> selectPlaylistSummaries(
+            const QSqlDatabase& database,
+            const QString& viewName,
+            const QString& viewSql,
+            const QSet<int>& playlistIds);
+    void updateChildModelLabels(
+            const QSet<int>& playlistIds,
+            const QList<PlaylistSummary>& playlistSummaries);
 
 
     const bool m_keepHiddenTracks;
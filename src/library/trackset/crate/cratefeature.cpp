@@ -3,6 +3,7 @@
 #include <QInputDialog>
 #include <QLineEdit>
 #include <QMenu>
+#include <QFutureWatcher>
 #include <QStandardPaths>
 #include <algorithm>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "moc_cratefeature.cpp"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
+#include "util/db/dbqueryexecutor.h"
 #include "util/defs.h"
 #include "util/file.h"
 #include "widget/wlibrary.h"
@@ -586,15 +588,42 @@ QModelIndex CrateFeature::rebuildChildModel(CrateId selectedCrateId) {
 }
 
 void CrateFeature::updateChildModel(const QSet<CrateId>& updatedCrateIds) {
-    const CrateStorage& crateStorage = m_pTrackCollection->crates();
-    for (const CrateId& crateId : updatedCrateIds) {
-        QModelIndex index = indexFromCrateId(crateId);
-        VERIFY_OR_DEBUG_ASSERT(index.isValid()) {
-            continue;
-        }
-        CrateSummary crateSummary;
-        VERIFY_OR_DEBUG_ASSERT(
-                crateStorage.readCrateSummaryById(crateId, &crateSummary)) {
+    mixxx::DbQueryExecutor* pQueryExecutor =
+            m_pLibrary->trackCollectionManager()->queryExecutor();
+    if (!pQueryExecutor) {
+        updateTreeItemsForCrateSummaries(readCrateSummaries(
+                m_pTrackCollection->crates(), updatedCrateIds));
+        return;
+    }
+
+    // Summarizing the tracks of large crates takes a while
+    auto* pWatcher = new QFutureWatcher<QList<CrateSummary>>(this);
+    connect(pWatcher,
+            &QFutureWatcher<QList<CrateSummary>>::finished,
+            this,
+            [this, pWatcher]() {
+                pWatcher->deleteLater();
+                if (!pWatcher->isCanceled()) {
+                    updateTreeItemsForCrateSummaries(pWatcher->result());
+                }
+            });
+    pWatcher->setFuture(pQueryExecutor->execute<QList<CrateSummary>>(
+            [updatedCrateIds](const QSqlDatabase& database) {
+                CrateStorage crateStorage;
+                crateStorage.connectDatabase(database);
+                const auto crateSummaries =
+                        readCrateSummaries(crateStorage, updatedCrateIds);
+                crateStorage.disconnectDatabase();
+                return crateSummaries;
+            }));
+}
+
+void CrateFeature::updateTreeItemsForCrateSummaries(
+        const QList<CrateSummary>& crateSummaries) {
+    for (const auto& crateSummary : crateSummaries) {
+        // The crate might have been deleted in the meantime
+        QModelIndex index = indexFromCrateId(crateSummary.getId());
+        if (!index.isValid()) {
             continue;
         }
         updateTreeItemForCrateSummary(
@@ -609,6 +638,20 @@ void CrateFeature::updateChildModel(const QSet<CrateId>& updatedCrateIds) {
     }
 }
 
+// static
+QList<CrateSummary> CrateFeature::readCrateSummaries(
+        const CrateStorage& crateStorage,
+        const QSet<CrateId>& crateIds) {
+    QList<CrateSummary> crateSummaries;
+    for (const CrateId& crateId : crateIds) {
+        CrateSummary crateSummary;
+        if (crateStorage.readCrateSummaryById(crateId, &crateSummary)) {
+            crateSummaries.append(crateSummary);
+        }
+    }
+    return crateSummaries;
+}
+
 CrateId CrateFeature::crateIdFromIndex(const QModelIndex& index) const {
     if (!index.isValid()) {
         return CrateId();
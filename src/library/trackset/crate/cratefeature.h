@@ -18,6 +18,7 @@ class Library;
 class WLibrarySidebar;
 class QAction;
 class QPoint;
+class CrateStorage;
 class CrateSummary;
 
 class CrateFeature : public BaseTrackSetFeature {
@@ -91,6 +92,10 @@ class CrateFeature : public BaseTrackSetFeature {
 
     QModelIndex rebuildChildModel(CrateId selectedCrateId = CrateId());
     void updateChildModel(const QSet<CrateId>& updatedCrateIds);
+    void updateTreeItemsForCrateSummaries(const QList<CrateSummary>& crateSummaries);
+    static QList<CrateSummary> readCrateSummaries(
+            const CrateStorage& crateStorage,
+            const QSet<CrateId>& crateIds);
 
     CrateId crateIdFromIndex(const QModelIndex& index) const;
     QModelIndex indexFromCrateId(CrateId crateId) const;
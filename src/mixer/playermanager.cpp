@@ -5,6 +5,7 @@
 #include "audio/types.h"
 #include "control/controlobject.h"
 #include "effects/effectsmanager.h"
+#include "engine/cachingreader/trackpreloader.h"
 #include "engine/channels/enginedeck.h"
 #include "engine/enginemixer.h"
 #include "library/library.h"
@@ -33,6 +34,20 @@ const QString kLegacyGroup = QStringLiteral("[Master]");
 // Utilize half of the available cores for adhoc analysis of tracks
 const int kNumberOfAnalyzerThreads = math_max(1, QThread::idealThreadCount() / 2);
 
+// The maximum number of channels that are supported by decks, which
+// are the only players that tracks are preloaded for
+#ifdef __STEM__
+constexpr mixxx::audio::ChannelCount kPreloadChannelCount =
+        mixxx::audio::ChannelCount::stem();
+#else
+constexpr mixxx::audio::ChannelCount kPreloadChannelCount =
+        mixxx::audio::ChannelCount::stereo();
+#endif
+
+// Scrolling through the library selects many tracks in a row, which
+// are not preloaded
+constexpr int kPreloadSelectedTrackDelayMillis = 500;
+
 const QRegularExpression kDeckRegex(QStringLiteral("^\\[Channel(\\d+)\\]$"));
 const QRegularExpression kSamplerRegex(QStringLiteral("^\\[Sampler(\\d+)\\]$"));
 const QRegularExpression kPreviewDeckRegex(QStringLiteral("^\\[PreviewDeck(\\d+)\\]$"));
@@ -121,7 +136,8 @@ PlayerManager::PlayerManager(UserSettingsPointer pConfig,
                   ConfigKey(kAppGroup, QStringLiteral("num_microphones")), true, true)),
           m_pCONumAuxiliaries(std::make_unique<ControlObject>(
                   ConfigKey(kAppGroup, QStringLiteral("num_auxiliaries")), true, true)),
-          m_pTrackAnalysisScheduler(TrackAnalysisScheduler::NullPointer()) {
+          m_pTrackAnalysisScheduler(TrackAnalysisScheduler::NullPointer()),
+          m_pTrackPreloader(std::make_unique<TrackPreloader>()) {
     m_pCONumDecks->addAlias(ConfigKey(kLegacyGroup, QStringLiteral("num_decks")));
     m_pCONumDecks->connectValueChangeRequest(this,
             &PlayerManager::slotChangeNumDecks, Qt::DirectConnection);
@@ -138,6 +154,13 @@ PlayerManager::PlayerManager(UserSettingsPointer pConfig,
     m_pCONumAuxiliaries->connectValueChangeRequest(this,
             &PlayerManager::slotChangeNumAuxiliaries, Qt::DirectConnection);
 
+    m_preloadSelectedTrackTimer.setSingleShot(true);
+    m_preloadSelectedTrackTimer.setInterval(kPreloadSelectedTrackDelayMillis);
+    connect(&m_preloadSelectedTrackTimer,
+            &QTimer::timeout,
+            this,
+            &PlayerManager::slotPreloadSelectedTrack);
+
     // This is parented to the PlayerManager so does not need to be deleted
     m_pSamplerBank = new SamplerBank(m_pConfig, this);
 
@@ -166,6 +189,8 @@ PlayerManager::~PlayerManager() {
         m_pTrackAnalysisScheduler->stop();
         m_pTrackAnalysisScheduler.reset();
     }
+
+    m_pTrackPreloader.reset();
 }
 
 void PlayerManager::bindToLibrary(Library* pLibrary) {
@@ -176,6 +201,11 @@ void PlayerManager::bindToLibrary(Library* pLibrary) {
             &Library::loadTrack,
             this,
             &PlayerManager::slotLoadTrackIntoNextAvailableDeck);
+    // The selected track is likely to be loaded next
+    connect(pLibrary,
+            &Library::trackSelected,
+            this,
+            &PlayerManager::slotTrackSelected);
     connect(this,
             &PlayerManager::loadLocationToPlayer,
             pLibrary,
@@ -625,6 +655,38 @@ Sampler* PlayerManager::getSampler(unsigned int sampler) const {
     return m_samplers[sampler - 1];
 }
 
+bool PlayerManager::isLoadedIntoDeck(const TrackPointer& pTrack) const {
+    const auto locker = lockMutex(&m_mutex);
+    for (const auto* pDeck : std::as_const(m_decks)) {
+        if (pDeck->getLoadedTrack() == pTrack) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PlayerManager::preloadTrack(const TrackPointer& pTrack) {
+    if (!pTrack || isLoadedIntoDeck(pTrack)) {
+        return;
+    }
+    m_pTrackPreloader->preloadTrack(pTrack, kPreloadChannelCount);
+}
+
+void PlayerManager::slotTrackSelected(TrackPointer pTrack) {
+    // Only the latest selection is kept
+    m_pSelectedTrack = std::move(pTrack);
+    m_preloadSelectedTrackTimer.start();
+}
+
+void PlayerManager::slotPreloadSelectedTrack() {
+    const TrackPointer pTrack = std::move(m_pSelectedTrack);
+    m_pSelectedTrack.reset();
+    if (!pTrack || isLoadedIntoDeck(pTrack)) {
+        return;
+    }
+    m_pTrackPreloader->preloadSelectedTrack(pTrack, kPreloadChannelCount);
+}
+
 TrackPointer PlayerManager::getLastEjectedTrack() const {
     VERIFY_OR_DEBUG_ASSERT(m_pLibrary != nullptr) {
         return nullptr;
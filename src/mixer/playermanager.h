@@ -5,6 +5,7 @@
 #include <QList>
 #include <QMap>
 #include <QObject>
+#include <QTimer>
 
 #include "analyzer/trackanalysisscheduler.h"
 #include "engine/channelhandle.h"
@@ -27,6 +28,7 @@ class Sampler;
 class SamplerBank;
 class SoundManager;
 class ControlProxy;
+class TrackPreloader;
 
 // For mocking PlayerManager
 class PlayerManagerInterface {
@@ -51,6 +53,10 @@ class PlayerManagerInterface {
     virtual Sampler* getSampler(unsigned int sampler) const = 0;
 
     virtual unsigned int numberOfSamplers() const = 0;
+
+    // Prepares a track that is likely to be loaded into a deck next
+    // in the background, e.g. by opening its audio source.
+    virtual void preloadTrack(const TrackPointer& pTrack) = 0;
 };
 
 class PlayerManager : public QObject, public PlayerManagerInterface {
@@ -125,6 +131,8 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
         return numSamplers();
     }
 
+    void preloadTrack(const TrackPointer& pTrack) override;
+
     // Returns the track that was last ejected or unloaded. Can return nullptr or
     // invalid TrackId in case of error.
     TrackPointer getLastEjectedTrack() const;
@@ -233,6 +241,11 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
   private slots:
     void slotAnalyzeTrack(TrackPointer track);
 
+    // Preloads the track that has been selected last when
+    // the selection doesn't change for a moment.
+    void slotTrackSelected(TrackPointer pTrack);
+    void slotPreloadSelectedTrack();
+
     void onTrackAnalysisProgress(TrackId trackId, AnalyzerProgress analyzerProgress);
     void onTrackAnalysisFinished();
 
@@ -264,6 +277,7 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
 
   private:
     TrackPointer lookupTrack(QString location);
+    bool isLoadedIntoDeck(const TrackPointer& pTrack) const;
     // Must hold m_mutex before calling this method. Internal method that
     // creates a new deck.
     void addDeckInner();
@@ -301,6 +315,10 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
 
     TrackAnalysisScheduler::Pointer m_pTrackAnalysisScheduler;
 
+    std::unique_ptr<TrackPreloader> m_pTrackPreloader;
+    QTimer m_preloadSelectedTrackTimer;
+    TrackPointer m_pSelectedTrack;
+
     TrackId m_secondLastEjectedTrackId;
     TrackId m_lastEjectedTrackId;
 
@@ -29,6 +29,7 @@ namespace {
 constexpr const char* kDoctype = "broadcastprofile";
 constexpr const char* kDocumentRoot = "BroadcastProfile";
 constexpr const char* kSecureCredentials = "SecureCredentialsStorage";
+constexpr const char* kAdaptiveBitrate = "AdaptiveBitrate";
 constexpr const char* kBitrate = "Bitrate";
 constexpr const char* kChannels = "Channels";
 constexpr const char* kCustomArtist = "CustomArtist";
@@ -65,6 +66,7 @@ constexpr const char* kStreamWebsite = "StreamWebsite";
 constexpr const char* kKeychainPrefix = "Mixxx - ";
 #endif
 
+constexpr bool kDefaultAdaptiveBitrate = false;
 constexpr int kDefaultBitrate = 128;
 constexpr int kDefaultChannels = 2;
 constexpr bool kDefaultEnableMetadata = false;
@@ -152,6 +154,7 @@ bool BroadcastProfile::valuesEquals(BroadcastProfilePtr other) {
             && getReconnectFirstDelay() == other->getReconnectFirstDelay()
             && getFormat() == other->getFormat()
             && getBitrate() == other->getBitrate()
+            && getAdaptiveBitrate() == other->getAdaptiveBitrate()
             && getChannels() == other->getChannels()
             && getMountpoint() == other->getMountpoint()
             && getStreamName() == other->getStreamName()
@@ -202,6 +205,7 @@ void BroadcastProfile::copyValuesTo(BroadcastProfilePtr other) {
 
     other->setFormat(this->getFormat());
     other->setBitrate(this->getBitrate());
+    other->setAdaptiveBitrate(this->getAdaptiveBitrate());
     other->setChannels(this->getChannels());
 
     other->setMountPoint(this->getMountpoint());
@@ -256,6 +260,7 @@ void BroadcastProfile::adoptDefaultValues() {
     m_oggDynamicUpdate = kDefaultOggDynamicupdate;
 
     m_bitrate = kDefaultBitrate;
+    m_adaptiveBitrate = kDefaultAdaptiveBitrate;
     m_channels = kDefaultChannels;
     m_format = QString();
 
@@ -333,6 +338,7 @@ bool BroadcastProfile::loadValues(const QString& filename) {
         m_format = ENCODING_OGG;
     }
     m_bitrate = XmlParse::selectNodeInt(doc, kBitrate);
+    m_adaptiveBitrate = (bool)XmlParse::selectNodeInt(doc, kAdaptiveBitrate);
     m_channels = XmlParse::selectNodeInt(doc, kChannels);
 
     m_enableMetadata = (bool)XmlParse::selectNodeInt(doc, kEnableMetadata);
@@ -397,6 +403,8 @@ bool BroadcastProfile::save(const QString& filename) {
     XmlParse::addElement(doc, docRoot, kFormat, m_format);
     XmlParse::addElement(doc, docRoot, kBitrate,
                          QString::number(m_bitrate));
+    XmlParse::addElement(doc, docRoot, kAdaptiveBitrate,
+                         QString::number((int)m_adaptiveBitrate));
     XmlParse::addElement(doc, docRoot, kChannels,
                          QString::number(m_channels));
 
@@ -726,6 +734,14 @@ void BroadcastProfile::setBitrate(int value) {
     m_bitrate = value;
 }
 
+bool BroadcastProfile::getAdaptiveBitrate() const {
+    return m_adaptiveBitrate;
+}
+
+void BroadcastProfile::setAdaptiveBitrate(bool value) {
+    m_adaptiveBitrate = value;
+}
+
 int BroadcastProfile::getChannels() const {
     return m_channels;
 }
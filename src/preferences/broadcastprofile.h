@@ -84,6 +84,10 @@ class BroadcastProfile : public QObject {
     int getBitrate() const;
     void setBitrate(int value);
 
+    // Temporarily lower the bitrate while the network can't keep up
+    bool getAdaptiveBitrate() const;
+    void setAdaptiveBitrate(bool value);
+
     int getChannels() const;
     void setChannels(int value);
 
@@ -182,6 +186,7 @@ class BroadcastProfile : public QObject {
 
     QString m_format;
     int m_bitrate;
+    bool m_adaptiveBitrate;
     int m_channels;
 
     bool m_enableMetadata;
@@ -22,6 +22,14 @@ const char* kSettingsGroupHeader = "Settings for %1";
 constexpr int kColumnEnabled = 0;
 constexpr int kColumnName = 1;
 const mixxx::Logger kLogger("DlgPrefBroadcast");
+
+// The bitrate can only be changed on the fly for streams without headers
+bool supportsAdaptiveBitrate(const QVariant& format) {
+    return format == ENCODING_MP3 ||
+            format == ENCODING_AAC ||
+            format == ENCODING_HEAAC ||
+            format == ENCODING_HEAACV2;
+}
 } // namespace
 
 DlgPrefBroadcast::DlgPrefBroadcast(QWidget *parent,
@@ -127,6 +135,8 @@ DlgPrefBroadcast::DlgPrefBroadcast(QWidget *parent,
              [this]() {
                  ogg_dynamicupdate->setEnabled(
                          comboBoxEncodingFormat->currentData() == ENCODING_OGG);
+                 checkBoxAdaptiveBitrate->setEnabled(supportsAdaptiveBitrate(
+                         comboBoxEncodingFormat->currentData()));
              });
      comboBoxEncodingFormat->addItem(tr("MP3"), ENCODING_MP3);
      comboBoxEncodingFormat->addItem(tr("Ogg Vorbis"), ENCODING_OGG);
@@ -514,6 +524,10 @@ void DlgPrefBroadcast::getValuesFromProfile(BroadcastProfilePtr profile) {
     }
     comboBoxEncodingChannels->setCurrentIndex(tmp_index);
 
+    // "Adapt bitrate" checkbox
+    checkBoxAdaptiveBitrate->setEnabled(supportsAdaptiveBitrate(profile->getFormat()));
+    checkBoxAdaptiveBitrate->setChecked(profile->getAdaptiveBitrate());
+
     // Metadata format
     metadata_format->setText(profile->getMetadataFormat());
 
@@ -555,6 +569,7 @@ void DlgPrefBroadcast::setValuesToProfile(BroadcastProfilePtr profile) {
             comboBoxEncodingFormat->currentIndex()).toString());
     profile->setChannels(comboBoxEncodingChannels->itemData(
             comboBoxEncodingChannels->currentIndex()).toInt());
+    profile->setAdaptiveBitrate(checkBoxAdaptiveBitrate->isChecked());
 
     mountpoint->setText(mountpoint->text().trimmed());
     profile->setMountPoint(mountpoint->text());
@@ -24,6 +24,7 @@
 #include "skin/legacy/colorschemeparser.h"
 #include "skin/legacy/launchimage.h"
 #include "skin/legacy/skincontext.h"
+#include "skin/legacy/skinxmlcache.h"
 #include "track/track.h"
 #include "util/assert.h"
 #include "util/cmdlineargs.h"
@@ -231,10 +232,17 @@ QDomElement LegacySkinParser::openSkin(const QString& skinPath) {
         return QDomElement();
     }
 
-    QDomDocument skin("skin");
+    const QByteArray skinXml = skinXmlFile.readAll();
+    skinXmlFile.close();
+
+    QDomDocument skin = SkinXmlCache::instance().lookup(skinXml);
+    if (!skin.isNull()) {
+        return skin.documentElement();
+    }
+    skin = QDomDocument("skin");
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
-    const auto parseResult = skin.setContent(&skinXmlFile);
+    const auto parseResult = skin.setContent(skinXml);
     if (!parseResult) {
         qDebug() << "LegacySkinParser::openSkin - setContent failed see"
                  << "line:" << parseResult.errorLine << "column:" << parseResult.errorColumn;
@@ -244,7 +252,7 @@ QDomElement LegacySkinParser::openSkin(const QString& skinPath) {
     int errorLine;
     int errorColumn;
 
-    if (!skin.setContent(&skinXmlFile,&errorMessage,&errorLine,&errorColumn)) {
+    if (!skin.setContent(skinXml, &errorMessage, &errorLine, &errorColumn)) {
         qDebug() << "LegacySkinParser::openSkin - setContent failed see"
                  << "line:" << errorLine << "column:" << errorColumn;
         qDebug() << "LegacySkinParser::openSkin - message:" << errorMessage;
@@ -252,7 +260,7 @@ QDomElement LegacySkinParser::openSkin(const QString& skinPath) {
         return QDomElement();
     }
 
-    skinXmlFile.close();
+    SkinXmlCache::instance().insert(skinXml, skin);
     return skin.documentElement();
 }
 
@@ -1810,10 +1818,19 @@ QDomElement LegacySkinParser::loadTemplate(const QString& path) {
         return QDomElement();
     }
 
-    QDomDocument tmpl("template");
+    const QByteArray templateXml = templateFile.readAll();
+    templateFile.close();
+
+    QDomDocument tmpl = SkinXmlCache::instance().lookup(templateXml);
+    if (!tmpl.isNull()) {
+        m_templateCache[absolutePath] = tmpl.documentElement();
+        m_pContext->setSkinTemplatePath(templateFileInfo.absoluteDir().absolutePath());
+        return tmpl.documentElement();
+    }
+    tmpl = QDomDocument("template");
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
-    const auto parseResult = tmpl.setContent(&templateFile);
+    const auto parseResult = tmpl.setContent(templateXml);
     if (!parseResult) {
         qWarning() << "LegacySkinParser::loadTemplate - setContent failed see"
                    << absolutePath << "line:" << parseResult.errorLine
@@ -1824,8 +1841,7 @@ QDomElement LegacySkinParser::loadTemplate(const QString& path) {
     int errorLine;
     int errorColumn;
 
-    if (!tmpl.setContent(&templateFile, &errorMessage,
-                         &errorLine, &errorColumn)) {
+    if (!tmpl.setContent(templateXml, &errorMessage, &errorLine, &errorColumn)) {
         qWarning() << "LegacySkinParser::loadTemplate - setContent failed see"
                    << absolutePath << "line:" << errorLine << "column:" << errorColumn;
         qWarning() << "LegacySkinParser::loadTemplate - message:" << errorMessage;
@@ -1833,6 +1849,7 @@ QDomElement LegacySkinParser::loadTemplate(const QString& path) {
         return QDomElement();
     }
 
+    SkinXmlCache::instance().insert(templateXml, tmpl);
     m_templateCache[absolutePath] = tmpl.documentElement();
     m_pContext->setSkinTemplatePath(templateFileInfo.absoluteDir().absolutePath());
     return tmpl.documentElement();
@@ -0,0 +1,281 @@
+#include "skin/legacy/skinxmlcache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QSaveFile>
+#include <QStringList>
+#include <QtConcurrentRun>
+
+#include "util/assert.h"
+#include "util/cachedirectory.h"
+#include "util/cmdlineargs.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("SkinXmlCache");
+
+constexpr quint32 kMagic = 0x4d58534b; // "MXSK"
+// Fixed, so the files don't depend on the Qt version Mixxx is built with
+constexpr QDataStream::Version kStreamVersion = QDataStream::Qt_5_12;
+
+const QString kCacheDirName = QStringLiteral("skincache");
+const QString kCacheFileSuffix = QStringLiteral(".bin");
+
+// Several times the size of the templates of all skins that
+// are shipped with Mixxx
+constexpr qint64 kMaxCacheSizeBytes = 16 * 1024 * 1024;
+
+// Avoid writing the file system on each lookup, a coarse
+// modification time is sufficient for pruning
+constexpr qint64 kTouchIntervalSecs = 24 * 60 * 60;
+
+enum class NodeType : quint8 {
+    Element = 0,
+    Text = 1,
+    CDATASection = 2,
+};
+
+/// Collects all strings of a document in a table and writes the tree
+/// with indices into that table.
+class DocumentWriter {
+  public:
+    DocumentWriter()
+            : m_stream(&m_tree, QIODevice::WriteOnly) {
+        m_stream.setVersion(kStreamVersion);
+    }
+
+    void writeNode(const QDomNode& node) {
+        if (node.isElement()) {
+            const QDomElement element = node.toElement();
+            m_stream << static_cast<quint8>(NodeType::Element)
+                     << intern(element.tagName());
+            const QDomNamedNodeMap attributes = element.attributes();
+            m_stream << static_cast<quint32>(attributes.count());
+            for (int i = 0; i < attributes.count(); ++i) {
+                const QDomAttr attribute = attributes.item(i).toAttr();
+                m_stream << intern(attribute.name()) << intern(attribute.value());
+            }
+            const QDomNodeList children = node.childNodes();
+            quint32 childCount = 0;
+            for (int i = 0; i < children.count(); ++i) {
+                if (isStored(children.at(i))) {
+                    ++childCount;
+                }
+            }
+            m_stream << childCount;
+            for (int i = 0; i < children.count(); ++i) {
+                if (isStored(children.at(i))) {
+                    writeNode(children.at(i));
+                }
+            }
+        } else if (node.isCDATASection()) {
+            m_stream << static_cast<quint8>(NodeType::CDATASection)
+                     << intern(node.toCDATASection().data());
+        } else {
+            DEBUG_ASSERT(node.isText());
+            m_stream << static_cast<quint8>(NodeType::Text)
+                     << intern(node.toText().data());
+        }
+    }
+
+    /// Comments and processing instructions are not used by the parser
+    static bool isStored(const QDomNode& node) {
+        return node.isElement() || node.isText() || node.isCDATASection();
+    }
+
+    const QStringList& strings() const {
+        return m_strings;
+    }
+
+    const QByteArray& tree() const {
+        return m_tree;
+    }
+
+  private:
+    quint32 intern(const QString& string) {
+        auto it = m_stringIndices.constFind(string);
+        if (it != m_stringIndices.constEnd()) {
+            return it.value();
+        }
+        const auto index = static_cast<quint32>(m_strings.size());
+        m_strings.append(string);
+        m_stringIndices.insert(string, index);
+        return index;
+    }
+
+    QByteArray m_tree;
+    QDataStream m_stream;
+    QStringList m_strings;
+    QHash<QString, quint32> m_stringIndices;
+};
+
+class DocumentReader {
+  public:
+    DocumentReader(QDataStream* pStream, const QStringList& strings)
+            : m_pStream(pStream),
+              m_strings(strings),
+              m_ok(true) {
+    }
+
+    QDomNode readNode(QDomDocument* pDocument) {
+        quint8 type;
+        *m_pStream >> type;
+        switch (static_cast<NodeType>(type)) {
+        case NodeType::Element: {
+            QDomElement element = pDocument->createElement(readString());
+            quint32 attributeCount;
+            *m_pStream >> attributeCount;
+            for (quint32 i = 0; i < attributeCount && isOk(); ++i) {
+                const QString name = readString();
+                element.setAttribute(name, readString());
+            }
+            quint32 childCount;
+            *m_pStream >> childCount;
+            for (quint32 i = 0; i < childCount && isOk(); ++i) {
+                element.appendChild(readNode(pDocument));
+            }
+            return element;
+        }
+        case NodeType::Text:
+            return pDocument->createTextNode(readString());
+        case NodeType::CDATASection:
+            return pDocument->createCDATASection(readString());
+        }
+        m_ok = false;
+        return QDomNode();
+    }
+
+    bool isOk() const {
+        return m_ok && m_pStream->status() == QDataStream::Ok;
+    }
+
+  private:
+    QString readString() {
+        quint32 index;
+        *m_pStream >> index;
+        if (index >= static_cast<quint32>(m_strings.size())) {
+            m_ok = false;
+            return QString();
+        }
+        return m_strings.at(index);
+    }
+
+    QDataStream* const m_pStream;
+    const QStringList& m_strings;
+    bool m_ok;
+};
+
+} // anonymous namespace
+
+SkinXmlCache::SkinXmlCache(const QString& cacheDirPath, qint64 maxTotalSizeBytes)
+        : m_cacheDir(cacheDirPath),
+          m_maxTotalSizeBytes(maxTotalSizeBytes) {
+}
+
+// static
+SkinXmlCache& SkinXmlCache::instance() {
+    static SkinXmlCache s_cache(
+            QDir(CmdlineArgs::Instance().getSettingsPath()).filePath(kCacheDirName),
+            kMaxCacheSizeBytes);
+    static const bool s_pruned = [] {
+        QtConcurrent::run([] {
+            s_cache.prune();
+        });
+        return true;
+    }();
+    Q_UNUSED(s_pruned);
+    return s_cache;
+}
+
+void SkinXmlCache::prune() const {
+    mixxx::pruneCacheDirectory(
+            m_cacheDir.path(),
+            QStringLiteral("*") + kCacheFileSuffix,
+            m_maxTotalSizeBytes);
+}
+
+QString SkinXmlCache::cacheFilePath(const QByteArray& xml) const {
+    const QByteArray hash = QCryptographicHash::hash(xml, QCryptographicHash::Sha1);
+    return m_cacheDir.filePath(QString::fromLatin1(hash.toHex()) + kCacheFileSuffix);
+}
+
+QDomDocument SkinXmlCache::lookup(const QByteArray& xml) const {
+    QFile file(cacheFilePath(xml));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QDomDocument();
+    }
+    QDataStream stream(&file);
+    stream.setVersion(kStreamVersion);
+    quint32 magic;
+    quint32 version;
+    stream >> magic >> version;
+    if (magic != kMagic || version != kFormatVersion) {
+        kLogger.debug() << "Ignoring outdated cache file" << file.fileName();
+        return QDomDocument();
+    }
+    QStringList strings;
+    stream >> strings;
+
+    QDomDocument document;
+    DocumentReader reader(&stream, strings);
+    const QDomNode root = reader.readNode(&document);
+    if (!reader.isOk() || !root.isElement()) {
+        kLogger.warning() << "Ignoring corrupt cache file" << file.fileName();
+        return QDomDocument();
+    }
+    document.appendChild(root);
+    // The modification time is used for pruning the least recently
+    // used files
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    if (file.fileTime(QFileDevice::FileModificationTime).secsTo(now) > kTouchIntervalSecs) {
+        file.setFileTime(now, QFileDevice::FileModificationTime);
+    }
+    return document;
+}
+
+void SkinXmlCache::insert(const QByteArray& xml, const QDomDocument& document) const {
+    const QDomElement root = document.documentElement();
+    VERIFY_OR_DEBUG_ASSERT(!root.isNull()) {
+        return;
+    }
+    if (!m_cacheDir.exists() && !m_cacheDir.mkpath(QStringLiteral("."))) {
+        kLogger.warning() << "Failed to create cache directory" << m_cacheDir.path();
+        return;
+    }
+
+    DocumentWriter writer;
+    writer.writeNode(root);
+
+    // Concurrent readers either find the previous file or the complete
+    // new file, but never a partially written file
+    QSaveFile file(cacheFilePath(xml));
+    if (!file.open(QIODevice::WriteOnly)) {
+        kLogger.warning()
+                << "Failed to create cache file"
+                << file.fileName()
+                << file.errorString();
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(kStreamVersion);
+    stream << kMagic << kFormatVersion << writer.strings();
+    stream.writeRawData(writer.tree().constData(), static_cast<int>(writer.tree().size()));
+    if (stream.status() != QDataStream::Ok) {
+        kLogger.warning()
+                << "Failed to write cache file"
+                << file.fileName()
+                << file.errorString();
+        file.cancelWriting();
+        return;
+    }
+    if (!file.commit()) {
+        kLogger.warning()
+                << "Failed to commit cache file"
+                << file.fileName()
+                << file.errorString();
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDir>
+#include <QDomDocument>
+#include <QString>
+
+/// A persistent cache of parsed skin XML documents.
+///
+/// Skin files are stored as a compact binary representation of their DOM
+/// tree with interned tag and attribute names, keyed by a hash of the XML
+/// source. Restoring a document from this form is considerably faster than
+/// running the XML parser, which matters for skins with hundreds of
+/// template files.
+///
+/// Only the parsed documents are cached. Template instantiation and the
+/// evaluation of variables and scripts depend on runtime state and still
+/// happen on every load.
+class SkinXmlCache {
+  public:
+    /// Increment whenever the binary format changes
+    static constexpr quint32 kFormatVersion = 1;
+
+    SkinXmlCache(const QString& cacheDirPath, qint64 maxTotalSizeBytes);
+
+    /// The cache in the skin cache directory of the settings path. It is
+    /// pruned in the background when accessed for the first time.
+    static SkinXmlCache& instance();
+
+    /// Returns the cached document for the given XML source or a null
+    /// document if it is not cached.
+    QDomDocument lookup(const QByteArray& xml) const;
+    void insert(const QByteArray& xml, const QDomDocument& document) const;
+
+    /// Deletes the least recently used files until the total size
+    /// of the cache does not exceed the limit.
+    void prune() const;
+
+  private:
+    QString cacheFilePath(const QByteArray& xml) const;
+
+    const QDir m_cacheDir;
+    const qint64 m_maxTotalSizeBytes;
+};
@@ -14,6 +14,7 @@ class AudioOutputBuffer;
 class AudioInputBuffer;
 
 const QString kNetworkDeviceInternalName = "Network stream";
+const QString kLoopbackDeviceInternalName = "Loopback";
 
 class SoundDevice {
   public:
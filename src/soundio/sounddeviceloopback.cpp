@@ -0,0 +1,440 @@
+#include "soundio/sounddeviceloopback.h"
+
+#include <QtDebug>
+#include <thread>
+
+#include "control/controlobject.h"
+#include "moc_sounddeviceloopback.cpp"
+#include "soundio/soundmanager.h"
+#include "soundio/soundmanagerconfig.h"
+#include "util/denormalsarezero.h"
+#include "util/logger.h"
+#include "util/math.h"
+#include "util/sample.h"
+#include "util/timer.h"
+#include "util/trace.h"
+#include "waveform/visualplayposition.h"
+
+namespace {
+
+const mixxx::Logger kLogger("SoundDeviceLoopback");
+
+const QString kAppGroup = QStringLiteral("[App]");
+const QString kSoundcardGroup = QStringLiteral("[Soundcard]");
+
+// Enough channels to route main, booth, headphones and a few decks
+// through the loopback at the same time.
+constexpr int kLoopbackChannelCount = 8;
+
+constexpr int kDefaultLatencyBuffers = 2;
+constexpr int kDefaultJitterMicros = 0;
+
+// The channel that carries the impulses of the latency probe
+constexpr int kLatencyProbeChannel = kLoopbackChannelCount - 1;
+// The number of frames before the first impulse, which gives the gains
+// of the engine time to settle, and between the detection of an impulse
+// and the injection of the next one
+constexpr SINT kLatencyProbeIntervalFrames = 4096;
+constexpr CSAMPLE kLatencyProbeThreshold = 0.5f;
+
+constexpr int kCpuUsageUpdateRate = 30; // in 1/s, fits to display frame rate
+
+} // anonymous namespace
+
+SoundDeviceLoopback::SoundDeviceLoopback(
+        UserSettingsPointer config,
+        SoundManager* sm)
+        : SoundDevice(config, sm),
+          m_latencyFrames(0),
+          m_maxJitterMicros(0),
+          m_period(Clock::duration::zero()),
+          m_audioLatencyUsage(kAppGroup, QStringLiteral("audio_latency_usage")),
+          m_framesSinceAudioLatencyUsageUpdate(0),
+          m_callbackCount(0),
+          m_xrunCount(0),
+          m_maxLatenessMicros(0),
+          m_maxCallbackMicros(0),
+          m_latencyProbe(false),
+          m_framesWritten(0),
+          m_probeFrame(-1),
+          m_nextProbeFrame(kLatencyProbeIntervalFrames) {
+    // Setting parent class members:
+    m_hostAPI = kLoopbackDeviceInternalName;
+    m_sampleRate = SoundManagerConfig::kMixxxDefaultSampleRate;
+    m_deviceId.name = kLoopbackDeviceInternalName;
+    m_strDisplayName = QObject::tr("Loopback");
+    m_numInputChannels = mixxx::audio::ChannelCount(kLoopbackChannelCount);
+    m_numOutputChannels = mixxx::audio::ChannelCount(kLoopbackChannelCount);
+}
+
+SoundDeviceLoopback::~SoundDeviceLoopback() {
+    close();
+}
+
+SoundDeviceStatus SoundDeviceLoopback::open(bool isClkRefDevice, int syncBuffers) {
+    Q_UNUSED(syncBuffers);
+    kLogger.debug() << "open:" << m_deviceId.name;
+
+    if (!m_sampleRate.isValid()) {
+        m_sampleRate = SoundManagerConfig::kMixxxDefaultSampleRate;
+    }
+
+    const SINT framesPerBuffer = m_configFramesPerBuffer;
+    const auto requestedBufferTime = mixxx::Duration::fromSeconds(
+            framesPerBuffer / m_sampleRate.toDouble());
+
+    const int latencyBuffers = math_max(1,
+            m_pConfig->getValue(ConfigKey(kSoundcardGroup,
+                                        QStringLiteral("LoopbackLatencyBuffers")),
+                    kDefaultLatencyBuffers));
+    m_maxJitterMicros = math_max(0,
+            m_pConfig->getValue(ConfigKey(kSoundcardGroup,
+                                        QStringLiteral("LoopbackJitterMicros")),
+                    kDefaultJitterMicros));
+    m_latencyFrames = latencyBuffers * framesPerBuffer;
+    m_latencyProbe = m_pConfig->getValue(
+            ConfigKey(kSoundcardGroup, QStringLiteral("LoopbackLatencyProbe")),
+            false);
+
+    // The ring holds the loopback delay plus one buffer in flight in each
+    // direction. Prefill it with silence, so the first readProcess()
+    // finds exactly the configured delay.
+    m_pLoopbackFifo = std::make_unique<FIFO<CSAMPLE>>(
+            m_numOutputChannels * (m_latencyFrames + 2 * framesPerBuffer));
+    CSAMPLE* dataPtr1;
+    ring_buffer_size_t size1;
+    CSAMPLE* dataPtr2;
+    ring_buffer_size_t size2;
+    const int prefill = static_cast<int>(m_numOutputChannels * m_latencyFrames);
+    (void)m_pLoopbackFifo->aquireWriteRegions(prefill,
+            &dataPtr1, &size1, &dataPtr2, &size2);
+    SampleUtil::clear(dataPtr1, size1);
+    if (size2 > 0) {
+        SampleUtil::clear(dataPtr2, size2);
+    }
+    m_pLoopbackFifo->releaseWriteRegions(prefill);
+
+    m_callbackCount = 0;
+    m_xrunCount = 0;
+    m_maxLatenessMicros = 0;
+    m_maxCallbackMicros = 0;
+    m_framesWritten = 0;
+    m_probeFrame = -1;
+    m_nextProbeFrame = kLatencyProbeIntervalFrames;
+    m_probeStatistics = Statistics();
+
+    if (isClkRefDevice) {
+        kLogger.info() << "Clock Reference with:" << framesPerBuffer
+                       << "frames/buffer @" << m_sampleRate << "Hz ="
+                       << requestedBufferTime.formatMillisWithUnit()
+                       << "loopback latency:" << m_latencyFrames << "frames"
+                       << "injected jitter:" << m_maxJitterMicros << "us";
+
+        // Update the samplerate and latency ControlObjects, which allow the
+        // waveform view to properly correct for the latency.
+        ControlObject::set(ConfigKey(kAppGroup, QStringLiteral("output_latency_ms")),
+                requestedBufferTime.toDoubleMillis());
+        ControlObject::set(ConfigKey(kAppGroup, QStringLiteral("samplerate")), m_sampleRate);
+
+        m_period = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(requestedBufferTime.toDoubleSeconds()));
+        m_nextDeadline = Clock::now() + m_period;
+
+        m_pThread = std::make_unique<SoundDeviceLoopbackThread>(this);
+        m_pThread->start(QThread::TimeCriticalPriority);
+    }
+
+    return SoundDeviceStatus::Ok;
+}
+
+bool SoundDeviceLoopback::isOpen() const {
+    return m_pLoopbackFifo != nullptr;
+}
+
+SoundDeviceStatus SoundDeviceLoopback::close() {
+    if (m_pThread) {
+        m_pThread->stop();
+        m_pThread->wait();
+        m_pThread.reset();
+        logStatistics();
+    }
+    m_pLoopbackFifo.reset();
+    return SoundDeviceStatus::Ok;
+}
+
+mixxx::audio::SampleRate SoundDeviceLoopback::getDefaultSampleRate() const {
+    return SoundManagerConfig::kMixxxDefaultSampleRate;
+}
+
+QString SoundDeviceLoopback::getError() const {
+    return QString();
+}
+
+void SoundDeviceLoopback::readProcess(SINT framesPerBuffer) {
+    if (!m_pLoopbackFifo) {
+        return;
+    }
+    DEBUG_ASSERT(m_configFramesPerBuffer >= framesPerBuffer);
+
+    const int inChunkSize = static_cast<int>(framesPerBuffer * m_numInputChannels);
+    int readCount = inChunkSize;
+    const int readAvailable = m_pLoopbackFifo->readAvailable();
+    if (readAvailable < inChunkSize) {
+        readCount = readAvailable;
+        m_pSoundManager->underflowHappened(31);
+    }
+    if (readCount > 0) {
+        CSAMPLE* dataPtr1;
+        ring_buffer_size_t size1;
+        CSAMPLE* dataPtr2;
+        ring_buffer_size_t size2;
+        // We use size1 and size2, so we can ignore the return value
+        (void)m_pLoopbackFifo->aquireReadRegions(readCount,
+                &dataPtr1, &size1, &dataPtr2, &size2);
+        composeInputBuffer(dataPtr1,
+                size1 / m_numInputChannels,
+                0,
+                m_numInputChannels);
+        if (size2 > 0) {
+            composeInputBuffer(dataPtr2,
+                    size2 / m_numInputChannels,
+                    size1 / m_numInputChannels,
+                    m_numInputChannels);
+        }
+        m_pLoopbackFifo->releaseReadRegions(readCount);
+    }
+    if (readCount < inChunkSize) {
+        // Fill remaining buffers with zeros
+        clearInputBuffer(framesPerBuffer - readCount / m_numInputChannels,
+                readCount / m_numInputChannels);
+    }
+
+    m_pSoundManager->pushInputBuffers(m_audioInputs, framesPerBuffer);
+}
+
+void SoundDeviceLoopback::writeProcess(SINT framesPerBuffer) {
+    if (!m_pLoopbackFifo) {
+        return;
+    }
+    DEBUG_ASSERT(m_configFramesPerBuffer >= framesPerBuffer);
+
+    const int outChunkSize = static_cast<int>(framesPerBuffer * m_numOutputChannels);
+    int writeCount = outChunkSize;
+    const int writeAvailable = m_pLoopbackFifo->writeAvailable();
+    if (writeAvailable < outChunkSize) {
+        // Keep whole frames only
+        writeCount = writeAvailable - writeAvailable % m_numOutputChannels;
+        m_pSoundManager->underflowHappened(32);
+    }
+    if (writeCount > 0) {
+        CSAMPLE* dataPtr1;
+        ring_buffer_size_t size1;
+        CSAMPLE* dataPtr2;
+        ring_buffer_size_t size2;
+        // We use size1 and size2, so we can ignore the return value
+        (void)m_pLoopbackFifo->aquireWriteRegions(writeCount,
+                &dataPtr1, &size1, &dataPtr2, &size2);
+        composeOutputBuffer(dataPtr1, size1 / m_numOutputChannels, 0, m_numOutputChannels);
+        if (size2 > 0) {
+            composeOutputBuffer(dataPtr2,
+                    size2 / m_numOutputChannels,
+                    size1 / m_numOutputChannels,
+                    m_numOutputChannels);
+        }
+        if (m_latencyProbe) {
+            // The engine has passed the impulse from the input of the
+            // probe channel through to its other outputs
+            detectLatencyProbe(dataPtr1, size1 / m_numOutputChannels, 0);
+            if (size2 > 0) {
+                detectLatencyProbe(dataPtr2,
+                        size2 / m_numOutputChannels,
+                        size1 / m_numOutputChannels);
+            }
+            injectLatencyProbe(dataPtr1, size1 / m_numOutputChannels, 0);
+            if (size2 > 0) {
+                injectLatencyProbe(dataPtr2,
+                        size2 / m_numOutputChannels,
+                        size1 / m_numOutputChannels);
+            }
+        }
+        m_pLoopbackFifo->releaseWriteRegions(writeCount);
+    }
+    m_framesWritten += framesPerBuffer;
+}
+
+void SoundDeviceLoopback::injectLatencyProbe(
+        CSAMPLE* pBuffer, SINT frames, SINT frameOffset) {
+    const auto channelCount = static_cast<int>(m_numOutputChannels);
+    // The probe channel only carries the impulse
+    for (SINT i = 0; i < frames; ++i) {
+        pBuffer[i * channelCount + kLatencyProbeChannel] = 0;
+    }
+    if (m_probeFrame >= 0 || m_framesWritten < m_nextProbeFrame ||
+            frameOffset > 0 || frames <= 0) {
+        return;
+    }
+    pBuffer[kLatencyProbeChannel] = 1;
+    m_probeFrame = m_framesWritten;
+    m_probeTime = Clock::now();
+}
+
+void SoundDeviceLoopback::detectLatencyProbe(
+        const CSAMPLE* pBuffer, SINT frames, SINT frameOffset) {
+    if (m_probeFrame < 0) {
+        return;
+    }
+    const auto channelCount = static_cast<int>(m_numOutputChannels);
+    for (SINT i = 0; i < frames; ++i) {
+        bool detected = false;
+        for (int channel = 0; channel < channelCount; ++channel) {
+            if (channel != kLatencyProbeChannel &&
+                    std::abs(pBuffer[i * channelCount + channel]) >=
+                            kLatencyProbeThreshold) {
+                detected = true;
+                break;
+            }
+        }
+        if (!detected) {
+            continue;
+        }
+        // The impulse has been written at m_probeFrame of the output stream
+        // of the probe channel. It has been looped back to the input of the
+        // probe channel and the engine has passed it through to this frame
+        // of the output stream.
+        const SINT latencyFrames = m_framesWritten + frameOffset + i - m_probeFrame;
+        const qint64 latencyMicros =
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                        Clock::now() - m_probeTime)
+                        .count();
+        Statistics& stats = m_probeStatistics;
+        if (stats.latencyProbes == 0) {
+            stats.minLatencyFrames = latencyFrames;
+            stats.maxLatencyFrames = latencyFrames;
+        } else {
+            stats.minLatencyFrames = math_min(stats.minLatencyFrames, latencyFrames);
+            stats.maxLatencyFrames = math_max(stats.maxLatencyFrames, latencyFrames);
+        }
+        stats.maxLatencyMicros = math_max(stats.maxLatencyMicros, latencyMicros);
+        ++stats.latencyProbes;
+        m_probeFrame = -1;
+        m_nextProbeFrame = m_framesWritten + kLatencyProbeIntervalFrames;
+        return;
+    }
+}
+
+void SoundDeviceLoopback::callbackProcessClkRef() {
+    const SINT framesPerBuffer = m_configFramesPerBuffer;
+
+    waitForNextPeriod(framesPerBuffer);
+
+    // This must be the very first call after waking up, to measure an
+    // exact value
+    updateCallbackEntryToDacTime(framesPerBuffer);
+
+    Trace trace("SoundDeviceLoopback::callbackProcessClkRef %1",
+            m_deviceId.name);
+
+    if (m_callbackCount.load(std::memory_order_relaxed) == 0) {
+        // Same as the other clock reference devices: disable the denormals
+        // calculations, to avoid a performance penalty of ~20
+        // https://github.com/mixxxdj/mixxx/issues/7747
+#if defined(__SSE__) && !defined(__EMSCRIPTEN__)
+        _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+        _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+#endif
+    }
+
+    m_pSoundManager->readProcess(framesPerBuffer);
+
+    {
+        ScopedTimer t(QStringLiteral("SoundDeviceLoopback::callbackProcess prepare %1"),
+                m_deviceId.name);
+        m_pSoundManager->onDeviceOutputCallback(framesPerBuffer);
+    }
+
+    m_pSoundManager->writeProcess(framesPerBuffer);
+
+    m_pSoundManager->processUnderflowHappened(framesPerBuffer);
+
+    updateAudioLatencyUsage(framesPerBuffer);
+}
+
+void SoundDeviceLoopback::waitForNextPeriod(SINT framesPerBuffer) {
+    Q_UNUSED(framesPerBuffer);
+    Clock::time_point wakeup = m_nextDeadline;
+    if (m_maxJitterMicros > 0) {
+        std::uniform_int_distribution<int> jitter(0, m_maxJitterMicros);
+        wakeup += std::chrono::microseconds(jitter(m_jitterGenerator));
+    }
+    std::this_thread::sleep_until(wakeup);
+
+    const Clock::time_point now = Clock::now();
+    const qint64 latenessMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+            now - m_nextDeadline)
+                                          .count();
+    if (latenessMicros > m_maxLatenessMicros.load(std::memory_order_relaxed)) {
+        m_maxLatenessMicros.store(latenessMicros, std::memory_order_relaxed);
+    }
+    if (now - m_nextDeadline > m_period) {
+        // A real device would have run out of samples, so we count it as
+        // xrun and resynchronize instead of trying to catch up.
+        m_xrunCount.fetch_add(1, std::memory_order_relaxed);
+        m_pSoundManager->underflowHappened(33);
+        m_nextDeadline = now;
+    }
+    m_nextDeadline += m_period;
+    m_callbackCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SoundDeviceLoopback::updateCallbackEntryToDacTime(SINT framesPerBuffer) {
+    m_clkRefTimer.start();
+    // Everything written in this callback becomes audible after the
+    // loopback latency
+    const double callbackEntrytoDacSecs =
+            (m_latencyFrames + framesPerBuffer) / m_sampleRate.toDouble();
+    VisualPlayPosition::setCallbackEntryToDacSecs(callbackEntrytoDacSecs, m_clkRefTimer);
+}
+
+void SoundDeviceLoopback::updateAudioLatencyUsage(SINT framesPerBuffer) {
+    const mixxx::Duration timeInCallback = m_clkRefTimer.elapsed();
+    const qint64 callbackMicros = timeInCallback.toIntegerMicros();
+    if (callbackMicros > m_maxCallbackMicros.load(std::memory_order_relaxed)) {
+        m_maxCallbackMicros.store(callbackMicros, std::memory_order_relaxed);
+    }
+
+    m_timeInAudioCallback += timeInCallback;
+    m_framesSinceAudioLatencyUsageUpdate += framesPerBuffer;
+    if (m_framesSinceAudioLatencyUsageUpdate > (m_sampleRate.toDouble() / kCpuUsageUpdateRate)) {
+        double secInAudioCb = m_timeInAudioCallback.toDoubleSeconds();
+        m_audioLatencyUsage.set(secInAudioCb /
+                (m_framesSinceAudioLatencyUsageUpdate / m_sampleRate.toDouble()));
+        m_timeInAudioCallback = mixxx::Duration::empty();
+        m_framesSinceAudioLatencyUsageUpdate = 0;
+    }
+}
+
+SoundDeviceLoopback::Statistics SoundDeviceLoopback::getStatistics() const {
+    Statistics stats = m_probeStatistics;
+    stats.callbacks = m_callbackCount.load();
+    stats.xruns = m_xrunCount.load();
+    stats.maxLatenessMicros = m_maxLatenessMicros.load();
+    stats.maxCallbackMicros = m_maxCallbackMicros.load();
+    return stats;
+}
+
+void SoundDeviceLoopback::logStatistics() const {
+    const Statistics stats = getStatistics();
+    kLogger.info() << "Statistics:"
+                   << stats.callbacks << "callbacks,"
+                   << stats.xruns << "xruns ("
+                   << (stats.callbacks > 0 ? 100.0 * stats.xruns / stats.callbacks : 0.0)
+                   << "%),"
+                   << "max wakeup lateness:" << stats.maxLatenessMicros << "us,"
+                   << "max callback duration:" << stats.maxCallbackMicros << "us";
+    if (stats.latencyProbes > 0) {
+        kLogger.info() << "Measured round trip latency of"
+                       << stats.latencyProbes << "impulses:"
+                       << stats.minLatencyFrames << "-" << stats.maxLatencyFrames
+                       << "frames, max" << stats.maxLatencyMicros << "us";
+    }
+}
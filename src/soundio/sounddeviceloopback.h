@@ -0,0 +1,136 @@
+#pragma once
+
+#include <QString>
+#include <QThread>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+
+#include "control/pollingcontrolproxy.h"
+#include "soundio/sounddevice.h"
+#include "util/duration.h"
+#include "util/fifo.h"
+#include "util/performancetimer.h"
+
+class SoundManager;
+class SoundDeviceLoopbackThread;
+
+/// A virtual sound device without any hardware behind it. Every output
+/// channel is fed back to the input channel with the same index after
+/// a configurable delay, and the callbacks are driven by a high resolution
+/// timer thread. This allows running the full engine headless, e.g. on CI
+/// machines, and measuring callback jitter and xrun rates under load.
+///
+/// The device is only available when Mixxx is started with
+/// `--loopback-audio`. The following optional settings are read from
+/// the [Soundcard] group of mixxx.cfg:
+///  - LoopbackLatencyBuffers: loopback delay in buffers (default: 2)
+///  - LoopbackJitterMicros: maximum random wakeup delay that is injected
+///    into each callback to emulate a noisy driver (default: 0)
+///  - LoopbackLatencyProbe: reserves the output of the last channel for
+///    measuring the round trip latency through the engine. An impulse is
+///    injected into the output of this channel and detected on the other
+///    output channels, after it has been looped back to the input of this
+///    channel and passed through the engine, e.g. by an auxiliary input
+///    that is mixed into the main output (default: 0)
+class SoundDeviceLoopback : public SoundDevice {
+  public:
+    struct Statistics {
+        quint64 callbacks = 0;
+        quint64 xruns = 0;
+        qint64 maxLatenessMicros = 0;
+        qint64 maxCallbackMicros = 0;
+        /// The number of impulses that have been detected by the latency
+        /// probe and the measured round trip latency from the output of
+        /// the device through its input and the engine back to its output.
+        int latencyProbes = 0;
+        SINT minLatencyFrames = 0;
+        SINT maxLatencyFrames = 0;
+        qint64 maxLatencyMicros = 0;
+    };
+
+    SoundDeviceLoopback(UserSettingsPointer config, SoundManager* sm);
+    ~SoundDeviceLoopback() override;
+
+    SoundDeviceStatus open(bool isClkRefDevice, int syncBuffers) override;
+    bool isOpen() const override;
+    SoundDeviceStatus close() override;
+    void readProcess(SINT framesPerBuffer) override;
+    void writeProcess(SINT framesPerBuffer) override;
+    QString getError() const override;
+
+    mixxx::audio::SampleRate getDefaultSampleRate() const override;
+
+    /// Called repeatedly by the timer thread if this is the clock
+    /// reference device. Sleeps until the deadline of the next period.
+    void callbackProcessClkRef();
+
+    /// Only consistent while the device is closed or from the
+    /// callback thread.
+    Statistics getStatistics() const;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    void waitForNextPeriod(SINT framesPerBuffer);
+    void updateCallbackEntryToDacTime(SINT framesPerBuffer);
+    void updateAudioLatencyUsage(SINT framesPerBuffer);
+    void logStatistics() const;
+
+    void injectLatencyProbe(CSAMPLE* pBuffer, SINT frames, SINT frameOffset);
+    void detectLatencyProbe(const CSAMPLE* pBuffer, SINT frames, SINT frameOffset);
+
+    std::unique_ptr<FIFO<CSAMPLE>> m_pLoopbackFifo;
+    SINT m_latencyFrames;
+    int m_maxJitterMicros;
+    std::minstd_rand m_jitterGenerator;
+
+    std::unique_ptr<SoundDeviceLoopbackThread> m_pThread;
+    Clock::time_point m_nextDeadline;
+    Clock::duration m_period;
+
+    PollingControlProxy m_audioLatencyUsage;
+    mixxx::Duration m_timeInAudioCallback;
+    int m_framesSinceAudioLatencyUsageUpdate;
+    PerformanceTimer m_clkRefTimer;
+
+    // Statistics, only written by the callback thread
+    std::atomic<quint64> m_callbackCount;
+    std::atomic<quint64> m_xrunCount;
+    std::atomic<qint64> m_maxLatenessMicros;
+    std::atomic<qint64> m_maxCallbackMicros;
+
+    // Latency probe, only accessed by the callback thread
+    bool m_latencyProbe;
+    SINT m_framesWritten;
+    // The frame of the output stream that contains the pending impulse,
+    // or -1 if no impulse is on its way.
+    SINT m_probeFrame;
+    SINT m_nextProbeFrame;
+    Clock::time_point m_probeTime;
+    Statistics m_probeStatistics;
+};
+
+class SoundDeviceLoopbackThread : public QThread {
+    Q_OBJECT
+  public:
+    SoundDeviceLoopbackThread(SoundDeviceLoopback* pParent)
+            : m_pParent(pParent),
+              m_stop(false) {
+    }
+
+    void stop() {
+        m_stop.store(true);
+    }
+
+  private:
+    void run() override {
+        while (!m_stop.load()) {
+            m_pParent->callbackProcessClkRef();
+        }
+    }
+
+    SoundDeviceLoopback* m_pParent;
+    std::atomic<bool> m_stop;
+};
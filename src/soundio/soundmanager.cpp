@@ -12,6 +12,7 @@
 #include "engine/sidechain/enginenetworkstream.h"
 #include "moc_soundmanager.cpp"
 #include "soundio/sounddevice.h"
+#include "soundio/sounddeviceloopback.h"
 #include "soundio/sounddevicenetwork.h"
 #include "soundio/sounddevicenotfound.h"
 #include "soundio/sounddeviceportaudio.h"
@@ -141,6 +142,9 @@ QList<QString> SoundManager::getHostAPIList() const {
             apiList.push_back(api->name);
         }
     }
+    if (CmdlineArgs::Instance().getLoopbackAudio()) {
+        apiList.push_back(kLoopbackDeviceInternalName);
+    }
 
     return apiList;
 }
@@ -319,6 +323,10 @@ void SoundManager::queryDevicesMixxx() {
     auto currentDevice = SoundDevicePointer(new SoundDeviceNetwork(
             m_pConfig, this, m_pNetworkStream));
     m_devices.append(currentDevice);
+
+    if (CmdlineArgs::Instance().getLoopbackAudio()) {
+        m_devices.append(SoundDevicePointer(new SoundDeviceLoopback(m_pConfig, this)));
+    }
 }
 
 SoundDeviceStatus SoundManager::setupDevices() {
@@ -0,0 +1,114 @@
+#include "sources/decodedframecache.h"
+
+#include <algorithm>
+
+#include "util/assert.h"
+#include "util/sample.h"
+
+namespace mixxx {
+
+DecodedFrameCache::DecodedFrameCache(
+        int maxBlockCount,
+        SINT maxBlockFrameCount)
+        : m_maxBlockCount(maxBlockCount),
+          m_maxBlockFrameCount(maxBlockFrameCount),
+          m_currentBlockIndex(-1),
+          m_accessCounter(0) {
+    DEBUG_ASSERT(m_maxBlockCount > 0);
+    DEBUG_ASSERT(m_maxBlockFrameCount > 0);
+}
+
+void DecodedFrameCache::reset(
+        const audio::SignalInfo& signalInfo) {
+    m_signalInfo = signalInfo;
+    // Blocks are allocated lazily, because most audio sources
+    // are only read sequentially without seeking, e.g. for analysis
+    m_blocks.clear();
+    m_currentBlockIndex = -1;
+    m_accessCounter = 0;
+}
+
+IndexRange DecodedFrameCache::tryRead(
+        const WritableSampleFrames& writableSampleFrames) {
+    const IndexRange frameIndexRange = writableSampleFrames.frameIndexRange();
+    if (frameIndexRange.empty()) {
+        return IndexRange();
+    }
+    for (auto& block : m_blocks) {
+        if (!frameIndexRange.isSubrangeOf(block.frameIndexRange)) {
+            continue;
+        }
+        if (writableSampleFrames.writableData()) {
+            const SINT offset = m_signalInfo.frames2samples(
+                    frameIndexRange.start() - block.frameIndexRange.start());
+            SampleUtil::copy(
+                    writableSampleFrames.writableData(),
+                    block.sampleBuffer.data(offset),
+                    m_signalInfo.frames2samples(frameIndexRange.length()));
+        }
+        block.lastAccess = ++m_accessCounter;
+        // The decoder continues elsewhere
+        m_currentBlockIndex = -1;
+        return block.frameIndexRange;
+    }
+    return IndexRange();
+}
+
+void DecodedFrameCache::startBlock(
+        SINT frameIndex) {
+    DEBUG_ASSERT(m_signalInfo.isValid());
+    int blockIndex = -1;
+    if (static_cast<int>(m_blocks.size()) < m_maxBlockCount) {
+        m_blocks.emplace_back();
+        m_blocks.back().sampleBuffer =
+                SampleBuffer(m_signalInfo.frames2samples(m_maxBlockFrameCount));
+        blockIndex = static_cast<int>(m_blocks.size()) - 1;
+    } else {
+        // Replace the least recently used block
+        const auto iBlock = std::min_element(
+                m_blocks.begin(),
+                m_blocks.end(),
+                [](const Block& lhs, const Block& rhs) {
+                    return lhs.lastAccess < rhs.lastAccess;
+                });
+        blockIndex = static_cast<int>(iBlock - m_blocks.begin());
+    }
+    Block& block = m_blocks[blockIndex];
+    block.frameIndexRange = IndexRange::forward(frameIndex, 0);
+    block.lastAccess = ++m_accessCounter;
+    m_currentBlockIndex = blockIndex;
+}
+
+void DecodedFrameCache::appendToBlock(
+        const ReadableSampleFrames& readableSampleFrames) {
+    if (m_currentBlockIndex < 0) {
+        return;
+    }
+    Block& block = m_blocks[m_currentBlockIndex];
+    const IndexRange frameIndexRange = readableSampleFrames.frameIndexRange();
+    if (!readableSampleFrames.readableData() ||
+            frameIndexRange.start() > block.frameIndexRange.end() ||
+            frameIndexRange.end() <= block.frameIndexRange.end()) {
+        // Not continuous
+        m_currentBlockIndex = -1;
+        return;
+    }
+    const SINT skipFrameCount =
+            block.frameIndexRange.end() - frameIndexRange.start();
+    const SINT appendFrameCount = std::min(
+            frameIndexRange.length() - skipFrameCount,
+            m_maxBlockFrameCount - block.frameIndexRange.length());
+    SampleUtil::copy(
+            block.sampleBuffer.data(
+                    m_signalInfo.frames2samples(block.frameIndexRange.length())),
+            readableSampleFrames.readableData(
+                    m_signalInfo.frames2samples(skipFrameCount)),
+            m_signalInfo.frames2samples(appendFrameCount));
+    block.frameIndexRange.growBack(appendFrameCount);
+    if (block.frameIndexRange.length() >= m_maxBlockFrameCount) {
+        // Full
+        m_currentBlockIndex = -1;
+    }
+}
+
+} // namespace mixxx
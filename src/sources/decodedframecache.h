@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+#include "sources/audiosource.h"
+#include "util/samplebuffer.h"
+
+namespace mixxx {
+
+/// Keeps the decoded sample frames after the most recent seek
+/// positions of an audio source.
+///
+/// Seeking in compressed streams is expensive, because the decoder
+/// needs to be flushed and some preroll frames have to be decoded
+/// before reaching the actual position. Jumping back to the same
+/// positions over and over again, e.g. when juggling hot cues or
+/// with loop rolls, can then be served from this cache instead.
+///
+/// Each seek starts a new block that records the subsequently decoded
+/// frames until it is full. The least recently used block is replaced
+/// when all blocks are in use.
+class DecodedFrameCache final {
+  public:
+    DecodedFrameCache(
+            int maxBlockCount,
+            SINT maxBlockFrameCount);
+
+    /// Discards all blocks, e.g. when (re-)opening the audio source.
+    void reset(
+            const audio::SignalInfo& signalInfo);
+
+    /// Fills the writable frames from a single block if they are
+    /// cached completely. Returns the frame range of this block or
+    /// an empty range if the frames are not cached.
+    IndexRange tryRead(
+            const WritableSampleFrames& writableSampleFrames);
+
+    /// Starts a new block at the seek position.
+    void startBlock(
+            SINT frameIndex);
+
+    /// Appends the decoded frames to the current block, if they
+    /// continue the block and it is not yet full.
+    void appendToBlock(
+            const ReadableSampleFrames& readableSampleFrames);
+
+  private:
+    struct Block {
+        IndexRange frameIndexRange;
+        SampleBuffer sampleBuffer;
+        quint64 lastAccess = 0;
+    };
+
+    const int m_maxBlockCount;
+    const SINT m_maxBlockFrameCount;
+
+    audio::SignalInfo m_signalInfo;
+
+    std::vector<Block> m_blocks;
+
+    // The block that is currently recorded or -1 if none
+    int m_currentBlockIndex;
+
+    quint64 m_accessCounter;
+};
+
+} // namespace mixxx
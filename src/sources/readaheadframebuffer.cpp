@@ -68,15 +68,11 @@ void ReadAheadFrameBuffer::adjustCapacityBeforeBuffering(
 
 bool ReadAheadFrameBuffer::tryContinueReadingFrom(
         FrameIndex readIndex) {
-    if (!isReady()) {
-        return false;
-    }
-    const auto clampedReadIndex = bufferedRange().clampIndex(readIndex);
-    if (clampedReadIndex != readIndex) {
+    if (!canContinueReadingFrom(readIndex)) {
         return false;
     }
-    DEBUG_ASSERT(clampedReadIndex >= m_readIndex);
-    discardFirstBufferedFrames(clampedReadIndex - m_readIndex);
+    DEBUG_ASSERT(readIndex >= m_readIndex);
+    discardFirstBufferedFrames(readIndex - m_readIndex);
     return true;
 }
 
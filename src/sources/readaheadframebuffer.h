@@ -86,6 +86,14 @@ class ReadAheadFrameBuffer final {
     void reset(
             FrameIndex currentIndex = kUnknownFrameIndex);
 
+    /// Check if reading could continue from the given position
+    /// without seeking, i.e. if it is within the buffered range.
+    bool canContinueReadingFrom(
+            FrameIndex readIndex) const {
+        return isReady() &&
+                bufferedRange().clampIndex(readIndex) == readIndex;
+    }
+
     /// Try to reposition the buffer to a new read position
     /// within the buffered range, keeping all remaining data
     /// ahead of the read position.
@@ -9,6 +9,9 @@ extern "C" {
 
 } // extern "C"
 
+#include <QtConcurrentRun>
+
+#include "util/fileblockcache.h"
 #include "util/logger.h"
 #include "util/sample.h"
 
@@ -38,6 +41,12 @@ constexpr int64_t kavStreamDefaultStartTime = 0;
 // appear in the logs!
 constexpr uint64_t kavMaxDecodedFramesPerPacket = 16;
 
+// The decoded frames after the most recent seek positions are cached
+// for jumping back to hot cues or loops without seeking again. Each
+// block covers 2 chunks of the CachingReader.
+constexpr int kDecodedFrameCacheBlockCount = 8;
+constexpr SINT kDecodedFrameCacheBlockFrameCount = 16384;
+
 // 0.5 sec @ 96 kHz / 1 sec @ 48 kHz / 1.09 sec @ 44.1 kHz
 constexpr FrameCount kDefaultFrameBufferCapacity = 48000;
 
@@ -139,6 +148,54 @@ inline void avTrace(const QString& preamble, const AVFrame& avFrame) {
 }
 #endif // VERBOSE_DEBUG_LOG
 
+// Size of the buffer for custom I/O that is allocated by FFmpeg
+constexpr int kavIOBufferSize = 32 * 1024;
+
+// Custom I/O callbacks for reading the file through the block cache
+
+int readAVIOPacket(void* opaque, uint8_t* buf, int buf_size) {
+    const qint64 bytesRead = static_cast<BlockCachedFile*>(opaque)->read(
+            reinterpret_cast<char*>(buf), buf_size);
+    if (bytesRead < 0) {
+        return AVERROR(EIO);
+    }
+    if (bytesRead == 0) {
+        return AVERROR_EOF;
+    }
+    return static_cast<int>(bytesRead);
+}
+
+int64_t seekAVIO(void* opaque, int64_t offset, int whence) {
+    auto* const pFile = static_cast<BlockCachedFile*>(opaque);
+    switch (whence & ~AVSEEK_FORCE) {
+    case AVSEEK_SIZE:
+        return pFile->size();
+    case SEEK_SET:
+        break;
+    case SEEK_CUR:
+        offset += pFile->pos();
+        break;
+    case SEEK_END:
+        offset += pFile->size();
+        break;
+    default:
+        return AVERROR(EINVAL);
+    }
+    if (!pFile->seek(offset)) {
+        return AVERROR(EIO);
+    }
+    return pFile->pos();
+}
+
+void freeAVIOContext(AVIOContext** ppavIOContext) {
+    if (*ppavIOContext == nullptr) {
+        return;
+    }
+    delete static_cast<BlockCachedFile*>((*ppavIOContext)->opaque);
+    av_freep(&(*ppavIOContext)->buffer);
+    avio_context_free(ppavIOContext);
+}
+
 } // anonymous namespace
 
 // FFmpeg API Changes:
@@ -284,10 +341,46 @@ QString SoundSourceFFmpeg::formatErrorString(int errnum) {
 // Static
 AVFormatContext* SoundSourceFFmpeg::openInputFile(
         const QString& fileName) {
-    // Will be allocated implicitly when opening the input file
-    AVFormatContext* pavInputFormatContext = nullptr;
+    // The file is read through the block cache using custom I/O
+    auto pFile = std::make_unique<BlockCachedFile>(fileName);
+    if (!pFile->open()) {
+        return nullptr;
+    }
+    auto* const pavIOBuffer = static_cast<unsigned char*>(av_malloc(kavIOBufferSize));
+    if (pavIOBuffer == nullptr) {
+        kLogger.warning()
+                << "av_malloc() failed";
+        return nullptr;
+    }
+    AVIOContext* pavIOContext = avio_alloc_context(
+            pavIOBuffer,
+            kavIOBufferSize,
+            0, // read-only
+            pFile.get(),
+            readAVIOPacket,
+            nullptr,
+            seekAVIO);
+    if (pavIOContext == nullptr) {
+        kLogger.warning()
+                << "avio_alloc_context() failed";
+        av_free(pavIOBuffer);
+        return nullptr;
+    }
+    // Owned by the I/O context from now on
+    pFile.release();
+
+    AVFormatContext* pavInputFormatContext = avformat_alloc_context();
+    if (pavInputFormatContext == nullptr) {
+        kLogger.warning()
+                << "avformat_alloc_context() failed";
+        freeAVIOContext(&pavIOContext);
+        return nullptr;
+    }
+    pavInputFormatContext->pb = pavIOContext;
+    pavInputFormatContext->flags |= AVFMT_FLAG_CUSTOM_IO;
 
-    // Open input file and allocate/initialize AVFormatContext
+    // Open input file and initialize AVFormatContext. The file name
+    // is still needed for detecting the format.
     const int avformat_open_input_result =
             avformat_open_input(
                     &pavInputFormatContext, fileName.toLocal8Bit().constData(), nullptr, nullptr);
@@ -296,11 +389,30 @@ AVFormatContext* SoundSourceFFmpeg::openInputFile(
         kLogger.warning().noquote()
                 << "avformat_open_input() failed:"
                 << formatErrorString(avformat_open_input_result);
+        // The AVFormatContext has been freed, but not the custom I/O context
         DEBUG_ASSERT(pavInputFormatContext == nullptr);
+        freeAVIOContext(&pavIOContext);
     }
     return pavInputFormatContext;
 }
 
+// Static
+void SoundSourceFFmpeg::closeInputFile(
+        AVFormatContext** ppavInputFormatContext) {
+    DEBUG_ASSERT(ppavInputFormatContext != nullptr);
+    if (*ppavInputFormatContext == nullptr) {
+        return;
+    }
+    // The custom I/O context is not freed when closing the input
+    AVIOContext* pavIOContext = nullptr;
+    if ((*ppavInputFormatContext)->flags & AVFMT_FLAG_CUSTOM_IO) {
+        pavIOContext = (*ppavInputFormatContext)->pb;
+    }
+    avformat_close_input(ppavInputFormatContext);
+    DEBUG_ASSERT(*ppavInputFormatContext == nullptr);
+    freeAVIOContext(&pavIOContext);
+}
+
 void SoundSourceFFmpeg::InputAVFormatContextPtr::take(
         AVFormatContext** ppavInputFormatContext) {
     DEBUG_ASSERT(ppavInputFormatContext != nullptr);
@@ -312,10 +424,7 @@ void SoundSourceFFmpeg::InputAVFormatContextPtr::take(
 }
 
 void SoundSourceFFmpeg::InputAVFormatContextPtr::close() {
-    if (m_pavInputFormatContext != nullptr) {
-        avformat_close_input(&m_pavInputFormatContext);
-        DEBUG_ASSERT(m_pavInputFormatContext == nullptr);
-    }
+    closeInputFile(&m_pavInputFormatContext);
 }
 
 //static
@@ -486,9 +595,14 @@ SoundSourceFFmpeg::SoundSourceFFmpeg(const QUrl& url)
           m_pavStream(nullptr),
           m_pavDecodedFrame(nullptr),
           m_seekPrerollFrameCount(0),
+          m_decodedFrameCache(
+                  kDecodedFrameCacheBlockCount,
+                  kDecodedFrameCacheBlockFrameCount),
           m_pavPacket(av_packet_alloc()),
           m_pavResampledFrame(nullptr),
           m_avutilVersion(avutil_version()) {
+    // The decoder is repositioned by at most a single task at a time
+    m_repositionDecoderThreadPool.setMaxThreadCount(1);
     DEBUG_ASSERT(m_pavPacket);
 #if LIBAVUTIL_VERSION_INT >= AV_VERSION_INT(57, 28, 100) // FFmpeg 5.1
     av_channel_layout_default(&m_avStreamChannelLayout, 0);
@@ -737,6 +851,7 @@ SoundSource::OpenResult SoundSourceFFmpeg::tryOpen(
 #if VERBOSE_DEBUG_LOG
     kLogger.debug() << "Frame buffer capacity:" << m_frameBuffer.capacity();
 #endif
+    m_decodedFrameCache.reset(getSignalInfo());
 
     return OpenResult::Succeeded;
 }
@@ -873,6 +988,7 @@ bool SoundSourceFFmpeg::initResampling(
 }
 
 void SoundSourceFFmpeg::close() {
+    finishRepositioningDecoder();
     av_frame_free(&m_pavResampledFrame);
     DEBUG_ASSERT(!m_pavResampledFrame);
     av_frame_free(&m_pavDecodedFrame);
@@ -1087,8 +1203,52 @@ const CSAMPLE* SoundSourceFFmpeg::resampleDecodedAVFrame() {
     }
 }
 
+void SoundSourceFFmpeg::finishRepositioningDecoder() {
+    m_repositionDecoder.waitForFinished();
+}
+
+void SoundSourceFFmpeg::startRepositioningDecoder(
+        SINT frameIndex) {
+    DEBUG_ASSERT(m_repositionDecoder.isFinished());
+    if (frameIndex >= frameIndexMax() ||
+            m_frameBuffer.canContinueReadingFrom(frameIndex)) {
+        // Nothing to do
+        return;
+    }
+    DEBUG_ASSERT(frameIndex > frameIndexMin());
+    m_repositionDecoder = QtConcurrent::run(
+            &m_repositionDecoderThreadPool,
+            [this, frameIndex] {
+                // Decoding the last frame before the requested position
+                // keeps all subsequently decoded frames buffered
+                SampleBuffer sampleBuffer(getSignalInfo().frames2samples(1));
+                readSampleFramesFromDecoder(
+                        WritableSampleFrames(
+                                IndexRange::forward(frameIndex - 1, 1),
+                                SampleBuffer::WritableSlice(sampleBuffer)),
+                        false);
+            });
+}
+
 ReadableSampleFrames SoundSourceFFmpeg::readSampleFramesClamped(
-        const WritableSampleFrames& originalWritableSampleFrames) {
+        const WritableSampleFrames& writableSampleFrames) {
+    if (!m_repositionDecoder.isFinished()) {
+        // The decoder is still busy, but the frames might be cached
+        if (!m_decodedFrameCache.tryRead(writableSampleFrames).empty()) {
+            return ReadableSampleFrames(
+                    writableSampleFrames.frameIndexRange(),
+                    SampleBuffer::ReadableSlice(
+                            writableSampleFrames.writableData(),
+                            writableSampleFrames.writableLength()));
+        }
+        finishRepositioningDecoder();
+    }
+    return readSampleFramesFromDecoder(writableSampleFrames, true);
+}
+
+ReadableSampleFrames SoundSourceFFmpeg::readSampleFramesFromDecoder(
+        const WritableSampleFrames& originalWritableSampleFrames,
+        bool useDecodedFrameCache) {
     DEBUG_ASSERT(m_frameBuffer.signalInfo() == getSignalInfo());
     const SINT readableStartIndex =
             originalWritableSampleFrames.frameIndexRange().start();
@@ -1124,12 +1284,32 @@ ReadableSampleFrames SoundSourceFFmpeg::readSampleFramesClamped(
                 SampleBuffer::ReadableSlice(readableData, readableSampleCount));
     }
 
+    // Jumping back to a recent seek position is served from the cache
+    // if decoding could not simply continue from the current position
+    if (useDecodedFrameCache &&
+            !m_frameBuffer.canContinueReadingFrom(writableFrameRange.start())) {
+        const auto cachedBlockRange = m_decodedFrameCache.tryRead(writableSampleFrames);
+        if (!cachedBlockRange.empty()) {
+            // Reading will most likely continue after the cached block
+            startRepositioningDecoder(cachedBlockRange.end());
+            const auto readableRange = IndexRange::between(
+                    readableStartIndex, writableFrameRange.end());
+            return ReadableSampleFrames(readableRange,
+                    SampleBuffer::ReadableSlice(readableData,
+                            getSignalInfo().frames2samples(readableRange.length())));
+        }
+    }
+
     // Adjust the current position
     if (!adjustCurrentPosition(writableFrameRange.start())) {
         // Abort reading on seek errors
         return ReadableSampleFrames();
     }
     DEBUG_ASSERT(m_frameBuffer.isValid());
+    if (useDecodedFrameCache && !m_frameBuffer.isReady()) {
+        // The position is unknown after seeking
+        m_decodedFrameCache.startBlock(writableFrameRange.start());
+    }
 
     // Start decoding into the output buffer from the current position
     CSAMPLE* pOutputSampleBuffer = writableSampleFrames.writableData();
@@ -1348,11 +1528,15 @@ ReadableSampleFrames SoundSourceFFmpeg::readSampleFramesClamped(
             IndexRange::between(
                     readableStartIndex,
                     writableFrameRange.start());
-    return ReadableSampleFrames(
+    const auto readableSampleFrames = ReadableSampleFrames(
             readableRange,
             SampleBuffer::ReadableSlice(
                     readableData,
                     getSignalInfo().frames2samples(readableRange.length())));
+    if (useDecodedFrameCache) {
+        m_decodedFrameCache.appendToBlock(readableSampleFrames);
+    }
+    return readableSampleFrames;
 }
 
 } // namespace mixxx
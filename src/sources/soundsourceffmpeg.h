@@ -8,6 +8,10 @@ extern "C" {
 
 } // extern "C"
 
+#include <QFuture>
+#include <QThreadPool>
+
+#include "sources/decodedframecache.h"
 #include "sources/readaheadframebuffer.h"
 #include "sources/soundsourceprovider.h"
 
@@ -30,9 +34,24 @@ class SoundSourceFFmpeg : public SoundSource {
             OpenMode mode,
             const OpenParams& params) override;
 
+    // Blocks until the decoder has been repositioned in the background
+    void finishRepositioningDecoder();
+
   private:
     const CSAMPLE* resampleDecodedAVFrame();
 
+    // Reads the requested frames by decoding them, optionally serving
+    // recent seek positions from m_decodedFrameCache instead.
+    ReadableSampleFrames readSampleFramesFromDecoder(
+            const WritableSampleFrames& sampleFrames,
+            bool useDecodedFrameCache);
+
+    // Positions the decoder at the end of a cached block in the
+    // background, so that reading can continue there without seeking
+    // while the cached frames are consumed.
+    void startRepositioningDecoder(
+            SINT frameIndex);
+
     // Seek to the requested start index (if needed) or return false
     // upon seek errors.
     bool adjustCurrentPosition(
@@ -137,6 +156,7 @@ class SoundSourceFFmpeg : public SoundSource {
     // The following static functions are used by children and closely related
     // classes, this is why these static methods aren't defined as protected.
     static AVFormatContext* openInputFile(const QString& fileName);
+    static void closeInputFile(AVFormatContext** ppavInputFormatContext);
     static bool openDecodingContext(AVCodecContext* pavCodecContext);
 #if LIBAVUTIL_VERSION_INT >= AV_VERSION_INT(57, 28, 100) // FFmpeg 5.1
     static void initChannelLayoutFromStream(
@@ -156,6 +176,11 @@ class SoundSourceFFmpeg : public SoundSource {
     AVFrame* m_pavDecodedFrame;
     FrameCount m_seekPrerollFrameCount;
     ReadAheadFrameBuffer m_frameBuffer;
+    DecodedFrameCache m_decodedFrameCache;
+    // All of the above except the cache is owned by the repositioning
+    // task while it is running
+    QThreadPool m_repositionDecoderThreadPool;
+    QFuture<void> m_repositionDecoder;
 
     // FFmpeg static constants
     static constexpr AVSampleFormat s_avSampleFormat = AV_SAMPLE_FMT_FLT;
@@ -2,9 +2,8 @@
 
 #include <FLAC/stream_decoder.h>
 
-#include <QFile>
-
 #include "sources/soundsourceprovider.h"
+#include "util/fileblockcache.h"
 #include "util/readaheadsamplebuffer.h"
 
 namespace mixxx {
@@ -36,7 +35,7 @@ class SoundSourceFLAC final : public SoundSource {
             OpenMode mode,
             const OpenParams& params) override;
 
-    QFile m_file;
+    BlockCachedFile m_file;
 
     FLAC__StreamDecoder* m_decoder;
     // misc bits about the flac format:
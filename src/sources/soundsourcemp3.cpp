@@ -1,6 +1,15 @@
 #include "sources/soundsourcemp3.h"
 #include "sources/mp3decoding.h"
 
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrentRun>
+#include <cstring>
+
+#include "util/cachedirectory.h"
 #include "util/logger.h"
 #include "util/math.h"
 
@@ -16,6 +25,10 @@ const Logger kLogger("SoundSourceMp3");
 constexpr SINT kChannelCountMax = 2;
 
 constexpr SINT kMaxBytesPerMp3Frame = 1441;
+// The shortest MP3 frame (MPEG 2 Layer III, 8 kbps, 24 kHz)
+constexpr SINT kMinBytesPerMp3Frame = 24;
+// The longest MP3 frame (MPEG 1 Layer III) in sample frames
+constexpr SINT kMaxSampleFramesPerMp3Frame = 1152;
 
 // mp3 supports 9 different sample rates
 constexpr int kSampleRateCount = 9;
@@ -90,6 +103,55 @@ constexpr SINT kMaxMp3FramesPerSecond = 39; // fixed: 1 MP3 frame = 26 ms -> ~ 1
 constexpr SINT kSeekFrameListCapacity =
         kMinutesPerFile * kSecondsPerMinute * kMaxMp3FramesPerSecond;
 
+const QString kSeekIndexFileSuffix = QStringLiteral(".mp3idx");
+
+constexpr quint32 kSeekIndexMagic = 0x4d585349; // "MXSI"
+
+// Increment when changing the file layout to invalidate all existing files
+constexpr quint32 kSeekIndexVersion = 1;
+
+// Indexes of files that have been moved or deleted are never
+// read again and deleted when exceeding the limit
+constexpr qint64 kMaxSeekIndexDirectorySizeBytes = 64 * 1024 * 1024;
+
+// Followed by the compressed payload of variable-length integers
+struct SeekIndexHeader {
+    quint32 magic;
+    quint32 version;
+    quint64 fileSize;
+    qint64 fileLastModified; // ms since epoch
+};
+
+// Seek frames are stored as differences to their predecessor. Those
+// are small and fit into 1 or 2 bytes with 7 bits per byte.
+void appendVarUInt(QByteArray* pData, quint64 value) {
+    while (value >= 0x80) {
+        pData->append(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    pData->append(static_cast<char>(value));
+}
+
+bool readVarUInt(const char** ppData, const char* pEnd, quint64* pValue) {
+    quint64 value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (*ppData >= pEnd) {
+            return false;
+        }
+        const auto byte = static_cast<quint8>(*(*ppData)++);
+        value |= static_cast<quint64>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            *pValue = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline qint64 fileLastModified(const QFile& file) {
+    return QFileInfo(file).lastModified().toMSecsSinceEpoch();
+}
+
 inline QString formatHeaderFlags(int headerFlags) {
     return QString("0x%1").arg(headerFlags, 4, 16, QLatin1Char('0'));
 }
@@ -185,16 +247,40 @@ const QStringList SoundSourceProviderMp3::kSupportedFileTypes = {
         QStringLiteral("mp3"),
 };
 
+SoundSourceProviderMp3::SoundSourceProviderMp3(
+        const QString& seekIndexDirectoryPath)
+        : m_seekIndexDirectoryPath(seekIndexDirectoryPath) {
+    if (m_seekIndexDirectoryPath.isEmpty()) {
+        return;
+    }
+    if (!QDir().mkpath(m_seekIndexDirectoryPath)) {
+        kLogger.warning()
+                << "Failed to create directory"
+                << m_seekIndexDirectoryPath;
+        return;
+    }
+    QtConcurrent::run([seekIndexDirectoryPath] {
+        pruneCacheDirectory(
+                seekIndexDirectoryPath,
+                QStringLiteral("*") + kSeekIndexFileSuffix,
+                kMaxSeekIndexDirectorySizeBytes);
+    });
+}
+
 QString SoundSourceProviderMp3::getVersionString() const {
     return QString(QString(mad_version) + QChar(' ') + QString(mad_build)).trimmed();
 }
 
-SoundSourceMp3::SoundSourceMp3(const QUrl& url)
+SoundSourceMp3::SoundSourceMp3(
+        const QUrl& url,
+        const QString& seekIndexDirectoryPath)
         : SoundSource(url),
+          m_seekIndexDirectoryPath(seekIndexDirectoryPath),
           m_file(getLocalFileName()),
           m_fileSize(0),
           m_pFileData(nullptr),
           m_avgSeekFrameCount(0),
+          m_leftoverFrameOffset(-1),
           m_curFrameIndex(0),
           m_madSynthCount(0),
           m_leftoverBuffer(kMaxBytesPerMp3Frame + MAD_BUFFER_GUARD) {
@@ -247,6 +333,18 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
     DEBUG_ASSERT(m_seekFrameList.empty());
     m_avgSeekFrameCount = 0;
     m_curFrameIndex = 0;
+
+    if (readSeekIndex()) {
+        // Restart decoding at the beginning of the audio stream
+        restartDecoding(m_seekFrameList.front());
+        if (m_curFrameIndex != frameIndexMin()) {
+            kLogger.warning() << "Failed to start decoding:" << m_file.fileName();
+            // Abort
+            return OpenResult::Failed;
+        }
+        return OpenResult::Succeeded;
+    }
+
     int headerPerSampleRate[kSampleRateCount];
     for (int i = 0; i < kSampleRateCount; ++i) {
         headerPerSampleRate[i] = 0;
@@ -475,6 +573,8 @@ SoundSource::OpenResult SoundSourceMp3::tryOpen(
     addSeekFrame(m_curFrameIndex, nullptr);
     DEBUG_ASSERT(m_seekFrameList.back().frameIndex == frameIndexMax());
 
+    writeSeekIndex();
+
     // Restart decoding at the beginning of the audio stream
     restartDecoding(m_seekFrameList.front());
 
@@ -498,6 +598,7 @@ void SoundSourceMp3::close() {
     m_file.close();
 
     m_seekFrameList.clear();
+    m_leftoverFrameOffset = -1;
 
     // Re-init the decoder, because the SoundSource might be reopened and
     // the destructor calls finishDecoding() after close().
@@ -556,6 +657,205 @@ void SoundSourceMp3::addSeekFrame(
     m_seekFrameList.push_back(seekFrame);
 }
 
+QString SoundSourceMp3::seekIndexFilePath() const {
+    const QByteArray fileNameHash = QCryptographicHash::hash(
+            m_file.fileName().toUtf8(), QCryptographicHash::Sha1);
+    return m_seekIndexDirectoryPath +
+            QChar('/') +
+            QString::fromLatin1(fileNameHash.toHex()) +
+            kSeekIndexFileSuffix;
+}
+
+bool SoundSourceMp3::readSeekIndex() {
+    if (m_seekIndexDirectoryPath.isEmpty()) {
+        return false;
+    }
+    QFile indexFile(seekIndexFilePath());
+    if (!indexFile.open(QIODevice::ReadOnly)) {
+        // Not indexed yet
+        return false;
+    }
+    const QByteArray indexData = indexFile.readAll();
+    SeekIndexHeader header;
+    if (indexData.size() < static_cast<int>(sizeof(header))) {
+        return false;
+    }
+    std::memcpy(&header, indexData.constData(), sizeof(header));
+    if (header.magic != kSeekIndexMagic ||
+            header.version != kSeekIndexVersion ||
+            header.fileSize != m_fileSize ||
+            header.fileLastModified != fileLastModified(m_file)) {
+        kLogger.debug()
+                << "Outdated seek index for"
+                << m_file.fileName();
+        return false;
+    }
+
+    const QByteArray payload = qUncompress(
+            indexData.mid(static_cast<int>(sizeof(header))));
+    const char* pData = payload.constData();
+    const char* const pEnd = pData + payload.size();
+    quint64 channelCount;
+    quint64 sampleRate;
+    quint64 bitrate;
+    quint64 frameLength;
+    quint64 seekFrameCount;
+    quint64 hasLeftoverFrame;
+    if (!readVarUInt(&pData, pEnd, &channelCount) ||
+            !readVarUInt(&pData, pEnd, &sampleRate) ||
+            !readVarUInt(&pData, pEnd, &bitrate) ||
+            !readVarUInt(&pData, pEnd, &frameLength) ||
+            !readVarUInt(&pData, pEnd, &seekFrameCount) ||
+            !readVarUInt(&pData, pEnd, &hasLeftoverFrame) ||
+            channelCount < 1 ||
+            channelCount > kChannelCountMax ||
+            getIndexBySampleRate(audio::SampleRate(
+                    static_cast<audio::SampleRate::value_t>(sampleRate))) >=
+                    kSampleRateCount ||
+            seekFrameCount < 1 ||
+            seekFrameCount > m_fileSize / static_cast<quint64>(kMinBytesPerMp3Frame) ||
+            // Each seek frame is followed by the samples of at most one
+            // MP3 frame, otherwise the seek frames don't cover the stream
+            frameLength < 1 ||
+            frameLength > seekFrameCount *
+                            static_cast<quint64>(kMaxSampleFramesPerMp3Frame) ||
+            hasLeftoverFrame > 1) {
+        kLogger.warning()
+                << "Corrupt seek index for"
+                << m_file.fileName();
+        return false;
+    }
+
+    // The byte offsets of all seek frames within the file
+    std::vector<quint64> seekFrameOffsets;
+    seekFrameOffsets.reserve(seekFrameCount);
+    SeekFrameList seekFrameList;
+    seekFrameList.reserve(seekFrameCount + 1);
+    quint64 frameIndex = 0;
+    quint64 offset = 0;
+    for (quint64 i = 0; i < seekFrameCount; ++i) {
+        quint64 frameIndexDelta;
+        quint64 offsetDelta;
+        if (!readVarUInt(&pData, pEnd, &frameIndexDelta) ||
+                !readVarUInt(&pData, pEnd, &offsetDelta) ||
+                (i == 0 && frameIndexDelta != 0) ||
+                (i > 0 && (frameIndexDelta == 0 || offsetDelta == 0))) {
+            kLogger.warning()
+                    << "Corrupt seek index for"
+                    << m_file.fileName();
+            return false;
+        }
+        frameIndex += frameIndexDelta;
+        offset += offsetDelta;
+        if (frameIndex >= frameLength || offset >= m_fileSize) {
+            kLogger.warning()
+                    << "Corrupt seek index for"
+                    << m_file.fileName();
+            return false;
+        }
+        seekFrameOffsets.push_back(offset);
+        seekFrameList.push_back(SeekFrameType{
+                static_cast<SINT>(frameIndex),
+                m_pFileData + offset});
+    }
+
+    if (hasLeftoverFrame) {
+        // Decoding of the last frame requires the copy that has been
+        // padded with 0 bytes, see copyLeftoverFrame()
+        const quint64 leftoverFrameOffset = seekFrameOffsets.back();
+        const SINT remainingBytes = static_cast<SINT>(m_fileSize - leftoverFrameOffset);
+        const SINT leftoverBytes = remainingBytes + MAD_BUFFER_GUARD;
+        if (leftoverBytes > SINT(m_leftoverBuffer.size())) {
+            kLogger.warning()
+                    << "Corrupt seek index for"
+                    << m_file.fileName();
+            return false;
+        }
+        unsigned char* pLeftoverBuffer = &*m_leftoverBuffer.begin();
+        std::copy(m_pFileData + leftoverFrameOffset,
+                m_pFileData + m_fileSize,
+                pLeftoverBuffer);
+        std::fill(pLeftoverBuffer + remainingBytes, pLeftoverBuffer + leftoverBytes, 0);
+        m_leftoverFrameOffset = static_cast<SINT>(leftoverFrameOffset);
+        seekFrameList.back().pInputData = pLeftoverBuffer;
+    }
+
+    initChannelCountOnce(static_cast<int>(channelCount));
+    initSampleRateOnce(static_cast<SINT>(sampleRate));
+    initFrameIndexRangeOnce(IndexRange::forward(0, static_cast<SINT>(frameLength)));
+    if (bitrate > 0) {
+        initBitrateOnce(static_cast<SINT>(bitrate));
+    }
+    m_seekFrameList = std::move(seekFrameList);
+    m_curFrameIndex = static_cast<SINT>(frameLength);
+    m_avgSeekFrameCount = m_curFrameIndex / static_cast<SINT>(m_seekFrameList.size());
+
+    // Terminate m_seekFrameList
+    addSeekFrame(m_curFrameIndex, nullptr);
+    DEBUG_ASSERT(m_seekFrameList.back().frameIndex == frameIndexMax());
+    return true;
+}
+
+void SoundSourceMp3::writeSeekIndex() const {
+    if (m_seekIndexDirectoryPath.isEmpty()) {
+        return;
+    }
+    // Excluding the terminating seek frame
+    DEBUG_ASSERT(m_seekFrameList.size() >= 2);
+    const auto seekFrameCount = m_seekFrameList.size() - 1;
+    const unsigned char* pLeftoverBuffer = &*m_leftoverBuffer.begin();
+    const bool hasLeftoverFrame =
+            m_seekFrameList[seekFrameCount - 1].pInputData == pLeftoverBuffer;
+
+    QByteArray payload;
+    payload.reserve(static_cast<int>(seekFrameCount * 4 + 32));
+    appendVarUInt(&payload, getSignalInfo().getChannelCount().value());
+    appendVarUInt(&payload, getSignalInfo().getSampleRate().value());
+    appendVarUInt(&payload, getBitrate().value());
+    appendVarUInt(&payload, frameLength());
+    appendVarUInt(&payload, seekFrameCount);
+    appendVarUInt(&payload, hasLeftoverFrame ? 1 : 0);
+    SINT frameIndex = 0;
+    SINT offset = 0;
+    for (std::size_t i = 0; i < seekFrameCount; ++i) {
+        const SeekFrameType& seekFrame = m_seekFrameList[i];
+        SINT seekFrameOffset;
+        if (seekFrame.pInputData == pLeftoverBuffer) {
+            // Only the last frame is supposed to be copied
+            VERIFY_OR_DEBUG_ASSERT(hasLeftoverFrame &&
+                    i == seekFrameCount - 1 &&
+                    m_leftoverFrameOffset >= 0) {
+                return;
+            }
+            seekFrameOffset = m_leftoverFrameOffset;
+        } else {
+            seekFrameOffset = seekFrame.pInputData - m_pFileData;
+        }
+        appendVarUInt(&payload, seekFrame.frameIndex - frameIndex);
+        appendVarUInt(&payload, seekFrameOffset - offset);
+        frameIndex = seekFrame.frameIndex;
+        offset = seekFrameOffset;
+    }
+
+    SeekIndexHeader header;
+    header.magic = kSeekIndexMagic;
+    header.version = kSeekIndexVersion;
+    header.fileSize = m_fileSize;
+    header.fileLastModified = fileLastModified(m_file);
+
+    QSaveFile indexFile(seekIndexFilePath());
+    if (!indexFile.open(QIODevice::WriteOnly) ||
+            indexFile.write(reinterpret_cast<const char*>(&header), sizeof(header)) !=
+                    static_cast<qint64>(sizeof(header)) ||
+            indexFile.write(qCompress(payload)) < 0 ||
+            !indexFile.commit()) {
+        kLogger.warning()
+                << "Failed to write seek index"
+                << indexFile.fileName()
+                << indexFile.errorString();
+    }
+}
+
 SINT SoundSourceMp3::findSeekFrameIndex(
         SINT frameIndex) const {
     // Check preconditions
@@ -861,6 +1161,7 @@ bool SoundSourceMp3::copyLeftoverFrame() {
         DEBUG_ASSERT(remainingBytes <= kMaxBytesPerMp3Frame); // only last MP3 frame
         const SINT leftoverBytes = remainingBytes + MAD_BUFFER_GUARD;
         if ((remainingBytes > 0) && (leftoverBytes <= SINT(m_leftoverBuffer.size()))) {
+            m_leftoverFrameOffset = m_madStream.next_frame - m_pFileData;
             // Copy the data of the last MP3 frame into the leftover buffer...
             std::copy(m_madStream.next_frame,
                     m_madStream.next_frame + remainingBytes,
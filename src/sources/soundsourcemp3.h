@@ -18,7 +18,13 @@ namespace mixxx {
 
 class SoundSourceMp3 final : public SoundSource {
   public:
-    explicit SoundSourceMp3(const QUrl& url);
+    /// Scanning all MP3 frame headers when opening a file requires
+    /// to read the whole file. If a directory is provided the resulting
+    /// seek frames are stored there and reused when opening the file
+    /// again as long as its size and modification time are unchanged.
+    explicit SoundSourceMp3(
+            const QUrl& url,
+            const QString& seekIndexDirectoryPath = QString());
     ~SoundSourceMp3() override;
 
     void close() override;
@@ -32,6 +38,8 @@ class SoundSourceMp3 final : public SoundSource {
             OpenMode mode,
             const OpenParams& params) override;
 
+    const QString m_seekIndexDirectoryPath;
+
     QFile m_file;
     quint64 m_fileSize;
     unsigned char* m_pFileData;
@@ -56,7 +64,15 @@ class SoundSourceMp3 final : public SoundSource {
     /** Returns the position in m_seekFrameList of the requested frame index. */
     SINT findSeekFrameIndex(SINT frameIndex) const;
 
+    QString seekIndexFilePath() const;
+    /** Restores m_seekFrameList and the audio properties from the seek index. */
+    bool readSeekIndex();
+    void writeSeekIndex() const;
+
     bool copyLeftoverFrame();
+    // The offset of the last MP3 frame that has been copied into the
+    // leftover buffer within the file, or -1 if none
+    SINT m_leftoverFrameOffset;
 
     SINT m_curFrameIndex;
 
@@ -81,6 +97,9 @@ class SoundSourceProviderMp3 : public SoundSourceProvider {
     static const QString kDisplayName;
     static const QStringList kSupportedFileTypes;
 
+    explicit SoundSourceProviderMp3(
+            const QString& seekIndexDirectoryPath = QString());
+
     QString getDisplayName() const override {
         return kDisplayName + QStringLiteral(": ") + getVersionString();
     }
@@ -90,10 +109,13 @@ class SoundSourceProviderMp3 : public SoundSourceProvider {
     }
 
     SoundSourcePointer newSoundSource(const QUrl& url) override {
-        return newSoundSourceFromUrl<SoundSourceMp3>(url);
+        return std::make_shared<SoundSourceMp3>(url, m_seekIndexDirectoryPath);
     }
 
     QString getVersionString() const;
+
+  private:
+    const QString m_seekIndexDirectoryPath;
 };
 
 } // namespace mixxx
@@ -1,9 +1,11 @@
 #include "sources/soundsourceproxy.h"
 
+#include <QDir>
 #include <QMimeDatabase>
 #include <QMimeType>
 #include <QRegularExpression>
 #include <QStandardPaths>
+#include <tuple>
 
 #include "sources/audiosourcetrackproxy.h"
 
@@ -195,7 +197,8 @@ QList<QMimeType> mimeTypesForFileType(const QString& fileType) {
 } // anonymous namespace
 
 // static
-bool SoundSourceProxy::registerProviders() {
+bool SoundSourceProxy::registerProviders(
+        const QString& cacheDirectoryPath) {
     // Initialize built-in file types.
     // Fallback providers should be registered before specialized
     // providers to ensure that they are only after the specialized
@@ -218,7 +221,12 @@ bool SoundSourceProxy::registerProviders() {
 #ifdef __MAD__
     registerSoundSourceProvider(
             &s_soundSourceProviders,
-            std::make_shared<mixxx::SoundSourceProviderMp3>());
+            std::make_shared<mixxx::SoundSourceProviderMp3>(
+                    cacheDirectoryPath.isEmpty()
+                            ? QString()
+                            : QDir(cacheDirectoryPath).filePath(QStringLiteral("mp3seekindex"))));
+#else
+    Q_UNUSED(cacheDirectoryPath);
 #endif
 #ifdef __MODPLUG__
     registerSoundSourceProvider(
@@ -590,6 +598,23 @@ SoundSourceProxy::importTrackMetadataAndCoverImageFromFile(
             resetMissingTagMetadata);
 }
 
+//static
+SoundSourceProxy::PrefetchedMetadata SoundSourceProxy::prefetchMetadataOfNewFile(
+        const mixxx::FileAccess& fileAccess,
+        bool resetMissingTagMetadata) {
+    PrefetchedMetadata prefetched;
+    if (!fileAccess.info().checkFileExists()) {
+        return prefetched;
+    }
+    std::tie(prefetched.importResult, prefetched.sourceSynchronizedAt) =
+            SoundSourceProxy(fileAccess.info().toQUrl())
+                    .importTrackMetadataAndCoverImage(
+                            &prefetched.trackMetadata,
+                            &prefetched.coverImage,
+                            resetMissingTagMetadata);
+    return prefetched;
+}
+
 std::pair<mixxx::MetadataSource::ImportResult, QDateTime>
 SoundSourceProxy::importTrackMetadataAndCoverImage(
         mixxx::TrackMetadata* pTrackMetadata,
@@ -635,7 +660,8 @@ inline bool shouldImportSeratoTagsFromSource(
 
 SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromSource(
         UpdateTrackFromSourceMode mode,
-        const SyncTrackMetadataParams& syncParams) {
+        const SyncTrackMetadataParams& syncParams,
+        const PrefetchedMetadata* pPrefetchedMetadata) {
     DEBUG_ASSERT(m_pTrack);
 
     if (getUrl().isEmpty()) {
@@ -707,11 +733,24 @@ SoundSourceProxy::UpdateTrackFromSourceResult SoundSourceProxy::updateTrackFromS
 
     // Parse the tags stored in the audio file and the date and time when the
     // file has been last modified to detect future changes of the tags.
-    auto [metadataImportResult, sourceSynchronizedAt] =
-            importTrackMetadataAndCoverImage(
-                    &trackMetadata,
-                    pCoverImg,
-                    syncParams.resetMissingTagMetadataOnImport);
+    std::pair<mixxx::MetadataSource::ImportResult, QDateTime> importResult;
+    if (pPrefetchedMetadata &&
+            sourceSyncStatus == mixxx::TrackRecord::SourceSyncStatus::Void &&
+            pCoverImg) {
+        // The prefetched metadata has been imported from the file into
+        // empty metadata, just like it would be done here for a new track.
+        trackMetadata = pPrefetchedMetadata->trackMetadata;
+        coverImg = pPrefetchedMetadata->coverImage;
+        importResult = std::make_pair(
+                pPrefetchedMetadata->importResult,
+                pPrefetchedMetadata->sourceSynchronizedAt);
+    } else {
+        importResult = importTrackMetadataAndCoverImage(
+                &trackMetadata,
+                pCoverImg,
+                syncParams.resetMissingTagMetadataOnImport);
+    }
+    auto [metadataImportResult, sourceSynchronizedAt] = importResult;
     VERIFY_OR_DEBUG_ASSERT(!sourceSynchronizedAt.isValid() ||
             sourceSynchronizedAt.timeSpec() == Qt::UTC) {
         qWarning() << "Converting source synchronization time to UTC:" << sourceSynchronizedAt;
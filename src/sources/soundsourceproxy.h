@@ -2,10 +2,13 @@
 
 #include <gtest/gtest_prod.h>
 
+#include <QDateTime>
+#include <QImage>
 #include <QMimeType>
 
 #include "sources/soundsourceproviderregistry.h"
 #include "track/track_decl.h"
+#include "track/trackmetadata.h"
 
 namespace mixxx {
 
@@ -22,9 +25,14 @@ class SoundSourceProxy {
     /// not thread-safe and must be called only once upon startup of the
     /// application.
     ///
+    /// Providers may store data that speeds up opening files again in
+    /// subdirectories of the cache directory. Nothing is stored if no
+    /// directory is given.
+    ///
     /// Returns true if providers for one or more file extensions have been
     /// registered.
-    static bool registerProviders();
+    static bool registerProviders(
+            const QString& cacheDirectoryPath = QString());
 
     static QStringList getSupportedFileTypes() {
         return s_soundSourceProviders.getRegisteredFileTypes();
@@ -123,6 +131,28 @@ class SoundSourceProxy {
             QImage* pCoverImage,
             bool resetMissingTagMetadata) const;
 
+    /// Track metadata and the embedded cover image of a file that have
+    /// been imported in advance, i.e. before a track object exists.
+    struct PrefetchedMetadata {
+        mixxx::MetadataSource::ImportResult importResult =
+                mixxx::MetadataSource::ImportResult::Unavailable;
+        QDateTime sourceSynchronizedAt;
+        mixxx::TrackMetadata trackMetadata;
+        QImage coverImage;
+    };
+
+    /// Import the track metadata and the embedded cover image of a file
+    /// that is not yet referenced by any track object, as needed when
+    /// initializing a new track with updateTrackFromSource().
+    ///
+    /// Unlike importTrackMetadataAndCoverImageFromFile() this function does
+    /// not lock GlobalTrackCache and can be invoked concurrently from any
+    /// thread. The caller must ensure that the file is not part of the
+    /// library, otherwise its metadata might be written concurrently.
+    static PrefetchedMetadata prefetchMetadataOfNewFile(
+            const mixxx::FileAccess& fileAccess,
+            bool resetMissingTagMetadata);
+
     /// Controls which (metadata/coverart) and how tags are (re-)imported from
     /// audio files when creating a SoundSourceProxy.
     ///
@@ -174,10 +204,15 @@ class SoundSourceProxy {
     /// properly. The application log will contain warning messages for a detailed
     /// analysis in case unexpected behavior has been reported.
     ///
+    /// Metadata that has been prefetched with prefetchMetadataOfNewFile()
+    /// is used instead of reading the file again when initializing a new
+    /// track object.
+    ///
     /// Returns true if the track has been modified and false otherwise.
     UpdateTrackFromSourceResult updateTrackFromSource(
             UpdateTrackFromSourceMode mode,
-            const SyncTrackMetadataParams& syncParams);
+            const SyncTrackMetadataParams& syncParams,
+            const PrefetchedMetadata* pPrefetchedMetadata = nullptr);
 
     /// Opening the audio source through the proxy will update the
     /// audio properties of the corresponding track object. Returns
@@ -245,3 +280,5 @@ class SoundSourceProxy {
     // the corresponding track pointer. Don't pass it around!!
     mixxx::SoundSourcePointer m_pSoundSource;
 };
+
+Q_DECLARE_METATYPE(SoundSourceProxy::PrefetchedMetadata);
@@ -1,7 +1,5 @@
 #include "sources/soundsourcesndfile.h"
 
-#include <QDir>
-
 #include "util/logger.h"
 #include "util/semanticversion.h"
 
@@ -40,6 +38,55 @@ QStringList getSupportedFileTypesFiltered() {
     return supportedFileTypes;
 };
 
+// Virtual I/O callbacks for reading the file through the block cache
+
+sf_count_t sfGetFileLength(void* pUserData) {
+    return static_cast<BlockCachedFile*>(pUserData)->size();
+}
+
+sf_count_t sfSeek(sf_count_t offset, int whence, void* pUserData) {
+    auto* const pFile = static_cast<BlockCachedFile*>(pUserData);
+    switch (whence) {
+    case SEEK_SET:
+        break;
+    case SEEK_CUR:
+        offset += pFile->pos();
+        break;
+    case SEEK_END:
+        offset += pFile->size();
+        break;
+    default:
+        return -1;
+    }
+    if (!pFile->seek(offset)) {
+        return -1;
+    }
+    return pFile->pos();
+}
+
+sf_count_t sfRead(void* pData, sf_count_t count, void* pUserData) {
+    const qint64 bytesRead = static_cast<BlockCachedFile*>(pUserData)->read(
+            static_cast<char*>(pData), count);
+    return bytesRead > 0 ? bytesRead : 0;
+}
+
+sf_count_t sfWrite(const void* /*pData*/, sf_count_t /*count*/, void* /*pUserData*/) {
+    // Read-only
+    return 0;
+}
+
+sf_count_t sfTell(void* pUserData) {
+    return static_cast<BlockCachedFile*>(pUserData)->pos();
+}
+
+SF_VIRTUAL_IO sfVirtualIO = {
+        sfGetFileLength,
+        sfSeek,
+        sfRead,
+        sfWrite,
+        sfTell,
+};
+
 } // anonymous namespace
 
 //static
@@ -67,6 +114,7 @@ SoundSourceProviderPriority SoundSourceProviderSndFile::getPriorityHint(
 
 SoundSourceSndFile::SoundSourceSndFile(const QUrl& url)
         : SoundSource(url),
+          m_file(getLocalFileName()),
           m_pSndFile(nullptr),
           m_curFrameIndex(0) {
 }
@@ -79,21 +127,17 @@ SoundSource::OpenResult SoundSourceSndFile::tryOpen(
         OpenMode /*mode*/,
         const OpenParams& /*config*/) {
     DEBUG_ASSERT(!m_pSndFile);
+    if (!m_file.open()) {
+        kLogger.warning()
+                << "Failed to open file:"
+                << m_file.fileName();
+        return OpenResult::Failed;
+    }
     SF_INFO sfInfo;
     memset(&sfInfo, 0, sizeof(sfInfo));
-#ifdef __WINDOWS__
-    // Note: we cannot use QString::toStdWString since QT 4 is compiled with
-    // '/Zc:wchar_t-' flag and QT 5 not
-    const QString localFileName(QDir::toNativeSeparators(getLocalFileName()));
-    const ushort* const fileNameUtf16 = localFileName.utf16();
-    static_assert(sizeof(wchar_t) == sizeof(ushort), "QString::utf16(): wchar_t and ushort have different sizes");
-    m_pSndFile = sf_wchar_open(
-            reinterpret_cast<wchar_t*>(const_cast<ushort*>(fileNameUtf16)),
-            SFM_READ,
-            &sfInfo);
-#else
-    m_pSndFile = sf_open(QFile::encodeName(getLocalFileName()), SFM_READ, &sfInfo);
-#endif
+    // The file is read through virtual I/O, i.e. the file name
+    // does not need to be encoded for the platform
+    m_pSndFile = sf_open_virtual(&sfVirtualIO, SFM_READ, &sfInfo, &m_file);
 
     switch (sf_error(m_pSndFile)) {
     case SF_ERR_NO_ERROR:
@@ -137,6 +181,7 @@ void SoundSourceSndFile::close() {
                               << getUrlString();
         }
     }
+    m_file.close();
 }
 
 ReadableSampleFrames SoundSourceSndFile::readSampleFramesClamped(
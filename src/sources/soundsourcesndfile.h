@@ -1,15 +1,10 @@
 #pragma once
 
-#include "sources/soundsourceprovider.h"
-
-#ifdef Q_OS_WIN
-//Enable unicode in libsndfile on Windows
-//(sf_open uses UTF-8 otherwise)
-#include <windows.h>
-#define ENABLE_SNDFILE_WINDOWS_PROTOTYPES 1
-#endif
 #include <sndfile.h>
 
+#include "sources/soundsourceprovider.h"
+#include "util/fileblockcache.h"
+
 namespace mixxx {
 
 class SoundSourceSndFile final : public SoundSource {
@@ -28,6 +23,8 @@ class SoundSourceSndFile final : public SoundSource {
             OpenMode mode,
             const OpenParams& params) override;
 
+    BlockCachedFile m_file;
+
     SNDFILE* m_pSndFile;
 
     SINT m_curFrameIndex;
@@ -1,5 +1,10 @@
 #include "sources/soundsourcestem.h"
 
+#include <QFuture>
+#include <QList>
+#include <QScopeGuard>
+#include <QtConcurrentRun>
+
 #include "sources/readaheadframebuffer.h"
 
 extern "C" {
@@ -66,6 +71,16 @@ SoundSource::OpenResult SoundSourceSingleSTEM::tryOpen(
         }
         m_pavInputFormatContext.take(&pavInputFormatContext);
     }
+    // All stems are stored in the same container. Skip the packets of
+    // all other streams while demuxing, i.e. each stem only reads the
+    // data of its own stream instead of demuxing the whole file again.
+    for (unsigned int streamIdx = 0;
+            streamIdx < m_pavInputFormatContext->nb_streams;
+            ++streamIdx) {
+        if (streamIdx != m_streamIdx) {
+            m_pavInputFormatContext->streams[streamIdx]->discard = AVDISCARD_ALL;
+        }
+    }
 #if VERBOSE_DEBUG_LOG
     kLogger.debug()
             << "AVFormatContext"
@@ -273,12 +288,18 @@ SoundSource::OpenResult SoundSourceSingleSTEM::tryOpen(
 #if VERBOSE_DEBUG_LOG
     kLogger.debug() << "Frame buffer capacity:" << m_frameBuffer.capacity();
 #endif
+    m_decodedFrameCache.reset(getSignalInfo());
 
     return OpenResult::Succeeded;
 }
 
 SoundSourceSTEM::SoundSourceSTEM(const QUrl& url)
         : SoundSource(url) {
+    // The first stem is always handled by the calling thread
+    m_stemThreadPool.setMaxThreadCount(kRequiredStreamCount - 1);
+    // Keep the threads while the source exists instead of starting
+    // new ones for the next chunk after an idle period
+    m_stemThreadPool.setExpiryTimeout(-1);
 }
 
 SoundSource::OpenResult SoundSourceSTEM::tryOpen(
@@ -297,6 +318,10 @@ SoundSource::OpenResult SoundSourceSTEM::tryOpen(
                 << getLocalFileName();
         return OpenResult::Failed;
     }
+    // Only needed for probing the streams
+    const auto inputFileCloser = qScopeGuard([&pavInputFormatContext] {
+        SoundSourceFFmpeg::closeInputFile(&pavInputFormatContext);
+    });
 #if VERBOSE_DEBUG_LOG
     kLogger.debug()
             << "AVFormatContext"
@@ -377,10 +402,6 @@ SoundSource::OpenResult SoundSourceSTEM::tryOpen(
         }
 
         m_pStereoStreams.emplace_back(std::make_unique<SoundSourceSingleSTEM>(getUrl(), streamIdx));
-        if (m_pStereoStreams.back()->open(OpenMode::Strict /*Unused*/,
-                    stemParam) != OpenResult::Succeeded) {
-            return OpenResult::Failed;
-        }
     }
 
     if (stemCount != kRequiredStreamCount) {
@@ -398,6 +419,28 @@ SoundSource::OpenResult SoundSourceSTEM::tryOpen(
         return OpenResult::Failed;
     }
 
+    // The stems are opened concurrently, because each of them needs
+    // to open the file and to probe its stream
+    QList<QFuture<OpenResult>> stemOpenResults;
+    for (std::size_t stemIdx = 1; stemIdx < m_pStereoStreams.size(); ++stemIdx) {
+        SoundSourceSingleSTEM* pStem = m_pStereoStreams[stemIdx].get();
+        stemOpenResults.append(QtConcurrent::run(&m_stemThreadPool, [pStem, &stemParam] {
+            return pStem->open(OpenMode::Strict /*Unused*/, stemParam);
+        }));
+    }
+    bool stemsOpened = m_pStereoStreams.front()->open(
+                               OpenMode::Strict /*Unused*/, stemParam) ==
+            OpenResult::Succeeded;
+    for (const auto& stemOpenResult : std::as_const(stemOpenResults)) {
+        if (stemOpenResult.result() != OpenResult::Succeeded) {
+            stemsOpened = false;
+        }
+    }
+    if (!stemsOpened) {
+        close();
+        return OpenResult::Failed;
+    }
+
     if (params.getSignalInfo().getChannelCount() ==
                     mixxx::audio::ChannelCount::stereo() ||
             selectedStemMask) {
@@ -440,13 +483,6 @@ ReadableSampleFrames SoundSourceSTEM::readSampleFramesClamped(
     SINT stemSampleLength = m_pStereoStreams.front()->getSignalInfo().frames2samples(
             globalSampleFrames.frameLength());
 
-    // The same buffer is reused between requests tp prevent reallocation, but
-    // it will be reallocated if a larger chunk is requested and will keep the
-    // new maximum size
-    if (stemSampleLength > m_buffer.size()) {
-        m_buffer = SampleBuffer(stemSampleLength);
-    }
-
     ReadableSampleFrames read(globalSampleFrames.frameIndexRange(),
             SampleBuffer::ReadableSlice(
                     globalSampleFrames.writableData(),
@@ -466,11 +502,27 @@ ReadableSampleFrames SoundSourceSTEM::readSampleFramesClamped(
         return read;
     }
 
-    for (std::size_t streamIdx = 0; streamIdx < stemCount; streamIdx++) {
+    // The same buffers are reused between requests to prevent reallocation,
+    // but they will be reallocated if a larger chunk is requested and will
+    // keep the new maximum size
+    if (m_buffers.size() != stemCount) {
+        m_buffers.clear();
+        m_buffers.resize(stemCount);
+    }
+    for (auto& buffer : m_buffers) {
+        if (stemSampleLength > buffer.size()) {
+            buffer = SampleBuffer(stemSampleLength);
+        }
+    }
+
+    const bool interleaveStems =
+            m_requestedChannelCount != mixxx::audio::ChannelCount::stereo();
+    const auto readStem = [&](std::size_t streamIdx) {
+        SampleBuffer& buffer = m_buffers[streamIdx];
         WritableSampleFrames currentStemFrame = WritableSampleFrames(
                 globalSampleFrames.frameIndexRange(),
                 SampleBuffer::WritableSlice(
-                        m_buffer.data(),
+                        buffer.data(),
                         stemSampleLength));
         m_pStereoStreams[streamIdx]->readSampleFrames(currentStemFrame);
 
@@ -479,17 +531,37 @@ ReadableSampleFrames SoundSourceSTEM::readSampleFramesClamped(
         //    1L1R1L1R1L1R...2L2R2L2R2L2R2L2R......3L3R3L3R3L3R3L3R......4L4R4L4R4L4R4L4R....
         //    Can FFmpeg decode as without having to use a decoder per
         //    channel? 1LLLLLLLLLLLLLL....1RRRRRRRRR...2LLLLLLL...?
-        if (m_requestedChannelCount != mixxx::audio::ChannelCount::stereo()) {
-            // Change the sample layout to interleave all channels together
+        if (interleaveStems) {
+            // Change the sample layout to interleave all channels together.
+            // Each stem writes its own channels, so this is safe while the
+            // other stems are decoded concurrently.
             for (SINT i = 0; i < stemSampleLength / 2; i++) {
-                pBuffer[2 * stemCount * i + 2 * streamIdx] = m_buffer[2 * i];
-                pBuffer[2 * stemCount * i + 2 * streamIdx + 1] = m_buffer[2 * i + 1];
+                pBuffer[2 * stemCount * i + 2 * streamIdx] = buffer[2 * i];
+                pBuffer[2 * stemCount * i + 2 * streamIdx + 1] = buffer[2 * i + 1];
             }
-        } else {
-            // Change the sample layout to mix all channels together
+        }
+    };
+
+    // Each stem has its own demuxer and decoder. Decode all but the
+    // first stem on worker threads while decoding the first stem on
+    // this thread.
+    QList<QFuture<void>> stemReads;
+    for (std::size_t streamIdx = 1; streamIdx < stemCount; streamIdx++) {
+        stemReads.append(QtConcurrent::run(&m_stemThreadPool, [&readStem, streamIdx] {
+            readStem(streamIdx);
+        }));
+    }
+    readStem(0);
+    for (auto& stemRead : stemReads) {
+        stemRead.waitForFinished();
+    }
+
+    if (!interleaveStems) {
+        // Change the sample layout to mix all channels together
+        for (const auto& buffer : m_buffers) {
             for (SINT i = 0; i < stemSampleLength / 2; i++) {
-                pBuffer[2 * i] += m_buffer[2 * i];
-                pBuffer[2 * i + 1] += m_buffer[2 * i + 1];
+                pBuffer[2 * i] += buffer[2 * i];
+                pBuffer[2 * i + 1] += buffer[2 * i + 1];
             }
         }
     }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QThreadPool>
+
 #include "sources/soundsourceffmpeg.h"
 #include "sources/soundsourceprovider.h"
 #include "util/samplebuffer.h"
@@ -35,7 +37,13 @@ class SoundSourceSTEM : public SoundSource {
   private:
     // Contains each stem source, or the main mix if opened in stereo mode
     std::vector<std::unique_ptr<SoundSourceSingleSTEM>> m_pStereoStreams;
-    SampleBuffer m_buffer;
+    // The decoding buffer of each stem source
+    std::vector<SampleBuffer> m_buffers;
+    // Opens and decodes all but the first stem concurrently. The calling
+    // thread blocks until they are finished, so the tasks must neither
+    // queue up behind unrelated tasks of the global thread pool nor
+    // compete with the stems of other sources.
+    QThreadPool m_stemThreadPool;
 
     mixxx::audio::ChannelCount m_requestedChannelCount;
 
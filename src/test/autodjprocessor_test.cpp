@@ -20,6 +20,9 @@
 #include "track/track.h"
 
 using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::AtLeast;
+using ::testing::Eq;
 using ::testing::Return;
 
 namespace {
@@ -158,6 +161,8 @@ class MockPlayerManager : public PlayerManagerInterface {
         return static_cast<unsigned int>(numPreviewDecks.get());
     }
 
+    MOCK_METHOD1(preloadTrack, void(const TrackPointer&));
+
     ControlObject numDecks;
     ControlObject numSamplers;
     ControlObject numPreviewDecks;
@@ -901,6 +906,57 @@ TEST_F(AutoDJProcessorTest, EnabledSuccess_PlayingDeck1) {
     EXPECT_DOUBLE_EQ(0.0, deck2.play.get());
 }
 
+TEST_F(AutoDJProcessorTest, EnabledSuccess_PreloadNextTracks) {
+    const QStringList trackLocations = {
+            kTrackLocationTest,
+            QStringLiteral("id3-test-data/cover-test.flac"),
+            QStringLiteral("id3-test-data/cover-test.ogg"),
+            QStringLiteral("id3-test-data/cover-test.wav"),
+    };
+    QList<TrackPointer> queuedTracks;
+    PlaylistTableModel* pAutoDJTableModel = pProcessor->getTableModel();
+    for (const auto& trackLocation : trackLocations) {
+        TrackPointer pQueuedTrack =
+                getOrAddTrackByLocation(getTestDir().filePath(trackLocation));
+        ASSERT_TRUE(pQueuedTrack);
+        pAutoDJTableModel->appendTrack(pQueuedTrack->getId());
+        queuedTracks.append(pQueuedTrack);
+    }
+
+    // Pretend a track is playing on deck 1.
+    TrackPointer pTrack = newTestTrack();
+    deck1.slotLoadTrack(pTrack,
+#ifdef __STEM__
+            mixxx::StemChannelSelection(),
+#endif
+            true);
+    deck1.fakeTrackLoadedEvent(pTrack);
+
+    EXPECT_CALL(*pProcessor, emitAutoDJStateChanged(AutoDJProcessor::ADJ_IDLE));
+    EXPECT_CALL(*pProcessor,
+            emitLoadTrackToPlayer(Eq(queuedTracks[0]), QString("[Channel2]"), false));
+
+    // The first track may already be preloaded before it has been loaded
+    EXPECT_CALL(*pPlayerManager, preloadTrack(_)).Times(AnyNumber());
+    // The next 2 tracks after the loaded track are preloaded...
+    EXPECT_CALL(*pPlayerManager, preloadTrack(Eq(queuedTracks[1]))).Times(AtLeast(1));
+    EXPECT_CALL(*pPlayerManager, preloadTrack(Eq(queuedTracks[2]))).Times(AtLeast(1));
+    // ...but not any of the following tracks
+    EXPECT_CALL(*pPlayerManager, preloadTrack(Eq(queuedTracks[3]))).Times(0);
+
+    AutoDJProcessor::AutoDJError err = pProcessor->toggleAutoDJ(true);
+    EXPECT_EQ(AutoDJProcessor::ADJ_OK, err);
+    EXPECT_EQ(AutoDJProcessor::ADJ_IDLE, pProcessor->getState());
+
+    // Pretend the track load succeeds.
+    deck2.slotLoadTrack(queuedTracks[0],
+#ifdef __STEM__
+            mixxx::StemChannelSelection(),
+#endif
+            false);
+    deck2.fakeTrackLoadedEvent(queuedTracks[0]);
+}
+
 TEST_F(AutoDJProcessorTest, EnabledSuccess_PlayingDeck1_TrackLoadFailed) {
     TrackId testId = addTrackToCollection(kTrackLocationTest);
     ASSERT_TRUE(testId.isValid());
@@ -0,0 +1,205 @@
+#include "library/basetrackcache.h"
+
+#include <gtest/gtest.h>
+
+#include <QSqlQuery>
+
+#include "library/dao/trackschema.h"
+#include "library/queryutil.h"
+#include "test/librarytest.h"
+#include "track/track.h"
+
+namespace {
+
+const QString kTableName = QStringLiteral("base_track_cache_test_view");
+
+const QStringList kTrackFiles = {
+        QStringLiteral("id3-test-data/cover-test-jpg.mp3"),
+        QStringLiteral("id3-test-data/cover-test-png.mp3"),
+        QStringLiteral("id3-test-data/cover-test-vbr.mp3"),
+        QStringLiteral("id3-test-data/artist.mp3"),
+        QStringLiteral("id3-test-data/TOAL_TPE2.mp3"),
+};
+
+class BaseTrackCacheTest : public LibraryTest {
+  protected:
+    BaseTrackCacheTest() {
+        const QStringList columns = {
+                LIBRARYTABLE_ID,
+                LIBRARYTABLE_ARTIST,
+                LIBRARYTABLE_TITLE,
+                LIBRARYTABLE_BPM,
+                TRACKLOCATIONSTABLE_LOCATION,
+                LIBRARYTABLE_MIXXXDELETED};
+        QStringList qualifiedTableColumns;
+        for (const auto& column : columns) {
+            qualifiedTableColumns.append(mixxx::trackschema::tableForColumn(column) +
+                    QLatin1Char('.') + column);
+        }
+        QSqlQuery query(internalCollection()->database());
+        if (!query.exec(QStringLiteral(
+                                "CREATE TEMPORARY VIEW %1 AS "
+                                "SELECT %2 FROM library "
+                                "INNER JOIN track_locations "
+                                "ON library.location = track_locations.id")
+                                .arg(kTableName, qualifiedTableColumns.join(",")))) {
+            LOG_FAILED_QUERY(query);
+        }
+
+        m_pTrackCache = QSharedPointer<BaseTrackCache>(
+                new BaseTrackCache(internalCollection(),
+                        kTableName,
+                        LIBRARYTABLE_ID,
+                        columns,
+                        {LIBRARYTABLE_ARTIST, LIBRARYTABLE_TITLE},
+                        true));
+        // Receive the dirty and clean notifications of the tracks
+        internalCollection()->connectTrackSource(m_pTrackCache);
+    }
+
+    /// Adds and saves a track for each title and BPM. The tracks are
+    /// kept in memory, otherwise they could not become dirty.
+    void addTracks(const QStringList& titles, const QList<double>& bpms) {
+        ASSERT_EQ(titles.size(), bpms.size());
+        ASSERT_LE(titles.size(), kTrackFiles.size());
+        for (int i = 0; i < titles.size(); ++i) {
+            TrackPointer pTrack = getOrAddTrackByLocation(
+                    getTestDir().filePath(kTrackFiles[i]));
+            ASSERT_TRUE(pTrack);
+            pTrack->setArtist(QStringLiteral("Artist"));
+            pTrack->setTitle(titles[i]);
+            ASSERT_TRUE(pTrack->trySetBpm(bpms[i]));
+            ASSERT_TRUE(internalCollection()->getTrackDAO().saveTrack(pTrack.get()));
+            ASSERT_FALSE(pTrack->isDirty());
+            m_tracks.append(pTrack);
+        }
+    }
+
+    TrackId trackId(int i) const {
+        return m_tracks[i]->getId();
+    }
+
+    QVector<TrackId> trackIds(std::initializer_list<int> indices) const {
+        QVector<TrackId> trackIds;
+        for (int i : indices) {
+            trackIds.append(trackId(i));
+        }
+        return trackIds;
+    }
+
+    QVector<TrackId> filterAndSort(const QString& searchQuery,
+            const QString& columnName,
+            Qt::SortOrder order) {
+        QSet<TrackId> allTrackIds;
+        for (const auto& pTrack : std::as_const(m_tracks)) {
+            allTrackIds.insert(pTrack->getId());
+        }
+        const int column = m_pTrackCache->fieldIndex(columnName);
+        const QString orderByClause =
+                QStringLiteral("ORDER BY %1 %2")
+                        .arg(m_pTrackCache->columnSortForFieldIndex(column),
+                                order == Qt::AscendingOrder
+                                        ? QStringLiteral("ASC")
+                                        : QStringLiteral("DESC"));
+        QHash<TrackId, int> trackToIndex;
+        m_pTrackCache->filterAndSort(allTrackIds,
+                searchQuery,
+                QString(),
+                orderByClause,
+                {SortColumn(column, order)},
+                0,
+                &trackToIndex);
+
+        // Every track must only be listed once, i.e. the indices must
+        // not exceed the number of tracks.
+        QVector<TrackId> trackOrder(trackToIndex.size());
+        for (auto it = trackToIndex.constBegin(); it != trackToIndex.constEnd(); ++it) {
+            EXPECT_LE(0, it.value());
+            EXPECT_LT(it.value(), trackOrder.size());
+            if (it.value() >= 0 && it.value() < trackOrder.size()) {
+                trackOrder[it.value()] = it.key();
+            }
+        }
+        return trackOrder;
+    }
+
+    QSharedPointer<BaseTrackCache> m_pTrackCache;
+    QList<TrackPointer> m_tracks;
+};
+
+TEST_F(BaseTrackCacheTest, MergeDirtyTracksSortedByText) {
+    addTracks({"Alpha", "Charlie", "Echo", "Golf", "India"}, {120, 120, 120, 120, 120});
+    EXPECT_EQ(trackIds({0, 1, 2, 3, 4}),
+            filterAndSort(QString(), LIBRARYTABLE_TITLE, Qt::AscendingOrder));
+
+    // The modified titles are not saved in the database
+    m_tracks[0]->setTitle("Hotel");
+    m_tracks[2]->setTitle("bravo");
+    m_tracks[4]->setTitle("Delta");
+    ASSERT_TRUE(m_tracks[0]->isDirty());
+
+    // The text is compared case-insensitively
+    EXPECT_EQ(trackIds({2, 1, 4, 3, 0}),
+            filterAndSort(QString(), LIBRARYTABLE_TITLE, Qt::AscendingOrder));
+    EXPECT_EQ(trackIds({0, 3, 4, 1, 2}),
+            filterAndSort(QString(), LIBRARYTABLE_TITLE, Qt::DescendingOrder));
+}
+
+TEST_F(BaseTrackCacheTest, MergeDirtyTracksSortedByNumber) {
+    addTracks({"A", "B", "C", "D", "E"}, {80, 100, 120, 140, 160});
+    EXPECT_EQ(trackIds({0, 1, 2, 3, 4}),
+            filterAndSort(QString(), LIBRARYTABLE_BPM, Qt::AscendingOrder));
+
+    // Compared as text the order of 90 and 150 would be reversed
+    m_tracks[0]->trySetBpm(150);
+    m_tracks[2]->trySetBpm(95);
+    m_tracks[4]->trySetBpm(90);
+
+    EXPECT_EQ(trackIds({4, 2, 1, 3, 0}),
+            filterAndSort(QString(), LIBRARYTABLE_BPM, Qt::AscendingOrder));
+    EXPECT_EQ(trackIds({0, 3, 1, 2, 4}),
+            filterAndSort(QString(), LIBRARYTABLE_BPM, Qt::DescendingOrder));
+}
+
+TEST_F(BaseTrackCacheTest, MergeDirtyTracksMatchingSearch) {
+    addTracks({"Match 1", "Match 3", "Other 2", "Other 4", "Match 5"},
+            {120, 120, 120, 120, 120});
+    EXPECT_EQ(trackIds({0, 1, 4}),
+            filterAndSort(QStringLiteral("match"), LIBRARYTABLE_TITLE, Qt::AscendingOrder));
+
+    // Newly matching
+    m_tracks[2]->setTitle("Match 2");
+    // No longer matching
+    m_tracks[1]->setTitle("Other 3");
+    // Still matching with a different sort key
+    m_tracks[4]->setTitle("Match 0");
+
+    EXPECT_EQ(trackIds({4, 0, 2}),
+            filterAndSort(QStringLiteral("match"), LIBRARYTABLE_TITLE, Qt::AscendingOrder));
+    EXPECT_EQ(trackIds({2, 0, 4}),
+            filterAndSort(QStringLiteral("match"), LIBRARYTABLE_TITLE, Qt::DescendingOrder));
+}
+
+TEST_F(BaseTrackCacheTest, MergeDirtyTracksWithEqualKeys) {
+    addTracks({"A", "B", "C", "D", "E"}, {100, 120, 130, 140, 160});
+
+    // Dirty tracks with equal keys are ordered by id and precede the
+    // tracks with the same key from the database
+    m_tracks[4]->trySetBpm(120);
+    m_tracks[3]->trySetBpm(120);
+    EXPECT_EQ(trackIds({0, 3, 4, 1, 2}),
+            filterAndSort(QString(), LIBRARYTABLE_BPM, Qt::AscendingOrder));
+    EXPECT_EQ(trackIds({2, 3, 4, 1, 0}),
+            filterAndSort(QString(), LIBRARYTABLE_BPM, Qt::DescendingOrder));
+
+    // A dirty track with an unchanged key that is also selected from
+    // the database is not listed twice
+    m_tracks[1]->setArtist("Other artist");
+    ASSERT_TRUE(m_tracks[1]->isDirty());
+    EXPECT_EQ(trackIds({0, 1, 3, 4, 2}),
+            filterAndSort(QString(), LIBRARYTABLE_BPM, Qt::AscendingOrder));
+    EXPECT_EQ(trackIds({2, 1, 3, 4, 0}),
+            filterAndSort(QString(), LIBRARYTABLE_BPM, Qt::DescendingOrder));
+}
+
+} // namespace
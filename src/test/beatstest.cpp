@@ -1,3 +1,4 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
 #include <QtDebug>
@@ -34,6 +35,20 @@ const auto kNonConstTempoBeats = Beats(
         kSampleRate,
         QString());
 
+// Create the beats of a beatmap that alternates between 120 and 121 BPM
+// every 4 beats, i.e. each beat marker only contains a few beats.
+QVector<audio::FramePos> variableTempoBeatPositions(int beatCount) {
+    QVector<audio::FramePos> beatPositions;
+    beatPositions.reserve(beatCount);
+    auto position = kStartPosition;
+    for (int i = 0; i < beatCount; ++i) {
+        beatPositions.append(position);
+        const auto bpm = ((i / 4) % 2 == 0) ? kBpm : Bpm(121.0);
+        position += 60.0 * kSampleRate.value() / bpm.value();
+    }
+    return beatPositions;
+}
+
 TEST(BeatsTest, ConstTempoGetBpmInRange) {
     EXPECT_DOUBLE_EQ(kBpm.value(),
             kConstTempoBeats.getBpmInRange(kStartPosition, kEndPosition)
@@ -537,4 +552,71 @@ TEST(BeatsTest, ConstTempoFindPrevNextBeatWhenNotOnBeat) {
     EXPECT_NEAR(nextBeat.value(), foundNextBeat.value(), kMaxBeatError);
 }
 
+TEST(BeatsTest, NonConstTempoFindBeatsWithManyMarkers) {
+    const auto pBeats = Beats::fromBeatPositions(
+            kSampleRate, variableTempoBeatPositions(400));
+    ASSERT_NE(nullptr, pBeats);
+    ASSERT_LT(50u, pBeats->getMarkers().size());
+
+    std::vector<audio::FramePos> beatPositions;
+    for (auto it = pBeats->cfirstmarker(); it != pBeats->clastmarker() + 1; ++it) {
+        beatPositions.push_back(*it);
+    }
+    ASSERT_EQ(400u, beatPositions.size());
+
+    for (std::size_t i = 1; i < beatPositions.size(); ++i) {
+        const auto position = beatPositions[i];
+        const auto previousPosition = beatPositions[i - 1];
+        const auto betweenBeats = previousPosition + (position - previousPosition) / 2;
+        EXPECT_EQ(position.value(), pBeats->findNextBeat(betweenBeats).value());
+        EXPECT_EQ(previousPosition.value(), pBeats->findPrevBeat(betweenBeats).value());
+        EXPECT_EQ(position.value(), pBeats->findNextBeat(position).value());
+        EXPECT_EQ(position.value(), pBeats->findPrevBeat(position).value());
+
+        const auto it = pBeats->iteratorFrom(position);
+        EXPECT_EQ(static_cast<int>(i), it - pBeats->cfirstmarker());
+        EXPECT_EQ(-static_cast<int>(i), pBeats->cfirstmarker() - it);
+        EXPECT_EQ(it, pBeats->cfirstmarker() + static_cast<int>(i));
+        EXPECT_EQ(pBeats->cfirstmarker(), pBeats->iteratorFrom(position) - static_cast<int>(i));
+    }
+}
+
+void runFindPrevNextBeats(benchmark::State& state, const Beats& beats) {
+    const auto endPosition = *(beats.clastmarker() + 64);
+    auto position = kStartPosition;
+    audio::FramePos prevBeatPosition;
+    audio::FramePos nextBeatPosition;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(beats.findPrevNextBeats(
+                position, &prevBeatPosition, &nextBeatPosition, true));
+        // Advance by a typical buffer size
+        position += 512;
+        if (position >= endPosition) {
+            position = kStartPosition;
+        }
+    }
+}
+
+void BM_ConstTempoFindPrevNextBeats(benchmark::State& state) {
+    runFindPrevNextBeats(state, kConstTempoBeats);
+}
+BENCHMARK(BM_ConstTempoFindPrevNextBeats);
+
+void BM_NonConstTempoFindPrevNextBeats(benchmark::State& state) {
+    const auto pBeats = Beats::fromBeatPositions(kSampleRate,
+            variableTempoBeatPositions(static_cast<int>(state.range(0))));
+    runFindPrevNextBeats(state, *pBeats);
+}
+BENCHMARK(BM_NonConstTempoFindPrevNextBeats)->Range(64, 4096);
+
+void BM_NonConstTempoIteratorAdd(benchmark::State& state) {
+    const auto pBeats = Beats::fromBeatPositions(
+            kSampleRate, variableTempoBeatPositions(4096));
+    const auto n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(*(pBeats->cfirstmarker() + n));
+    }
+}
+BENCHMARK(BM_NonConstTempoIteratorAdd)->Range(8, 4096);
+
 } // namespace
@@ -0,0 +1,66 @@
+#ifdef __BROADCAST__
+
+#include <gtest/gtest.h>
+
+#include "broadcast/broadcastbitrateadapter.h"
+
+namespace {
+
+using Clock = BroadcastBitrateAdapter::Clock;
+using namespace std::chrono_literals;
+
+const QList<int> kBitrates = {32, 64, 96, 128, 160, 192, 256, 320};
+
+TEST(BroadcastBitrateAdapterTest, StartsAtConfiguredBitrate) {
+    BroadcastBitrateAdapter adapter(kBitrates, 128);
+    EXPECT_EQ(128, adapter.bitrate());
+
+    // A configured bitrate that is not a regular step is kept
+    BroadcastBitrateAdapter oddAdapter(kBitrates, 100);
+    EXPECT_EQ(100, oddAdapter.bitrate());
+}
+
+TEST(BroadcastBitrateAdapterTest, StepDownAndHold) {
+    BroadcastBitrateAdapter adapter(kBitrates, 128);
+    const auto start = Clock::now();
+    adapter.reset(start);
+
+    // No switch within the hold time after connecting
+    EXPECT_EQ(128, adapter.update(3000ms, start + 1s));
+    EXPECT_EQ(96, adapter.update(3000ms, start + 5s));
+    // The next step down has to wait for the hold time again
+    EXPECT_EQ(96, adapter.update(3000ms, start + 6s));
+    EXPECT_EQ(64, adapter.update(3000ms, start + 10s));
+    EXPECT_EQ(32, adapter.update(3000ms, start + 15s));
+    // Never below the lowest bitrate
+    EXPECT_EQ(32, adapter.update(3000ms, start + 20s));
+}
+
+TEST(BroadcastBitrateAdapterTest, StepUpAfterDrained) {
+    BroadcastBitrateAdapter adapter(kBitrates, 128);
+    const auto start = Clock::now();
+    adapter.reset(start);
+    EXPECT_EQ(96, adapter.update(3000ms, start + 5s));
+
+    // A moderate backlog neither steps down nor up
+    EXPECT_EQ(96, adapter.update(1000ms, start + 20s));
+
+    EXPECT_EQ(96, adapter.update(0ms, start + 21s));
+    EXPECT_EQ(96, adapter.update(100ms, start + 30s));
+    EXPECT_EQ(128, adapter.update(0ms, start + 31s));
+    // Never above the configured bitrate
+    EXPECT_EQ(128, adapter.update(0ms, start + 60s));
+}
+
+TEST(BroadcastBitrateAdapterTest, ResetRestoresConfiguredBitrate) {
+    BroadcastBitrateAdapter adapter(kBitrates, 128);
+    const auto start = Clock::now();
+    adapter.reset(start);
+    EXPECT_EQ(96, adapter.update(3000ms, start + 5s));
+    adapter.reset(start + 6s);
+    EXPECT_EQ(128, adapter.bitrate());
+}
+
+} // namespace
+
+#endif // __BROADCAST__
@@ -0,0 +1,218 @@
+#include "library/columnartrackstore.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QHash>
+#include <QVector>
+
+namespace {
+
+constexpr int kColumnCount = 4;
+constexpr int kIntColumn = 0;
+constexpr int kDoubleColumn = 1;
+constexpr int kStringColumn = 2;
+constexpr int kMixedColumn = 3;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+const QVariant kNullString = QVariant(QMetaType::fromType<QString>());
+#else
+const QVariant kNullString = QVariant(QVariant::String);
+#endif
+
+class ColumnarTrackStoreTest : public testing::Test {
+  protected:
+    ColumnarTrackStoreTest()
+            : m_store(kColumnCount) {
+    }
+
+    ColumnarTrackStore m_store;
+};
+
+TEST_F(ColumnarTrackStoreTest, InsertAndRead) {
+    const int row = m_store.insertRow(TrackId(QVariant(1)));
+    EXPECT_EQ(0, row);
+    EXPECT_EQ(row, m_store.insertRow(TrackId(QVariant(1))));
+    EXPECT_EQ(1, m_store.rowCount());
+
+    // New rows are invalid until a value is set
+    EXPECT_FALSE(m_store.value(row, kIntColumn).isValid());
+
+    m_store.setValue(row, kIntColumn, QVariant(qlonglong{42}));
+    m_store.setValue(row, kDoubleColumn, QVariant(128.5));
+    m_store.setValue(row, kStringColumn, QVariant(QStringLiteral("Artist")));
+
+    EXPECT_EQ(ColumnarTrackStore::Storage::Integer,
+            m_store.columnStorage(kIntColumn));
+    EXPECT_EQ(ColumnarTrackStore::Storage::Double,
+            m_store.columnStorage(kDoubleColumn));
+    EXPECT_EQ(ColumnarTrackStore::Storage::String,
+            m_store.columnStorage(kStringColumn));
+
+    EXPECT_EQ(QVariant(qlonglong{42}), m_store.value(row, kIntColumn));
+    EXPECT_EQ(QMetaType::LongLong, m_store.value(row, kIntColumn).userType());
+    EXPECT_EQ(QVariant(128.5), m_store.value(row, kDoubleColumn));
+    EXPECT_EQ(QVariant(QStringLiteral("Artist")), m_store.value(row, kStringColumn));
+}
+
+TEST_F(ColumnarTrackStoreTest, IntegerTypesArePreserved) {
+    const int row1 = m_store.insertRow(TrackId(QVariant(1)));
+    const int row2 = m_store.insertRow(TrackId(QVariant(2)));
+    const int row3 = m_store.insertRow(TrackId(QVariant(3)));
+    m_store.setValue(row1, kIntColumn, QVariant(qlonglong{1}));
+    m_store.setValue(row2, kIntColumn, QVariant(2));
+    m_store.setValue(row3, kIntColumn, QVariant(true));
+
+    // Mixed integer types share the integer storage
+    EXPECT_EQ(ColumnarTrackStore::Storage::Integer,
+            m_store.columnStorage(kIntColumn));
+    EXPECT_EQ(QMetaType::LongLong, m_store.value(row1, kIntColumn).userType());
+    EXPECT_EQ(QMetaType::Int, m_store.value(row2, kIntColumn).userType());
+    EXPECT_EQ(QMetaType::Bool, m_store.value(row3, kIntColumn).userType());
+    EXPECT_EQ(QVariant(true), m_store.value(row3, kIntColumn));
+}
+
+TEST_F(ColumnarTrackStoreTest, NullValues) {
+    const int row1 = m_store.insertRow(TrackId(QVariant(1)));
+    const int row2 = m_store.insertRow(TrackId(QVariant(2)));
+    m_store.setValue(row1, kDoubleColumn, QVariant(1.0));
+    m_store.setValue(row2, kDoubleColumn, kNullString);
+    m_store.setValue(row1, kStringColumn, QVariant());
+
+    const QVariant nullValue = m_store.value(row2, kDoubleColumn);
+    EXPECT_TRUE(nullValue.isValid());
+    EXPECT_TRUE(nullValue.isNull());
+    EXPECT_EQ(QMetaType::QString, nullValue.userType());
+
+    EXPECT_FALSE(m_store.value(row1, kStringColumn).isValid());
+}
+
+TEST_F(ColumnarTrackStoreTest, FallBackToVariants) {
+    const int row1 = m_store.insertRow(TrackId(QVariant(1)));
+    const int row2 = m_store.insertRow(TrackId(QVariant(2)));
+    m_store.setValue(row1, kMixedColumn, QVariant(7));
+    m_store.setValue(row2, kMixedColumn, QVariant(QByteArray("digest")));
+
+    EXPECT_EQ(ColumnarTrackStore::Storage::Variant,
+            m_store.columnStorage(kMixedColumn));
+    EXPECT_EQ(QVariant(7), m_store.value(row1, kMixedColumn));
+    EXPECT_EQ(QMetaType::Int, m_store.value(row1, kMixedColumn).userType());
+    EXPECT_EQ(QVariant(QByteArray("digest")), m_store.value(row2, kMixedColumn));
+}
+
+TEST_F(ColumnarTrackStoreTest, StringsAreInterned) {
+    for (int i = 1; i <= 100; ++i) {
+        const int row = m_store.insertRow(TrackId(QVariant(i)));
+        m_store.setValue(row, kStringColumn, QVariant(QStringLiteral("Genre %1").arg(i % 3)));
+        m_store.setValue(row, kMixedColumn, QVariant(QStringLiteral("Genre %1").arg(i % 3)));
+    }
+    EXPECT_EQ(3, m_store.internedStringCount());
+}
+
+TEST_F(ColumnarTrackStoreTest, StringsAreReleased) {
+    const int row1 = m_store.insertRow(TrackId(QVariant(1)));
+    const int row2 = m_store.insertRow(TrackId(QVariant(2)));
+    m_store.setValue(row1, kStringColumn, QVariant(QStringLiteral("Artist")));
+    m_store.setValue(row2, kStringColumn, QVariant(QStringLiteral("Artist")));
+    m_store.setValue(row1, kMixedColumn, QVariant(QStringLiteral("Genre")));
+    EXPECT_EQ(2, m_store.internedStringCount());
+
+    // Overwritten values release their strings
+    m_store.setValue(row1, kMixedColumn, QVariant(QStringLiteral("Other Genre")));
+    EXPECT_EQ(2, m_store.internedStringCount());
+    m_store.setValue(row1, kMixedColumn, kNullString);
+    EXPECT_EQ(1, m_store.internedStringCount());
+
+    // A string is released with the last row that refers to it
+    m_store.removeRow(TrackId(QVariant(1)));
+    EXPECT_EQ(1, m_store.internedStringCount());
+    m_store.removeRow(TrackId(QVariant(2)));
+    EXPECT_EQ(0, m_store.internedStringCount());
+
+    // Released slots are reused
+    const int row3 = m_store.insertRow(TrackId(QVariant(3)));
+    m_store.setValue(row3, kStringColumn, QVariant(QStringLiteral("New Artist")));
+    EXPECT_EQ(1, m_store.internedStringCount());
+    EXPECT_EQ(QVariant(QStringLiteral("New Artist")), m_store.value(row3, kStringColumn));
+}
+
+TEST_F(ColumnarTrackStoreTest, FallBackToVariantsReleasesStrings) {
+    const int row1 = m_store.insertRow(TrackId(QVariant(1)));
+    const int row2 = m_store.insertRow(TrackId(QVariant(2)));
+    m_store.setValue(row1, kMixedColumn, QVariant(QStringLiteral("Genre")));
+    m_store.setValue(row2, kMixedColumn, QVariant(42));
+    EXPECT_EQ(ColumnarTrackStore::Storage::Variant, m_store.columnStorage(kMixedColumn));
+    EXPECT_EQ(0, m_store.internedStringCount());
+    EXPECT_EQ(QVariant(QStringLiteral("Genre")), m_store.value(row1, kMixedColumn));
+}
+
+TEST_F(ColumnarTrackStoreTest, RemoveKeepsRowsDense) {
+    for (int i = 1; i <= 3; ++i) {
+        const int row = m_store.insertRow(TrackId(QVariant(i)));
+        m_store.setValue(row, kIntColumn, QVariant(i * 10));
+    }
+    m_store.removeRow(TrackId(QVariant(1)));
+
+    EXPECT_EQ(2, m_store.rowCount());
+    EXPECT_FALSE(m_store.contains(TrackId(QVariant(1))));
+    EXPECT_EQ(-1, m_store.row(TrackId(QVariant(1))));
+    for (int i = 2; i <= 3; ++i) {
+        const TrackId trackId(QVariant{i});
+        const int row = m_store.row(trackId);
+        ASSERT_GE(row, 0);
+        EXPECT_EQ(trackId, m_store.trackIdAt(row));
+        EXPECT_EQ(QVariant(i * 10), m_store.value(row, kIntColumn));
+    }
+
+    // Removing an unknown track does nothing
+    m_store.removeRow(TrackId(QVariant(42)));
+    EXPECT_EQ(2, m_store.rowCount());
+}
+
+TEST_F(ColumnarTrackStoreTest, Clear) {
+    const int row = m_store.insertRow(TrackId(QVariant(1)));
+    m_store.setValue(row, kStringColumn, QVariant(QStringLiteral("Title")));
+    m_store.clear();
+    EXPECT_EQ(0, m_store.rowCount());
+    EXPECT_EQ(0, m_store.internedStringCount());
+    EXPECT_EQ(ColumnarTrackStore::Storage::Empty,
+            m_store.columnStorage(kStringColumn));
+}
+
+// Populates a store the same way BaseTrackCache does from a library query,
+// with typical repetition of artist, album and genre strings.
+static void BM_PopulateColumnarTrackStore(benchmark::State& state) {
+    const int tracks = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        ColumnarTrackStore store(kColumnCount);
+        for (int i = 1; i <= tracks; ++i) {
+            const int row = store.insertRow(TrackId(QVariant(i)));
+            store.setValue(row, kIntColumn, QVariant(qlonglong{i % 200}));
+            store.setValue(row, kDoubleColumn, QVariant(120.0 + i % 40));
+            store.setValue(row, kStringColumn, QVariant(QStringLiteral("Artist %1").arg(i % 500)));
+            store.setValue(row, kMixedColumn, QVariant(QStringLiteral("Genre %1").arg(i % 30)));
+        }
+        benchmark::DoNotOptimize(store.rowCount());
+    }
+}
+BENCHMARK(BM_PopulateColumnarTrackStore)->Range(1 << 10, 1 << 16);
+
+// The previous row-oriented layout for comparison
+static void BM_PopulateVariantRows(benchmark::State& state) {
+    const int tracks = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        QHash<TrackId, QVector<QVariant>> rows;
+        for (int i = 1; i <= tracks; ++i) {
+            QVector<QVariant>& record = rows[TrackId(QVariant(i))];
+            record.resize(kColumnCount);
+            record[kIntColumn] = QVariant(qlonglong{i % 200});
+            record[kDoubleColumn] = QVariant(120.0 + i % 40);
+            record[kStringColumn] = QVariant(QStringLiteral("Artist %1").arg(i % 500));
+            record[kMixedColumn] = QVariant(QStringLiteral("Genre %1").arg(i % 30));
+        }
+        benchmark::DoNotOptimize(rows.size());
+    }
+}
+BENCHMARK(BM_PopulateVariantRows)->Range(1 << 10, 1 << 16);
+
+} // namespace
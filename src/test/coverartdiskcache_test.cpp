@@ -0,0 +1,105 @@
+#include "library/coverartdiskcache.h"
+
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+namespace {
+
+QImage createImage(int width, int height, QImage::Format format) {
+    QImage image(width, height, format);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            image.setPixelColor(x,
+                    y,
+                    QColor(x * 7 % 256, y * 13 % 256, (x + y) % 256, 255 - x));
+        }
+    }
+    return image;
+}
+
+class CoverArtDiskCacheTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+    }
+
+    int countFiles() const {
+        return QDir(m_tempDir.path()).entryList(QDir::Files).size();
+    }
+
+    QTemporaryDir m_tempDir;
+};
+
+TEST_F(CoverArtDiskCacheTest, ReadWrittenImages) {
+    const CoverArtDiskCache diskCache(m_tempDir.path(), 1024 * 1024);
+    const mixxx::cache_key_t cacheKey = 0x0123456789abcdef;
+    EXPECT_TRUE(diskCache.readImage(cacheKey, 37).isNull());
+
+    // Opaque images are stored without an alpha channel
+    const QImage opaqueImage = createImage(37, 41, QImage::Format_RGB32);
+    ASSERT_TRUE(diskCache.writeImage(cacheKey, 37, opaqueImage));
+    const QImage opaqueCachedImage = diskCache.readImage(cacheKey, 37);
+    EXPECT_EQ(QImage::Format_RGB888, opaqueCachedImage.format());
+    EXPECT_EQ(opaqueImage.convertToFormat(QImage::Format_RGB888), opaqueCachedImage);
+
+    const QImage translucentImage = createImage(64, 48, QImage::Format_ARGB32);
+    ASSERT_TRUE(diskCache.writeImage(cacheKey, 64, translucentImage));
+    EXPECT_EQ(translucentImage.convertToFormat(QImage::Format_ARGB32_Premultiplied),
+            diskCache.readImage(cacheKey, 64));
+
+    // Thumbnails are cached per width
+    EXPECT_TRUE(diskCache.readImage(cacheKey, 36).isNull());
+    EXPECT_TRUE(diskCache.readImage(cacheKey + 1, 37).isNull());
+    EXPECT_EQ(2, countFiles());
+}
+
+TEST_F(CoverArtDiskCacheTest, DiscardCorruptFiles) {
+    const CoverArtDiskCache diskCache(m_tempDir.path(), 1024 * 1024);
+    const mixxx::cache_key_t cacheKey = 42;
+    ASSERT_TRUE(diskCache.writeImage(
+            cacheKey, 16, createImage(16, 16, QImage::Format_RGB32)));
+    const QStringList fileNames = QDir(m_tempDir.path()).entryList(QDir::Files);
+    ASSERT_EQ(1, fileNames.size());
+    {
+        QFile file(QDir(m_tempDir.path()).filePath(fileNames.first()));
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.resize(file.size() - 1));
+    }
+    EXPECT_TRUE(diskCache.readImage(cacheKey, 16).isNull());
+    EXPECT_EQ(0, countFiles());
+}
+
+TEST_F(CoverArtDiskCacheTest, PruneLeastRecentlyUsed) {
+    const QImage image = createImage(32, 32, QImage::Format_RGB32);
+    {
+        const CoverArtDiskCache diskCache(m_tempDir.path(), 1024 * 1024);
+        for (mixxx::cache_key_t cacheKey = 1; cacheKey <= 4; ++cacheKey) {
+            ASSERT_TRUE(diskCache.writeImage(cacheKey, 32, image));
+        }
+    }
+    // Backdate all files except the last one
+    const QDir dir(m_tempDir.path());
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    for (const auto& fileName : dir.entryList(QDir::Files)) {
+        if (fileName.startsWith(QStringLiteral("0000000000000004"))) {
+            continue;
+        }
+        QFile file(dir.filePath(fileName));
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(now.addDays(-1), QFileDevice::FileModificationTime));
+    }
+
+    // Only enough space for a single thumbnail
+    const qint64 fileSize = QFileInfo(dir.entryInfoList(QDir::Files).first()).size();
+    const CoverArtDiskCache diskCache(m_tempDir.path(), fileSize);
+    diskCache.prune();
+    EXPECT_EQ(1, countFiles());
+    EXPECT_FALSE(diskCache.readImage(4, 32).isNull());
+}
+
+} // namespace
@@ -0,0 +1,183 @@
+#include "util/db/dbqueryexecutor.h"
+
+#include <gtest/gtest.h>
+
+#include <QSemaphore>
+#include <QSqlQuery>
+#include <QThread>
+
+#include "test/mixxxdbtest.h"
+
+namespace {
+
+class DbQueryExecutorTest : public MixxxDbTest {
+  protected:
+    DbQueryExecutorTest() {
+        MixxxDb::initDatabaseSchema(dbConnection());
+    }
+
+    static int countTracks(const QSqlDatabase& database) {
+        QSqlQuery query(database);
+        if (!query.exec(QStringLiteral("SELECT COUNT(*) FROM library")) ||
+                !query.next()) {
+            return -1;
+        }
+        return query.value(0).toInt();
+    }
+};
+
+TEST_F(DbQueryExecutorTest, ExecuteOnSeparateConnection) {
+    QSqlQuery insert(dbConnection());
+    ASSERT_TRUE(insert.exec(QStringLiteral(
+            "INSERT INTO library (id) VALUES (1), (2), (3)")));
+
+    mixxx::DbQueryExecutor executor(dbConnectionPooler());
+    const QThread* const pCallerThread = QThread::currentThread();
+    QFuture<bool> onCallerThread = executor.execute<bool>(
+            [pCallerThread](const QSqlDatabase&) {
+                return QThread::currentThread() == pCallerThread;
+            });
+    QFuture<int> trackCount = executor.execute<int>(&countTracks);
+    QFuture<QString> connectionName = executor.execute<QString>(
+            [](const QSqlDatabase& database) {
+                return database.connectionName();
+            });
+
+    EXPECT_FALSE(onCallerThread.result());
+    EXPECT_EQ(3, trackCount.result());
+    EXPECT_NE(dbConnection().connectionName(), connectionName.result());
+}
+
+TEST_F(DbQueryExecutorTest, ReadsBlockWritersWithoutWriteAheadLog) {
+    // Write-ahead logging is disabled by default
+    mixxx::DbQueryExecutor executor(dbConnectionPooler());
+    EXPECT_TRUE(executor.readsBlockWriters());
+}
+
+TEST_F(DbQueryExecutorTest, SkipCanceledQueries) {
+    mixxx::DbQueryExecutor executor(dbConnectionPooler());
+    QSemaphore started;
+    QSemaphore blocked;
+    QFuture<int> blocking = executor.execute<int>(
+            [&started, &blocked](const QSqlDatabase&) {
+                started.release();
+                blocked.acquire();
+                return 1;
+            });
+    bool executed = false;
+    QFuture<int> canceled = executor.execute<int>(
+            [&executed](const QSqlDatabase&) {
+                executed = true;
+                return 2;
+            });
+    started.acquire();
+    canceled.cancel();
+    blocked.release();
+
+    EXPECT_EQ(1, blocking.result());
+    canceled.waitForFinished();
+    EXPECT_TRUE(canceled.isCanceled());
+    EXPECT_FALSE(executed);
+}
+
+TEST_F(DbQueryExecutorTest, CancelPendingQueriesOnDestruction) {
+    QFuture<int> pending;
+    bool executed = false;
+    {
+        mixxx::DbQueryExecutor executor(dbConnectionPooler());
+        QSemaphore started;
+        QFuture<int> blocking = executor.execute<int>(
+                [&started](const QSqlDatabase&) {
+                    started.release();
+                    // Give the destructor a chance to stop the executor
+                    QThread::msleep(50);
+                    return 1;
+                });
+        pending = executor.execute<int>(
+                [&executed](const QSqlDatabase&) {
+                    executed = true;
+                    return 2;
+                });
+        started.acquire();
+    }
+    EXPECT_TRUE(pending.isFinished());
+    EXPECT_TRUE(pending.isCanceled());
+    EXPECT_FALSE(executed);
+}
+
+TEST_F(DbQueryExecutorTest, TemporaryViews) {
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(QStringLiteral(
+            "INSERT INTO library (id, bpm) VALUES (1, 120), (2, 128), (3, 174)")));
+    ASSERT_TRUE(query.exec(QStringLiteral(
+            "CREATE TEMPORARY VIEW fast_tracks AS "
+            "SELECT id FROM library WHERE bpm>125")));
+    ASSERT_TRUE(query.exec(QStringLiteral(
+            "CREATE TEMPORARY TABLE temp_tracks (id INTEGER)")));
+
+    QString viewSql;
+    EXPECT_TRUE(mixxx::DbQueryExecutor::isVisibleFromExecutor(
+            dbConnection(), QStringLiteral("library"), &viewSql));
+    EXPECT_TRUE(viewSql.isEmpty());
+    EXPECT_FALSE(mixxx::DbQueryExecutor::isVisibleFromExecutor(
+            dbConnection(), QStringLiteral("temp_tracks"), &viewSql));
+    ASSERT_TRUE(mixxx::DbQueryExecutor::isVisibleFromExecutor(
+            dbConnection(), QStringLiteral("fast_tracks"), &viewSql));
+    ASSERT_FALSE(viewSql.isEmpty());
+
+    const auto countFastTracks = [](const QSqlDatabase& database,
+                                         const QString& viewSql) {
+        if (!mixxx::DbQueryExecutor::createTemporaryView(
+                    database, QStringLiteral("fast_tracks"), viewSql)) {
+            return -1;
+        }
+        QSqlQuery query(database);
+        if (!query.exec(QStringLiteral("SELECT COUNT(*) FROM fast_tracks")) ||
+                !query.next()) {
+            return -1;
+        }
+        return query.value(0).toInt();
+    };
+    mixxx::DbQueryExecutor executor(dbConnectionPooler());
+    EXPECT_EQ(2,
+            executor.execute<int>(
+                            [&countFastTracks, viewSql](const QSqlDatabase& database) {
+                                return countFastTracks(database, viewSql);
+                            })
+                    .result());
+
+    // A redefined view replaces the view that has been created before
+    ASSERT_TRUE(query.exec(QStringLiteral("DROP VIEW fast_tracks")));
+    ASSERT_TRUE(query.exec(QStringLiteral(
+            "CREATE TEMPORARY VIEW fast_tracks AS "
+            "SELECT id FROM library WHERE bpm>150")));
+    ASSERT_TRUE(mixxx::DbQueryExecutor::isVisibleFromExecutor(
+            dbConnection(), QStringLiteral("fast_tracks"), &viewSql));
+    EXPECT_EQ(1,
+            executor.execute<int>(
+                            [&countFastTracks, viewSql](const QSqlDatabase& database) {
+                                return countFastTracks(database, viewSql);
+                            })
+                    .result());
+
+    // Dropped from the connection of the executor only, and created
+    // again on demand
+    const auto hasTemporaryView = [](const QSqlDatabase& database) {
+        QSqlQuery query(database);
+        return query.exec(QStringLiteral(
+                       "SELECT name FROM sqlite_temp_master "
+                       "WHERE type='view' AND name='fast_tracks'")) &&
+                query.next();
+    };
+    executor.dropTemporaryView(QStringLiteral("fast_tracks"));
+    EXPECT_FALSE(executor.execute<bool>(hasTemporaryView).result());
+    EXPECT_TRUE(hasTemporaryView(dbConnection()));
+    EXPECT_EQ(1,
+            executor.execute<int>(
+                            [&countFastTracks, viewSql](const QSqlDatabase& database) {
+                                return countFastTracks(database, viewSql);
+                            })
+                    .result());
+}
+
+} // namespace
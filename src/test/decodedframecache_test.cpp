@@ -0,0 +1,89 @@
+#include "sources/decodedframecache.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace {
+
+const mixxx::audio::SignalInfo kSignalInfo(
+        mixxx::audio::ChannelCount::stereo(),
+        mixxx::audio::SampleRate(44100));
+
+// Each sample encodes its frame index
+mixxx::ReadableSampleFrames decodedFrames(
+        std::vector<CSAMPLE>* pSamples,
+        SINT start,
+        SINT length) {
+    pSamples->resize(kSignalInfo.frames2samples(length));
+    for (SINT i = 0; i < static_cast<SINT>(pSamples->size()); ++i) {
+        (*pSamples)[i] = static_cast<CSAMPLE>(start + i / 2);
+    }
+    return mixxx::ReadableSampleFrames(
+            mixxx::IndexRange::forward(start, length),
+            mixxx::SampleBuffer::ReadableSlice(
+                    pSamples->data(), static_cast<SINT>(pSamples->size())));
+}
+
+bool tryRead(mixxx::DecodedFrameCache* pCache, SINT start, SINT length) {
+    std::vector<CSAMPLE> samples(kSignalInfo.frames2samples(length), -1.0f);
+    const auto blockRange = pCache->tryRead(mixxx::WritableSampleFrames(
+            mixxx::IndexRange::forward(start, length),
+            mixxx::SampleBuffer::WritableSlice(
+                    samples.data(), static_cast<SINT>(samples.size()))));
+    if (blockRange.empty()) {
+        return false;
+    }
+    EXPECT_TRUE(mixxx::IndexRange::forward(start, length).isSubrangeOf(blockRange));
+    for (SINT i = 0; i < static_cast<SINT>(samples.size()); ++i) {
+        EXPECT_EQ(static_cast<CSAMPLE>(start + i / 2), samples[i]);
+    }
+    return true;
+}
+
+TEST(DecodedFrameCacheTest, RecordBlocksAfterSeeking) {
+    mixxx::DecodedFrameCache cache(2, 1000);
+    cache.reset(kSignalInfo);
+    std::vector<CSAMPLE> samples;
+
+    cache.startBlock(100);
+    cache.appendToBlock(decodedFrames(&samples, 100, 400));
+    cache.appendToBlock(decodedFrames(&samples, 500, 400));
+    // Exceeds the block size
+    cache.appendToBlock(decodedFrames(&samples, 900, 400));
+    EXPECT_TRUE(tryRead(&cache, 100, 1000));
+    EXPECT_TRUE(tryRead(&cache, 450, 100));
+    EXPECT_FALSE(tryRead(&cache, 50, 100));
+    EXPECT_FALSE(tryRead(&cache, 1000, 200));
+
+    // Discontinuous frames are not recorded
+    cache.startBlock(5000);
+    cache.appendToBlock(decodedFrames(&samples, 5000, 100));
+    cache.appendToBlock(decodedFrames(&samples, 6000, 100));
+    EXPECT_TRUE(tryRead(&cache, 5000, 100));
+    EXPECT_FALSE(tryRead(&cache, 6000, 100));
+}
+
+TEST(DecodedFrameCacheTest, ReplaceLeastRecentlyUsedBlock) {
+    mixxx::DecodedFrameCache cache(2, 1000);
+    cache.reset(kSignalInfo);
+    std::vector<CSAMPLE> samples;
+
+    cache.startBlock(0);
+    cache.appendToBlock(decodedFrames(&samples, 0, 100));
+    cache.startBlock(1000);
+    cache.appendToBlock(decodedFrames(&samples, 1000, 100));
+    EXPECT_TRUE(tryRead(&cache, 0, 100));
+
+    cache.startBlock(2000);
+    cache.appendToBlock(decodedFrames(&samples, 2000, 100));
+    EXPECT_TRUE(tryRead(&cache, 0, 100));
+    EXPECT_FALSE(tryRead(&cache, 1000, 100));
+    EXPECT_TRUE(tryRead(&cache, 2000, 100));
+
+    // Reading from the cache stops recording
+    cache.appendToBlock(decodedFrames(&samples, 2100, 100));
+    EXPECT_FALSE(tryRead(&cache, 2100, 100));
+}
+
+} // namespace
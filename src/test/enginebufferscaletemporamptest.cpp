@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <QtDebug>
+#include <cmath>
+
+#include "engine/bufferscalers/enginebufferscalest.h"
+#include "engine/readaheadmanager.h"
+#include "test/mixxxtest.h"
+#include "util/math.h"
+#include "util/samplebuffer.h"
+#include "util/types.h"
+#ifdef __RUBBERBAND__
+#include "engine/bufferscalers/enginebufferscalerubberband.h"
+#include "engine/bufferscalers/rubberbandworkerpool.h"
+#endif
+
+namespace {
+
+const mixxx::audio::SampleRate kSampleRate(44100);
+const mixxx::audio::ChannelCount kChannelCount = mixxx::audio::ChannelCount::stereo();
+
+constexpr SINT kBufferFrames = 8192;
+
+// The read frames are only accounted per block of input frames
+// that is passed to the time stretcher. The tempo changes between
+// these blocks while ramping.
+constexpr double kMaxReadFramesError = 0.05 * kBufferFrames;
+
+// Provides an endless sine wave
+class ReadAheadManagerFake : public ReadAheadManager {
+  public:
+    ReadAheadManagerFake()
+            : ReadAheadManager(),
+              m_frameIndex(0) {
+    }
+
+    SINT getNextSamples(double dRate,
+            CSAMPLE* buffer,
+            SINT requested_samples,
+            mixxx::audio::ChannelCount channelCount) override {
+        Q_UNUSED(dRate);
+        const SINT frames = requested_samples / channelCount;
+        for (SINT i = 0; i < frames; ++i) {
+            const CSAMPLE value = static_cast<CSAMPLE>(0.5 *
+                    std::sin(2 * M_PI * 440 * m_frameIndex++ / kSampleRate));
+            for (int channel = 0; channel < channelCount; ++channel) {
+                buffer[i * channelCount + channel] = value;
+            }
+        }
+        return frames * channelCount;
+    }
+
+  private:
+    SINT m_frameIndex;
+};
+
+// Exposes the tempo ramp that is shared by all scalers
+class EngineBufferScaleSTProbe : public EngineBufferScaleST {
+  public:
+    using EngineBufferScaleST::EngineBufferScaleST;
+    using EngineBufferScale::rampedTempoRatio;
+};
+
+class EngineBufferScaleTempoRampTest : public MixxxTest {
+  protected:
+    EngineBufferScaleTempoRampTest()
+            : m_outputBuffer(kChannelCount * kBufferFrames) {
+    }
+
+    static void setTempo(EngineBufferScale* pScaler, double tempoRatio) {
+        double pitchRatio = 1.0;
+        pScaler->setScaleParameters(1.0, &tempoRatio, &pitchRatio);
+    }
+
+    double scaleBuffer(EngineBufferScale* pScaler) {
+        return pScaler->scaleBuffer(m_outputBuffer.data(), m_outputBuffer.size());
+    }
+
+    void expectReadFramesFollowRamp(EngineBufferScale* pScaler) {
+        pScaler->setSignal(kSampleRate, kChannelCount);
+        setTempo(pScaler, 1.0);
+        pScaler->clear();
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_NEAR(kBufferFrames, scaleBuffer(pScaler), kMaxReadFramesError);
+        }
+
+        // Integrated over a linear ramp from 1.0 to 1.5
+        setTempo(pScaler, 1.5);
+        EXPECT_NEAR(1.25 * kBufferFrames, scaleBuffer(pScaler), kMaxReadFramesError);
+        // Constant afterwards
+        EXPECT_NEAR(1.5 * kBufferFrames, scaleBuffer(pScaler), kMaxReadFramesError);
+
+        // No ramp after seeking, which clears the scaler
+        setTempo(pScaler, 1.0);
+        pScaler->clear();
+        EXPECT_NEAR(kBufferFrames, scaleBuffer(pScaler), kMaxReadFramesError);
+
+        // Nothing is read at a tempo of 0
+        setTempo(pScaler, 0.0);
+        EXPECT_EQ(0.0, scaleBuffer(pScaler));
+    }
+
+    ReadAheadManagerFake m_readAheadManager;
+    mixxx::SampleBuffer m_outputBuffer;
+};
+
+TEST_F(EngineBufferScaleTempoRampTest, RampFromPreviousTempo) {
+    EngineBufferScaleSTProbe scaler(&m_readAheadManager);
+    scaler.setSignal(kSampleRate, kChannelCount);
+    setTempo(&scaler, 1.0);
+    scaleBuffer(&scaler);
+
+    setTempo(&scaler, 1.5);
+    EXPECT_DOUBLE_EQ(1.0, scaler.rampedTempoRatio(0, kBufferFrames));
+    EXPECT_DOUBLE_EQ(1.25, scaler.rampedTempoRatio(kBufferFrames / 2, kBufferFrames));
+    EXPECT_DOUBLE_EQ(1.5, scaler.rampedTempoRatio(kBufferFrames, kBufferFrames));
+
+    // The next buffer starts at the new tempo
+    scaleBuffer(&scaler);
+    EXPECT_DOUBLE_EQ(1.5, scaler.rampedTempoRatio(0, kBufferFrames));
+    EXPECT_DOUBLE_EQ(1.5, scaler.rampedTempoRatio(kBufferFrames, kBufferFrames));
+}
+
+TEST_F(EngineBufferScaleTempoRampTest, NoRampAfterClear) {
+    EngineBufferScaleSTProbe scaler(&m_readAheadManager);
+    scaler.setSignal(kSampleRate, kChannelCount);
+    setTempo(&scaler, 1.0);
+    scaleBuffer(&scaler);
+
+    // EngineBuffer clears the scaler after seeking
+    setTempo(&scaler, 1.5);
+    scaler.clear();
+    EXPECT_DOUBLE_EQ(1.5, scaler.rampedTempoRatio(0, kBufferFrames));
+    EXPECT_DOUBLE_EQ(1.5, scaler.rampedTempoRatio(kBufferFrames / 2, kBufferFrames));
+}
+
+TEST_F(EngineBufferScaleTempoRampTest, NoRampFromOrToZero) {
+    EngineBufferScaleSTProbe scaler(&m_readAheadManager);
+    scaler.setSignal(kSampleRate, kChannelCount);
+    setTempo(&scaler, 0.0);
+    EXPECT_EQ(0.0, scaleBuffer(&scaler));
+
+    // Starting
+    setTempo(&scaler, 1.5);
+    EXPECT_DOUBLE_EQ(1.5, scaler.rampedTempoRatio(0, kBufferFrames));
+    EXPECT_DOUBLE_EQ(1.5, scaler.rampedTempoRatio(kBufferFrames / 2, kBufferFrames));
+    scaleBuffer(&scaler);
+
+    // Stopping
+    setTempo(&scaler, 0.0);
+    EXPECT_DOUBLE_EQ(0.0, scaler.rampedTempoRatio(0, kBufferFrames));
+    EXPECT_DOUBLE_EQ(0.0, scaler.rampedTempoRatio(kBufferFrames / 2, kBufferFrames));
+    EXPECT_EQ(0.0, scaleBuffer(&scaler));
+}
+
+TEST_F(EngineBufferScaleTempoRampTest, SoundTouchReadFramesFollowRamp) {
+    EngineBufferScaleST scaler(&m_readAheadManager);
+    expectReadFramesFollowRamp(&scaler);
+}
+
+#ifdef __RUBBERBAND__
+TEST_F(EngineBufferScaleTempoRampTest, RubberBandReadFramesFollowRamp) {
+    RubberBandWorkerPool::createInstance();
+    {
+        EngineBufferScaleRubberBand scaler(&m_readAheadManager);
+        expectReadFramesFollowRamp(&scaler);
+    }
+    RubberBandWorkerPool::destroy();
+}
+#endif
+
+} // namespace
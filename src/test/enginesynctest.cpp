@@ -1,3 +1,4 @@
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -87,6 +88,10 @@ class EngineSyncTest : public MockedEngineBackendTest {
         }
     }
 
+    Syncable* getSyncable(const QString& group) {
+        return m_pEngineSync->getSyncableForGroup(group);
+    }
+
     void assertNoLeader() {
         EXPECT_EQ(NULL, m_pEngineSync->getLeaderChannel());
         EXPECT_EQ(NULL, m_pEngineSync->getLeaderSyncable());
@@ -3179,3 +3184,76 @@ TEST_F(EngineSyncTest, DISABLED_KeepCorrectFactorOnLoad) {
             ControlObject::get(ConfigKey(m_sGroup2, "rate")),
             0.005);
 }
+
+TEST_F(EngineSyncTest, InternalClockBeatDistancePublishedAfterCallback) {
+    m_pTrack1->trySetBeats(mixxx::Beats::fromConstTempo(
+            m_pTrack1->getSampleRate(), mixxx::audio::kStartFramePos, mixxx::Bpm(120)));
+    m_pTrack2->trySetBeats(mixxx::Beats::fromConstTempo(
+            m_pTrack2->getSampleRate(), mixxx::audio::kStartFramePos, mixxx::Bpm(124)));
+    ControlProxy(m_sGroup1, "sync_mode").set(static_cast<double>(SyncMode::LeaderExplicit));
+    ControlProxy(m_sGroup2, "sync_enabled").set(1.0);
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+    for (int i = 0; i < 10; ++i) {
+        ProcessBuffer();
+    }
+    ASSERT_TRUE(isExplicitLeader(m_sGroup1));
+    ASSERT_TRUE(isFollower(m_sGroup2));
+
+    // The beat distance of the internal clock is only published once at
+    // the end of each callback, but must still be the final value.
+    Syncable* pInternalClock = getSyncable(m_sInternalClockGroup);
+    ASSERT_NE(nullptr, pInternalClock);
+    EXPECT_DOUBLE_EQ(pInternalClock->getBeatDistance(),
+            ControlObject::get(ConfigKey(m_sInternalClockGroup, "beat_distance")));
+
+    // Outside of a callback the control is updated immediately
+    ControlObject::set(ConfigKey(m_sInternalClockGroup, "beat_distance"), 0.25);
+    EXPECT_DOUBLE_EQ(0.25, pInternalClock->getBeatDistance());
+}
+
+namespace {
+
+class EngineSyncBenchmark : public EngineSyncTest {
+  public:
+    void TestBody() override {
+    }
+
+    // Measures the Sync Lock updates that are done once per audio callback
+    // without processing any audio. Deck 1 is the playing leader and all
+    // other decks are followers.
+    void run(benchmark::State& state, int deckCount) {
+        SetUp();
+        const QString groups[] = {m_sGroup1, m_sGroup2, m_sGroup3};
+        const TrackPointer tracks[] = {m_pTrack1, m_pTrack2, m_pTrack3};
+        for (int i = 0; i < deckCount; ++i) {
+            tracks[i]->trySetBeats(mixxx::Beats::fromConstTempo(
+                    tracks[i]->getSampleRate(),
+                    mixxx::audio::kStartFramePos,
+                    mixxx::Bpm(120 + i)));
+            ControlProxy(groups[i], "sync_mode")
+                    .set(static_cast<double>(i == 0
+                                    ? SyncMode::LeaderExplicit
+                                    : SyncMode::Follower));
+        }
+        ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+        ProcessBuffer();
+
+        Syncable* pLeader = getSyncable(m_sGroup1);
+        const auto sampleRate = mixxx::audio::SampleRate(44100);
+        const auto bufferSize = static_cast<std::size_t>(kProcessBufferSize);
+        for (auto _ : state) {
+            m_pEngineSync->onCallbackStart(sampleRate, bufferSize);
+            m_pEngineSync->notifyBeatDistanceChanged(
+                    pLeader, pLeader->getBeatDistance());
+            m_pEngineSync->onCallbackEnd(sampleRate, bufferSize);
+        }
+        TearDown();
+    }
+};
+
+static void BM_EngineSyncCallback(benchmark::State& state) {
+    EngineSyncBenchmark().run(state, static_cast<int>(state.range(0)));
+}
+BENCHMARK(BM_EngineSyncCallback)->DenseRange(1, 3);
+
+} // namespace
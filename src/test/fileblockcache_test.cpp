@@ -0,0 +1,119 @@
+#include "util/fileblockcache.h"
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+
+namespace {
+
+// Not a multiple of the block size
+constexpr qint64 kFileSize = 5 * mixxx::FileBlockCache::kBlockSize + 123;
+
+class FileBlockCacheTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        ASSERT_TRUE(m_tempDir.isValid());
+        m_fileData.resize(static_cast<int>(kFileSize));
+        for (int i = 0; i < m_fileData.size(); ++i) {
+            m_fileData[i] = static_cast<char>(QRandomGenerator::global()->bounded(256));
+        }
+        m_filePath = m_tempDir.filePath(QStringLiteral("test.bin"));
+        QFile file(m_filePath);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        ASSERT_EQ(m_fileData.size(), file.write(m_fileData));
+    }
+
+    QByteArray readAt(mixxx::BlockCachedFile* pFile, qint64 pos, qint64 size) {
+        QByteArray data(static_cast<int>(size), '\0');
+        EXPECT_TRUE(pFile->seek(pos));
+        const qint64 bytesRead = pFile->read(data.data(), size);
+        EXPECT_LE(0, bytesRead);
+        data.resize(static_cast<int>(bytesRead));
+        return data;
+    }
+
+    QTemporaryDir m_tempDir;
+    QString m_filePath;
+    QByteArray m_fileData;
+};
+
+TEST_F(FileBlockCacheTest, ReadAcrossBlocks) {
+    mixxx::FileBlockCache cache(1024 * 1024, 0);
+    mixxx::BlockCachedFile file(m_filePath, &cache);
+    ASSERT_TRUE(file.open());
+    EXPECT_EQ(kFileSize, file.size());
+
+    const qint64 pos = mixxx::FileBlockCache::kBlockSize - 7;
+    EXPECT_EQ(m_fileData.mid(static_cast<int>(pos), 1000), readAt(&file, pos, 1000));
+    EXPECT_EQ(pos + 1000, file.pos());
+    EXPECT_EQ(0u, cache.stats().hits);
+    EXPECT_EQ(2u, cache.stats().misses);
+
+    // Reading beyond the end
+    EXPECT_EQ(m_fileData.right(10), readAt(&file, kFileSize - 10, 100));
+    EXPECT_TRUE(file.atEnd());
+    EXPECT_TRUE(readAt(&file, kFileSize, 100).isEmpty());
+}
+
+TEST_F(FileBlockCacheTest, ShareBlocksBetweenFiles) {
+    mixxx::FileBlockCache cache(1024 * 1024, 0);
+    {
+        mixxx::BlockCachedFile file(m_filePath, &cache);
+        ASSERT_TRUE(file.open());
+        EXPECT_EQ(m_fileData, readAt(&file, 0, kFileSize));
+    }
+    const auto stats = cache.stats();
+    EXPECT_EQ(0u, stats.hits);
+    EXPECT_EQ(6u, stats.misses);
+
+    mixxx::BlockCachedFile file(m_filePath, &cache);
+    ASSERT_TRUE(file.open());
+    EXPECT_EQ(m_fileData, readAt(&file, 0, kFileSize));
+    EXPECT_EQ(6u, cache.stats().hits);
+    EXPECT_EQ(6u, cache.stats().misses);
+    EXPECT_DOUBLE_EQ(0.5, cache.stats().hitRate());
+}
+
+TEST_F(FileBlockCacheTest, IgnoreBlocksOfModifiedFiles) {
+    mixxx::FileBlockCache cache(1024 * 1024, 0);
+    {
+        mixxx::BlockCachedFile file(m_filePath, &cache);
+        ASSERT_TRUE(file.open());
+        EXPECT_EQ(m_fileData.left(100), readAt(&file, 0, 100));
+    }
+
+    // Modifying the file changes its size
+    m_fileData[0] = static_cast<char>(~m_fileData[0]);
+    m_fileData.append("modified");
+    {
+        QFile file(m_filePath);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        ASSERT_EQ(m_fileData.size(), file.write(m_fileData));
+    }
+
+    mixxx::BlockCachedFile file(m_filePath, &cache);
+    ASSERT_TRUE(file.open());
+    EXPECT_EQ(m_fileData.left(100), readAt(&file, 0, 100));
+    EXPECT_EQ(0u, cache.stats().hits);
+}
+
+TEST_F(FileBlockCacheTest, ReadAhead) {
+    mixxx::FileBlockCache cache(1024 * 1024, 2 * mixxx::FileBlockCache::kBlockSize);
+    mixxx::BlockCachedFile file(m_filePath, &cache);
+    ASSERT_TRUE(file.open());
+
+    // Random access with prefetching of the following blocks
+    QRandomGenerator random(42);
+    for (int i = 0; i < 100; ++i) {
+        const qint64 pos = random.bounded(static_cast<int>(kFileSize));
+        const qint64 size = random.bounded(3 * static_cast<int>(
+                                                   mixxx::FileBlockCache::kBlockSize));
+        ASSERT_EQ(m_fileData.mid(static_cast<int>(pos), static_cast<int>(size)),
+                readAt(&file, pos, size));
+    }
+    EXPECT_LT(0u, cache.stats().hits);
+}
+
+} // namespace
@@ -3,6 +3,7 @@
 #include <QThread>
 #include <QtDebug>
 #include <atomic>
+#include <memory>
 
 #include "test/mixxxtest.h"
 #include "track/track.h"
@@ -229,3 +230,44 @@ TEST_F(GlobalTrackCacheTest, evictWhileMoving) {
 
     EXPECT_TRUE(GlobalTrackCacheLocker().isEmpty());
 }
+
+TEST_F(GlobalTrackCacheTest, lookupWhileLocked) {
+    ASSERT_TRUE(GlobalTrackCacheLocker().isEmpty());
+
+    const TrackId trackId(QVariant(1));
+
+    TrackPointer track;
+    {
+        auto testFileAccess = mixxx::FileAccess(mixxx::FileInfo(getTestDir().filePath(kTestFile)));
+        GlobalTrackCacheResolver resolver(testFileAccess);
+        track = resolver.getTrack();
+        EXPECT_TRUE(static_cast<bool>(track));
+
+        resolver.initTrackIdAndUnlockCache(trackId);
+    }
+    const auto trackRef = TrackRef::fromFileInfo(track->getFileInfo());
+
+    {
+        // Lookups from other threads must not wait while the
+        // cache is locked, e.g. while saving an evicted track
+        GlobalTrackCacheLocker cacheLocker;
+        TrackPointer trackById;
+        TrackPointer trackByRef;
+        QSet<TrackId> trackIds;
+        std::unique_ptr<QThread> lookupThread(QThread::create([&] {
+            trackById = GlobalTrackCacheReader::lookupTrackById(trackId);
+            trackByRef = GlobalTrackCacheReader::lookupTrackByRef(trackRef);
+            trackIds = GlobalTrackCacheReader::getCachedTrackIds();
+        }));
+        lookupThread->start();
+        EXPECT_TRUE(lookupThread->wait(10000));
+        EXPECT_EQ(track, trackById);
+        EXPECT_EQ(track, trackByRef);
+        EXPECT_EQ(QSet<TrackId>{trackId}, trackIds);
+    }
+
+    track.reset();
+    EXPECT_TRUE(GlobalTrackCacheLocker().isEmpty());
+    EXPECT_EQ(TrackPointer(), GlobalTrackCacheReader::lookupTrackById(trackId));
+    EXPECT_EQ(TrackPointer(), GlobalTrackCacheReader::lookupTrackByRef(trackRef));
+}
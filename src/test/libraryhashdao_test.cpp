@@ -0,0 +1,59 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <QDateTime>
+#include <QDir>
+
+#include "library/dao/libraryhashdao.h"
+#include "test/librarytest.h"
+
+using ::testing::ElementsAre;
+
+class LibraryHashDAOTest : public LibraryTest {
+  protected:
+    LibraryHashDAOTest() {
+        m_libraryHashDao.initialize(dbConnection());
+    }
+
+    LibraryHashDAO m_libraryHashDao;
+};
+
+TEST_F(LibraryHashDAOTest, changeJournal) {
+    const QString dir1 = QDir::tempPath() + QStringLiteral("/music/dir1");
+    const QString dir2 = QDir::tempPath() + QStringLiteral("/music/dir2");
+    EXPECT_TRUE(m_libraryHashDao.getChangedDirectories().isEmpty());
+
+    m_libraryHashDao.recordChangedDirectory(dir2);
+    m_libraryHashDao.recordChangedDirectory(dir1);
+    // Recording a change again doesn't add a duplicate
+    m_libraryHashDao.recordChangedDirectory(dir2);
+    EXPECT_THAT(m_libraryHashDao.getChangedDirectories(), ElementsAre(dir1, dir2));
+
+    m_libraryHashDao.clearChangedDirectories();
+    EXPECT_TRUE(m_libraryHashDao.getChangedDirectories().isEmpty());
+}
+
+TEST_F(LibraryHashDAOTest, directoryModifiedTimes) {
+    const QString dir1 = QDir::tempPath() + QStringLiteral("/music/dir1");
+    const QString dir2 = QDir::tempPath() + QStringLiteral("/music/dir2");
+    m_libraryHashDao.saveDirectoryHash(dir1, 1);
+    m_libraryHashDao.saveDirectoryHash(dir2, 2);
+
+    // Unknown until a scan has finished
+    auto modifiedTimes = m_libraryHashDao.getDirectoryModifiedTimes();
+    ASSERT_EQ(2, modifiedTimes.size());
+    EXPECT_FALSE(modifiedTimes.value(dir1).isValid());
+    EXPECT_FALSE(modifiedTimes.value(dir2).isValid());
+
+    const QDateTime modified = QDateTime::fromMSecsSinceEpoch(1700000000123, Qt::UTC);
+    m_libraryHashDao.updateDirectoryModifiedTimes({{dir1, modified}, {dir2, QDateTime()}});
+    modifiedTimes = m_libraryHashDao.getDirectoryModifiedTimes();
+    EXPECT_EQ(modified, modifiedTimes.value(dir1));
+    EXPECT_FALSE(modifiedTimes.value(dir2).isValid());
+
+    // Deleted directories are not included
+    m_libraryHashDao.updateDirectoryStatuses({dir1}, true, false);
+    modifiedTimes = m_libraryHashDao.getDirectoryModifiedTimes();
+    EXPECT_FALSE(modifiedTimes.contains(dir1));
+    EXPECT_TRUE(modifiedTimes.contains(dir2));
+}
@@ -0,0 +1,106 @@
+#include "engine/cachingreader/preloadedtrackpool.h"
+
+#include <gtest/gtest.h>
+
+#include "engine/cachingreader/cachingreaderchunk.h"
+
+namespace {
+
+const mixxx::audio::SampleRate kSampleRate(44100);
+
+PreloadedTrackPool::Key trackKey(const QString& location) {
+    PreloadedTrackPool::Key key;
+    key.location = location;
+    key.fileSize = 1000;
+    key.fileLastModified = 1;
+    key.channelCount = 2;
+    return key;
+}
+
+PreloadedTrackPointer preloadedTrack(int chunkCount) {
+    auto pTrack = std::make_shared<PreloadedTrack>();
+    pTrack->signalInfo = mixxx::audio::SignalInfo(
+            mixxx::audio::ChannelCount::stereo(),
+            kSampleRate);
+    pTrack->frameIndexRange = mixxx::IndexRange::forward(
+            0, chunkCount * CachingReaderChunk::kFrames);
+    for (int i = 0; i < chunkCount; ++i) {
+        PreloadedTrack::Chunk chunk;
+        chunk.frameIndexRange = mixxx::IndexRange::forward(
+                i * CachingReaderChunk::kFrames,
+                CachingReaderChunk::kFrames);
+        chunk.samples.fill(static_cast<CSAMPLE>(i),
+                CachingReaderChunk::kFrames * 2);
+        pTrack->chunks.insert(i, chunk);
+    }
+    return pTrack;
+}
+
+TEST(PreloadedTrackPoolTest, FindTracks) {
+    PreloadedTrackPool pool(1024 * 1024, 1);
+    pool.insert(trackKey(QStringLiteral("a.mp3")), preloadedTrack(2));
+    EXPECT_EQ(1, pool.count());
+    EXPECT_EQ(2 * CachingReaderChunk::kFrames * 2 * qint64(sizeof(CSAMPLE)),
+            pool.sizeInBytes());
+
+    const auto pTrack = pool.find(trackKey(QStringLiteral("a.mp3")));
+    ASSERT_TRUE(pTrack);
+    EXPECT_EQ(2, pTrack->chunks.size());
+    EXPECT_FALSE(pool.find(trackKey(QStringLiteral("b.mp3"))));
+
+    // The file has been modified
+    auto modifiedKey = trackKey(QStringLiteral("a.mp3"));
+    modifiedKey.fileLastModified = 2;
+    EXPECT_FALSE(pool.find(modifiedKey));
+
+    pool.remove(trackKey(QStringLiteral("a.mp3")));
+    EXPECT_FALSE(pool.find(trackKey(QStringLiteral("a.mp3"))));
+}
+
+TEST(PreloadedTrackPoolTest, EvictLeastRecentlyUsedTrack) {
+    // Capacity for 4 chunks
+    PreloadedTrackPool pool(4 * CachingReaderChunk::kFrames * 2 * sizeof(CSAMPLE), 1);
+    pool.insert(trackKey(QStringLiteral("a.mp3")), preloadedTrack(2));
+    pool.insert(trackKey(QStringLiteral("b.mp3")), preloadedTrack(2));
+    EXPECT_TRUE(pool.find(trackKey(QStringLiteral("a.mp3"))));
+
+    pool.insert(trackKey(QStringLiteral("c.mp3")), preloadedTrack(2));
+    EXPECT_EQ(2, pool.count());
+    EXPECT_TRUE(pool.find(trackKey(QStringLiteral("a.mp3"))));
+    EXPECT_FALSE(pool.find(trackKey(QStringLiteral("b.mp3"))));
+    EXPECT_TRUE(pool.find(trackKey(QStringLiteral("c.mp3"))));
+
+    // Exceeds the capacity
+    pool.insert(trackKey(QStringLiteral("d.mp3")), preloadedTrack(5));
+    EXPECT_FALSE(pool.find(trackKey(QStringLiteral("d.mp3"))));
+}
+
+TEST(PreloadedTrackPoolTest, ChunksToPreload) {
+    const auto frameIndexRange = mixxx::IndexRange::forward(
+            0, 100 * CachingReaderChunk::kFrames);
+    // 3 seconds at 44.1 kHz
+    const SINT chunkCount = 17;
+    const auto mainCuePosition = mixxx::audio::FramePos(
+            50 * CachingReaderChunk::kFrames + 100);
+
+    EXPECT_TRUE(PreloadedTrackPool::isChunkToPreload(
+            0, frameIndexRange, kSampleRate, mainCuePosition));
+    EXPECT_TRUE(PreloadedTrackPool::isChunkToPreload(
+            chunkCount - 1, frameIndexRange, kSampleRate, mainCuePosition));
+    EXPECT_FALSE(PreloadedTrackPool::isChunkToPreload(
+            chunkCount, frameIndexRange, kSampleRate, mainCuePosition));
+    EXPECT_FALSE(PreloadedTrackPool::isChunkToPreload(
+            48, frameIndexRange, kSampleRate, mainCuePosition));
+    EXPECT_TRUE(PreloadedTrackPool::isChunkToPreload(
+            49, frameIndexRange, kSampleRate, mainCuePosition));
+    EXPECT_TRUE(PreloadedTrackPool::isChunkToPreload(
+            50 + chunkCount - 1, frameIndexRange, kSampleRate, mainCuePosition));
+    EXPECT_FALSE(PreloadedTrackPool::isChunkToPreload(
+            50 + chunkCount, frameIndexRange, kSampleRate, mainCuePosition));
+
+    // Without a main cue only the start is preloaded
+    EXPECT_FALSE(PreloadedTrackPool::isChunkToPreload(
+            50, frameIndexRange, kSampleRate, mixxx::audio::FramePos()));
+}
+
+} // namespace
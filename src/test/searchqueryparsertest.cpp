@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <QDir>
+#include <QSqlQuery>
 #include <QtDebug>
 
 #include "library/searchquery.h"
@@ -35,6 +36,18 @@ class SearchQueryParserTest : public LibraryTest {
         return pTrack ? pTrack->getId() : TrackId();
     }
 
+    QList<TrackId> selectTrackIds(const QString& whereClause) {
+        QSqlQuery query(dbConnection());
+        EXPECT_TRUE(query.exec(
+                QStringLiteral("SELECT id FROM library WHERE %1 ORDER BY id")
+                        .arg(whereClause)));
+        QList<TrackId> trackIds;
+        while (query.next()) {
+            trackIds.append(TrackId(query.value(0)));
+        }
+        return trackIds;
+    }
+
     SearchQueryParser m_parser;
 
     // The expected query to be returned by CrateFilterNode
@@ -843,6 +856,74 @@ TEST_F(SearchQueryParserTest, HumanReadableDurationSearchwithRangeFilter) {
             qPrintable(pQuery->toSql()));
 }
 
+TEST_F(SearchQueryParserTest, FullTextIndex) {
+    if (!internalCollection()->getTrackDAO().hasFullTextIndex()) {
+        GTEST_SKIP() << "SQLite has been built without FTS5";
+    }
+    m_parser.setSearchColumns({"artist", "title", "filetype"});
+    m_parser.setUseFullTextIndex(true);
+
+    const QString kTrackALocationTest(getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-jpg.mp3")));
+    const QString kTrackBLocationTest(getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-png.mp3")));
+    TrackPointer pTrackA = getOrAddTrackByLocation(kTrackALocationTest);
+    ASSERT_TRUE(pTrackA);
+    TrackPointer pTrackB = getOrAddTrackByLocation(kTrackBLocationTest);
+    ASSERT_TRUE(pTrackB);
+    pTrackA->setArtist(QStringLiteral("Sven Väth"));
+    pTrackA->setTitle(QStringLiteral("L'Esperanza"));
+    ASSERT_TRUE(internalCollection()->getTrackDAO().saveTrack(pTrackA.get()));
+    pTrackB->setArtist(QStringLiteral("Röyksopp"));
+    pTrackB->setTitle(QStringLiteral("\"Eple\" (Vath Remix)"));
+    ASSERT_TRUE(internalCollection()->getTrackDAO().saveTrack(pTrackB.get()));
+
+    // Indexed columns are searched with a single phrase query, the
+    // remaining columns with LIKE
+    auto pQuery(m_parser.parseQuery("VÄTH", QString()));
+    EXPECT_STREQ(
+            qPrintable(QString(
+                    "(id IN (SELECT rowid FROM library_fts WHERE library_fts "
+                    "MATCH '{artist title} : \"vath\"')) OR (filetype LIKE '%vath%')")),
+            qPrintable(pQuery->toSql()));
+    EXPECT_EQ((QList<TrackId>{pTrackA->getId(), pTrackB->getId()}),
+            selectTrackIds(pQuery->toSql()));
+
+    pQuery = m_parser.parseQuery("artist:vath", QString());
+    EXPECT_EQ(QList<TrackId>{pTrackA->getId()}, selectTrackIds(pQuery->toSql()));
+
+    // Quotes within the phrase
+    const TextFilterNode quotedNode(dbConnection(),
+            {"title"},
+            QStringLiteral("\"eple\""),
+            StringMatch::Contains,
+            true);
+    EXPECT_EQ(QList<TrackId>{pTrackB->getId()}, selectTrackIds(quotedNode.toSql()));
+
+    // Terms that are too short for the trigram index fall back to LIKE
+    pQuery = m_parser.parseQuery("artist:va", QString());
+    EXPECT_STREQ(
+            qPrintable(QString("artist LIKE '%va%'")),
+            qPrintable(pQuery->toSql()));
+
+    // The index follows updates of the library
+    pTrackA->setArtist(QStringLiteral("Dr. Motte"));
+    ASSERT_TRUE(internalCollection()->getTrackDAO().saveTrack(pTrackA.get()));
+    pQuery = m_parser.parseQuery("artist:vath", QString());
+    EXPECT_TRUE(selectTrackIds(pQuery->toSql()).isEmpty());
+    pQuery = m_parser.parseQuery("artist:motte", QString());
+    EXPECT_EQ(QList<TrackId>{pTrackA->getId()}, selectTrackIds(pQuery->toSql()));
+
+    const TrackId trackBId = pTrackB->getId();
+    pTrackB.reset();
+    trackCollectionManager()->purgeTracks(
+            {TrackRef::fromFilePath(kTrackBLocationTest, trackBId)});
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(QStringLiteral("SELECT COUNT(*) FROM library_fts")));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(1, query.value(0).toInt());
+}
+
 TEST_F(SearchQueryParserTest, CrateFilter) {
     // User's search term
     QString searchTerm = "test";
@@ -0,0 +1,197 @@
+#include "skin/legacy/skinxmlcache.h"
+
+#include <benchmark/benchmark.h>
+
+#include <QDateTime>
+#include <QDomDocument>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "test/mixxxtest.h"
+
+namespace {
+
+const QByteArray kSkinXml = QByteArrayLiteral(
+        "<skin>\n"
+        "  <!-- comments are not needed -->\n"
+        "  <Template src=\"skin:deck.xml\">\n"
+        "    <SetVariable name=\"group\">[Channel1]</SetVariable>\n"
+        "  </Template>\n"
+        "  <WidgetGroup>\n"
+        "    <ObjectName>DeckContainer</ObjectName>\n"
+        "    <Size>100f,50me</Size>\n"
+        "    <Connection>\n"
+        "      <ConfigKey><Variable name=\"group\"/>,play</ConfigKey>\n"
+        "    </Connection>\n"
+        "    <Style><![CDATA[WWidget { color: #fff; }]]></Style>\n"
+        "  </WidgetGroup>\n"
+        "</skin>\n");
+
+constexpr qint64 kMaxCacheSizeBytes = 1024 * 1024;
+
+/// A template with the given number of decks that resembles the
+/// structure of the shipped skins
+QByteArray generateSkinXml(int deckCount) {
+    QByteArray xml = QByteArrayLiteral("<Template>\n");
+    for (int deck = 1; deck <= deckCount; ++deck) {
+        const QByteArray group = QByteArrayLiteral("[Channel") +
+                QByteArray::number(deck) + QByteArrayLiteral("]");
+        xml += QByteArrayLiteral("  <WidgetGroup>\n    <ObjectName>Deck") +
+                QByteArray::number(deck) +
+                QByteArrayLiteral("</ObjectName>\n    <Layout>horizontal</Layout>\n"
+                                  "    <Children>\n");
+        for (int button = 0; button < 20; ++button) {
+            xml += QByteArrayLiteral(
+                           "      <PushButton>\n"
+                           "        <TooltipId>play_cue_set</TooltipId>\n"
+                           "        <Size>40f,24f</Size>\n"
+                           "        <NumberStates>2</NumberStates>\n"
+                           "        <State><Number>0</Number><Text>Play</Text></State>\n"
+                           "        <State><Number>1</Number><Text>Pause</Text></State>\n"
+                           "        <Connection>\n"
+                           "          <ConfigKey>") +
+                    group +
+                    QByteArrayLiteral(",play</ConfigKey>\n"
+                                      "          <ButtonState>LeftButton</ButtonState>\n"
+                                      "        </Connection>\n"
+                                      "      </PushButton>\n");
+        }
+        xml += QByteArrayLiteral("    </Children>\n  </WidgetGroup>\n");
+    }
+    xml += QByteArrayLiteral("</Template>\n");
+    return xml;
+}
+
+class SkinXmlCacheTest : public MixxxTest {
+  protected:
+    SkinXmlCacheTest()
+            : m_cache(getTestDataDir().filePath("skincache"), kMaxCacheSizeBytes) {
+    }
+
+    static QString withoutComments(const QByteArray& xml) {
+        QDomDocument document;
+        document.setContent(xml);
+        QDomElement root = document.documentElement();
+        for (QDomNode child = root.firstChild(); !child.isNull();) {
+            QDomNode next = child.nextSibling();
+            if (child.isComment()) {
+                root.removeChild(child);
+            }
+            child = next;
+        }
+        return document.toString();
+    }
+
+    SkinXmlCache m_cache;
+};
+
+TEST_F(SkinXmlCacheTest, MissWhenNotInserted) {
+    EXPECT_TRUE(m_cache.lookup(kSkinXml).isNull());
+}
+
+TEST_F(SkinXmlCacheTest, RoundTrip) {
+    QDomDocument document;
+    ASSERT_TRUE(document.setContent(kSkinXml));
+    m_cache.insert(kSkinXml, document);
+
+    const QDomDocument cached = m_cache.lookup(kSkinXml);
+    ASSERT_FALSE(cached.isNull());
+    EXPECT_QSTRING_EQ(withoutComments(kSkinXml), cached.toString());
+
+    const QDomElement style = cached.documentElement()
+                                      .firstChildElement("WidgetGroup")
+                                      .firstChildElement("Style");
+    EXPECT_TRUE(style.firstChild().isCDATASection());
+    EXPECT_QSTRING_EQ("WWidget { color: #fff; }", style.text());
+}
+
+TEST_F(SkinXmlCacheTest, ChangedSourceIsNotFound) {
+    QDomDocument document;
+    ASSERT_TRUE(document.setContent(kSkinXml));
+    m_cache.insert(kSkinXml, document);
+
+    QByteArray changedXml = kSkinXml;
+    changedXml.replace("DeckContainer", "OtherContainer");
+    EXPECT_TRUE(m_cache.lookup(changedXml).isNull());
+}
+
+TEST_F(SkinXmlCacheTest, CorruptFileIsIgnored) {
+    QDomDocument document;
+    ASSERT_TRUE(document.setContent(kSkinXml));
+    m_cache.insert(kSkinXml, document);
+
+    const QDir cacheDir(getTestDataDir().filePath("skincache"));
+    const QStringList files = cacheDir.entryList(QDir::Files);
+    ASSERT_EQ(1, files.size());
+    QFile file(cacheDir.filePath(files.first()));
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    const qint64 size = file.size();
+    ASSERT_TRUE(file.resize(size / 2));
+    file.close();
+
+    EXPECT_TRUE(m_cache.lookup(kSkinXml).isNull());
+}
+
+TEST_F(SkinXmlCacheTest, PruneLeastRecentlyUsed) {
+    const QByteArray otherXml = generateSkinXml(1);
+    QDomDocument document;
+    ASSERT_TRUE(document.setContent(kSkinXml));
+    m_cache.insert(kSkinXml, document);
+    QDomDocument otherDocument;
+    ASSERT_TRUE(otherDocument.setContent(otherXml));
+    m_cache.insert(otherXml, otherDocument);
+
+    // Backdate all files, looking up a document marks it as used
+    const QDir cacheDir(getTestDataDir().filePath("skincache"));
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    for (const auto& fileName : cacheDir.entryList(QDir::Files)) {
+        QFile file(cacheDir.filePath(fileName));
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(now.addDays(-2), QFileDevice::FileModificationTime));
+    }
+    ASSERT_FALSE(m_cache.lookup(kSkinXml).isNull());
+
+    // Only enough space for the smaller file of kSkinXml
+    const SkinXmlCache cache(cacheDir.path(),
+            cacheDir.entryInfoList(QDir::Files, QDir::Size | QDir::Reversed)
+                    .first()
+                    .size());
+    cache.prune();
+    EXPECT_EQ(1, cacheDir.entryList(QDir::Files).size());
+    EXPECT_FALSE(cache.lookup(kSkinXml).isNull());
+    EXPECT_TRUE(cache.lookup(otherXml).isNull());
+}
+
+/// Compares the time needed to restore a document from the cache with
+/// the time needed to parse it.
+static void BM_SkinXmlParse(benchmark::State& state) {
+    const QByteArray xml = generateSkinXml(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        QDomDocument document;
+        document.setContent(xml);
+        benchmark::DoNotOptimize(document);
+    }
+    state.SetBytesProcessed(state.iterations() * xml.size());
+}
+BENCHMARK(BM_SkinXmlParse)->Arg(1)->Arg(4)->Arg(16);
+
+static void BM_SkinXmlCacheLookup(benchmark::State& state) {
+    const QByteArray xml = generateSkinXml(static_cast<int>(state.range(0)));
+    QTemporaryDir tempDir;
+    const SkinXmlCache cache(tempDir.path(), kMaxCacheSizeBytes);
+    QDomDocument parsed;
+    parsed.setContent(xml);
+    cache.insert(xml, parsed);
+    if (cache.lookup(xml).isNull()) {
+        state.SkipWithError("document not cached");
+        return;
+    }
+    for (auto _ : state) {
+        QDomDocument document = cache.lookup(xml);
+        benchmark::DoNotOptimize(document);
+    }
+    state.SetBytesProcessed(state.iterations() * xml.size());
+}
+BENCHMARK(BM_SkinXmlCacheLookup)->Arg(1)->Arg(4)->Arg(16);
+
+} // namespace
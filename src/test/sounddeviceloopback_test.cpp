@@ -0,0 +1,196 @@
+#include "soundio/sounddeviceloopback.h"
+
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "effects/effectsmanager.h"
+#include "engine/channelhandle.h"
+#include "engine/channels/engineaux.h"
+#include "engine/enginemixer.h"
+#include "soundio/soundmanager.h"
+#include "soundio/soundmanagerutil.h"
+#include "test/mixxxtest.h"
+#include "util/cmdlineargs.h"
+#include "util/defs.h"
+#include "util/samplebuffer.h"
+
+namespace {
+
+const QString kSoundcardGroup = QStringLiteral("[Soundcard]");
+const QString kAuxGroup = QStringLiteral("[Auxiliary1]");
+
+constexpr SINT kFramesPerBuffer = 256;
+constexpr int kLatencyBuffers = 3;
+
+class SoundDeviceLoopbackTest : public MixxxTest {
+  protected:
+    SoundDeviceLoopbackTest() {
+        config()->setValue(ConfigKey(kSoundcardGroup,
+                                   QStringLiteral("LoopbackLatencyBuffers")),
+                kLatencyBuffers);
+        config()->setValue(ConfigKey(kSoundcardGroup,
+                                   QStringLiteral("LoopbackLatencyProbe")),
+                true);
+
+        auto pChannelHandleFactory = std::make_shared<ChannelHandleFactory>();
+        m_pEffectsManager = std::make_unique<EffectsManager>(
+                config(), pChannelHandleFactory);
+        m_pEngineMixer = std::make_unique<EngineMixer>(config(),
+                "[Master]",
+                m_pEffectsManager.get(),
+                pChannelHandleFactory,
+                false);
+        // The loopback device is only offered if requested
+        // on the command line
+        CmdlineArgs::Instance().setLoopbackAudio(true);
+        m_pSoundManager = std::make_unique<SoundManager>(
+                config(), m_pEngineMixer.get());
+        CmdlineArgs::Instance().setLoopbackAudio(false);
+
+        ControlObject::set(ConfigKey(QStringLiteral("[App]"),
+                                   QStringLiteral("samplerate")),
+                44100);
+    }
+
+    ~SoundDeviceLoopbackTest() override {
+        m_pSoundManager.reset();
+        m_pEngineMixer.reset();
+        m_pEffectsManager.reset();
+    }
+
+    QSharedPointer<SoundDeviceLoopback> loopbackDevice() const {
+        const auto devices = m_pSoundManager->getDeviceList(
+                kLoopbackDeviceInternalName, true, true);
+        if (devices.isEmpty()) {
+            return nullptr;
+        }
+        auto pDevice = devices.first().dynamicCast<SoundDeviceLoopback>();
+        if (pDevice) {
+            pDevice->setConfigFramesPerBuffer(
+                    static_cast<unsigned int>(kFramesPerBuffer));
+        }
+        return pDevice;
+    }
+
+    /// Routes the impulses of the latency probe through the engine:
+    /// The stereo auxiliary input on the last two channels receives them
+    /// on its right channel and is mixed into the main output on the
+    /// first two channels.
+    void routeAuxiliaryToMain(SoundDeviceLoopback* pDevice) {
+        auto pAux = std::make_unique<EngineAux>(
+                m_pEngineMixer->registerChannelGroup(kAuxGroup),
+                m_pEffectsManager.get());
+        EngineAux* pAuxChannel = pAux.get();
+        m_pEngineMixer->addChannel(std::move(pAux));
+
+        const AudioInput auxInput(AudioPathType::Auxiliary,
+                static_cast<unsigned char>(pDevice->getNumInputChannels() - 2),
+                mixxx::audio::ChannelCount::stereo(),
+                0);
+        m_pSoundManager->registerInput(auxInput, pAuxChannel);
+        ASSERT_EQ(SoundDeviceStatus::Ok,
+                pDevice->addInput(AudioInputBuffer(auxInput, m_auxInputBuffer.data())));
+        pAuxChannel->onInputConfigured(auxInput);
+        ControlObject::set(ConfigKey(kAuxGroup, QStringLiteral("main_mix")), 1.0);
+
+        const AudioOutput mainOutput(AudioPathType::Main,
+                0,
+                mixxx::audio::ChannelCount::stereo());
+        ASSERT_EQ(SoundDeviceStatus::Ok,
+                pDevice->addOutput(AudioOutputBuffer(
+                        mainOutput, m_pEngineMixer->getMainBuffer().data())));
+        m_pEngineMixer->onOutputConnected(mainOutput);
+    }
+
+    mixxx::SampleBuffer m_auxInputBuffer{kMaxEngineSamples};
+    std::unique_ptr<EffectsManager> m_pEffectsManager;
+    std::unique_ptr<EngineMixer> m_pEngineMixer;
+    std::unique_ptr<SoundManager> m_pSoundManager;
+};
+
+TEST_F(SoundDeviceLoopbackTest, MeasureLatency) {
+    const auto pDevice = loopbackDevice();
+    ASSERT_TRUE(pDevice);
+    routeAuxiliaryToMain(pDevice.data());
+    ASSERT_EQ(SoundDeviceStatus::Ok, pDevice->open(false, 0));
+
+    // Same order as in the callback of the clock reference
+    for (int i = 0; i < 200; ++i) {
+        pDevice->readProcess(kFramesPerBuffer);
+        m_pSoundManager->onDeviceOutputCallback(kFramesPerBuffer);
+        pDevice->writeProcess(kFramesPerBuffer);
+    }
+    pDevice->close();
+
+    // The impulses need at least the loopback delay and the engine must not
+    // delay them by more than a buffer
+    const auto stats = pDevice->getStatistics();
+    EXPECT_LT(0, stats.latencyProbes);
+    EXPECT_LE(kLatencyBuffers * kFramesPerBuffer, stats.minLatencyFrames);
+    EXPECT_LE(stats.minLatencyFrames, stats.maxLatencyFrames);
+    EXPECT_GE((kLatencyBuffers + 1) * kFramesPerBuffer, stats.maxLatencyFrames);
+}
+
+TEST_F(SoundDeviceLoopbackTest, NoLatencyWithoutEnginePath) {
+    const auto pDevice = loopbackDevice();
+    ASSERT_TRUE(pDevice);
+    ASSERT_EQ(SoundDeviceStatus::Ok, pDevice->open(false, 0));
+
+    for (int i = 0; i < 200; ++i) {
+        pDevice->readProcess(kFramesPerBuffer);
+        m_pSoundManager->onDeviceOutputCallback(kFramesPerBuffer);
+        pDevice->writeProcess(kFramesPerBuffer);
+    }
+    pDevice->close();
+
+    // Nothing passes the impulses from the input to the output
+    EXPECT_EQ(0, pDevice->getStatistics().latencyProbes);
+}
+
+// Manual stress test that keeps all cores busy for a while. Run with
+// --gtest_also_run_disabled_tests. The device logs its statistics when
+// it is closed.
+TEST_F(SoundDeviceLoopbackTest, DISABLED_RunUnderLoad) {
+    const auto pDevice = loopbackDevice();
+    ASSERT_TRUE(pDevice);
+    routeAuxiliaryToMain(pDevice.data());
+    ASSERT_EQ(SoundDeviceStatus::Ok, pDevice->open(true, 0));
+
+    // Keep all cores busy while the engine is driven by the device
+    std::atomic<bool> stop(false);
+    std::vector<std::unique_ptr<QThread>> loadThreads;
+    for (int i = 0; i < QThread::idealThreadCount(); ++i) {
+        loadThreads.emplace_back(QThread::create([&stop] {
+            volatile double x = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                x = x + 1.0;
+            }
+        }));
+        loadThreads.back()->start();
+    }
+
+    QThread::msleep(500);
+    pDevice->close();
+
+    stop = true;
+    for (const auto& pThread : loadThreads) {
+        pThread->wait();
+    }
+
+    const auto stats = pDevice->getStatistics();
+    RecordProperty("callbacks", static_cast<int>(stats.callbacks));
+    RecordProperty("xruns", static_cast<int>(stats.xruns));
+    RecordProperty("maxLatencyMicros", static_cast<int>(stats.maxLatencyMicros));
+
+    EXPECT_LT(0u, stats.callbacks);
+    EXPECT_LE(stats.xruns, stats.callbacks);
+    EXPECT_LT(0, stats.latencyProbes);
+    EXPECT_LE(kLatencyBuffers * kFramesPerBuffer, stats.minLatencyFrames);
+}
+
+} // namespace
@@ -1,9 +1,17 @@
+#include <benchmark/benchmark.h>
+
 #include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QtDebug>
 
 #include "analyzer/analyzersilence.h"
 #include "sources/audiosourcestereoproxy.h"
+#ifdef __FFMPEG__
+#include "sources/soundsourceffmpeg.h"
+#endif
+#ifdef __MAD__
+#include "sources/soundsourcemp3.h"
+#endif
 #include "sources/soundsourceproxy.h"
 #include "test/mixxxtest.h"
 #include "test/soundsourceproviderregistration.h"
@@ -291,6 +299,39 @@ TEST_F(SoundSourceProxyTest, readNoTitle) {
     EXPECT_EQ("test22kMono", pTrack3->getTitle());
 }
 
+TEST_F(SoundSourceProxyTest, updateTrackFromPrefetchedMetadata) {
+    const QString filePath =
+            getTestDir().filePath(QStringLiteral("id3-test-data/cover-test-png.mp3"));
+
+    auto pTrack = Track::newTemporary(filePath);
+    EXPECT_EQ(
+            SoundSourceProxy::UpdateTrackFromSourceResult::MetadataImportedAndUpdated,
+            SoundSourceProxy(pTrack).updateTrackFromSource(
+                    SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                    SyncTrackMetadataParams{}));
+
+    const auto prefetchedMetadata = SoundSourceProxy::prefetchMetadataOfNewFile(
+            mixxx::FileAccess(mixxx::FileInfo(filePath)),
+            SyncTrackMetadataParams{}.resetMissingTagMetadataOnImport);
+    EXPECT_EQ(mixxx::MetadataSource::ImportResult::Succeeded,
+            prefetchedMetadata.importResult);
+    EXPECT_FALSE(prefetchedMetadata.coverImage.isNull());
+
+    auto pPrefetchedTrack = Track::newTemporary(filePath);
+    EXPECT_EQ(
+            SoundSourceProxy::UpdateTrackFromSourceResult::MetadataImportedAndUpdated,
+            SoundSourceProxy(pPrefetchedTrack)
+                    .updateTrackFromSource(
+                            SoundSourceProxy::UpdateTrackFromSourceMode::Once,
+                            SyncTrackMetadataParams{},
+                            &prefetchedMetadata));
+
+    EXPECT_EQ(pTrack->getMetadata(), pPrefetchedTrack->getMetadata());
+    EXPECT_EQ(pTrack->getCoverInfo(), pPrefetchedTrack->getCoverInfo());
+    EXPECT_EQ(pTrack->getSourceSynchronizedAt(),
+            pPrefetchedTrack->getSourceSynchronizedAt());
+}
+
 TEST_F(SoundSourceProxyTest, TOAL_TPE2) {
     auto pTrack = Track::newTemporary(
             getTestDir().filePath(QStringLiteral("id3-test-data/TOAL_TPE2.mp3")));
@@ -1125,3 +1166,179 @@ TEST_F(SoundSourceProxyTest, taglibStringToEnumFileType) {
         }
     }
 }
+
+#ifdef __MAD__
+namespace {
+
+std::shared_ptr<mixxx::SoundSourceMp3> openMp3File(
+        const QString& filePath,
+        const QString& seekIndexDirectoryPath) {
+    auto pSoundSource = std::make_shared<mixxx::SoundSourceMp3>(
+            QUrl::fromLocalFile(filePath),
+            seekIndexDirectoryPath);
+    if (pSoundSource->open(mixxx::AudioSource::OpenMode::Strict) !=
+            mixxx::AudioSource::OpenResult::Succeeded) {
+        return nullptr;
+    }
+    return pSoundSource;
+}
+
+} // anonymous namespace
+
+TEST_F(SoundSourceProxyTest, mp3SeekIndex) {
+    const QTemporaryDir seekIndexDir;
+    ASSERT_TRUE(seekIndexDir.isValid());
+    const QStringList fileNames = {
+            QStringLiteral("cover-test-png.mp3"),
+            QStringLiteral("cover-test-vbr.mp3"),
+    };
+    for (const auto& fileName : fileNames) {
+        const QString filePath = getTestDir().filePath(
+                QStringLiteral("id3-test-data/") + fileName);
+        const auto pScannedSource = openMp3File(filePath, QString());
+        ASSERT_TRUE(pScannedSource);
+        // Writes the seek index...
+        ASSERT_TRUE(openMp3File(filePath, seekIndexDir.path()));
+        // ...that is read when opening the file again
+        const auto pIndexedSource = openMp3File(filePath, seekIndexDir.path());
+        ASSERT_TRUE(pIndexedSource);
+
+        EXPECT_EQ(pScannedSource->getSignalInfo(), pIndexedSource->getSignalInfo());
+        EXPECT_EQ(pScannedSource->getBitrate(), pIndexedSource->getBitrate());
+        ASSERT_EQ(pScannedSource->frameIndexRange(), pIndexedSource->frameIndexRange());
+
+        // Decode the second half of the file after seeking
+        const auto readFrameIndexRange = mixxx::IndexRange::between(
+                pScannedSource->frameIndexMin() + pScannedSource->frameLength() / 2,
+                pScannedSource->frameIndexMax());
+        const SINT sampleCount =
+                pScannedSource->getSignalInfo().frames2samples(
+                        readFrameIndexRange.length());
+        mixxx::SampleBuffer scannedData(sampleCount);
+        mixxx::SampleBuffer indexedData(sampleCount);
+        const auto scannedFrames = pScannedSource->readSampleFrames(
+                mixxx::WritableSampleFrames(
+                        readFrameIndexRange,
+                        mixxx::SampleBuffer::WritableSlice(scannedData)));
+        const auto indexedFrames = pIndexedSource->readSampleFrames(
+                mixxx::WritableSampleFrames(
+                        readFrameIndexRange,
+                        mixxx::SampleBuffer::WritableSlice(indexedData)));
+        ASSERT_EQ(scannedFrames.frameIndexRange(), indexedFrames.frameIndexRange());
+        expectDecodedSamplesEqual(
+                pScannedSource->getSignalInfo().frames2samples(
+                        scannedFrames.frameLength()),
+                &scannedData[0],
+                &indexedData[0],
+                "Decoding mismatch with seek index");
+    }
+    EXPECT_EQ(fileNames.size(), QDir(seekIndexDir.path()).entryList(QDir::Files).size());
+}
+
+/// Opens an MP3 file like when loading a track into a deck.
+/// Arguments: reuse the seek index
+static void BM_OpenMp3File(benchmark::State& state) {
+    const bool indexed = state.range(0) != 0;
+    const QTemporaryDir seekIndexDir;
+    const QString seekIndexDirectoryPath = indexed ? seekIndexDir.path() : QString();
+    const QString filePath = MixxxTest::getOrInitTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-vbr.mp3"));
+    // Create the seek index in advance
+    openMp3File(filePath, seekIndexDirectoryPath);
+    for (auto _ : state) {
+        const auto pSoundSource = openMp3File(filePath, seekIndexDirectoryPath);
+        if (!pSoundSource) {
+            state.SkipWithError("failed to open file");
+            break;
+        }
+        benchmark::DoNotOptimize(pSoundSource->frameIndexRange());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OpenMp3File)->Arg(0)->Arg(1);
+#endif
+
+#ifdef __FFMPEG__
+namespace {
+
+class SoundSourceFFmpegProbe : public mixxx::SoundSourceFFmpeg {
+  public:
+    using mixxx::SoundSourceFFmpeg::SoundSourceFFmpeg;
+
+    /// Checks if reading could continue at the given position
+    /// without seeking after repositioning has finished.
+    bool canContinueDecodingFrom(SINT frameIndex) {
+        finishRepositioningDecoder();
+        return m_frameBuffer.canContinueReadingFrom(frameIndex);
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(SoundSourceProxyTest, ffmpegContinueAfterCachedBlock) {
+    // The size of a cached block
+    constexpr SINT kBlockFrameCount = 16384;
+    constexpr SINT kChunkFrameCount = 4096;
+    const QUrl url = QUrl::fromLocalFile(getTestDir().filePath(
+            QStringLiteral("id3-test-data/cover-test-ffmpeg-aac.m4a")));
+    SoundSourceFFmpegProbe source(url);
+    ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+            source.open(mixxx::AudioSource::OpenMode::Strict));
+    mixxx::SoundSourceFFmpeg refSource(url);
+    ASSERT_EQ(mixxx::AudioSource::OpenResult::Succeeded,
+            refSource.open(mixxx::AudioSource::OpenMode::Strict));
+
+    // Far enough from the start to require a seek
+    const SINT blockStart = source.frameIndexMin() + source.frameLength() / 2;
+    const SINT blockEnd = blockStart + kBlockFrameCount;
+    ASSERT_LE(blockEnd + kChunkFrameCount, source.frameIndexMax());
+    const SINT sampleCount =
+            source.getSignalInfo().frames2samples(kChunkFrameCount);
+    mixxx::SampleBuffer readData(sampleCount);
+    mixxx::SampleBuffer refData(sampleCount);
+    const auto readChunk = [&](mixxx::AudioSource* pSource,
+                                   mixxx::SampleBuffer* pData,
+                                   SINT start) {
+        return pSource->readSampleFrames(
+                                mixxx::WritableSampleFrames(
+                                        mixxx::IndexRange::forward(
+                                                start, kChunkFrameCount),
+                                        mixxx::SampleBuffer::WritableSlice(*pData)))
+                .frameIndexRange();
+    };
+
+    // Seek and play through a whole block that is cached
+    for (SINT start = blockStart; start < blockEnd; start += kChunkFrameCount) {
+        ASSERT_EQ(mixxx::IndexRange::forward(start, kChunkFrameCount),
+                readChunk(&source, &readData, start));
+    }
+    // Continue elsewhere
+    ASSERT_EQ(mixxx::IndexRange::forward(source.frameIndexMin(), kChunkFrameCount),
+            readChunk(&source, &readData, source.frameIndexMin()));
+    EXPECT_FALSE(source.canContinueDecodingFrom(blockEnd));
+
+    // Jump back and play through the cached block...
+    for (SINT start = blockStart; start < blockEnd; start += kChunkFrameCount) {
+        ASSERT_EQ(mixxx::IndexRange::forward(start, kChunkFrameCount),
+                readChunk(&source, &readData, start));
+        ASSERT_EQ(mixxx::IndexRange::forward(start, kChunkFrameCount),
+                readChunk(&refSource, &refData, start));
+        expectDecodedSamplesEqual(
+                sampleCount,
+                &refData[0],
+                &readData[0],
+                "Decoding mismatch in cached block");
+    }
+    // ...and continue after its end without seeking again
+    EXPECT_TRUE(source.canContinueDecodingFrom(blockEnd));
+    ASSERT_EQ(mixxx::IndexRange::forward(blockEnd, kChunkFrameCount),
+            readChunk(&source, &readData, blockEnd));
+    ASSERT_EQ(mixxx::IndexRange::forward(blockEnd, kChunkFrameCount),
+            readChunk(&refSource, &refData, blockEnd));
+    expectDecodedSamplesEqual(
+            sampleCount,
+            &refData[0],
+            &readData[0],
+            "Decoding mismatch after cached block");
+}
+#endif
@@ -1,6 +1,33 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
+
+#include <iterator>
+#include <vector>
+
 #include "util/db/dbconnection.h"
 
+namespace {
+
+// Both implementations must return the same result
+int likeCompareLatinLow(const QString& pattern, const QString& string, QChar esc) {
+    QString patternCopy = pattern;
+    QString stringCopy = string;
+    const int result = mixxx::DbConnection::likeCompareLatinLow(
+            &patternCopy, &stringCopy, esc);
+    const QByteArray patternUtf8 = pattern.toUtf8();
+    const QByteArray stringUtf8 = string.toUtf8();
+    EXPECT_EQ(result,
+            mixxx::DbConnection::likeCompareLatinLowUtf8(
+                    patternUtf8.constData(),
+                    static_cast<int>(patternUtf8.size()),
+                    stringUtf8.constData(),
+                    static_cast<int>(stringUtf8.size()),
+                    esc.unicode()))
+            << pattern.toStdString() << " LIKE " << string.toStdString();
+    return result;
+}
+
+} // namespace
 
 class SqliteLikeTest : public testing::Test {};
 
@@ -49,3 +76,106 @@ TEST_F(SqliteLikeTest, PatternTest) {
     esc = '\0';
     EXPECT_FALSE(mixxx::DbConnection::likeCompareLatinLow(&pattern, &string, esc));
 }
+
+TEST_F(SqliteLikeTest, PatternTestUtf8) {
+    const QChar noEsc('\0');
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("%väth%"), QString::fromUtf8("Sven Väth"), noEsc));
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("%vath%"), QString::fromUtf8("SVEN VÄTH"), noEsc));
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("%VÄTH%"), QString::fromUtf8("Sven Vath"), noEsc));
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("%v_th%"), QString::fromUtf8("Sven Väth"), noEsc));
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("%v%_%th%%"), QString::fromUtf8("Sven Väth"), noEsc));
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("%v!%th%"), QString::fromUtf8("Sven V%th"), '!'));
+    EXPECT_FALSE(likeCompareLatinLow(QString::fromUtf8("%v!%th%"), QString::fromUtf8("Sven Väth"), '!'));
+    EXPECT_FALSE(likeCompareLatinLow(QString::fromUtf8("%ä%"), QString::fromUtf8("Tiësto"), noEsc));
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("%ЗВЕР%"), QString::fromUtf8("Звери"), noEsc));
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("björk"), QString::fromUtf8("Björk"), noEsc));
+    EXPECT_FALSE(likeCompareLatinLow(QString::fromUtf8("björk"), QString::fromUtf8("Björk Remix"), noEsc));
+    EXPECT_TRUE(likeCompareLatinLow(QString(), QString(), noEsc));
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("%"), QString(), noEsc));
+}
+
+TEST_F(SqliteLikeTest, MatchOneRequiresCharacter) {
+    const QChar noEsc('\0');
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("_"), QString::fromUtf8("ä"), noEsc));
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("%_"), QString::fromUtf8("a"), noEsc));
+    EXPECT_TRUE(likeCompareLatinLow(QString::fromUtf8("v_th"), QString::fromUtf8("Väth"), noEsc));
+    EXPECT_FALSE(likeCompareLatinLow(QString::fromUtf8("_"), QString(), noEsc));
+    EXPECT_FALSE(likeCompareLatinLow(QString::fromUtf8("%_"), QString(), noEsc));
+    EXPECT_FALSE(likeCompareLatinLow(QString::fromUtf8("a__"), QString::fromUtf8("ab"), noEsc));
+}
+
+TEST_F(SqliteLikeTest, MalformedUtf8) {
+    // Invalid and truncated sequences are compared as U+FFFD
+    const QByteArray pattern("%\xE4%");
+    const QByteArray string("Sven V\xE4th");
+    EXPECT_TRUE(mixxx::DbConnection::likeCompareLatinLowUtf8(
+            pattern.constData(),
+            static_cast<int>(pattern.size()),
+            string.constData(),
+            static_cast<int>(string.size()),
+            0));
+    const QByteArray truncated("Sven V\xC3");
+    EXPECT_FALSE(mixxx::DbConnection::likeCompareLatinLowUtf8(
+            "%v\xC3\xA4%", 5, truncated.constData(), static_cast<int>(truncated.size()), 0));
+}
+
+namespace {
+
+// Typical values of a text column that is searched with '%term%'
+std::vector<QByteArray> benchmarkColumnValues() {
+    const char* const names[] = {
+            "Sven Väth",
+            "Tiësto",
+            "Daft Punk",
+            "Aphex Twin",
+            "Boards of Canada",
+            "Röyksopp",
+            "The Chemical Brothers",
+            "Майя Плисецкая",
+    };
+    std::vector<QByteArray> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(QByteArray(names[i % std::size(names)]) +
+                " - Track " + QByteArray::number(i) + " (Extended Mix)");
+    }
+    return values;
+}
+
+} // namespace
+
+static void BM_SqliteLikeQString(benchmark::State& state) {
+    const std::vector<QByteArray> values = benchmarkColumnValues();
+    const QByteArray pattern("%chemical%");
+    for (auto _ : state) {
+        int matches = 0;
+        for (const auto& value : values) {
+            // What the LIKE function did before for every row
+            QString patternString = QString::fromUtf8(pattern);
+            QString valueString = QString::fromUtf8(value);
+            matches += mixxx::DbConnection::likeCompareLatinLow(
+                    &patternString, &valueString, QChar('\0'));
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_SqliteLikeQString);
+
+static void BM_SqliteLikeUtf8(benchmark::State& state) {
+    const std::vector<QByteArray> values = benchmarkColumnValues();
+    const QByteArray pattern("%chemical%");
+    for (auto _ : state) {
+        int matches = 0;
+        for (const auto& value : values) {
+            matches += mixxx::DbConnection::likeCompareLatinLowUtf8(
+                    pattern.constData(),
+                    static_cast<int>(pattern.size()),
+                    value.constData(),
+                    static_cast<int>(value.size()),
+                    0);
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_SqliteLikeUtf8);
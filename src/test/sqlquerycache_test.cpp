@@ -0,0 +1,227 @@
+#include "util/db/sqlquerycache.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <memory>
+#include <random>
+
+#include "test/mixxxdbtest.h"
+#include "util/db/dbconnectionpool.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/db/dbconnectionpooler.h"
+#include "util/db/sqltransaction.h"
+
+namespace {
+
+const QString kSelectTrackLocation = QStringLiteral(
+        "SELECT track_locations.location FROM track_locations "
+        "INNER JOIN library ON library.location = track_locations.id "
+        "WHERE library.id=:id");
+
+class SqlQueryCacheTest : public MixxxDbTest {
+  protected:
+    SqlQueryCacheTest() {
+        MixxxDb::initDatabaseSchema(dbConnection());
+    }
+
+    QString queryTrackLocation(int trackId) {
+        mixxx::CachedSqlQuery query(dbConnection(), kSelectTrackLocation);
+        query->bindValue(QStringLiteral(":id"), trackId);
+        EXPECT_TRUE(query->execPrepared());
+        if (!query->next()) {
+            return QString();
+        }
+        return query->fieldValue(query->fieldIndex(QStringLiteral("location"))).toString();
+    }
+};
+
+// The database is only opened after write-ahead logging has been
+// enabled in the config
+class SqlQueryCacheWriteAheadLogTest : public MixxxTest {
+  protected:
+    SqlQueryCacheWriteAheadLogTest() {
+        config()->setValue(ConfigKey(QStringLiteral("[Library]"),
+                                   QStringLiteral("SqliteWriteAheadLog")),
+                true);
+        m_pMixxxDb = std::make_unique<MixxxDb>(config());
+        m_pDbConnectionPooler = std::make_unique<mixxx::DbConnectionPooler>(
+                m_pMixxxDb->connectionPool());
+    }
+
+    ~SqlQueryCacheWriteAheadLogTest() override {
+        m_pDbConnectionPooler.reset();
+        m_pMixxxDb.reset();
+    }
+
+    QSqlDatabase dbConnection() const {
+        return mixxx::DbConnectionPooled(m_pMixxxDb->connectionPool());
+    }
+
+  private:
+    std::unique_ptr<MixxxDb> m_pMixxxDb;
+    std::unique_ptr<mixxx::DbConnectionPooler> m_pDbConnectionPooler;
+};
+
+QString journalMode(const QSqlDatabase& database) {
+    QSqlQuery query(database);
+    EXPECT_TRUE(query.exec(QStringLiteral("PRAGMA journal_mode")));
+    EXPECT_TRUE(query.next());
+    return query.value(0).toString();
+}
+
+TEST_F(SqlQueryCacheTest, WriteAheadLogDisabledByDefault) {
+    EXPECT_QSTRING_EQ(QStringLiteral("delete"), journalMode(dbConnection()));
+}
+
+TEST_F(SqlQueryCacheWriteAheadLogTest, WriteAheadLogEnabled) {
+    EXPECT_QSTRING_EQ(QStringLiteral("wal"), journalMode(dbConnection()));
+}
+
+TEST_F(SqlQueryCacheTest, ReuseQueryWithNewBindings) {
+    QSqlQuery insert(dbConnection());
+    ASSERT_TRUE(insert.exec(QStringLiteral(
+            "INSERT INTO track_locations (id, location, filename, directory) "
+            "VALUES (1, '/music/a.mp3', 'a.mp3', '/music'), "
+            "(2, '/music/b.mp3', 'b.mp3', '/music')")));
+    ASSERT_TRUE(insert.exec(QStringLiteral(
+            "INSERT INTO library (id, location) VALUES (10, 1), (20, 2)")));
+
+    auto* pCache = mixxx::SqlQueryCache::forDatabase(dbConnection());
+    ASSERT_NE(nullptr, pCache);
+    pCache->clear();
+
+    EXPECT_QSTRING_EQ(QStringLiteral("/music/a.mp3"), queryTrackLocation(10));
+    EXPECT_EQ(1, pCache->size());
+    EXPECT_QSTRING_EQ(QStringLiteral("/music/b.mp3"), queryTrackLocation(20));
+    EXPECT_EQ(1, pCache->size());
+    EXPECT_TRUE(queryTrackLocation(30).isEmpty());
+
+    // A nested borrower of the same statement gets its own query
+    const FwdSqlQuery* pOuterQuery;
+    {
+        mixxx::CachedSqlQuery outer(dbConnection(), kSelectTrackLocation);
+        pOuterQuery = &*outer;
+        EXPECT_EQ(0, pCache->size());
+        EXPECT_QSTRING_EQ(QStringLiteral("/music/a.mp3"), queryTrackLocation(10));
+    }
+    EXPECT_EQ(1, pCache->size());
+    mixxx::CachedSqlQuery query(dbConnection(), kSelectTrackLocation);
+    EXPECT_EQ(pOuterQuery, &*query);
+}
+
+TEST_F(SqlQueryCacheTest, FailedQueriesAreNotCached) {
+    auto* pCache = mixxx::SqlQueryCache::forDatabase(dbConnection());
+    ASSERT_NE(nullptr, pCache);
+    pCache->clear();
+    {
+        mixxx::CachedSqlQuery query(
+                dbConnection(), QStringLiteral("SELECT * FROM no_such_table"));
+        EXPECT_FALSE(query->isPrepared());
+    }
+    EXPECT_EQ(0, pCache->size());
+}
+
+// A synthetic library that is shared by all benchmarks, because
+// populating it takes considerably longer than a benchmark run.
+constexpr int kBenchmarkTrackCount = 200000;
+
+const QString& benchmarkDbFilePath() {
+    static QTemporaryDir s_dir;
+    static const QString s_filePath = [] {
+        const QString filePath = s_dir.filePath(QStringLiteral("benchmark.sqlite"));
+        mixxx::DbConnection::Params params;
+        params.type = QStringLiteral("QSQLITE");
+        params.filePath = filePath;
+        auto pPool = mixxx::DbConnectionPool::create(params, "BENCHMARK_SETUP");
+        const mixxx::DbConnectionPooler pooler(pPool);
+        const QSqlDatabase database = mixxx::DbConnectionPooled(pooler);
+        QSqlQuery query(database);
+        query.exec(QStringLiteral(
+                "CREATE TABLE track_locations ("
+                "id INTEGER PRIMARY KEY, location TEXT UNIQUE)"));
+        query.exec(QStringLiteral(
+                "CREATE TABLE library ("
+                "id INTEGER PRIMARY KEY, location INTEGER REFERENCES track_locations(id), "
+                "artist TEXT, title TEXT, album TEXT, genre TEXT, bpm REAL, duration REAL)"));
+        SqlTransaction transaction(database);
+        QSqlQuery insertLocation(database);
+        insertLocation.prepare(QStringLiteral(
+                "INSERT INTO track_locations (id, location) VALUES (:id, :location)"));
+        QSqlQuery insertTrack(database);
+        insertTrack.prepare(QStringLiteral(
+                "INSERT INTO library (id, location, artist, title, album, genre, bpm, duration) "
+                "VALUES (:id, :id, :artist, :title, :album, :genre, :bpm, :duration)"));
+        for (int id = 1; id <= kBenchmarkTrackCount; ++id) {
+            insertLocation.bindValue(QStringLiteral(":id"), id);
+            insertLocation.bindValue(QStringLiteral(":location"),
+                    QStringLiteral("/music/artist %1/album %2/track %3.mp3")
+                            .arg(id % 5000)
+                            .arg(id % 20000)
+                            .arg(id));
+            insertLocation.exec();
+            insertTrack.bindValue(QStringLiteral(":id"), id);
+            insertTrack.bindValue(QStringLiteral(":artist"),
+                    QStringLiteral("Artist %1").arg(id % 5000));
+            insertTrack.bindValue(QStringLiteral(":title"),
+                    QStringLiteral("Title %1").arg(id));
+            insertTrack.bindValue(QStringLiteral(":album"),
+                    QStringLiteral("Album %1").arg(id % 20000));
+            insertTrack.bindValue(QStringLiteral(":genre"),
+                    QStringLiteral("Genre %1").arg(id % 50));
+            insertTrack.bindValue(QStringLiteral(":bpm"), 80.0 + id % 100);
+            insertTrack.bindValue(QStringLiteral(":duration"), 120.0 + id % 300);
+            insertTrack.exec();
+        }
+        transaction.commit();
+        return filePath;
+    }();
+    return s_filePath;
+}
+
+/// Looks up the location and metadata of random tracks.
+/// Arguments: use CachedSqlQuery, apply the SQLite tuning options
+static void BM_SelectTrackById(benchmark::State& state) {
+    const bool cached = state.range(0) != 0;
+    const bool tuned = state.range(1) != 0;
+
+    mixxx::DbConnection::Params params;
+    params.type = QStringLiteral("QSQLITE");
+    params.filePath = benchmarkDbFilePath();
+    if (tuned) {
+        params.writeAheadLog = true;
+        params.pageCacheSizeKiB = 16 * 1024;
+        params.mmapSizeBytes = 256 * 1024 * 1024;
+    }
+    if (cached) {
+        params.preparedQueryCacheCapacity = 32;
+    }
+    auto pPool = mixxx::DbConnectionPool::create(params, "BENCHMARK");
+    const mixxx::DbConnectionPooler pooler(pPool);
+    const QSqlDatabase database = mixxx::DbConnectionPooled(pooler);
+
+    const QString statement = QStringLiteral(
+            "SELECT track_locations.location, artist, title, album, genre, bpm, duration "
+            "FROM library "
+            "INNER JOIN track_locations ON library.location = track_locations.id "
+            "WHERE library.id=:id");
+    std::minstd_rand randomIds(0x5eed);
+    std::uniform_int_distribution<int> distribution(1, kBenchmarkTrackCount);
+    for (auto _ : state) {
+        // Without a cache CachedSqlQuery prepares the statement every
+        // time just like an ordinary FwdSqlQuery
+        mixxx::CachedSqlQuery query(database, statement);
+        query->bindValue(QStringLiteral(":id"), distribution(randomIds));
+        if (!query->execPrepared() || !query->next()) {
+            state.SkipWithError("query failed");
+            break;
+        }
+        benchmark::DoNotOptimize(query->record());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SelectTrackById)->ArgsProduct({{0, 1}, {0, 1}});
+
+} // namespace
@@ -1,3 +1,4 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
 #include <QtDebug>
@@ -152,4 +153,108 @@ TEST_F(StemTest, OpenStem) {
             sourceStem.getSignalInfo());
 }
 
+QUrl stemFileUrl() {
+    return QUrl::fromLocalFile(
+            MixxxTest::getOrInitTestDir().filePath("stems/test.stem.mp4"));
+}
+
+mixxx::AudioSource::OpenParams stereoOpenParams() {
+    mixxx::AudioSource::OpenParams config;
+    config.setChannelCount(mixxx::audio::ChannelCount::stereo());
+    return config;
+}
+
+/// Opens all stems one after another on the calling thread, the way
+/// SoundSourceSTEM did before using its own thread pool.
+std::vector<std::unique_ptr<SoundSourceSingleSTEM>> openStemsSequentially() {
+    std::vector<std::unique_ptr<SoundSourceSingleSTEM>> stems;
+    for (int stemIdx = 0; stemIdx < kStemFiles.size(); ++stemIdx) {
+        auto pStem = std::make_unique<SoundSourceSingleSTEM>(stemFileUrl(), stemIdx);
+        if (pStem->open(AudioSource::OpenMode::Strict, stereoOpenParams()) !=
+                AudioSource::OpenResult::Succeeded) {
+            return {};
+        }
+        stems.push_back(std::move(pStem));
+    }
+    return stems;
+}
+
+/// Compares the latency of opening and reading the stems one after
+/// another with SoundSourceSTEM, which handles the stems concurrently.
+static void BM_StemOpenSequential(benchmark::State& state) {
+    for (auto _ : state) {
+        const auto stems = openStemsSequentially();
+        if (stems.empty()) {
+            state.SkipWithError("failed to open stems");
+            return;
+        }
+    }
+}
+BENCHMARK(BM_StemOpenSequential)->Unit(benchmark::kMillisecond);
+
+static void BM_StemOpenConcurrent(benchmark::State& state) {
+    mixxx::AudioSource::OpenParams config;
+    config.setChannelCount(mixxx::audio::ChannelCount::stem());
+    for (auto _ : state) {
+        SoundSourceSTEM sourceStem(stemFileUrl());
+        if (sourceStem.open(AudioSource::OpenMode::Strict, config) !=
+                AudioSource::OpenResult::Succeeded) {
+            state.SkipWithError("failed to open stems");
+            return;
+        }
+    }
+}
+BENCHMARK(BM_StemOpenConcurrent)->Unit(benchmark::kMillisecond);
+
+static void BM_StemReadSequential(benchmark::State& state) {
+    const auto stems = openStemsSequentially();
+    if (stems.empty()) {
+        state.SkipWithError("failed to open stems");
+        return;
+    }
+    const SINT chunkFrames = state.range(0);
+    const auto frameIndexRange = stems.front()->frameIndexRange();
+    SampleBuffer buffer(stems.front()->getSignalInfo().frames2samples(chunkFrames));
+    SINT frameIndex = frameIndexRange.start();
+    for (auto _ : state) {
+        if (frameIndex + chunkFrames > frameIndexRange.end()) {
+            frameIndex = frameIndexRange.start();
+        }
+        const auto chunk = IndexRange::forward(frameIndex, chunkFrames);
+        for (const auto& pStem : stems) {
+            pStem->readSampleFrames(WritableSampleFrames(
+                    chunk, SampleBuffer::WritableSlice(buffer)));
+        }
+        frameIndex += chunkFrames;
+    }
+    state.SetItemsProcessed(state.iterations() * chunkFrames);
+}
+BENCHMARK(BM_StemReadSequential)->Arg(1024)->Arg(8192);
+
+static void BM_StemReadConcurrent(benchmark::State& state) {
+    mixxx::AudioSource::OpenParams config;
+    config.setChannelCount(mixxx::audio::ChannelCount::stem());
+    SoundSourceSTEM sourceStem(stemFileUrl());
+    if (sourceStem.open(AudioSource::OpenMode::Strict, config) !=
+            AudioSource::OpenResult::Succeeded) {
+        state.SkipWithError("failed to open stems");
+        return;
+    }
+    const SINT chunkFrames = state.range(0);
+    const auto frameIndexRange = sourceStem.frameIndexRange();
+    SampleBuffer buffer(sourceStem.getSignalInfo().frames2samples(chunkFrames));
+    SINT frameIndex = frameIndexRange.start();
+    for (auto _ : state) {
+        if (frameIndex + chunkFrames > frameIndexRange.end()) {
+            frameIndex = frameIndexRange.start();
+        }
+        sourceStem.readSampleFrames(WritableSampleFrames(
+                IndexRange::forward(frameIndex, chunkFrames),
+                SampleBuffer::WritableSlice(buffer)));
+        frameIndex += chunkFrames;
+    }
+    state.SetItemsProcessed(state.iterations() * chunkFrames);
+}
+BENCHMARK(BM_StemReadConcurrent)->Arg(1024)->Arg(8192);
+
 } // namespace
@@ -0,0 +1,79 @@
+#include "engine/cachingreader/trackpreloader.h"
+
+#include <gtest/gtest.h>
+
+#include "engine/cachingreader/cachingreaderchunk.h"
+#include "test/mixxxtest.h"
+#include "test/soundsourceproviderregistration.h"
+#include "track/track.h"
+
+namespace {
+
+class TrackPreloaderTest : public MixxxTest, SoundSourceProviderRegistration {
+  protected:
+    TrackPreloaderTest()
+            : m_pool(64 * 1024 * 1024, 2) {
+    }
+
+    TrackPointer newTrack(const QString& fileName) const {
+        return Track::newTemporary(getTestDir().filePath(
+                QStringLiteral("id3-test-data/") + fileName));
+    }
+
+    PreloadedTrackPool m_pool;
+};
+
+TEST_F(TrackPreloaderTest, HandOverAudioSource) {
+    const auto pTrack = newTrack(QStringLiteral("cover-test.flac"));
+    const auto key = PreloadedTrackPool::key(
+            pTrack->getFileInfo(),
+            mixxx::audio::ChannelCount::stereo());
+    {
+        TrackPreloader preloader(&m_pool);
+        preloader.preloadTrack(pTrack, mixxx::audio::ChannelCount::stereo());
+        preloader.waitForDone();
+
+        const auto pPreloadedTrack = m_pool.find(key);
+        ASSERT_TRUE(pPreloadedTrack);
+        EXPECT_TRUE(pPreloadedTrack->chunks.contains(
+                CachingReaderChunk::indexForFrame(
+                        pPreloadedTrack->frameIndexRange.start())));
+
+        const auto pAudioSource = m_pool.takeAudioSource(key);
+        ASSERT_TRUE(pAudioSource);
+        EXPECT_EQ(pPreloadedTrack->signalInfo, pAudioSource->getSignalInfo());
+        EXPECT_EQ(pPreloadedTrack->frameIndexRange, pAudioSource->frameIndexRange());
+        // Each audio source is only handed over once
+        EXPECT_FALSE(m_pool.takeAudioSource(key));
+
+        // Tracks that are preloaded for a different number of channels
+        // are not shared
+        preloader.preloadTrack(pTrack, mixxx::audio::ChannelCount::stem());
+        preloader.waitForDone();
+        EXPECT_FALSE(m_pool.takeAudioSource(key));
+        EXPECT_EQ(1, m_pool.audioSourceCount());
+    }
+    // Closed when the preloader is destroyed
+    EXPECT_EQ(0, m_pool.audioSourceCount());
+    // ...but the preloaded chunks are kept
+    EXPECT_TRUE(m_pool.find(key));
+}
+
+TEST_F(TrackPreloaderTest, CloseFirstAudioSources) {
+    TrackPreloader preloader(&m_pool);
+    const auto pTrack1 = newTrack(QStringLiteral("cover-test.flac"));
+    const auto pTrack2 = newTrack(QStringLiteral("cover-test.ogg"));
+    const auto pTrack3 = newTrack(QStringLiteral("cover-test.wav"));
+    preloader.preloadTrack(pTrack1, mixxx::audio::ChannelCount::stereo());
+    preloader.preloadTrack(pTrack2, mixxx::audio::ChannelCount::stereo());
+    preloader.preloadTrack(pTrack3, mixxx::audio::ChannelCount::stereo());
+    preloader.waitForDone();
+
+    EXPECT_EQ(2, m_pool.audioSourceCount());
+    EXPECT_FALSE(m_pool.containsAudioSource(PreloadedTrackPool::key(
+            pTrack1->getFileInfo(), mixxx::audio::ChannelCount::stereo())));
+    EXPECT_TRUE(m_pool.containsAudioSource(PreloadedTrackPool::key(
+            pTrack3->getFileInfo(), mixxx::audio::ChannelCount::stereo())));
+}
+
+} // namespace
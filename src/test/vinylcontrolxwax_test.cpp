@@ -0,0 +1,173 @@
+#ifdef __VINYLCONTROL__
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "util/math.h"
+
+extern "C" {
+#include "timecoder.h"
+}
+
+namespace {
+
+constexpr unsigned int kSampleRate = 96000;
+constexpr int kTimecodeHz = 1000; // serato_2a resolution
+constexpr double kAmplitude = 0.5 * 32767;
+
+/// Same as fwd() of the timecoder: Returns the next state of the
+/// LFSR, the new bit is added at the MSB.
+unsigned int nextTimecode(unsigned int current, const timecode_def& def) {
+    unsigned int taken = current & (def.taps | 0x1);
+    unsigned int bit = 0;
+    while (taken != 0) {
+        bit ^= taken & 0x1;
+        taken >>= 1;
+    }
+    return (current >> 1) | (bit << (def.bits - 1));
+}
+
+/// Generates a stereo signal that looks like a Serato timecode playing at
+/// the given speed: two tones in quadrature whose peak amplitude carries
+/// the bits of the timecode LFSR, one bit per wave cycle, starting at
+/// timecode zero.
+std::vector<short> generateTimecode(
+        const timecode_def& def, std::size_t frames, double speed) {
+    std::vector<short> pcm(frames * TIMECODER_CHANNELS);
+    unsigned int timecode = def.seed;
+    const auto nextAmplitude = [&def, &timecode] {
+        timecode = nextTimecode(timecode, def);
+        const bool bit = (timecode >> (def.bits - 1)) & 0x1;
+        return bit ? kAmplitude : 0.75 * kAmplitude;
+    };
+    const double increment = 2 * M_PI * kTimecodeHz * std::fabs(speed) / kSampleRate;
+    double phase = 0.0;
+    double amplitude = nextAmplitude();
+    for (std::size_t i = 0; i < frames; ++i) {
+        const double direction = speed < 0 ? -1.0 : 1.0;
+        pcm[i * 2] = static_cast<short>(amplitude * std::sin(direction * phase));
+        pcm[i * 2 + 1] = static_cast<short>(amplitude * std::cos(direction * phase));
+        phase += increment;
+        if (phase >= 2 * M_PI) {
+            phase -= 2 * M_PI;
+            amplitude = nextAmplitude();
+        }
+    }
+    return pcm;
+}
+
+class VinylControlXwaxTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        m_pDef = timecoder_find_definition("serato_2a");
+        ASSERT_NE(nullptr, m_pDef);
+        timecoder_init(&m_timecoder, m_pDef, 1.0, kSampleRate, false);
+    }
+
+    void TearDown() override {
+        if (m_timecoder.mon) {
+            timecoder_monitor_clear(&m_timecoder);
+        }
+        timecoder_clear(&m_timecoder);
+    }
+
+    /// Starts decoding from scratch, without the monitor.
+    void reset() {
+        if (m_timecoder.mon) {
+            timecoder_monitor_clear(&m_timecoder);
+        }
+        timecoder_clear(&m_timecoder);
+        timecoder_init(&m_timecoder, m_pDef, 1.0, kSampleRate, false);
+    }
+
+    /// Decodes one second of timecode and returns the pitch. The
+    /// position decoded after each block is appended to pPositions.
+    double decodePitch(double speed, std::vector<int>* pPositions = nullptr) {
+        std::vector<short> pcm = generateTimecode(*m_pDef, kSampleRate, speed);
+        // Submit in small blocks as the VinylControlProcessor does
+        constexpr std::size_t kBlockFrames = 64;
+        for (std::size_t frame = 0; frame < kSampleRate; frame += kBlockFrames) {
+            timecoder_submit(&m_timecoder, &pcm[frame * TIMECODER_CHANNELS], kBlockFrames);
+            if (pPositions) {
+                pPositions->push_back(timecoder_get_position(&m_timecoder, nullptr));
+            }
+        }
+        return timecoder_get_pitch(&m_timecoder);
+    }
+
+    timecode_def* m_pDef;
+    timecoder m_timecoder;
+};
+
+TEST_F(VinylControlXwaxTest, PitchAtReferenceSpeed) {
+    const double pitch = decodePitch(1.0);
+    EXPECT_NEAR(1.0, std::fabs(pitch), 0.02);
+}
+
+TEST_F(VinylControlXwaxTest, PitchReverse) {
+    const double forward = decodePitch(1.0);
+    reset();
+    const double reverse = decodePitch(-1.0);
+    EXPECT_NEAR(forward, -reverse, 0.02);
+}
+
+TEST_F(VinylControlXwaxTest, MonitorDoesNotChangeDecoding) {
+    std::vector<int> positions;
+    const double pitch = decodePitch(0.9, &positions);
+    // The signal is long enough to lock onto the timecode
+    ASSERT_FALSE(positions.empty());
+    ASSERT_NE(-1, positions.back());
+
+    reset();
+    ASSERT_EQ(0, timecoder_monitor_init(&m_timecoder, 100));
+    std::vector<int> monitoredPositions;
+    const double monitoredPitch = decodePitch(0.9, &monitoredPositions);
+    EXPECT_DOUBLE_EQ(pitch, monitoredPitch);
+    EXPECT_EQ(positions, monitoredPositions);
+
+    bool anyPixel = false;
+    for (int i = 0; i < 100 * 100; ++i) {
+        anyPixel |= m_timecoder.mon[i] != 0;
+    }
+    EXPECT_TRUE(anyPixel);
+}
+
+static void BM_TimecoderSubmit(benchmark::State& state) {
+    timecode_def* pDef = timecoder_find_definition("serato_2a");
+    if (!pDef) {
+        state.SkipWithError("timecode definition not found");
+        return;
+    }
+    timecoder tc;
+    timecoder_init(&tc, pDef, 1.0, kSampleRate, false);
+    const bool withMonitor = state.range(1) != 0;
+    if (withMonitor) {
+        timecoder_monitor_init(&tc, 100);
+    }
+
+    const auto frames = static_cast<std::size_t>(state.range(0));
+    std::vector<short> pcm = generateTimecode(*pDef, kSampleRate, 1.0);
+    std::size_t offset = 0;
+    for (auto _ : state) {
+        if (offset + frames > kSampleRate) {
+            offset = 0;
+        }
+        timecoder_submit(&tc, &pcm[offset * TIMECODER_CHANNELS], frames);
+        offset += frames;
+    }
+    state.SetItemsProcessed(state.iterations() * frames);
+
+    if (withMonitor) {
+        timecoder_monitor_clear(&tc);
+    }
+    timecoder_clear(&tc);
+}
+BENCHMARK(BM_TimecoderSubmit)
+        ->ArgsProduct({benchmark::CreateRange(64, 4096, 4), {0, 1}});
+
+} // namespace
+
+#endif // __VINYLCONTROL__
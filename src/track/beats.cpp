@@ -1,5 +1,6 @@
 #include "track/beats.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iterator>
 #include <unordered_map>
@@ -77,9 +78,11 @@ Beats::ConstIterator Beats::ConstIterator::operator+=(Beats::ConstIterator::diff
     }
 
     m_beatOffset += n;
-    while (m_it != m_beats->m_markers.cend() && m_beatOffset >= m_it->beatsTillNextMarker()) {
-        m_beatOffset -= m_it->beatsTillNextMarker();
-        m_it++;
+    if (m_it != m_beats->m_markers.cend() && m_beatOffset >= m_it->beatsTillNextMarker()) {
+        const qint64 beatIndex =
+                static_cast<qint64>(m_beats->markerBeatIndex(m_it)) + m_beatOffset;
+        m_it = m_beats->findMarkerByBeatIndex(beatIndex);
+        m_beatOffset = static_cast<int>(beatIndex - m_beats->markerBeatIndex(m_it));
     }
     updateValue();
     DEBUG_ASSERT(m_value > origValue);
@@ -125,9 +128,13 @@ Beats::ConstIterator Beats::ConstIterator::operator-=(Beats::ConstIterator::diff
     }
 
     m_beatOffset -= n;
-    while (m_it != m_beats->m_markers.cbegin() && m_beatOffset < 0) {
-        m_it--;
-        m_beatOffset += m_it->beatsTillNextMarker();
+    if (m_it != m_beats->m_markers.cbegin() && m_beatOffset < 0) {
+        const qint64 beatIndex =
+                static_cast<qint64>(m_beats->markerBeatIndex(m_it)) + m_beatOffset;
+        m_it = (beatIndex < 0)
+                ? m_beats->m_markers.cbegin()
+                : m_beats->findMarkerByBeatIndex(beatIndex);
+        m_beatOffset = static_cast<int>(beatIndex - m_beats->markerBeatIndex(m_it));
     }
     updateValue();
     DEBUG_ASSERT(m_value < origValue);
@@ -136,23 +143,11 @@ Beats::ConstIterator Beats::ConstIterator::operator-=(Beats::ConstIterator::diff
 
 Beats::ConstIterator::difference_type Beats::ConstIterator::operator-(
         const Beats::ConstIterator& other) const {
-    const int vectorItDiff = m_it - other.m_it;
-    if (vectorItDiff == 0) {
+    if (m_it == other.m_it) {
         return m_beatOffset - other.m_beatOffset;
     }
-
-    if (vectorItDiff > 0) {
-        return -(other - *this);
-    }
-
-    auto it = m_it;
-    int result = -m_beatOffset + other.m_beatOffset;
-    while (it != m_beats->m_markers.cend() && it != other.m_it) {
-        result += it->beatsTillNextMarker();
-        it++;
-    }
-    DEBUG_ASSERT(it == other.m_it);
-    return -result;
+    return (m_beats->markerBeatIndex(m_it) - m_beats->markerBeatIndex(other.m_it)) +
+            (m_beatOffset - other.m_beatOffset);
 }
 
 void Beats::ConstIterator::updateValue() {
@@ -464,8 +459,23 @@ Beats::ConstIterator Beats::iteratorFrom(audio::FramePos position) const {
         }
         it -= static_cast<int>(n);
         it = previousIfNeeded(it, position);
+    } else if (position == m_lastMarkerPosition) {
+        it = clastmarker();
     } else {
-        it = std::lower_bound(cfirstmarker(), clastmarker() + 1, position);
+        // Lookup position is inside the section of a marker, in which all
+        // beats have the same length.
+        const auto markerIt = findMarkerByPosition(position);
+        DEBUG_ASSERT(markerIt != m_markers.cend());
+        it = ConstIterator(this, markerIt, 0);
+        const double n = std::ceil((position - markerIt->position()) / it.beatLengthFrames());
+        DEBUG_ASSERT(n >= 0 && n <= markerIt->beatsTillNextMarker());
+        it += static_cast<int>(n);
+        // Compensate floating point errors in both directions
+        if (*it < position) {
+            it++;
+        } else if (it != cfirstmarker()) {
+            it = previousIfNeeded(it, position);
+        }
     }
     DEBUG_ASSERT(it == cbegin() || it == cend() || *it >= position);
     DEBUG_ASSERT(it == cbegin() || it == cend() || *it > *std::prev(it));
@@ -703,6 +713,43 @@ bool Beats::isValid() const {
     return true;
 }
 
+void Beats::initMarkerBeatIndices() {
+    m_markerBeatIndices.clear();
+    m_markerBeatIndices.reserve(m_markers.size() + 1);
+    int beatIndex = 0;
+    for (const BeatMarker& marker : m_markers) {
+        m_markerBeatIndices.push_back(beatIndex);
+        beatIndex += marker.beatsTillNextMarker();
+    }
+    m_markerBeatIndices.push_back(beatIndex);
+}
+
+std::vector<BeatMarker>::const_iterator Beats::findMarkerByBeatIndex(qint64 beatIndex) const {
+    DEBUG_ASSERT(beatIndex >= 0);
+    // The first marker with a greater beat index is the next marker
+    const auto nextIndexIt = std::upper_bound(
+            m_markerBeatIndices.cbegin(), m_markerBeatIndices.cend(), beatIndex);
+    DEBUG_ASSERT(nextIndexIt != m_markerBeatIndices.cbegin());
+    return m_markers.cbegin() + (std::prev(nextIndexIt) - m_markerBeatIndices.cbegin());
+}
+
+std::vector<BeatMarker>::const_iterator Beats::findMarkerByPosition(
+        audio::FramePos position) const {
+    DEBUG_ASSERT(m_markers.empty() || position >= m_markers.front().position());
+    if (position >= m_lastMarkerPosition) {
+        return m_markers.cend();
+    }
+    // The first marker after the position is the next marker
+    const auto nextMarkerIt = std::upper_bound(m_markers.cbegin(),
+            m_markers.cend(),
+            position,
+            [](audio::FramePos lhs, const BeatMarker& rhs) {
+                return lhs < rhs.position();
+            });
+    DEBUG_ASSERT(nextMarkerIt != m_markers.cbegin());
+    return std::prev(nextMarkerIt);
+}
+
 mixxx::audio::FrameDiff_t Beats::firstBeatLengthFrames() const {
     const auto it = cfirstmarker();
     return it.beatLengthFrames();
@@ -167,6 +167,7 @@ class Beats : private std::enable_shared_from_this<Beats> {
         DEBUG_ASSERT(!m_lastMarkerPosition.isFractional());
         DEBUG_ASSERT(m_lastMarkerBpm.isValid());
         DEBUG_ASSERT(m_sampleRate.isValid());
+        initMarkerBeatIndices();
     }
 
     Beats(mixxx::audio::FramePos lastMarkerPosition,
@@ -429,7 +430,32 @@ class Beats : private std::enable_shared_from_this<Beats> {
     mixxx::audio::FrameDiff_t firstBeatLengthFrames() const;
     mixxx::audio::FrameDiff_t lastBeatLengthFrames() const;
 
+    void initMarkerBeatIndices();
+
+    /// Returns the index of the first beat of a marker, counted from the
+    /// first marker. The end of the markers refers to the last marker.
+    int markerBeatIndex(std::vector<BeatMarker>::const_iterator markerIt) const {
+        return m_markerBeatIndices[markerIt - m_markers.cbegin()];
+    }
+
+    /// Returns the marker that contains the beat with the given index
+    /// or the end of the markers if the beat is after the last marker.
+    /// The index must not be negative.
+    std::vector<BeatMarker>::const_iterator findMarkerByBeatIndex(qint64 beatIndex) const;
+
+    /// Returns the marker that contains the position or the end of the
+    /// markers if the position is after the last marker. The position
+    /// must not be before the first marker.
+    std::vector<BeatMarker>::const_iterator findMarkerByPosition(
+            audio::FramePos position) const;
+
     std::vector<BeatMarker> m_markers;
+    // The beat index of each marker and the last marker, i.e. the table
+    // contains one more element than m_markers. This allows to look up
+    // the marker of a beat or a position by binary search instead of
+    // iterating over all preceding markers. Beats are immutable and the
+    // table is only populated once when constructed.
+    std::vector<int> m_markerBeatIndices = {0};
     mixxx::audio::FramePos m_lastMarkerPosition;
     mixxx::Bpm m_lastMarkerBpm;
     mixxx::audio::SampleRate m_sampleRate;
@@ -224,6 +224,66 @@ void GlobalTrackCacheResolver::initTrackIdAndUnlockCache(TrackId trackId) {
     DEBUG_ASSERT(m_trackRef == createTrackRef(*m_strongPtr));
 }
 
+//static
+TrackPointer GlobalTrackCacheReader::lookupTrackById(
+        const TrackId& trackId) {
+    DEBUG_ASSERT(s_pInstance);
+    {
+        QReadLocker locker(&s_pInstance->m_indexLock);
+        const auto trackById = s_pInstance->m_tracksById.find(trackId);
+        if (s_pInstance->m_tracksById.end() == trackById) {
+            return nullptr;
+        }
+        TrackPointer trackPtr = trackById->second->lock();
+        if (trackPtr) {
+            return trackPtr;
+        }
+    }
+    // The track is about to be evicted and needs to be revived
+    return GlobalTrackCacheLocker().lookupTrackById(trackId);
+}
+
+//static
+TrackPointer GlobalTrackCacheReader::lookupTrackByRef(
+        const TrackRef& trackRef) {
+    DEBUG_ASSERT(s_pInstance);
+    if (trackRef.hasId()) {
+        TrackPointer trackPtr = lookupTrackById(trackRef.getId());
+        if (trackPtr) {
+            return trackPtr;
+        }
+    }
+    if (!trackRef.hasCanonicalLocation()) {
+        return nullptr;
+    }
+    TrackPointer trackPtr;
+    {
+        QReadLocker locker(&s_pInstance->m_indexLock);
+        const auto trackByCanonicalLocation =
+                s_pInstance->m_tracksByCanonicalLocation.find(
+                        trackRef.getCanonicalLocation());
+        if (s_pInstance->m_tracksByCanonicalLocation.end() == trackByCanonicalLocation) {
+            return nullptr;
+        }
+        trackPtr = trackByCanonicalLocation->second->lock();
+    }
+    if (!trackPtr) {
+        // The track is about to be evicted and needs to be revived
+        return GlobalTrackCacheLocker().lookupTrackByRef(trackRef);
+    }
+    // Only logs a warning if multiple tracks reference the same
+    // physical file on disk, see GlobalTrackCache::lookupByRef()
+    validateAndCanonicalizeRequestedTrackRef(trackRef, *trackPtr);
+    return trackPtr;
+}
+
+//static
+QSet<TrackId> GlobalTrackCacheReader::getCachedTrackIds() {
+    DEBUG_ASSERT(s_pInstance);
+    QReadLocker locker(&s_pInstance->m_indexLock);
+    return s_pInstance->getCachedTrackIds();
+}
+
 //static
 void GlobalTrackCache::createInstance(
         GlobalTrackCacheSaver* pSaver,
@@ -329,6 +389,7 @@ void GlobalTrackCache::relocateTracks(
         kLogger.debug()
                 << "Relocating tracks";
     }
+    // Build the new index without blocking readers
     TracksByCanonicalLocation relocatedTracksByCanonicalLocation;
     for (auto&&
             i = m_tracksByCanonicalLocation.begin();
@@ -371,7 +432,8 @@ void GlobalTrackCache::relocateTracks(
                 std::move(newCanonicalLocation),
                 i->second));
     }
-    m_tracksByCanonicalLocation = std::move(relocatedTracksByCanonicalLocation);
+    QWriteLocker locker(&m_indexLock);
+    m_tracksByCanonicalLocation.swap(relocatedTracksByCanonicalLocation);
 }
 
 void GlobalTrackCache::saveEvictedTrack(Track* pEvictedTrack) const {
@@ -411,6 +473,7 @@ void GlobalTrackCache::deactivate() {
         auto i = m_tracksById.begin();
         Track* plainPtr= i->second->getPlainPtr();
         saveEvictedTrack(plainPtr);
+        QWriteLocker locker(&m_indexLock);
         m_tracksByCanonicalLocation.erase(plainPtr->getFileInfo().canonicalLocation());
         m_tracksById.erase(i);
     }
@@ -419,6 +482,7 @@ void GlobalTrackCache::deactivate() {
         auto i = m_tracksByCanonicalLocation.begin();
         Track* plainPtr= i->second->getPlainPtr();
         saveEvictedTrack(plainPtr);
+        QWriteLocker locker(&m_indexLock);
         m_tracksByCanonicalLocation.erase(i);
     }
 
@@ -547,7 +611,10 @@ TrackPointer GlobalTrackCache::revive(
 
     savingPtr = TrackPointer(entryPtr->getPlainPtr(),
             EvictAndSaveFunctor(entryPtr));
-    entryPtr->init(savingPtr);
+    {
+        QWriteLocker locker(&m_indexLock);
+        entryPtr->init(savingPtr);
+    }
     DEBUG_ASSERT(!savingPtr->signalsBlocked());
     return savingPtr;
 }
@@ -652,6 +719,7 @@ void GlobalTrackCache::resolve(
                 << deletingPtr.get();
     }
 
+    QWriteLocker locker(&m_indexLock);
     if (trackRef.hasId()) {
         // Insert item by id
         DEBUG_ASSERT(m_tracksById.find(
@@ -668,6 +736,7 @@ void GlobalTrackCache::resolve(
                 trackRef.getCanonicalLocation(),
                 cacheEntryPtr));
     }
+    locker.unlock();
 
     // Track objects live together with the cache on the main thread
     // and will be deleted later within the event loop. But this
@@ -695,14 +764,19 @@ TrackRef GlobalTrackCache::initTrackId(
     EvictAndSaveFunctor* pDel = std::get_deleter<EvictAndSaveFunctor>(strongPtr);
     DEBUG_ASSERT(pDel);
 
-    // Insert item by id
-    DEBUG_ASSERT(m_tracksById.find(trackId) == m_tracksById.end());
-    m_tracksById.insert(std::make_pair(
-            trackId,
-            pDel->getCacheEntryPointer()));
-
+    // The id must be initialized before the track becomes
+    // visible for GlobalTrackCacheReader
     strongPtr->initId(trackId);
     DEBUG_ASSERT(createTrackRef(*strongPtr) == trackRefWithId);
+
+    // Insert item by id
+    DEBUG_ASSERT(m_tracksById.find(trackId) == m_tracksById.end());
+    {
+        QWriteLocker locker(&m_indexLock);
+        m_tracksById.insert(std::make_pair(
+                trackId,
+                pDel->getCacheEntryPointer()));
+    }
     DEBUG_ASSERT(m_tracksById.find(trackId) != m_tracksById.end());
 
     return trackRefWithId;
@@ -714,8 +788,11 @@ void GlobalTrackCache::purgeTrackId(TrackId trackId) {
     const auto trackById(m_tracksById.find(trackId));
     if (m_tracksById.end() != trackById) {
         Track* track = trackById->second->getPlainPtr();
+        {
+            QWriteLocker locker(&m_indexLock);
+            m_tracksById.erase(trackById);
+        }
         track->resetId();
-        m_tracksById.erase(trackById);
     }
 }
 
@@ -781,6 +858,7 @@ bool GlobalTrackCache::tryEvict(Track* plainPtr) {
                 << trackRef
                 << plainPtr;
     }
+    QWriteLocker locker(&m_indexLock);
     if (trackRef.hasId()) {
         const auto trackById = m_tracksById.find(trackRef.getId());
         if (trackById != m_tracksById.end()) {
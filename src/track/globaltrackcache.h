@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QReadWriteLock>
 #include <map>
 #include <unordered_map>
 
@@ -171,6 +172,24 @@ private:
     TrackRef m_trackRef;
 };
 
+/// Lookup of tracks that are already cached without locking the
+/// cache exclusively. Lookups neither block each other nor wait
+/// until evicted tracks have been saved, which might take a while.
+///
+/// Only use these functions for finding existing tracks, e.g. when
+/// refreshing library models or from worker threads. Tracks that are
+/// just about to be evicted are looked up again by locking the cache.
+class GlobalTrackCacheReader final {
+  public:
+    GlobalTrackCacheReader() = delete;
+
+    static TrackPointer lookupTrackById(
+            const TrackId& trackId);
+    static TrackPointer lookupTrackByRef(
+            const TrackRef& trackRef);
+    static QSet<TrackId> getCachedTrackIds();
+};
+
 /// Callback interface for pre-delete actions
 class /*interface*/ GlobalTrackCacheSaver {
 private:
@@ -225,6 +244,7 @@ class GlobalTrackCache : public QObject {
 
   private:
     friend class GlobalTrackCacheLocker;
+    friend class GlobalTrackCacheReader;
     friend class GlobalTrackCacheResolver;
 
     GlobalTrackCache(
@@ -275,6 +295,12 @@ class GlobalTrackCache : public QObject {
     // Managed by GlobalTrackCacheLocker
     mutable QT_RECURSIVE_MUTEX m_mutex;
 
+    // Protects both indices and the weak pointers of all cache entries
+    // for GlobalTrackCacheReader. Modifications require that m_mutex
+    // has been locked before. Never release a TrackPointer while
+    // holding this lock, the deleter might need to lock it for writing!
+    mutable QReadWriteLock m_indexLock;
+
     GlobalTrackCacheSaver* m_pSaver;
 
     deleteTrackFn_t m_deleteTrackFn;
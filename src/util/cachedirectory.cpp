@@ -0,0 +1,67 @@
+#include "util/cachedirectory.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <algorithm>
+#include <vector>
+
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("CacheDirectory");
+
+} // anonymous namespace
+
+void pruneCacheDirectory(
+        const QString& directoryPath,
+        const QString& nameFilter,
+        qint64 maxTotalSizeBytes) {
+    struct CachedFile {
+        QDateTime lastModified;
+        qint64 size;
+        QString filePath;
+    };
+    std::vector<CachedFile> cachedFiles;
+    qint64 totalSizeBytes = 0;
+    QDirIterator it(directoryPath,
+            QStringList{nameFilter},
+            QDir::Files);
+    while (it.hasNext()) {
+        it.next();
+        const QFileInfo fileInfo = it.fileInfo();
+        cachedFiles.push_back(CachedFile{
+                fileInfo.lastModified(),
+                fileInfo.size(),
+                fileInfo.filePath()});
+        totalSizeBytes += fileInfo.size();
+    }
+    if (totalSizeBytes <= maxTotalSizeBytes) {
+        return;
+    }
+    kLogger.info()
+            << "Pruning"
+            << directoryPath
+            << "with a total size of"
+            << totalSizeBytes
+            << "bytes";
+    std::sort(cachedFiles.begin(),
+            cachedFiles.end(),
+            [](const CachedFile& lhs, const CachedFile& rhs) {
+                return lhs.lastModified < rhs.lastModified;
+            });
+    for (const auto& cachedFile : cachedFiles) {
+        if (totalSizeBytes <= maxTotalSizeBytes) {
+            break;
+        }
+        if (QFile::remove(cachedFile.filePath)) {
+            totalSizeBytes -= cachedFile.size;
+        }
+    }
+}
+
+} // namespace mixxx
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <QString>
+
+namespace mixxx {
+
+/// Deletes the least recently modified files that match the name
+/// filter from the directory until their total size does not exceed
+/// the limit. Intended for directories with files that could be
+/// recreated on demand, e.g. thumbnails. Might take a while and should
+/// be invoked from a worker thread.
+void pruneCacheDirectory(
+        const QString& directoryPath,
+        const QString& nameFilter,
+        qint64 maxTotalSizeBytes);
+
+} // namespace mixxx
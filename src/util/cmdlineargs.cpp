@@ -53,6 +53,7 @@ CmdlineArgs::CmdlineArgs()
           m_controllerDebug(false),
           m_controllerAbortOnWarning(false),
           m_developer(false),
+          m_loopbackAudio(false),
 #ifdef MIXXX_USE_QML
           m_qml(false),
 #endif
@@ -277,6 +278,14 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
                             : QString());
     parser.addOption(developer);
 
+    const QCommandLineOption loopbackAudio(QStringLiteral("loopback-audio"),
+            forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
+                                      "Offers a virtual loopback sound device that "
+                                      "runs the audio engine without sound hardware, "
+                                      "e.g. for testing and latency measurements.")
+                            : QString());
+    parser.addOption(loopbackAudio);
+
 #ifdef MIXXX_USE_QML
     const QCommandLineOption qml(QStringLiteral("qml"),
             forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
@@ -434,6 +443,7 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
     m_controllerPreviewScreens = parser.isSet(controllerPreviewScreens);
     m_controllerAbortOnWarning = parser.isSet(controllerAbortOnWarning);
     m_developer = parser.isSet(developer);
+    m_loopbackAudio = parser.isSet(loopbackAudio);
 #ifdef MIXXX_USE_QML
     m_qml = parser.isSet(qml);
 #endif
@@ -46,6 +46,12 @@ class CmdlineArgs final {
         return m_controllerAbortOnWarning;
     }
     bool getDeveloper() const { return m_developer; }
+    bool getLoopbackAudio() const {
+        return m_loopbackAudio;
+    }
+    void setLoopbackAudio(bool loopbackAudio) {
+        m_loopbackAudio = loopbackAudio;
+    }
 #ifdef MIXXX_USE_QML
     bool isQml() const {
         return m_qml;
@@ -97,6 +103,7 @@ class CmdlineArgs final {
     bool m_controllerPreviewScreens;
     bool m_controllerAbortOnWarning; // Controller Engine will be stricter
     bool m_developer; // Developer Mode
+    bool m_loopbackAudio; // Offer the virtual loopback sound device
 #ifdef MIXXX_USE_QML
     bool m_qml;
 #endif
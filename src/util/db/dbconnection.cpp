@@ -1,5 +1,6 @@
 #include <QSqlDriver>
 #include <QSqlError>
+#include <array>
 
 #ifdef __SQLITE3__
 #include <sqlite3.h>
@@ -8,6 +9,7 @@
 #include "util/db/dbconnection.h"
 
 #include "util/db/sqllikewildcards.h"
+#include "util/db/sqlquerycache.h"
 #include "util/logger.h"
 #include "util/assert.h"
 
@@ -64,21 +66,39 @@ void removeDatabase(
     QSqlDatabase::removeDatabase(connectionName);
 }
 
-void makeLatinLow(QChar* c, int count) {
-    for (int i = 0; i < count; ++i) {
-        if (c[i].decompositionTag() != QChar::NoDecomposition) {
-            QString decomposition = c[i].decomposition();
-            if (!decomposition.isEmpty() && !decomposition[0].isSpace()) {
-                // here we remove the decoration from all characters.
-                // We want "o" matching "ó" and all other variants but we
-                // do not decompose decoration only characters like "˚" where
-                // the base character is a space
-                c[i] = decomposition.at(0);
+// Maps every UTF-16 code unit to its base character in lower case.
+// We want "o" matching "ó" and all other variants, so the decoration
+// is removed from all characters by using the first character of their
+// decomposition. We do not decompose decoration only characters like
+// "˚" where the base character is a space.
+//
+// Looking up QChar::decomposition() allocates a QString, so the table is
+// computed only once for all characters of the BMP.
+const std::array<char16_t, 0x10000>& latinLowTable() {
+    static const auto s_table = [] {
+        std::array<char16_t, 0x10000> table;
+        for (std::size_t i = 0; i < table.size(); ++i) {
+            QChar c(static_cast<char16_t>(i));
+            if (c.decompositionTag() != QChar::NoDecomposition) {
+                const QString decomposition = c.decomposition();
+                if (!decomposition.isEmpty() && !decomposition[0].isSpace()) {
+                    c = decomposition.at(0);
+                }
             }
+            if (c.isUpper()) {
+                c = c.toLower();
+            }
+            table[i] = c.unicode();
         }
-        if (c[i].isUpper()) {
-            c[i] = c[i].toLower();
-        }
+        return table;
+    }();
+    return s_table;
+}
+
+void makeLatinLow(QChar* c, int count) {
+    const auto& table = latinLowTable();
+    for (int i = 0; i < count; ++i) {
+        c[i] = QChar(table[c[i].unicode()]);
     }
 }
 
@@ -113,22 +133,21 @@ int likeCompareInner(
             // Skip any kSqlLikeMatchAll or kSqlLikeMatchOne characters that follow a
             // kSqlLikeMatchAll. For each kSqlLikeMatchOne, skip one character in the
             // test string.
-
-            if (iPattern >= patternSize) {
-                // Tailing %
-                return 1;
-            }
-
-            while ((c = pattern[iPattern]) == kSqlLikeMatchAll || c == kSqlLikeMatchOne) {
+            while (iPattern < patternSize &&
+                    ((c = pattern[iPattern]) == kSqlLikeMatchAll ||
+                            c == kSqlLikeMatchOne)) {
                 if (c == kSqlLikeMatchOne) {
-                    if (++iString == stringSize) {
+                    if (iString == stringSize) {
                         return 0;
                     }
+                    ++iString;
                 }
-                if (++iPattern == patternSize) {
-                    // Two or more tailing %
-                    return 1;
-                }
+                ++iPattern;
+            }
+
+            if (iPattern == patternSize) {
+                // Tailing %
+                return 1;
             }
 
             while (iString < stringSize) {
@@ -141,9 +160,10 @@ int likeCompareInner(
             return 0;
         } else if (!prevEscape && uPattern == kSqlLikeMatchOne) {
             // Case 2.
-            if (++iString == stringSize) {
+            if (iString == stringSize) {
                 return 0;
             }
+            ++iString;
         } else if (!prevEscape && uPattern == esc) {
             // Case 3.
             prevEscape = true;
@@ -162,11 +182,146 @@ int likeCompareInner(
     return iString == stringSize;
 }
 
+// Decodes the next code point and advances the position. Malformed
+// sequences are decoded byte by byte as U+FFFD.
+char32_t nextCodePointUtf8(const char** ppPos, const char* pEnd) {
+    const auto* pPos = reinterpret_cast<const unsigned char*>(*ppPos);
+    const char32_t lead = *pPos;
+    if (lead < 0x80) {
+        *ppPos += 1;
+        return lead;
+    }
+    int length;
+    char32_t codePoint;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        codePoint = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        codePoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        codePoint = lead & 0x07;
+    } else {
+        *ppPos += 1;
+        return 0xFFFD;
+    }
+    if (pEnd - *ppPos < length) {
+        *ppPos += 1;
+        return 0xFFFD;
+    }
+    for (int i = 1; i < length; ++i) {
+        if ((pPos[i] & 0xC0) != 0x80) {
+            *ppPos += 1;
+            return 0xFFFD;
+        }
+        codePoint = (codePoint << 6) | (pPos[i] & 0x3F);
+    }
+    *ppPos += length;
+    return codePoint;
+}
+
+// The same mapping as makeLatinLow() for a single code point
+char32_t latinLowCodePoint(char32_t codePoint) {
+    if (codePoint < 0x80) {
+        // ASCII characters don't have a decomposition
+        if (codePoint >= 'A' && codePoint <= 'Z') {
+            return codePoint + ('a' - 'A');
+        }
+        return codePoint;
+    }
+    if (codePoint < 0x10000) {
+        return latinLowTable()[codePoint];
+    }
+    return codePoint;
+}
+
+char32_t nextLatinLowCodePointUtf8(const char** ppPos, const char* pEnd) {
+    // ASCII fast path
+    const char first = **ppPos;
+    if (first >= 'A' && first <= 'Z') {
+        *ppPos += 1;
+        return first + ('a' - 'A');
+    } else if (static_cast<unsigned char>(first) < 0x80) {
+        *ppPos += 1;
+        return first;
+    }
+    return latinLowCodePoint(nextCodePointUtf8(ppPos, pEnd));
+}
+
+// The same algorithm as likeCompareInner() that operates directly on
+// UTF-8 encoded strings. Characters are compared by code point after
+// applying makeLatinLow(). Nothing is allocated.
+int likeCompareInnerUtf8(
+        const char* pattern, // LIKE pattern
+        const char* patternEnd,
+        const char* string, // The string to compare against
+        const char* stringEnd,
+        char32_t esc) { // The escape character
+    // All wildcards are ASCII characters
+    const char matchAll = kSqlLikeMatchAll.toLatin1();
+    const char matchOne = kSqlLikeMatchOne.toLatin1();
+
+    bool prevEscape = false; // True if the previous character was uEsc
+
+    while (pattern < patternEnd) {
+        // Read (and consume) the next character from the input pattern.
+        const char32_t uPattern = nextLatinLowCodePointUtf8(&pattern, patternEnd);
+        // The 4 possibilities are the same as in likeCompareInner()
+
+        if (!prevEscape && uPattern == static_cast<char32_t>(matchAll)) {
+            // Case 1.
+            while (pattern < patternEnd &&
+                    (*pattern == matchAll || *pattern == matchOne)) {
+                if (*pattern == matchOne) {
+                    if (string == stringEnd) {
+                        return 0;
+                    }
+                    nextCodePointUtf8(&string, stringEnd);
+                }
+                ++pattern;
+            }
+
+            if (pattern == patternEnd) {
+                // Tailing %
+                return 1;
+            }
+
+            while (string < stringEnd) {
+                if (likeCompareInnerUtf8(pattern, patternEnd, string, stringEnd, esc)) {
+                    return 1;
+                }
+                nextCodePointUtf8(&string, stringEnd);
+            }
+            return 0;
+        } else if (!prevEscape && uPattern == static_cast<char32_t>(matchOne)) {
+            // Case 2.
+            if (string == stringEnd) {
+                return 0;
+            }
+            nextCodePointUtf8(&string, stringEnd);
+        } else if (!prevEscape && uPattern == esc) {
+            // Case 3.
+            prevEscape = true;
+        } else {
+            // Case 4.
+            if (string == stringEnd) {
+                return 0;
+            }
+            if (nextLatinLowCodePointUtf8(&string, stringEnd) != uPattern) {
+                return 0;
+            }
+            prevEscape = false;
+        }
+    }
+    return string == stringEnd;
+}
+
 #ifdef __SQLITE3__
 
 namespace {
 
-const QChar kSqlLikeEscapeDefault = '\0';
+constexpr char32_t kSqlLikeEscapeDefault = 0;
 
 } // anonymous namespace
 
@@ -201,6 +356,8 @@ void sqliteLikeUtf8(sqlite3_context* context,
         return;
     }
 
+    // The pointers are only valid until the values are accessed again
+    // in a different encoding. Nothing is copied.
     const char* b = reinterpret_cast<const char*>(
             sqlite3_value_text(aArgv[0]));
     const char* a = reinterpret_cast<const char*>(
@@ -209,30 +366,118 @@ void sqliteLikeUtf8(sqlite3_context* context,
     if (!a || !b) {
         return;
     }
+    const int sizeB = sqlite3_value_bytes(aArgv[0]);
+    const int sizeA = sqlite3_value_bytes(aArgv[1]);
 
-    QString stringB = QString::fromUtf8(b); // Like String
-    QString stringA = QString::fromUtf8(a);
-
-    QChar esc = kSqlLikeEscapeDefault;
+    char32_t esc = kSqlLikeEscapeDefault;
     if (aArgc == 3) {
         const char* e = reinterpret_cast<const char*>(
                 sqlite3_value_text(aArgv[2]));
-        if (e) {
-            QString stringE = QString::fromUtf8(e);
-            if (!stringE.isEmpty()) {
-                esc = stringE.data()[0];
-            }
+        if (e && *e) {
+            esc = nextCodePointUtf8(&e, e + sqlite3_value_bytes(aArgv[2]));
         }
     }
 
-    int ret = DbConnection::likeCompareLatinLow(&stringB, &stringA, esc);
+    int ret = DbConnection::likeCompareLatinLowUtf8(b, sizeB, a, sizeA, esc);
     sqlite3_result_int64(context, ret);
     return;
 }
 
+// This implements the mixxx_latin_low() SQL function that folds text
+// in the same way as the LIKE function, e.g. for populating the
+// full-text index of the library.
+void sqliteLatinLowUtf8(sqlite3_context* context,
+        int aArgc,
+        sqlite3_value** aArgv) {
+    VERIFY_OR_DEBUG_ASSERT(aArgc == 1) {
+        return;
+    }
+    const char* text = reinterpret_cast<const char*>(
+            sqlite3_value_text(aArgv[0]));
+    if (!text) {
+        sqlite3_result_null(context);
+        return;
+    }
+    QString string = QString::fromUtf8(text, sqlite3_value_bytes(aArgv[0]));
+    DbConnection::makeStringLatinLow(&string);
+    const QByteArray utf8 = string.toUtf8();
+    sqlite3_result_text(context,
+            utf8.constData(),
+            static_cast<int>(utf8.size()),
+            SQLITE_TRANSIENT);
+}
+
+#endif // __SQLITE3__
+
+#ifdef __SQLITE3__
+
+void execPragma(sqlite3* handle, const QString& pragma) {
+    char* pErrorMessage = nullptr;
+    const int result = sqlite3_exec(
+            handle,
+            pragma.toUtf8().constData(),
+            nullptr,
+            nullptr,
+            &pErrorMessage);
+    if (result != SQLITE_OK) {
+        kLogger.warning()
+                << "Failed to execute"
+                << pragma
+                << ':'
+                << (pErrorMessage ? pErrorMessage : sqlite3_errstr(result));
+    }
+    sqlite3_free(pErrorMessage);
+}
+
+QString queryPragma(sqlite3* handle, const QString& pragma) {
+    QString value;
+    sqlite3_stmt* pStatement = nullptr;
+    if (sqlite3_prepare_v2(
+                handle,
+                pragma.toUtf8().constData(),
+                -1,
+                &pStatement,
+                nullptr) == SQLITE_OK &&
+            sqlite3_step(pStatement) == SQLITE_ROW) {
+        value = QString::fromUtf8(reinterpret_cast<const char*>(
+                sqlite3_column_text(pStatement, 0)));
+    }
+    sqlite3_finalize(pStatement);
+    return value;
+}
+
+void applyTuningParams(sqlite3* handle, const DbConnection::Params& params) {
+    if (params.writeAheadLog) {
+        execPragma(handle, QStringLiteral("PRAGMA journal_mode=WAL"));
+        // With WAL the database stays consistent with NORMAL and only
+        // the most recent transactions might be lost after a power
+        // failure. The default FULL syncs on every commit.
+        execPragma(handle, QStringLiteral("PRAGMA synchronous=NORMAL"));
+    } else if (queryPragma(handle, QStringLiteral("PRAGMA journal_mode")) ==
+            QLatin1String("wal")) {
+        // The journal mode is persistent. Switch a database back to the
+        // default after WAL has been disabled.
+        execPragma(handle, QStringLiteral("PRAGMA journal_mode=DELETE"));
+    }
+    if (params.pageCacheSizeKiB > 0) {
+        // Negative values are interpreted as KiB instead of pages
+        execPragma(handle,
+                QStringLiteral("PRAGMA cache_size=-%1")
+                        .arg(params.pageCacheSizeKiB));
+    }
+    if (params.mmapSizeBytes > 0) {
+        execPragma(handle,
+                QStringLiteral("PRAGMA mmap_size=%1")
+                        .arg(params.mmapSizeBytes));
+    }
+}
+
 #endif // __SQLITE3__
 
-bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator) {
+bool initDatabase(
+        const QSqlDatabase& database,
+        const DbConnection::Params& params,
+        mixxx::StringCollator* pCollator) {
     DEBUG_ASSERT(database.isOpen());
 #ifdef __SQLITE3__
     QVariant v = database.driver()->handle();
@@ -304,8 +549,26 @@ bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator
                 << "Failed to install custom 3-arg LIKE function for SQLite3:"
                 << result;
     }
+
+    result = sqlite3_create_function(
+            handle,
+            "mixxx_latin_low",
+            1,
+            SQLITE_UTF8 | SQLITE_DETERMINISTIC,
+            nullptr,
+            sqliteLatinLowUtf8,
+            nullptr,
+            nullptr);
+    VERIFY_OR_DEBUG_ASSERT(result == SQLITE_OK) {
+        kLogger.warning()
+                << "Failed to install custom mixxx_latin_low function for SQLite3:"
+                << result;
+    }
+
+    applyTuningParams(handle, params);
 #else
     Q_UNUSED(database);
+    Q_UNUSED(params);
     Q_UNUSED(pCollator);
 #endif // __SQLITE3__
     return true;
@@ -316,13 +579,15 @@ bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator
 DbConnection::DbConnection(
         const Params& params,
         const QString& connectionName)
-    : m_sqlDatabase(createDatabase(params, connectionName)) {
+    : m_params(params),
+      m_sqlDatabase(createDatabase(params, connectionName)) {
 }
 
 DbConnection::DbConnection(
         const DbConnection& prototype,
         const QString& connectionName)
-    : m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)) {
+    : m_params(prototype.m_params),
+      m_sqlDatabase(cloneDatabase(prototype.m_sqlDatabase, connectionName)) {
 }
 
 DbConnection::~DbConnection() {
@@ -343,17 +608,27 @@ bool DbConnection::open() {
                 << m_sqlDatabase.lastError();
         return false; // abort
     }
-    if (!initDatabase(m_sqlDatabase, &m_collator)) {
+    if (!initDatabase(m_sqlDatabase, m_params, &m_collator)) {
         kLogger.warning()
                 << "Failed to initialize database connection"
                 << *this;
         m_sqlDatabase.close();
         return false; // abort
     }
+    if (m_params.preparedQueryCacheCapacity > 0) {
+        m_pQueryCache = std::make_unique<SqlQueryCache>(
+                m_params.preparedQueryCacheCapacity);
+        SqlQueryCache::registerCache(name(), m_pQueryCache.get());
+    }
     return true;
 }
 
 void DbConnection::close() {
+    if (m_pQueryCache) {
+        // All prepared statements must be released before closing
+        SqlQueryCache::unregisterCache(name());
+        m_pQueryCache.reset();
+    }
     if (m_sqlDatabase.isOpen()) {
         // There should never be an outstanding transaction when this code is
         // called. If there is, it means we probably aren't committing a
@@ -394,6 +669,19 @@ int DbConnection::likeCompareLatinLow(
             esc);
 }
 
+//static
+int DbConnection::likeCompareLatinLowUtf8(
+        const char* pattern,
+        int patternSize,
+        const char* string,
+        int stringSize,
+        char32_t esc) {
+    return likeCompareInnerUtf8(
+            pattern, pattern + patternSize,
+            string, string + stringSize,
+            esc);
+}
+
 //static
 void DbConnection::makeStringLatinLow(QString* string) {
     makeLatinLow(string->data(), string->length());
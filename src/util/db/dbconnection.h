@@ -2,11 +2,14 @@
 
 #include <QSqlDatabase>
 #include <QtDebug>
+#include <memory>
 
 #include "util/string.h"
 
 namespace mixxx {
 
+class SqlQueryCache;
+
 class DbConnection final {
   public:
     // Order string fields lexicographically with a
@@ -20,6 +23,16 @@ class DbConnection final {
         QString* string,
         QChar esc);
 
+    // The same comparison as likeCompareLatinLow() for UTF-8 encoded
+    // strings, without converting them to QString first. Used for
+    // the LIKE operator of SQLite.
+    static int likeCompareLatinLowUtf8(
+            const char* pattern,
+            int patternSize,
+            const char* string,
+            int stringSize,
+            char32_t esc);
+
     static void makeStringLatinLow(QString* string);
 
     struct Params {
@@ -29,6 +42,21 @@ class DbConnection final {
         QString filePath;
         QString userName;
         QString password;
+
+        // Tuning options that are only applied to SQLite connections.
+        // A value of 0 keeps the default of SQLite.
+
+        // Write-ahead logging lets readers proceed while the library
+        // scanner is writing. Not supported for in-memory databases and
+        // for databases on network file systems. Otherwise the rollback
+        // journal is used, which is the default of SQLite.
+        bool writeAheadLog = false;
+        int pageCacheSizeKiB = 0;
+        qint64 mmapSizeBytes = 0;
+
+        // The capacity of the per-connection cache of prepared queries
+        // that are borrowed with CachedSqlQuery. 0 disables the cache.
+        int preparedQueryCacheCapacity = 0;
     };
 
     // All constructors are reserved for DbConnectionPool!!
@@ -51,6 +79,10 @@ class DbConnection final {
         return m_sqlDatabase.isOpen();
     }
 
+    const Params& params() const {
+        return m_params;
+    }
+
     operator QSqlDatabase() const {
         return m_sqlDatabase;
     }
@@ -61,8 +93,10 @@ class DbConnection final {
     DbConnection(const DbConnection&) = delete;
     DbConnection(const DbConnection&&) = delete;
 
+    const Params m_params;
     QSqlDatabase m_sqlDatabase;
     mixxx::StringCollator m_collator;
+    std::unique_ptr<SqlQueryCache> m_pQueryCache;
 };
 
 } // namespace mixxx
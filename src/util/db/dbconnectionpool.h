@@ -36,6 +36,11 @@ class DbConnectionPool final {
     bool createThreadLocalConnection();
     void destroyThreadLocalConnection();
 
+    // The parameters of all connections in this pool
+    const DbConnection::Params& params() const {
+        return m_prototypeConnection.params();
+    }
+
   private:
     DbConnectionPool(const DbConnectionPool&) = delete;
     DbConnectionPool(const DbConnectionPool&&) = delete;
@@ -0,0 +1,157 @@
+#include "util/db/dbqueryexecutor.h"
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/db/dbconnectionpooled.h"
+#include "util/db/dbconnectionpooler.h"
+#include "util/db/fwdsqlquery.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("DbQueryExecutor");
+
+} // anonymous namespace
+
+DbQueryExecutor::DbQueryExecutor(
+        DbConnectionPoolPtr pDbConnectionPool)
+        : m_pDbConnectionPool(std::move(pDbConnectionPool)),
+          m_stopping(false) {
+    setObjectName(QStringLiteral("DbQueryExecutor"));
+    start();
+}
+
+DbQueryExecutor::~DbQueryExecutor() {
+    {
+        const auto locker = lockMutex(&m_mutex);
+        m_stopping = true;
+    }
+    m_tasksAvailable.wakeAll();
+    wait();
+}
+
+void DbQueryExecutor::enqueue(Task task) {
+    {
+        const auto locker = lockMutex(&m_mutex);
+        if (!m_stopping) {
+            m_tasks.push_back(std::move(task));
+            m_tasksAvailable.wakeOne();
+            return;
+        }
+    }
+    task(QSqlDatabase());
+}
+
+void DbQueryExecutor::run() {
+    kLogger.debug() << "Entering thread";
+    {
+        const DbConnectionPooler dbConnectionPooler(m_pDbConnectionPool);
+        const QSqlDatabase database = DbConnectionPooled(m_pDbConnectionPool);
+        if (!database.isOpen()) {
+            kLogger.warning()
+                    << "Failed to open database connection for executing queries";
+        }
+
+        auto locker = lockMutex(&m_mutex);
+        while (!m_stopping) {
+            if (m_tasks.empty()) {
+                m_tasksAvailable.wait(&m_mutex);
+                continue;
+            }
+            Task task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            locker.unlock();
+            task(database);
+            locker.relock();
+        }
+    }
+
+    // Finish the futures of all pending tasks without executing them
+    std::deque<Task> discardedTasks;
+    {
+        const auto locker = lockMutex(&m_mutex);
+        discardedTasks.swap(m_tasks);
+    }
+    for (const auto& task : discardedTasks) {
+        task(QSqlDatabase());
+    }
+    kLogger.debug() << "Exiting thread";
+}
+
+// static
+bool DbQueryExecutor::isVisibleFromExecutor(
+        const QSqlDatabase& database,
+        const QString& tableName,
+        QString* pTemporaryViewSql) {
+    DEBUG_ASSERT(pTemporaryViewSql);
+    pTemporaryViewSql->clear();
+    FwdSqlQuery query(database,
+            QStringLiteral(
+                    "SELECT type,sql FROM sqlite_temp_master WHERE name=:name"));
+    query.bindValue(QStringLiteral(":name"), tableName);
+    if (!query.execPrepared()) {
+        return false;
+    }
+    if (!query.next()) {
+        // Neither a temporary table nor a temporary view
+        return true;
+    }
+    if (query.fieldValue(0).toString() != QStringLiteral("view")) {
+        return false;
+    }
+    *pTemporaryViewSql = query.fieldValue(1).toString();
+    return true;
+}
+
+// static
+bool DbQueryExecutor::createTemporaryView(
+        const QSqlDatabase& database,
+        const QString& viewName,
+        const QString& viewSql) {
+    // SQLite stores the statement without the TEMP keyword
+    const QString kCreateView = QStringLiteral("CREATE VIEW ");
+    VERIFY_OR_DEBUG_ASSERT(viewSql.startsWith(kCreateView)) {
+        return false;
+    }
+    FwdSqlQuery query(database,
+            QStringLiteral(
+                    "SELECT sql FROM sqlite_temp_master "
+                    "WHERE type='view' AND name=:name"));
+    query.bindValue(QStringLiteral(":name"), viewName);
+    if (!query.execPrepared()) {
+        return false;
+    }
+    if (query.next()) {
+        if (query.fieldValue(0).toString() == viewSql) {
+            return true;
+        }
+        // The view has been redefined in the meantime
+        QString quotedViewName = viewName;
+        quotedViewName.replace(QChar('"'), QStringLiteral("\"\""));
+        if (!FwdSqlQuery(database,
+                    QStringLiteral("DROP VIEW temp.\"%1\"").arg(quotedViewName))
+                        .execPrepared()) {
+            return false;
+        }
+    }
+    return FwdSqlQuery(database,
+            QStringLiteral("CREATE TEMP VIEW ") + viewSql.mid(kCreateView.size()))
+            .execPrepared();
+}
+
+void DbQueryExecutor::dropTemporaryView(const QString& viewName) {
+    QString quotedViewName = viewName;
+    quotedViewName.replace(QChar('"'), QStringLiteral("\"\""));
+    enqueue([quotedViewName](const QSqlDatabase& database) {
+        if (!database.isOpen()) {
+            return;
+        }
+        FwdSqlQuery(database,
+                QStringLiteral("DROP VIEW IF EXISTS temp.\"%1\"").arg(quotedViewName))
+                .execPrepared();
+    });
+}
+
+} // namespace mixxx
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QFuture>
+#include <QFutureInterface>
+#include <QMutex>
+#include <QSqlDatabase>
+#include <QThread>
+#include <QWaitCondition>
+#include <deque>
+#include <functional>
+#include <memory>
+
+#include "util/db/dbconnectionpool.h"
+
+namespace mixxx {
+
+/// Executes database queries on a dedicated thread with its own
+/// connection from the pool.
+///
+/// Queries are executed one after another in the order they have been
+/// submitted. The results are delivered through a QFuture, typically
+/// watched by a QFutureWatcher that receives them on the thread of the
+/// caller.
+///
+/// The connection of the executor is independent of the connection of
+/// the caller. Neither temporary tables and views nor uncommitted changes
+/// of the caller are visible to the queries.
+class DbQueryExecutor final : public QThread {
+  public:
+    explicit DbQueryExecutor(
+            DbConnectionPoolPtr pDbConnectionPool);
+    ~DbQueryExecutor() override;
+
+    /// Submits a query for execution. Can be invoked from any thread.
+    ///
+    /// Canceling the future before the query has been started skips the
+    /// query. The future is also canceled if the connection could not be
+    /// opened or if the executor is destroyed before the query has been
+    /// started.
+    template<typename T>
+    QFuture<T> execute(std::function<T(const QSqlDatabase&)> query) {
+        auto pPromise = std::make_shared<QFutureInterface<T>>();
+        pPromise->reportStarted();
+        QFuture<T> future = pPromise->future();
+        enqueue([pPromise, query = std::move(query)](const QSqlDatabase& database) {
+            if (database.isOpen() && !pPromise->isCanceled()) {
+                pPromise->reportResult(query(database));
+            } else {
+                pPromise->cancel();
+            }
+            pPromise->reportFinished();
+        });
+        return future;
+    }
+
+    /// Queries of the executor only run without blocking the writers on
+    /// other connections if the database uses write-ahead logging.
+    /// Otherwise a long running query holds a shared lock that blocks all
+    /// writers until it has finished.
+    bool readsBlockWriters() const {
+        return !m_pDbConnectionPool->params().writeAheadLog;
+    }
+
+    /// Checks if a table or view of the given connection is also visible
+    /// from the connection of the executor. Temporary views are visible
+    /// after creating them again with createTemporaryView(), their
+    /// definition is returned in pTemporaryViewSql. Temporary tables are
+    /// not visible.
+    static bool isVisibleFromExecutor(
+            const QSqlDatabase& database,
+            const QString& tableName,
+            QString* pTemporaryViewSql);
+
+    /// Creates or replaces a temporary view from the definition that is
+    /// stored for it in sqlite_temp_master.
+    static bool createTemporaryView(
+            const QSqlDatabase& database,
+            const QString& viewName,
+            const QString& viewSql);
+
+    /// Drops a temporary view that has been created with
+    /// createTemporaryView() from the connection of the executor after
+    /// all pending queries. Can be invoked from any thread.
+    ///
+    /// Other users of the view are not affected, because it is created
+    /// again on demand.
+    void dropTemporaryView(const QString& viewName);
+
+  protected:
+    void run() override;
+
+  private:
+    // Pending tasks are invoked with a closed connection when discarded
+    typedef std::function<void(const QSqlDatabase&)> Task;
+
+    void enqueue(Task task);
+
+    const DbConnectionPoolPtr m_pDbConnectionPool;
+
+    QMutex m_mutex;
+    QWaitCondition m_tasksAvailable;
+    std::deque<Task> m_tasks;
+    bool m_stopping;
+};
+
+} // namespace mixxx
@@ -0,0 +1,86 @@
+#include "util/db/sqlquerycache.h"
+
+#include <QHash>
+
+#include "util/assert.h"
+#include "util/db/sqlqueryfinisher.h"
+
+namespace mixxx {
+
+namespace {
+
+// Database connections are thread-local and so are their caches
+thread_local QHash<QString, SqlQueryCache*> s_cachesByConnectionName;
+
+} // anonymous namespace
+
+SqlQueryCache::SqlQueryCache(int capacity)
+        : m_queries(capacity) {
+    DEBUG_ASSERT(capacity > 0);
+}
+
+SqlQueryCache::~SqlQueryCache() {
+    clear();
+}
+
+//static
+SqlQueryCache* SqlQueryCache::forDatabase(const QSqlDatabase& database) {
+    if (s_cachesByConnectionName.isEmpty()) {
+        return nullptr;
+    }
+    return s_cachesByConnectionName.value(database.connectionName(), nullptr);
+}
+
+//static
+void SqlQueryCache::registerCache(
+        const QString& connectionName,
+        SqlQueryCache* pCache) {
+    DEBUG_ASSERT(pCache);
+    DEBUG_ASSERT(!s_cachesByConnectionName.contains(connectionName));
+    s_cachesByConnectionName.insert(connectionName, pCache);
+}
+
+//static
+void SqlQueryCache::unregisterCache(
+        const QString& connectionName) {
+    s_cachesByConnectionName.remove(connectionName);
+}
+
+std::unique_ptr<FwdSqlQuery> SqlQueryCache::take(const QString& statement) {
+    return std::unique_ptr<FwdSqlQuery>(m_queries.take(statement));
+}
+
+void SqlQueryCache::put(const QString& statement, std::unique_ptr<FwdSqlQuery> pQuery) {
+    DEBUG_ASSERT(pQuery);
+    // Ownership is transferred even if the query is rejected
+    m_queries.insert(statement, pQuery.release());
+}
+
+void SqlQueryCache::clear() {
+    m_queries.clear();
+}
+
+CachedSqlQuery::CachedSqlQuery(
+        const QSqlDatabase& database,
+        const QString& statement)
+        : m_pCache(SqlQueryCache::forDatabase(database)),
+          m_statement(statement) {
+    if (m_pCache) {
+        m_pQuery = m_pCache->take(statement);
+    }
+    if (!m_pQuery) {
+        m_pQuery = std::make_unique<FwdSqlQuery>(database, statement);
+    }
+}
+
+CachedSqlQuery::~CachedSqlQuery() {
+    // Release the resources of the result set before the query is
+    // reused by the next borrower
+    SqlQueryFinisher(m_pQuery.get()).tryFinish();
+    // Queries that failed to prepare are not reusable
+    if (m_pCache && m_pQuery->isPrepared()) {
+        m_pCache->put(m_statement, std::move(m_pQuery));
+    }
+}
+
+} // namespace mixxx
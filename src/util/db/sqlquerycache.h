@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QCache>
+#include <QSqlDatabase>
+#include <QString>
+#include <memory>
+
+#include "util/db/fwdsqlquery.h"
+
+namespace mixxx {
+
+/// A least-recently-used cache of prepared queries for a single
+/// database connection.
+///
+/// Preparing a statement requires SQLite to parse and plan the SQL
+/// text, which for the wide joins on the library table takes longer
+/// than executing the query for a single track. Statements that are
+/// executed repeatedly with different bound values should borrow
+/// their query from this cache by using CachedSqlQuery.
+///
+/// Like the connection it belongs to the cache must only be accessed
+/// from a single thread.
+class SqlQueryCache final {
+  public:
+    explicit SqlQueryCache(int capacity);
+    ~SqlQueryCache();
+
+    /// Returns the cache of the open connection with the given name
+    /// on the current thread or nullptr if caching is disabled.
+    static SqlQueryCache* forDatabase(const QSqlDatabase& database);
+
+    /// Connections register their cache after being opened and
+    /// must unregister it before being closed.
+    static void registerCache(
+            const QString& connectionName,
+            SqlQueryCache* pCache);
+    static void unregisterCache(
+            const QString& connectionName);
+
+    int capacity() const {
+        return m_queries.maxCost();
+    }
+    int size() const {
+        return m_queries.size();
+    }
+
+    /// Removes the query for the statement from the cache. The
+    /// caller takes ownership. Returns nullptr if the statement
+    /// has not been cached.
+    std::unique_ptr<FwdSqlQuery> take(const QString& statement);
+    /// Returns a query into the cache. The least recently used query
+    /// is deleted if the cache is full.
+    void put(const QString& statement, std::unique_ptr<FwdSqlQuery> pQuery);
+
+    /// Deletes all queries. Must be invoked before the connection is
+    /// closed.
+    void clear();
+
+  private:
+    QCache<QString, FwdSqlQuery> m_queries;
+};
+
+/// Borrows a prepared query from the cache of the connection for the
+/// lifetime of this object. The query is prepared on first use and
+/// returned to the cache after it has been finished when leaving the
+/// scope. If the connection has no cache an ordinary, uncached query
+/// is used.
+///
+/// The bound values of the previous execution are not reset. All
+/// placeholders of the statement need to be bound again before
+/// executing the query.
+class CachedSqlQuery final {
+  public:
+    CachedSqlQuery(
+            const QSqlDatabase& database,
+            const QString& statement);
+    ~CachedSqlQuery();
+
+    FwdSqlQuery* operator->() const {
+        return m_pQuery.get();
+    }
+    FwdSqlQuery& operator*() const {
+        return *m_pQuery;
+    }
+
+  private:
+    CachedSqlQuery(const CachedSqlQuery&) = delete;
+    CachedSqlQuery& operator=(const CachedSqlQuery&) = delete;
+
+    SqlQueryCache* const m_pCache;
+    const QString m_statement;
+    std::unique_ptr<FwdSqlQuery> m_pQuery;
+};
+
+} // namespace mixxx
@@ -0,0 +1,406 @@
+#include "util/fileblockcache.h"
+
+#include <QFileInfo>
+#include <QRunnable>
+#include <QThread>
+#include <QVector>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
+
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace mixxx {
+
+namespace {
+
+const Logger kLogger("FileBlockCache");
+
+constexpr qint64 kDefaultCapacityBytes = 32 * 1024 * 1024;
+
+constexpr qint64 kDefaultReadAheadBytes = 512 * 1024;
+
+// Prefetching is I/O bound and each file is prefetched sequentially
+constexpr int kMaxPrefetchThreadCount = 4;
+
+class PrefetchTask : public QRunnable {
+  public:
+    explicit PrefetchTask(std::function<void()> task)
+            : m_task(std::move(task)) {
+    }
+
+    void run() override {
+        m_task();
+    }
+
+  private:
+    const std::function<void()> m_task;
+};
+
+inline qint64 fileLastModified(const QFile& file) {
+    return QFileInfo(file).lastModified().toMSecsSinceEpoch();
+}
+
+/// Reads consecutive blocks with a single request, which is much
+/// faster on network storage than reading the blocks separately.
+QList<QByteArray> readFileBlocks(
+        QFile* pFile,
+        qint64 beginBlockIndex,
+        qint64 endBlockIndex) {
+    DEBUG_ASSERT(beginBlockIndex < endBlockIndex);
+    QList<QByteArray> blocks;
+    if (!pFile->seek(beginBlockIndex * FileBlockCache::kBlockSize)) {
+        kLogger.warning()
+                << "Failed to seek file"
+                << pFile->fileName()
+                << pFile->errorString();
+        return blocks;
+    }
+    const QByteArray data = pFile->read(
+            (endBlockIndex - beginBlockIndex) * FileBlockCache::kBlockSize);
+    if (data.isEmpty()) {
+        kLogger.warning()
+                << "Failed to read file"
+                << pFile->fileName()
+                << pFile->errorString();
+        return blocks;
+    }
+    for (qint64 offset = 0; offset < data.size(); offset += FileBlockCache::kBlockSize) {
+        blocks.append(data.mid(static_cast<int>(offset),
+                static_cast<int>(FileBlockCache::kBlockSize)));
+    }
+    return blocks;
+}
+
+/// Lets the OS start reading the range in the background,
+/// which is honored by both local and network file systems.
+void adviseWillNeed(
+        const QFile& file,
+        qint64 offset,
+        qint64 length) {
+#ifdef Q_OS_LINUX
+    const int fd = file.handle();
+    if (fd >= 0) {
+        posix_fadvise(fd, offset, length, POSIX_FADV_WILLNEED);
+    }
+#else
+    Q_UNUSED(file);
+    Q_UNUSED(offset);
+    Q_UNUSED(length);
+#endif
+}
+
+} // anonymous namespace
+
+FileBlockCache::FileBlockCache(
+        qint64 capacityBytes,
+        qint64 readAheadBytes)
+        : m_blocks(static_cast<int>(capacityBytes)),
+          m_hits(0),
+          m_misses(0) {
+    setReadAheadBytes(readAheadBytes);
+    m_prefetchThreadPool.setObjectName(QStringLiteral("FileBlockCache"));
+    m_prefetchThreadPool.setMaxThreadCount(
+            std::clamp(QThread::idealThreadCount(), 1, kMaxPrefetchThreadCount));
+}
+
+FileBlockCache::~FileBlockCache() {
+    m_prefetchThreadPool.waitForDone();
+}
+
+// static
+FileBlockCache* FileBlockCache::instance() {
+    static FileBlockCache s_instance(
+            kDefaultCapacityBytes,
+            kDefaultReadAheadBytes);
+    return &s_instance;
+}
+
+void FileBlockCache::setReadAheadBytes(qint64 readAheadBytes) {
+    VERIFY_OR_DEBUG_ASSERT(readAheadBytes >= 0) {
+        readAheadBytes = 0;
+    }
+    atomicStoreRelaxed(m_readAheadBlockCount,
+            static_cast<int>((readAheadBytes + kBlockSize - 1) / kBlockSize));
+}
+
+FileBlockCache::Stats FileBlockCache::stats() const {
+    Stats stats;
+    stats.hits = atomicLoadRelaxed(m_hits);
+    stats.misses = atomicLoadRelaxed(m_misses);
+    return stats;
+}
+
+QByteArray FileBlockCache::readBlock(
+        const BlockKey& key,
+        QFile* pFile,
+        bool* pHit) {
+    DEBUG_ASSERT(pFile);
+    DEBUG_ASSERT(pHit);
+    {
+        auto locker = lockMutex(&m_mutex);
+        while (true) {
+            const QByteArray* pBlock = m_blocks.object(key);
+            if (pBlock) {
+                m_hits.fetchAndAddRelaxed(1);
+                *pHit = true;
+                // Implicitly shared, i.e. only the reference is copied
+                return *pBlock;
+            }
+            if (!m_readingBlocks.contains(key)) {
+                break;
+            }
+            // The block is already being read by a prefetch or
+            // another reader
+            m_blockInserted.wait(&m_mutex);
+        }
+        // Don't wait for a prefetch that is still queued behind the
+        // prefetches of other files. The block is skipped when the
+        // prefetch starts.
+        m_queuedBlocks.remove(key);
+        m_readingBlocks.insert(key);
+    }
+    m_misses.fetchAndAddRelaxed(1);
+    *pHit = false;
+    const QList<QByteArray> blocks =
+            readFileBlocks(pFile, key.blockIndex, key.blockIndex + 1);
+    const QByteArray block = blocks.isEmpty() ? QByteArray() : blocks.first();
+    insertBlock(key, block);
+    return block;
+}
+
+void FileBlockCache::insertBlock(
+        const BlockKey& key,
+        const QByteArray& block) {
+    {
+        const auto locker = lockMutex(&m_mutex);
+        m_readingBlocks.remove(key);
+        if (!block.isEmpty()) {
+            m_blocks.insert(key, new QByteArray(block), block.size());
+        }
+    }
+    m_blockInserted.wakeAll();
+}
+
+void FileBlockCache::prefetchBlocks(
+        const BlockKey& firstKey,
+        int blockCount) {
+    // Only the first consecutive range of missing blocks is prefetched
+    BlockKey beginKey = firstKey;
+    qint64 endBlockIndex = firstKey.blockIndex;
+    {
+        const auto locker = lockMutex(&m_mutex);
+        for (BlockKey key = firstKey;
+                key.blockIndex < firstKey.blockIndex + blockCount;
+                ++key.blockIndex) {
+            if (m_blocks.contains(key) ||
+                    m_queuedBlocks.contains(key) ||
+                    m_readingBlocks.contains(key)) {
+                if (endBlockIndex > beginKey.blockIndex) {
+                    break;
+                }
+                beginKey.blockIndex = key.blockIndex + 1;
+                endBlockIndex = beginKey.blockIndex;
+                continue;
+            }
+            m_queuedBlocks.insert(key);
+            endBlockIndex = key.blockIndex + 1;
+        }
+    }
+    if (endBlockIndex <= beginKey.blockIndex) {
+        return;
+    }
+    auto* pTask = new PrefetchTask([this, beginKey, endBlockIndex] {
+        // Only read the blocks that have not been read directly while
+        // the prefetch was queued
+        QVector<bool> claimed(static_cast<int>(endBlockIndex - beginKey.blockIndex));
+        BlockKey readBeginKey = beginKey;
+        qint64 readEndBlockIndex = beginKey.blockIndex;
+        {
+            const auto locker = lockMutex(&m_mutex);
+            for (BlockKey key = beginKey; key.blockIndex < endBlockIndex; ++key.blockIndex) {
+                if (!m_queuedBlocks.remove(key)) {
+                    continue;
+                }
+                m_readingBlocks.insert(key);
+                claimed[static_cast<int>(key.blockIndex - beginKey.blockIndex)] = true;
+                if (readEndBlockIndex <= readBeginKey.blockIndex) {
+                    readBeginKey.blockIndex = key.blockIndex;
+                }
+                readEndBlockIndex = key.blockIndex + 1;
+            }
+        }
+        if (readEndBlockIndex <= readBeginKey.blockIndex) {
+            // All blocks have been read in the meantime
+            return;
+        }
+        // Opening the file again is required, because QFile
+        // must not be accessed concurrently
+        QFile file(readBeginKey.filePath);
+        QList<QByteArray> blocks;
+        if (file.open(QIODevice::ReadOnly)) {
+            blocks = readFileBlocks(&file, readBeginKey.blockIndex, readEndBlockIndex);
+        } else {
+            kLogger.warning()
+                    << "Failed to open file"
+                    << file.fileName()
+                    << file.errorString();
+        }
+        BlockKey key = readBeginKey;
+        for (; key.blockIndex < readEndBlockIndex; ++key.blockIndex) {
+            if (!claimed[static_cast<int>(key.blockIndex - beginKey.blockIndex)]) {
+                continue;
+            }
+            const qint64 blockOffset = key.blockIndex - readBeginKey.blockIndex;
+            insertBlock(key,
+                    blockOffset < blocks.size()
+                            ? blocks.at(static_cast<int>(blockOffset))
+                            : QByteArray());
+        }
+    });
+    m_prefetchThreadPool.start(pTask);
+}
+
+BlockCachedFile::BlockCachedFile(
+        const QString& fileName,
+        FileBlockCache* pCache)
+        : m_pCache(pCache),
+          m_file(fileName),
+          m_size(0),
+          m_lastModified(0),
+          m_pos(0),
+          m_readAheadBeginBlockIndex(0),
+          m_readAheadEndBlockIndex(0),
+          m_hits(0),
+          m_misses(0) {
+    DEBUG_ASSERT(m_pCache);
+}
+
+BlockCachedFile::~BlockCachedFile() {
+    close();
+}
+
+bool BlockCachedFile::open() {
+    DEBUG_ASSERT(!isOpen());
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        kLogger.warning()
+                << "Failed to open file"
+                << m_file.fileName()
+                << m_file.errorString();
+        return false;
+    }
+    m_size = m_file.size();
+    m_lastModified = fileLastModified(m_file);
+    m_pos = 0;
+    m_readAheadBeginBlockIndex = 0;
+    m_readAheadEndBlockIndex = 0;
+    return true;
+}
+
+void BlockCachedFile::close() {
+    if (!isOpen()) {
+        return;
+    }
+    kLogger.debug()
+            << "Closing"
+            << m_file.fileName()
+            << "with"
+            << m_hits
+            << "cache hits and"
+            << m_misses
+            << "cache misses";
+    m_file.close();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+bool BlockCachedFile::seek(qint64 pos) {
+    if (!isOpen() || pos < 0) {
+        return false;
+    }
+    // Seeking beyond the end is permitted like for QFile,
+    // but subsequent reads will not return any data
+    m_pos = pos;
+    return true;
+}
+
+FileBlockCache::BlockKey BlockCachedFile::blockKey(qint64 blockIndex) const {
+    return FileBlockCache::BlockKey{
+            m_file.fileName(),
+            m_size,
+            m_lastModified,
+            blockIndex};
+}
+
+qint64 BlockCachedFile::read(char* pData, qint64 maxSize) {
+    if (!isOpen()) {
+        return -1;
+    }
+    qint64 bytesRead = 0;
+    while (bytesRead < maxSize && m_pos < m_size) {
+        const qint64 blockIndex = m_pos / FileBlockCache::kBlockSize;
+        bool hit;
+        const QByteArray block = m_pCache->readBlock(blockKey(blockIndex), &m_file, &hit);
+        if (hit) {
+            ++m_hits;
+        } else {
+            ++m_misses;
+        }
+        const qint64 blockOffset = m_pos - blockIndex * FileBlockCache::kBlockSize;
+        if (block.size() <= blockOffset) {
+            // Read error or the file has been truncated
+            if (bytesRead == 0) {
+                return -1;
+            }
+            break;
+        }
+        const qint64 chunkSize = std::min(
+                block.size() - blockOffset,
+                maxSize - bytesRead);
+        std::memcpy(pData + bytesRead, block.constData() + blockOffset, chunkSize);
+        bytesRead += chunkSize;
+        m_pos += chunkSize;
+        readAhead(blockIndex);
+    }
+    return bytesRead;
+}
+
+void BlockCachedFile::readAhead(qint64 blockIndex) {
+    const int readAheadBlockCount = m_pCache->readAheadBlockCount();
+    if (readAheadBlockCount <= 0) {
+        return;
+    }
+    const qint64 nextBlockIndex = blockIndex + 1;
+    const qint64 blockCount =
+            (m_size + FileBlockCache::kBlockSize - 1) / FileBlockCache::kBlockSize;
+    // Continue prefetching after half of the prefetched blocks have been
+    // consumed, or start prefetching again after seeking
+    if (nextBlockIndex >= m_readAheadBeginBlockIndex &&
+            nextBlockIndex < m_readAheadEndBlockIndex - readAheadBlockCount / 2) {
+        return;
+    }
+    const qint64 beginBlockIndex = (nextBlockIndex >= m_readAheadBeginBlockIndex &&
+                                           nextBlockIndex <= m_readAheadEndBlockIndex)
+            ? m_readAheadEndBlockIndex
+            : nextBlockIndex;
+    const qint64 endBlockIndex =
+            std::min(nextBlockIndex + readAheadBlockCount, blockCount);
+    m_readAheadBeginBlockIndex = nextBlockIndex;
+    m_readAheadEndBlockIndex = std::max(endBlockIndex, nextBlockIndex);
+    if (beginBlockIndex >= endBlockIndex) {
+        return;
+    }
+    adviseWillNeed(m_file,
+            beginBlockIndex * FileBlockCache::kBlockSize,
+            (endBlockIndex - beginBlockIndex) * FileBlockCache::kBlockSize);
+    m_pCache->prefetchBlocks(blockKey(beginBlockIndex),
+            static_cast<int>(endBlockIndex - beginBlockIndex));
+}
+
+} // namespace mixxx
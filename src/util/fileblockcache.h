@@ -0,0 +1,181 @@
+#pragma once
+
+#include <QCache>
+#include <QFile>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include "util/compatibility/qatomic.h"
+#include "util/compatibility/qhash.h"
+
+namespace mixxx {
+
+/// Process-wide cache for blocks of audio files that are read by
+/// sound sources.
+///
+/// Decoding libraries read files in many small chunks. This is fine
+/// for local files, but each random access stalls the reader for a
+/// noticeable time if the file is stored on network storage. Files
+/// that are read through the cache are read in larger blocks and the
+/// following blocks are prefetched asynchronously on worker threads.
+///
+/// Blocks are identified by the file path, the size and the last
+/// modification time of the file, i.e. outdated blocks of a file
+/// that has been modified in the meantime are never returned.
+///
+/// All functions are thread-safe.
+class FileBlockCache final {
+  public:
+    static constexpr qint64 kBlockSize = 64 * 1024;
+
+    FileBlockCache(
+            qint64 capacityBytes,
+            qint64 readAheadBytes);
+    ~FileBlockCache();
+
+    /// The shared instance that is used by all sound sources.
+    static FileBlockCache* instance();
+
+    /// The number of bytes that are prefetched asynchronously in
+    /// advance of the current read position. Prefetching is disabled
+    /// if 0.
+    qint64 readAheadBytes() const {
+        return readAheadBlockCount() * kBlockSize;
+    }
+    void setReadAheadBytes(qint64 readAheadBytes);
+
+    struct Stats {
+        quint64 hits = 0;
+        quint64 misses = 0;
+
+        double hitRate() const {
+            const quint64 total = hits + misses;
+            return total > 0 ? static_cast<double>(hits) / total : 0.0;
+        }
+    };
+    Stats stats() const;
+
+  private:
+    friend class BlockCachedFile;
+
+    struct BlockKey {
+        QString filePath;
+        qint64 fileSize;
+        qint64 fileLastModified;
+        qint64 blockIndex;
+
+        friend bool operator==(const BlockKey& lhs, const BlockKey& rhs) {
+            return lhs.blockIndex == rhs.blockIndex &&
+                    lhs.fileSize == rhs.fileSize &&
+                    lhs.fileLastModified == rhs.fileLastModified &&
+                    lhs.filePath == rhs.filePath;
+        }
+        friend qhash_seed_t qHash(
+                const BlockKey& key,
+                qhash_seed_t seed = 0) {
+            return qHash(key.filePath, seed) ^
+                    qHash(key.blockIndex, seed) ^
+                    qHash(key.fileLastModified, seed);
+        }
+    };
+
+    int readAheadBlockCount() const {
+        return atomicLoadRelaxed(m_readAheadBlockCount);
+    }
+
+    /// Returns the cached block or reads it from the opened file.
+    /// Waits for a prefetch of the same block that is already reading
+    /// instead of reading it twice. Blocks of prefetches that are still
+    /// queued behind other files are read directly and skipped by the
+    /// prefetch. Returns an empty block on read errors.
+    QByteArray readBlock(
+            const BlockKey& key,
+            QFile* pFile,
+            bool* pHit);
+
+    /// Asynchronously reads all blocks that are neither cached, queued
+    /// nor reading in the given range.
+    void prefetchBlocks(
+            const BlockKey& firstKey,
+            int blockCount);
+
+    void insertBlock(
+            const BlockKey& key,
+            const QByteArray& block);
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_blockInserted;
+    QCache<BlockKey, QByteArray> m_blocks;
+    // Blocks of prefetches that have not been started yet
+    QSet<BlockKey> m_queuedBlocks;
+    // Blocks that are currently read, either directly or by a prefetch
+    QSet<BlockKey> m_readingBlocks;
+
+    QAtomicInteger<int> m_readAheadBlockCount;
+    QAtomicInteger<quint64> m_hits;
+    QAtomicInteger<quint64> m_misses;
+
+    QThreadPool m_prefetchThreadPool;
+};
+
+/// A read-only file that is read through a FileBlockCache.
+///
+/// Provides the subset of the QFile API that is needed for
+/// implementing the custom I/O callbacks of the decoding libraries.
+/// Not thread-safe, i.e. each instance must only be accessed by a
+/// single thread at a time.
+class BlockCachedFile final {
+  public:
+    explicit BlockCachedFile(
+            const QString& fileName,
+            FileBlockCache* pCache = FileBlockCache::instance());
+    ~BlockCachedFile();
+
+    QString fileName() const {
+        return m_file.fileName();
+    }
+
+    bool open();
+    void close();
+    bool isOpen() const {
+        return m_file.isOpen();
+    }
+
+    qint64 size() const {
+        return m_size;
+    }
+    qint64 pos() const {
+        return m_pos;
+    }
+    bool atEnd() const {
+        return m_pos >= m_size;
+    }
+    bool seek(qint64 pos);
+
+    /// Returns the number of bytes that have been read, 0 at the end
+    /// of the file, or -1 on errors.
+    qint64 read(char* pData, qint64 maxSize);
+
+  private:
+    FileBlockCache::BlockKey blockKey(qint64 blockIndex) const;
+
+    void readAhead(qint64 blockIndex);
+
+    FileBlockCache* const m_pCache;
+    QFile m_file;
+    qint64 m_size;
+    qint64 m_lastModified;
+    qint64 m_pos;
+
+    // The range of blocks that has been requested to be prefetched
+    qint64 m_readAheadBeginBlockIndex;
+    qint64 m_readAheadEndBlockIndex;
+
+    quint64 m_hits;
+    quint64 m_misses;
+};
+
+} // namespace mixxx
@@ -1,5 +1,9 @@
 #include "vinylcontrol/vinylcontrolprocessor.h"
 
+#include <QFuture>
+#include <QVarLengthArray>
+#include <QtConcurrentRun>
+
 #include "control/controlpushbutton.h"
 #include "moc_vinylcontrolprocessor.cpp"
 #include "util/defs.h"
@@ -16,7 +20,6 @@ VinylControlProcessor::VinylControlProcessor(QObject* pParent, UserSettingsPoint
         : QThread(pParent),
           m_pConfig(pConfig),
           m_pToggle(new ControlPushButton(ConfigKey(VINYL_PREF_KEY, "Toggle"))),
-          m_pWorkBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
           m_processorsLock(QT_RECURSIVE_MUTEX_INIT),
           m_processors(kMaximumVinylControlInputs, nullptr),
           m_signalQualityFifo(SIGNAL_QUALITY_FIFO_SIZE),
@@ -31,7 +34,11 @@ VinylControlProcessor::VinylControlProcessor(QObject* pParent, UserSettingsPoint
 
     for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
         m_samplePipes[i] = new FIFO<CSAMPLE>(SAMPLE_PIPE_FIFO_SIZE);
+        m_pWorkBuffers[i] = SampleUtil::alloc(MAX_BUFFER_LEN);
     }
+    m_deckThreadPool.setMaxThreadCount(kMaximumVinylControlInputs - 1);
+    // Keep the threads around, decks are analyzed for every buffer
+    m_deckThreadPool.setExpiryTimeout(-1);
 
     start(QThread::HighPriority);
 }
@@ -42,7 +49,6 @@ VinylControlProcessor::~VinylControlProcessor() {
     wait();
 
     delete m_pToggle;
-    SampleUtil::free(m_pWorkBuffer);
 
     {
         const auto locker = lockMutex(&m_processorsLock);
@@ -53,6 +59,8 @@ VinylControlProcessor::~VinylControlProcessor() {
 
             delete m_samplePipes[i];
             m_samplePipes[i] = nullptr;
+            SampleUtil::free(m_pWorkBuffers[i]);
+            m_pWorkBuffers[i] = nullptr;
         }
     }
 
@@ -85,32 +93,18 @@ void VinylControlProcessor::run() {
             m_bReloadConfig = false;
         }
 
-        for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
-            auto locker = lockMutex(&m_processorsLock);
-            VinylControl* pProcessor = m_processors[i];
-            locker.unlock();
-            FIFO<CSAMPLE>* pSamplePipe = m_samplePipes[i];
-
-            if (pSamplePipe->readAvailable() > 0) {
-                int samplesRead = pSamplePipe->read(m_pWorkBuffer, MAX_BUFFER_LEN);
-
-                if (samplesRead % 2 != 0) {
-                    qWarning() << "VinylControlProcessor received non-even number of samples via sample FIFO.";
-                    samplesRead--;
-                }
-                int framesRead = samplesRead / 2;
+        processDecks();
 
-                if (pProcessor) {
-                    pProcessor->analyzeSamples(m_pWorkBuffer, framesRead);
-                } else {
-                    // Samples are being written to a non-existent processor. Warning?
-                    qWarning() << "Samples written to non-existent VinylControl processor:" << i;
+        // TODO(rryan) define a time-based update rate. This will update way
+        // too quickly.
+        if (m_bReportSignalQuality) {
+            for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+                auto locker = lockMutex(&m_processorsLock);
+                VinylControl* pProcessor = m_processors[i];
+                locker.unlock();
+                if (!pProcessor) {
+                    continue;
                 }
-            }
-
-            // TODO(rryan) define a time-based update rate. This will update way
-            // too quickly.
-            if (pProcessor && m_bReportSignalQuality) {
                 VinylSignalQualityReport report;
                 if (pProcessor->writeQualityReport(&report)) {
                     report.processor = i;
@@ -133,6 +127,62 @@ void VinylControlProcessor::run() {
     }
 }
 
+void VinylControlProcessor::processDecks() {
+    VinylControl* pendingProcessors[kMaximumVinylControlInputs];
+    int pendingFrames[kMaximumVinylControlInputs];
+    int pendingDecks = 0;
+
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        pendingFrames[i] = 0;
+        auto locker = lockMutex(&m_processorsLock);
+        pendingProcessors[i] = m_processors[i];
+        locker.unlock();
+        FIFO<CSAMPLE>* pSamplePipe = m_samplePipes[i];
+
+        if (pSamplePipe->readAvailable() <= 0) {
+            continue;
+        }
+        int samplesRead = pSamplePipe->read(m_pWorkBuffers[i], MAX_BUFFER_LEN);
+
+        if (samplesRead % 2 != 0) {
+            qWarning() << "VinylControlProcessor received non-even number of samples via sample FIFO.";
+            samplesRead--;
+        }
+
+        if (!pendingProcessors[i]) {
+            // Samples are being written to a non-existent processor. Warning?
+            qWarning() << "Samples written to non-existent VinylControl processor:" << i;
+            continue;
+        }
+        pendingFrames[i] = samplesRead / 2;
+        ++pendingDecks;
+    }
+
+    // Each deck has its own timecoder state and work buffer. Hand all but
+    // the last pending deck to the thread pool and analyze the last one
+    // here, so a single deck never pays for a thread handover.
+    QVarLengthArray<QFuture<void>, kMaximumVinylControlInputs> futures;
+    for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
+        if (pendingFrames[i] <= 0) {
+            continue;
+        }
+        VinylControl* pProcessor = pendingProcessors[i];
+        CSAMPLE* pSamples = m_pWorkBuffers[i];
+        const int frames = pendingFrames[i];
+        if (--pendingDecks > 0) {
+            futures.append(QtConcurrent::run(&m_deckThreadPool,
+                    [pProcessor, pSamples, frames] {
+                        pProcessor->analyzeSamples(pSamples, frames);
+                    }));
+        } else {
+            pProcessor->analyzeSamples(pSamples, frames);
+        }
+    }
+    for (auto& future : futures) {
+        future.waitForFinished();
+    }
+}
+
 void VinylControlProcessor::reloadConfig() {
     for (int i = 0; i < kMaximumVinylControlInputs; ++i) {
         auto locker = lockMutex(&m_processorsLock);
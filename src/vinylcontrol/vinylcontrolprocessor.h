@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QThread>
+#include <QThreadPool>
 #include <QVector>
 #include <QWaitCondition>
 
@@ -62,6 +63,9 @@ class VinylControlProcessor : public QThread, public AudioDestination {
 
   private:
     void reloadConfig();
+    // Reads the pending samples of every deck and analyzes the decks in
+    // parallel if more than one of them has received samples.
+    void processDecks();
 
     UserSettingsPointer m_pConfig;
     ControlPushButton* m_pToggle;
@@ -69,7 +73,11 @@ class VinylControlProcessor : public QThread, public AudioDestination {
     // callback to the processor thread. There is a maximum of
     // kMaximumVinylControlInputs pipes.
     FIFO<CSAMPLE>* m_samplePipes[kMaximumVinylControlInputs];
-    CSAMPLE* m_pWorkBuffer;
+    // One work buffer per deck, so the decks can be analyzed concurrently
+    CSAMPLE* m_pWorkBuffers[kMaximumVinylControlInputs];
+    // Analyzes all but one deck when several decks have received samples.
+    // The remaining deck is analyzed on the processor thread itself.
+    QThreadPool m_deckThreadPool;
     QWaitCondition m_samplesAvailableSignal;
     QMutex m_waitForSampleMutex;
     QT_RECURSIVE_MUTEX m_processorsLock;
@@ -7,6 +7,7 @@
 #include <QUrl>
 
 #include "control/controlobject.h"
+#include "library/basesqltablemodel.h"
 #include "library/dao/trackschema.h"
 #include "library/library.h"
 #include "library/library_prefs.h"
@@ -96,6 +97,11 @@ void WTrackTableView::enableCachedOnly() {
 }
 
 void WTrackTableView::slotScrollValueChanged(int /*unused*/) {
+    if (m_loadCachedOnly) {
+        // Repeated while scrolling to withdraw the pending requests
+        // for covers that have been scrolled out of view
+        emit onlyCachedCoverArt(true);
+    }
     enableCachedOnly();
 }
 
@@ -553,25 +559,45 @@ void WTrackTableView::onSearch(const QString& text) {
     TrackId prevTrack = getCurrentTrackId();
     saveCurrentIndex();
     pTrackModel->search(text);
-    if (queryIsLessSpecific) {
-        // If the user removed query terms, we try to select the same
-        // tracks as before
-        setCurrentTrackId(prevTrack, m_prevColumn);
-        setSelectedTracks(selectedTracks);
-    } else {
-        // The user created a more specific search query, try to restore a
-        // previous state
-        if (!restoreCurrentViewState()) {
-            // We found no saved state for this query, try to select the
-            // tracks last active, if they are part of the result set
-            if (!setCurrentTrackId(prevTrack, m_prevColumn)) {
-                // if the last focused track is not present try to focus the
-                // respective index and scroll there
-                restoreCurrentIndex();
-            }
+    afterSelect([this, queryIsLessSpecific, selectedTracks, prevTrack]() {
+        if (queryIsLessSpecific) {
+            // If the user removed query terms, we try to select the same
+            // tracks as before
+            setCurrentTrackId(prevTrack, m_prevColumn);
             setSelectedTracks(selectedTracks);
+        } else {
+            // The user created a more specific search query, try to restore a
+            // previous state
+            if (!restoreCurrentViewState()) {
+                // We found no saved state for this query, try to select the
+                // tracks last active, if they are part of the result set
+                if (!setCurrentTrackId(prevTrack, m_prevColumn)) {
+                    // if the last focused track is not present try to focus the
+                    // respective index and scroll there
+                    restoreCurrentIndex();
+                }
+                setSelectedTracks(selectedTracks);
+            }
         }
+    });
+}
+
+void WTrackTableView::afterSelect(std::function<void()> function) {
+    disconnect(m_afterSelectConnection);
+    auto* pSqlTableModel = qobject_cast<BaseSqlTableModel*>(model());
+    if (!pSqlTableModel || !pSqlTableModel->isSelectPending()) {
+        function();
+        return;
     }
+    m_afterSelectConnection = connect(pSqlTableModel,
+            &BaseSqlTableModel::selectFinished,
+            this,
+            [this, function = std::move(function)]() {
+                // The function object is released when disconnecting
+                const auto invokeFunction = function;
+                disconnect(m_afterSelectConnection);
+                invokeFunction();
+            });
 }
 
 void WTrackTableView::onShow() {
@@ -1565,15 +1591,22 @@ void WTrackTableView::doSortByColumn(int headerSection, Qt::SortOrder sortOrder)
 
     sortByColumn(headerSection, sortOrder);
 
-    if (usePositions) {
-        selectTracksByPosition(selectedTrackPositions, prevColumn);
-    } else {
-        selectTracksById(selectedTrackIds, prevColumn);
-    }
+    afterSelect([this,
+                        usePositions,
+                        selectedTrackPositions,
+                        selectedTrackIds,
+                        prevColumn,
+                        savedHScrollBarPos]() {
+        if (usePositions) {
+            selectTracksByPosition(selectedTrackPositions, prevColumn);
+        } else {
+            selectTracksById(selectedTrackIds, prevColumn);
+        }
 
-    // This seems to be broken since at least Qt 5.12: no scrolling is issued
-    // scrollTo(first, QAbstractItemView::EnsureVisible);
-    horizontalScrollBar()->setValue(savedHScrollBarPos);
+        // This seems to be broken since at least Qt 5.12: no scrolling is issued
+        // scrollTo(first, QAbstractItemView::EnsureVisible);
+        horizontalScrollBar()->setValue(savedHScrollBarPos);
+    });
 }
 
 void WTrackTableView::selectTracksByPosition(const QList<int>& positions, int prevColumn) {
@@ -2,6 +2,7 @@
 
 #include <QAbstractItemModel>
 #include <QSortFilterProxyModel>
+#include <functional>
 
 #include "control/controlproxy.h"
 #include "control/pollingcontrolproxy.h"
@@ -173,6 +174,10 @@ class WTrackTableView : public WLibraryTableView {
 
     void hideOrRemoveSelectedTracks();
 
+    // Invokes the function after the model has selected its rows, which
+    // might happen in the background after searching or sorting.
+    void afterSelect(std::function<void()> function);
+
     const UserSettingsPointer m_pConfig;
     Library* const m_pLibrary;
 
@@ -184,6 +189,7 @@ class WTrackTableView : public WLibraryTableView {
     QColor m_trackPlayedColor;
     QColor m_trackMissingColor;
     bool m_sorting;
+    QMetaObject::Connection m_afterSelectConnection;
 
     // Control the delay to load a cover art.
     mixxx::Duration m_lastUserAction;